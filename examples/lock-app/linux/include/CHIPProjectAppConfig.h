@@ -32,3 +32,6 @@
 
 // Allows app options (ports) to be configured on launch of app
 #define CHIP_DEVICE_ENABLE_PORT_PARAMS 1
+
+// Resolve PIN codes and other credentials through the Door Lock server's in-memory credential index
+#define DOOR_LOCK_SERVER_CREDENTIAL_INDEX 1
@@ -267,7 +267,8 @@ class HostBuilder(GnBuilder):
                  separate_event_loop=True, fuzzing_type: HostFuzzingType = HostFuzzingType.NONE, use_clang=False,
                  interactive_mode=True, extra_tests=False, use_platform_mdns=False, enable_rpcs=False,
                  use_coverage=False, use_dmalloc=False, minmdns_address_policy=None,
-                 minmdns_high_verbosity=False, imgui_ui=False, crypto_library: HostCryptoLibrary = None):
+                 minmdns_high_verbosity=False, imgui_ui=False, crypto_library: HostCryptoLibrary = None,
+                 lazy_cluster_init=False):
         super(HostBuilder, self).__init__(
             root=os.path.join(root, 'examples', app.ExamplePath()),
             runner=runner)
@@ -325,6 +326,9 @@ class HostBuilder(GnBuilder):
         if imgui_ui:
             self.extra_gn_options.append('chip_examples_enable_imgui_ui=true')
 
+        if lazy_cluster_init:
+            self.extra_gn_options.append('chip_config_lazy_cluster_init=true')
+
         self.use_coverage = use_coverage
         if use_coverage:
             self.extra_gn_options.append('use_coverage=true')
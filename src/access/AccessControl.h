@@ -26,6 +26,10 @@
 #include <lib/core/Global.h>
 #include <lib/support/CodeUtils.h>
 
+#if CHIP_IM_REPORT_BUILDER_THREADS > 0
+#include <mutex>
+#endif
+
 // Dump function for use during development only (0 for disabled, non-zero for enabled).
 #define CHIP_ACCESS_CONTROL_DUMP_ENABLED 0
 
@@ -634,6 +638,9 @@ public:
      * @retval #CHIP_ERROR_ACCESS_DENIED if denied.
      * @retval other errors should also be treated as denied.
      * @retval #CHIP_NO_ERROR if allowed.
+     *
+     * With CHIP_IM_REPORT_BUILDER_THREADS, report builder threads may check
+     * access concurrently, while the thread holding the stack lock waits.
      */
     CHIP_ERROR Check(const SubjectDescriptor & subjectDescriptor, const RequestPath & requestPath, Privilege requestPrivilege);
 
@@ -655,6 +662,11 @@ private:
     DeviceTypeResolver * mDeviceTypeResolver = nullptr;
 
     EntryListener * mEntryListener = nullptr;
+
+#if CHIP_IM_REPORT_BUILDER_THREADS > 0
+    // Serializes Check, since delegates iterate their entries through shared state.
+    std::mutex mCheckMutex;
+#endif
 };
 
 /**
@@ -19,6 +19,8 @@
 #include "system/SystemPacketBuffer.h"
 #include <app/ClusterStateCache.h>
 #include <app/InteractionModelEngine.h>
+#include <lib/support/DefaultStorageKeyAllocator.h>
+#include <lib/support/SafeInt.h>
 #include <tuple>
 
 namespace chip {
@@ -47,6 +49,53 @@ size_t SizeOfStatusIB(const StatusIB & aStatus)
     return size;
 }
 
+// Bumped whenever the snapshot layout changes in a way older code cannot read.
+constexpr uint8_t kSnapshotFormatVersion = 1;
+
+// Persistent storage values are sized with a uint16_t.
+constexpr uint16_t kMaxStoredSnapshotSize = UINT16_MAX;
+
+//
+// Snapshot ::= STRUCTURE {
+//     formatVersion [0]      : uint8, always the first element
+//     highestEventNumber [1] : uint64, optional
+//     clusters [2]           : ARRAY of STRUCTURE {
+//         endpointId [0]  : uint16
+//         clusterId [1]   : uint32
+//         dataVersion [2] : uint32, optional, the committed data version
+//         attributes [3]  : ARRAY of STRUCTURE {
+//             attributeId [0]   : uint32
+//             data [1]          : octet string holding the cached anonymous TLV element, or
+//             status [2]        : uint8, with an optional clusterStatus [3] : uint8, or
+//             size [4]          : uint, when the cache does not store data
+//         }
+//     }
+// }
+//
+enum class SnapshotTag : uint8_t
+{
+    kFormatVersion      = 0,
+    kHighestEventNumber = 1,
+    kClusters           = 2,
+};
+
+enum class ClusterSnapshotTag : uint8_t
+{
+    kEndpointId  = 0,
+    kClusterId   = 1,
+    kDataVersion = 2,
+    kAttributes  = 3,
+};
+
+enum class AttributeSnapshotTag : uint8_t
+{
+    kAttributeId   = 0,
+    kData          = 1,
+    kStatus        = 2,
+    kClusterStatus = 3,
+    kSize          = 4,
+};
+
 } // anonymous namespace
 
 CHIP_ERROR ClusterStateCache::GetElementTLVSize(TLV::TLVReader * apData, size_t & aSize)
@@ -587,6 +636,334 @@ exit:
     return err;
 }
 
+CHIP_ERROR ClusterStateCache::SaveSnapshot(TLV::TLVWriter & aWriter, TLV::Tag aTag) const
+{
+    TLV::TLVType snapshotType;
+    TLV::TLVType clustersType;
+
+    ReturnErrorOnFailure(aWriter.StartContainer(aTag, TLV::kTLVType_Structure, snapshotType));
+    ReturnErrorOnFailure(aWriter.Put(TLV::ContextTag(SnapshotTag::kFormatVersion), kSnapshotFormatVersion));
+    if (mHighestReceivedEventNumber.HasValue())
+    {
+        ReturnErrorOnFailure(aWriter.Put(TLV::ContextTag(SnapshotTag::kHighestEventNumber), mHighestReceivedEventNumber.Value()));
+    }
+
+    ReturnErrorOnFailure(aWriter.StartContainer(TLV::ContextTag(SnapshotTag::kClusters), TLV::kTLVType_Array, clustersType));
+    for (auto const & endpointIter : mCache)
+    {
+        for (auto const & clusterIter : endpointIter.second)
+        {
+            TLV::TLVType clusterType;
+            TLV::TLVType attributesType;
+
+            ReturnErrorOnFailure(aWriter.StartContainer(TLV::AnonymousTag(), TLV::kTLVType_Structure, clusterType));
+            ReturnErrorOnFailure(aWriter.Put(TLV::ContextTag(ClusterSnapshotTag::kEndpointId), endpointIter.first));
+            ReturnErrorOnFailure(aWriter.Put(TLV::ContextTag(ClusterSnapshotTag::kClusterId), clusterIter.first));
+            if (clusterIter.second.mCommittedDataVersion.HasValue())
+            {
+                ReturnErrorOnFailure(aWriter.Put(TLV::ContextTag(ClusterSnapshotTag::kDataVersion),
+                                                 clusterIter.second.mCommittedDataVersion.Value()));
+            }
+
+            ReturnErrorOnFailure(
+                aWriter.StartContainer(TLV::ContextTag(ClusterSnapshotTag::kAttributes), TLV::kTLVType_Array, attributesType));
+            for (auto const & attributeIter : clusterIter.second.mAttributes)
+            {
+                ReturnErrorOnFailure(SaveAttributeSnapshot(aWriter, attributeIter.first, attributeIter.second));
+            }
+            ReturnErrorOnFailure(aWriter.EndContainer(attributesType));
+            ReturnErrorOnFailure(aWriter.EndContainer(clusterType));
+        }
+    }
+    ReturnErrorOnFailure(aWriter.EndContainer(clustersType));
+
+    return aWriter.EndContainer(snapshotType);
+}
+
+CHIP_ERROR ClusterStateCache::SaveAttributeSnapshot(TLV::TLVWriter & aWriter, AttributeId aAttributeId,
+                                                    const AttributeState & aState)
+{
+    TLV::TLVType attributeType;
+
+    ReturnErrorOnFailure(aWriter.StartContainer(TLV::AnonymousTag(), TLV::kTLVType_Structure, attributeType));
+    ReturnErrorOnFailure(aWriter.Put(TLV::ContextTag(AttributeSnapshotTag::kAttributeId), aAttributeId));
+
+    if (aState.Is<StatusIB>())
+    {
+        const StatusIB & status = aState.Get<StatusIB>();
+        ReturnErrorOnFailure(aWriter.Put(TLV::ContextTag(AttributeSnapshotTag::kStatus), status.mStatus));
+        if (status.mClusterStatus.HasValue())
+        {
+            ReturnErrorOnFailure(aWriter.Put(TLV::ContextTag(AttributeSnapshotTag::kClusterStatus), status.mClusterStatus.Value()));
+        }
+    }
+    else if (aState.Is<AttributeData>())
+    {
+        const AttributeData & data = aState.Get<AttributeData>();
+        ReturnErrorOnFailure(aWriter.Put(TLV::ContextTag(AttributeSnapshotTag::kData), ByteSpan(data.Get(), data.AllocatedSize())));
+    }
+    else
+    {
+        VerifyOrDie(aState.Is<size_t>());
+        uint64_t size = aState.Get<size_t>();
+        ReturnErrorOnFailure(aWriter.Put(TLV::ContextTag(AttributeSnapshotTag::kSize), size));
+    }
+
+    return aWriter.EndContainer(attributeType);
+}
+
+CHIP_ERROR ClusterStateCache::LoadSnapshot(TLV::TLVReader & aReader)
+{
+    NodeState cache;
+    Optional<EventNumber> highestReceivedEventNumber;
+    bool formatVersionChecked = false;
+    TLV::TLVType snapshotType;
+    CHIP_ERROR err;
+
+    VerifyOrReturnError(aReader.GetType() == TLV::kTLVType_Structure, CHIP_ERROR_WRONG_TLV_TYPE);
+    ReturnErrorOnFailure(aReader.EnterContainer(snapshotType));
+    while ((err = aReader.Next()) == CHIP_NO_ERROR)
+    {
+        VerifyOrReturnError(TLV::IsContextTag(aReader.GetTag()), CHIP_ERROR_INVALID_TLV_TAG);
+        auto tag = static_cast<SnapshotTag>(TLV::TagNumFromTag(aReader.GetTag()));
+
+        // Nothing after the format version can be interpreted before it has been checked.
+        VerifyOrReturnError(formatVersionChecked || tag == SnapshotTag::kFormatVersion, CHIP_ERROR_INVALID_TLV_ELEMENT);
+
+        switch (tag)
+        {
+        case SnapshotTag::kFormatVersion: {
+            uint8_t formatVersion;
+            ReturnErrorOnFailure(aReader.Get(formatVersion));
+            VerifyOrReturnError(formatVersion == kSnapshotFormatVersion, CHIP_ERROR_VERSION_MISMATCH);
+            formatVersionChecked = true;
+            break;
+        }
+        case SnapshotTag::kHighestEventNumber: {
+            EventNumber eventNumber;
+            ReturnErrorOnFailure(aReader.Get(eventNumber));
+            highestReceivedEventNumber.SetValue(eventNumber);
+            break;
+        }
+        case SnapshotTag::kClusters: {
+            TLV::TLVType clustersType;
+            ReturnErrorOnFailure(aReader.EnterContainer(clustersType));
+            while ((err = aReader.Next()) == CHIP_NO_ERROR)
+            {
+                ReturnErrorOnFailure(LoadClusterSnapshot(aReader, cache));
+            }
+            VerifyOrReturnError(err == CHIP_END_OF_TLV, err);
+            ReturnErrorOnFailure(aReader.ExitContainer(clustersType));
+            break;
+        }
+        default:
+            // Unknown elements are skipped, so that optional ones can be added without changing the format version.
+            break;
+        }
+    }
+    VerifyOrReturnError(err == CHIP_END_OF_TLV, err);
+    ReturnErrorOnFailure(aReader.ExitContainer(snapshotType));
+    VerifyOrReturnError(formatVersionChecked, CHIP_ERROR_INVALID_TLV_ELEMENT);
+
+    mCache = std::move(cache);
+    if (highestReceivedEventNumber.HasValue() &&
+        (!mHighestReceivedEventNumber.HasValue() || mHighestReceivedEventNumber.Value() < highestReceivedEventNumber.Value()))
+    {
+        mHighestReceivedEventNumber = highestReceivedEventNumber;
+    }
+    mChangedAttributeSet.clear();
+    mAddedEndpoints.clear();
+    mLastReportDataPath = ConcreteClusterPath(kInvalidEndpointId, kInvalidClusterId);
+
+    return CHIP_NO_ERROR;
+}
+
+CHIP_ERROR ClusterStateCache::LoadClusterSnapshot(TLV::TLVReader & aReader, NodeState & aCache) const
+{
+    Optional<EndpointId> endpointId;
+    Optional<ClusterId> clusterId;
+    ClusterState clusterState;
+    TLV::TLVType clusterType;
+    CHIP_ERROR err;
+
+    VerifyOrReturnError(aReader.GetType() == TLV::kTLVType_Structure, CHIP_ERROR_WRONG_TLV_TYPE);
+    ReturnErrorOnFailure(aReader.EnterContainer(clusterType));
+    while ((err = aReader.Next()) == CHIP_NO_ERROR)
+    {
+        VerifyOrReturnError(TLV::IsContextTag(aReader.GetTag()), CHIP_ERROR_INVALID_TLV_TAG);
+        switch (static_cast<ClusterSnapshotTag>(TLV::TagNumFromTag(aReader.GetTag())))
+        {
+        case ClusterSnapshotTag::kEndpointId: {
+            EndpointId value;
+            ReturnErrorOnFailure(aReader.Get(value));
+            endpointId.SetValue(value);
+            break;
+        }
+        case ClusterSnapshotTag::kClusterId: {
+            ClusterId value;
+            ReturnErrorOnFailure(aReader.Get(value));
+            clusterId.SetValue(value);
+            break;
+        }
+        case ClusterSnapshotTag::kDataVersion: {
+            DataVersion value;
+            ReturnErrorOnFailure(aReader.Get(value));
+            clusterState.mCommittedDataVersion.SetValue(value);
+            break;
+        }
+        case ClusterSnapshotTag::kAttributes: {
+            TLV::TLVType attributesType;
+            ReturnErrorOnFailure(aReader.EnterContainer(attributesType));
+            while ((err = aReader.Next()) == CHIP_NO_ERROR)
+            {
+                AttributeId attributeId;
+                AttributeState state;
+                ReturnErrorOnFailure(LoadAttributeSnapshot(aReader, attributeId, state));
+                clusterState.mAttributes[attributeId] = std::move(state);
+            }
+            VerifyOrReturnError(err == CHIP_END_OF_TLV, err);
+            ReturnErrorOnFailure(aReader.ExitContainer(attributesType));
+            break;
+        }
+        default:
+            break;
+        }
+    }
+    VerifyOrReturnError(err == CHIP_END_OF_TLV, err);
+    ReturnErrorOnFailure(aReader.ExitContainer(clusterType));
+    VerifyOrReturnError(endpointId.HasValue() && clusterId.HasValue(), CHIP_ERROR_INVALID_TLV_ELEMENT);
+
+    aCache[endpointId.Value()][clusterId.Value()] = std::move(clusterState);
+    return CHIP_NO_ERROR;
+}
+
+CHIP_ERROR ClusterStateCache::LoadAttributeSnapshot(TLV::TLVReader & aReader, AttributeId & aAttributeId,
+                                                    AttributeState & aState) const
+{
+    bool hasAttributeId = false;
+    bool hasStatus      = false;
+    StatusIB status;
+    TLV::TLVType attributeType;
+    CHIP_ERROR err;
+
+    VerifyOrReturnError(aReader.GetType() == TLV::kTLVType_Structure, CHIP_ERROR_WRONG_TLV_TYPE);
+    ReturnErrorOnFailure(aReader.EnterContainer(attributeType));
+    while ((err = aReader.Next()) == CHIP_NO_ERROR)
+    {
+        VerifyOrReturnError(TLV::IsContextTag(aReader.GetTag()), CHIP_ERROR_INVALID_TLV_TAG);
+        switch (static_cast<AttributeSnapshotTag>(TLV::TagNumFromTag(aReader.GetTag())))
+        {
+        case AttributeSnapshotTag::kAttributeId:
+            ReturnErrorOnFailure(aReader.Get(aAttributeId));
+            hasAttributeId = true;
+            break;
+        case AttributeSnapshotTag::kData: {
+            ByteSpan data;
+            ReturnErrorOnFailure(aReader.Get(data));
+
+            // The data must hold a TLV element, or Get() would fail on it later.
+            TLV::TLVReader dataReader;
+            dataReader.Init(data);
+            ReturnErrorOnFailure(dataReader.Next());
+
+            if (mCacheData)
+            {
+                AttributeData buffer;
+                buffer.Calloc(data.size());
+                VerifyOrReturnError(buffer.Get() != nullptr, CHIP_ERROR_NO_MEMORY);
+                memcpy(buffer.Get(), data.data(), data.size());
+                aState.Set<AttributeData>(std::move(buffer));
+            }
+            else
+            {
+                aState.Set<size_t>(data.size());
+            }
+            break;
+        }
+        case AttributeSnapshotTag::kStatus:
+            ReturnErrorOnFailure(aReader.Get(status.mStatus));
+            hasStatus = true;
+            break;
+        case AttributeSnapshotTag::kClusterStatus: {
+            ClusterStatus clusterStatus;
+            ReturnErrorOnFailure(aReader.Get(clusterStatus));
+            status.mClusterStatus.SetValue(clusterStatus);
+            break;
+        }
+        case AttributeSnapshotTag::kSize: {
+            uint64_t size;
+            ReturnErrorOnFailure(aReader.Get(size));
+            VerifyOrReturnError(CanCastTo<size_t>(size), CHIP_ERROR_INVALID_INTEGER_VALUE);
+            aState.Set<size_t>(static_cast<size_t>(size));
+            break;
+        }
+        default:
+            break;
+        }
+    }
+    VerifyOrReturnError(err == CHIP_END_OF_TLV, err);
+    ReturnErrorOnFailure(aReader.ExitContainer(attributeType));
+
+    if (hasStatus)
+    {
+        if (mCacheData)
+        {
+            aState.Set<StatusIB>(status);
+        }
+        else
+        {
+            aState.Set<size_t>(SizeOfStatusIB(status));
+        }
+    }
+
+    VerifyOrReturnError(hasAttributeId && aState.Valid(), CHIP_ERROR_INVALID_TLV_ELEMENT);
+    return CHIP_NO_ERROR;
+}
+
+CHIP_ERROR ClusterStateCache::SaveSnapshot(PersistentStorageDelegate & aStorage, const ScopedNodeId & aNodeId) const
+{
+    Platform::ScopedMemoryBuffer<uint8_t> buffer;
+    VerifyOrReturnError(buffer.Alloc(kMaxStoredSnapshotSize), CHIP_ERROR_NO_MEMORY);
+
+    TLV::TLVWriter writer;
+    writer.Init(buffer.Get(), kMaxStoredSnapshotSize);
+    CHIP_ERROR err = SaveSnapshot(writer, TLV::AnonymousTag());
+    if (err == CHIP_ERROR_NO_MEMORY || err == CHIP_ERROR_BUFFER_TOO_SMALL)
+    {
+        ChipLogError(DataManagement, "Cluster state cache snapshot does not fit in %u bytes",
+                     static_cast<unsigned>(kMaxStoredSnapshotSize));
+        return CHIP_ERROR_BUFFER_TOO_SMALL;
+    }
+    ReturnErrorOnFailure(err);
+    ReturnErrorOnFailure(writer.Finalize());
+
+    return aStorage.SyncSetKeyValue(
+        DefaultStorageKeyAllocator::ClusterStateCacheSnapshot(aNodeId.GetFabricIndex(), aNodeId.GetNodeId()).KeyName(),
+        buffer.Get(), static_cast<uint16_t>(writer.GetLengthWritten()));
+}
+
+CHIP_ERROR ClusterStateCache::LoadSnapshot(PersistentStorageDelegate & aStorage, const ScopedNodeId & aNodeId)
+{
+    Platform::ScopedMemoryBuffer<uint8_t> buffer;
+    VerifyOrReturnError(buffer.Alloc(kMaxStoredSnapshotSize), CHIP_ERROR_NO_MEMORY);
+
+    uint16_t size = kMaxStoredSnapshotSize;
+    ReturnErrorOnFailure(aStorage.SyncGetKeyValue(
+        DefaultStorageKeyAllocator::ClusterStateCacheSnapshot(aNodeId.GetFabricIndex(), aNodeId.GetNodeId()).KeyName(),
+        buffer.Get(), size));
+
+    TLV::TLVReader reader;
+    reader.Init(buffer.Get(), size);
+    ReturnErrorOnFailure(reader.Next(TLV::kTLVType_Structure, TLV::AnonymousTag()));
+    return LoadSnapshot(reader);
+}
+
+CHIP_ERROR ClusterStateCache::DeleteSnapshot(PersistentStorageDelegate & aStorage, const ScopedNodeId & aNodeId)
+{
+    return aStorage.SyncDeleteKeyValue(
+        DefaultStorageKeyAllocator::ClusterStateCacheSnapshot(aNodeId.GetFabricIndex(), aNodeId.GetNodeId()).KeyName());
+}
+
 CHIP_ERROR ClusterStateCache::GetLastReportDataPath(ConcreteClusterPath & aPath)
 {
     if (mLastReportDataPath.IsValidConcreteClusterPath())
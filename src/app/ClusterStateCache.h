@@ -27,6 +27,8 @@
 #include <app/ReadClient.h>
 #include <app/data-model/DecodableList.h>
 #include <app/data-model/Decode.h>
+#include <lib/core/CHIPPersistentStorageDelegate.h>
+#include <lib/core/ScopedNodeId.h>
 #include <lib/support/Variant.h>
 #include <list>
 #include <map>
@@ -525,6 +527,46 @@ public:
      */
     CHIP_ERROR GetLastReportDataPath(ConcreteClusterPath & aPath);
 
+    /*
+     * Snapshots let a controller keep what it knows about a node across restarts.
+     *
+     * A snapshot holds the attribute data and statuses in the cache, the committed data version of every cluster and the
+     * highest received event number. Cached events and event statuses are not part of it. Once a snapshot has been loaded,
+     * subscribing through this cache sends DataVersionFilters for the restored clusters and asks only for events after the
+     * restored event number, so the publisher only reports what changed in the meantime.
+     *
+     * Snapshots are best saved between reports, e.g. from OnReportEnd(): clusters that are in the middle of a report have no
+     * committed data version yet, and are fetched in full again after a restore.
+     */
+
+    /*
+     * Write a snapshot of the cache as a single TLV structure with the given tag.
+     */
+    CHIP_ERROR SaveSnapshot(TLV::TLVWriter & aWriter, TLV::Tag aTag) const;
+
+    /*
+     * Replace the attribute state of the cache and the highest received event number with the contents of a snapshot, given
+     * a reader positioned on the structure written by SaveSnapshot(). No callbacks are invoked.
+     *
+     * Notable return values:
+     *      - If the snapshot was written in a format this version does not understand, CHIP_ERROR_VERSION_MISMATCH
+     *        shall be returned.
+     *
+     *      - On any error, the cache is left unchanged.
+     *
+     */
+    CHIP_ERROR LoadSnapshot(TLV::TLVReader & aReader);
+
+    /*
+     * Save, load or delete the snapshot of the given node in persistent storage.
+     *
+     * Storage values are limited to 64 KiB; if the snapshot does not fit, CHIP_ERROR_BUFFER_TOO_SMALL shall be returned
+     * from SaveSnapshot() and the previously stored snapshot, if any, is left in place.
+     */
+    CHIP_ERROR SaveSnapshot(PersistentStorageDelegate & aStorage, const ScopedNodeId & aNodeId) const;
+    CHIP_ERROR LoadSnapshot(PersistentStorageDelegate & aStorage, const ScopedNodeId & aNodeId);
+    static CHIP_ERROR DeleteSnapshot(PersistentStorageDelegate & aStorage, const ScopedNodeId & aNodeId);
+
 private:
     // An attribute state can be one of three things:
     // * If we got a path-specific error for the attribute, the corresponding
@@ -661,6 +703,10 @@ private:
 
     CHIP_ERROR GetElementTLVSize(TLV::TLVReader * apData, size_t & aSize);
 
+    static CHIP_ERROR SaveAttributeSnapshot(TLV::TLVWriter & aWriter, AttributeId aAttributeId, const AttributeState & aState);
+    CHIP_ERROR LoadClusterSnapshot(TLV::TLVReader & aReader, NodeState & aCache) const;
+    CHIP_ERROR LoadAttributeSnapshot(TLV::TLVReader & aReader, AttributeId & aAttributeId, AttributeState & aState) const;
+
     Callback & mCallback;
     NodeState mCache;
     std::set<ConcreteAttributePath> mChangedAttributeSet;
@@ -348,6 +348,8 @@ Status CommandHandler::ProcessGroupCommandDataIB(CommandDataIB::Parser & aComman
     CommandId commandId;
     GroupId groupId;
     FabricIndex fabric;
+    Access::SubjectDescriptor subjectDescriptor;
+    Access::Privilege requestPrivilege = Access::Privilege::kOperate;
 
     Credentials::GroupDataProvider::GroupEndpoint mapping;
     Credentials::GroupDataProvider * groupDataProvider = Credentials::GetGroupDataProvider();
@@ -391,8 +393,14 @@ Status CommandHandler::ProcessGroupCommandDataIB(CommandDataIB::Parser & aComman
     // No check for `CommandIsFabricScoped` unlike in `ProcessCommandDataIB()` since group commands
     // always have an accessing fabric, by definition.
 
-    // Find which endpoints can process the command, and dispatch to them.
-    iterator = groupDataProvider->IterateEndpoints(fabric);
+    // The subject and the required privilege only depend on the session and the (cluster, command) pair,
+    // so compute them once instead of once per member endpoint.
+    subjectDescriptor = GetSubjectDescriptor();
+    requestPrivilege  = RequiredPrivilege::ForInvokeCommand(ConcreteCommandPath(kInvalidEndpointId, clusterId, commandId));
+
+    // Find which endpoints can process the command, and dispatch to them. Only the endpoints mapped to
+    // the destination group are loaded, rather than every group/endpoint mapping of the fabric.
+    iterator = groupDataProvider->IterateEndpoints(fabric, MakeOptional(groupId));
     VerifyOrReturnError(iterator != nullptr, Status::Failure);
 
     while (iterator->Next(mapping))
@@ -417,10 +425,9 @@ Status CommandHandler::ProcessGroupCommandDataIB(CommandDataIB::Parser & aComman
         }
 
         {
-            Access::SubjectDescriptor subjectDescriptor = GetSubjectDescriptor();
+            // Access control entries may target individual endpoints, so the check itself still has to be done per endpoint.
             Access::RequestPath requestPath{ .cluster = concretePath.mClusterId, .endpoint = concretePath.mEndpointId };
-            Access::Privilege requestPrivilege = RequiredPrivilege::ForInvokeCommand(concretePath);
-            err                                = Access::GetAccessControl().Check(subjectDescriptor, requestPath, requestPrivilege);
+            err = Access::GetAccessControl().Check(subjectDescriptor, requestPath, requestPrivilege);
             if (err != CHIP_NO_ERROR)
             {
                 // NOTE: an expected error is CHIP_ERROR_ACCESS_DENIED, but there could be other unexpected errors;
@@ -429,11 +436,11 @@ Status CommandHandler::ProcessGroupCommandDataIB(CommandDataIB::Parser & aComman
                 continue;
             }
         }
-        if ((err = MatterPreCommandReceivedCallback(concretePath, GetSubjectDescriptor())) == CHIP_NO_ERROR)
+        if ((err = MatterPreCommandReceivedCallback(concretePath, subjectDescriptor)) == CHIP_NO_ERROR)
         {
             TLV::TLVReader dataReader(commandDataReader);
             mpCallback->DispatchCommand(*this, concretePath, dataReader);
-            MatterPostCommandReceivedCallback(concretePath, GetSubjectDescriptor());
+            MatterPostCommandReceivedCallback(concretePath, subjectDescriptor);
         }
         else
         {
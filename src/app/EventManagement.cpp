@@ -19,6 +19,7 @@
 #include <access/AccessControl.h>
 #include <access/RequestPath.h>
 #include <access/SubjectDescriptor.h>
+#include <algorithm>
 #include <app/EventManagement.h>
 #include <app/InteractionModelEngine.h>
 #include <app/RequiredPrivilege.h>
@@ -26,6 +27,7 @@
 #include <inttypes.h>
 #include <lib/core/TLVUtilities.h>
 #include <lib/support/CodeUtils.h>
+#include <lib/support/SafeInt.h>
 #include <lib/support/logging/CHIPLogging.h>
 
 using namespace chip::TLV;
@@ -126,42 +128,18 @@ void EventManagement::Init(Messaging::ExchangeManager * apExchangeManager, uint3
     mMonotonicStartupTime = aMonotonicStartupTime;
 }
 
-CHIP_ERROR EventManagement::CopyToNextBuffer(CircularEventBuffer * apEventBuffer)
+CHIP_ERROR EventManagement::MoveHeadToNextBuffer(CircularEventBuffer * apEventBuffer, size_t aEventLength)
 {
-    CircularTLVWriter writer;
-    CircularTLVReader reader;
-    CHIP_ERROR err                   = CHIP_NO_ERROR;
     CircularEventBuffer * nextBuffer = apEventBuffer->GetNextCircularEventBuffer();
-    if (nextBuffer == nullptr)
-    {
-        return CHIP_ERROR_INVALID_ARGUMENT;
-    }
-    CircularEventBuffer backup = *nextBuffer;
-
-    // Set up the next buffer s.t. it fails if needs to evict an element
-    nextBuffer->mProcessEvictedElement = AlwaysFail;
-
-    writer.Init(*nextBuffer);
-
-    // Set up the reader s.t. it is positioned to read the head event
-    reader.Init(*apEventBuffer);
-
-    err = reader.Next();
-    SuccessOrExit(err);
-
-    err = writer.CopyElement(reader);
-    SuccessOrExit(err);
+    VerifyOrReturnError(nextBuffer != nullptr, CHIP_ERROR_INVALID_ARGUMENT);
+    VerifyOrReturnError(CanCastTo<uint32_t>(aEventLength), CHIP_ERROR_INVALID_ARGUMENT);
 
-    err = writer.Finalize();
-    SuccessOrExit(err);
+    // EvictEvent has already walked the head event to find its length, so the encoded bytes can be moved as they are
+    // instead of being parsed again by a TLV copy and then skipped over once more to evict them.
+    ReturnErrorOnFailure(apEventBuffer->MoveHeadTo(*nextBuffer, static_cast<uint32_t>(aEventLength)));
 
     ChipLogDetail(EventLogging, "Copy Event to next buffer with priority %u", static_cast<unsigned>(nextBuffer->GetPriority()));
-exit:
-    if (err != CHIP_NO_ERROR)
-    {
-        *nextBuffer = backup;
-    }
-    return err;
+    return CHIP_NO_ERROR;
 }
 
 CHIP_ERROR EventManagement::EnsureSpaceInCircularBuffer(size_t aRequiredSpace, PriorityLevel aPriority)
@@ -211,22 +189,10 @@ CHIP_ERROR EventManagement::EnsureSpaceInCircularBuffer(size_t aRequiredSpace, P
                 VerifyOrExit(eventBuffer->GetNextCircularEventBuffer() != nullptr, err = CHIP_ERROR_INCORRECT_STATE);
                 if (ctx.mSpaceNeededForMovedEvent <= eventBuffer->GetNextCircularEventBuffer()->AvailableDataLength())
                 {
-                    // we can copy the event outright.  copy event and
-                    // subsequently evict head s.t. evicting the head
-                    // element always succeeds.
-                    // Since we're calling CopyElement and we've checked
-                    // that there is space in the next buffer, we don't expect
-                    // this to fail.
-                    err = CopyToNextBuffer(eventBuffer);
-                    SuccessOrExit(err);
-                    // success; evict head unconditionally
-                    eventBuffer->mProcessEvictedElement = nullptr;
-                    err                                 = eventBuffer->EvictHead();
-                    // if unconditional eviction failed, this
-                    // means that we have no way of further
-                    // clearing the buffer.  fail out and let the
-                    // caller know that we could not honor the
-                    // request
+                    // we can move the event outright.  Since we've checked
+                    // that there is space in the next buffer, we don't
+                    // expect this to fail.
+                    err = MoveHeadToNextBuffer(eventBuffer, ctx.mSpaceNeededForMovedEvent);
                     SuccessOrExit(err);
                     continue;
                 }
@@ -248,12 +214,16 @@ CHIP_ERROR EventManagement::EnsureSpaceInCircularBuffer(size_t aRequiredSpace, P
         else
         {
             // this branch is only taken when we go back in the buffer chain since we have free/spare enough space in next buffer,
-            // and need to retry to copy event from current buffer to next buffer, and free space for current buffer
+            // and need to move the event from current buffer to next buffer, and free space for current buffer
             if (eventBuffer == mpEventBuffer)
                 break;
-            eventBuffer   = eventBuffer->GetPreviousCircularEventBuffer();
-            requiredSpace = eventBuffer->GetRequiredSpaceforEvicted();
-            err           = CHIP_NO_ERROR;
+            // the space we just made is exactly what the head of the previous buffer needs, and that head has not changed
+            // since EvictEvent measured it, so move it now rather than evicting (and parsing) it a second time.
+            const size_t movedEventLength = requiredSpace;
+            eventBuffer                   = eventBuffer->GetPreviousCircularEventBuffer();
+            requiredSpace                 = eventBuffer->GetRequiredSpaceforEvicted();
+            err                           = MoveHeadToNextBuffer(eventBuffer, movedEventLength);
+            SuccessOrExit(err);
         }
     }
 
@@ -264,28 +234,6 @@ exit:
     return err;
 }
 
-CHIP_ERROR EventManagement::CalculateEventSize(EventLoggingDelegate * apDelegate, const EventOptions * apOptions,
-                                               uint32_t & requiredSize)
-{
-    System::PacketBufferTLVWriter writer;
-    EventLoadOutContext ctxt       = EventLoadOutContext(writer, apOptions->mPriority, GetLastEventNumber());
-    System::PacketBufferHandle buf = System::PacketBufferHandle::New(kMaxEventSizeReserve);
-    if (buf.IsNull())
-    {
-        return CHIP_ERROR_NO_MEMORY;
-    }
-    writer.Init(std::move(buf));
-
-    ctxt.mCurrentEventNumber = mLastEventNumber;
-    ctxt.mCurrentTime        = mLastEventTimestamp;
-    CHIP_ERROR err           = ConstructEvent(&ctxt, apDelegate, apOptions);
-    if (err == CHIP_NO_ERROR)
-    {
-        requiredSize = writer.GetLengthWritten();
-    }
-    return err;
-}
-
 CHIP_ERROR EventManagement::ConstructEvent(EventLoadOutContext * apContext, EventLoggingDelegate * apDelegate,
                                            const EventOptions * apOptions)
 {
@@ -421,11 +369,13 @@ CHIP_ERROR EventManagement::LogEventPrivate(EventLoggingDelegate * apDelegate, c
                                             EventNumber & aEventNumber)
 {
     CircularTLVWriter writer;
+    System::PacketBufferHandle stagingBuffer;
+    TLVWriter stagingWriter;
+    TLVReader stagingReader;
     CHIP_ERROR err               = CHIP_NO_ERROR;
-    uint32_t requestSize         = 0;
     aEventNumber                 = 0;
     CircularTLVWriter checkpoint = writer;
-    EventLoadOutContext ctxt     = EventLoadOutContext(writer, aEventOptions.mPriority, mLastEventNumber);
+    EventLoadOutContext ctxt     = EventLoadOutContext(stagingWriter, aEventOptions.mPriority, mLastEventNumber);
     EventOptions opts;
 
     Timestamp timestamp;
@@ -457,14 +407,24 @@ CHIP_ERROR EventManagement::LogEventPrivate(EventLoggingDelegate * apDelegate, c
     ctxt.mCurrentEventNumber = mLastEventNumber;
     ctxt.mCurrentTime.mValue = mLastEventTimestamp.mValue;
 
-    err = CalculateEventSize(apDelegate, &opts, requestSize);
+    // Encode the event once, into a staging buffer held only for this call, which tells us how much room it needs.
+    stagingBuffer = System::PacketBufferHandle::New(kMaxEventSizeReserve);
+    VerifyOrExit(!stagingBuffer.IsNull(), err = CHIP_ERROR_NO_MEMORY);
+    stagingWriter.Init(stagingBuffer->Start(), std::min<size_t>(stagingBuffer->AvailableDataLength(), kMaxEventSizeReserve));
+    err = ConstructEvent(&ctxt, apDelegate, &opts);
     SuccessOrExit(err);
 
     // Ensure we have space in the in-memory logging queues
-    err = EnsureSpaceInCircularBuffer(requestSize, aEventOptions.mPriority);
+    err = EnsureSpaceInCircularBuffer(stagingWriter.GetLengthWritten(), aEventOptions.mPriority);
     SuccessOrExit(err);
 
-    err = ConstructEvent(&ctxt, apDelegate, &opts);
+    // Then copy the encoded event into the circular buffer as-is.
+    stagingReader.Init(stagingBuffer->Start(), stagingWriter.GetLengthWritten());
+    err = stagingReader.Next();
+    SuccessOrExit(err);
+    err = writer.CopyElement(stagingReader);
+    SuccessOrExit(err);
+    err = writer.Finalize();
     SuccessOrExit(err);
 
     mBytesWritten += writer.GetLengthWritten();
@@ -813,13 +773,24 @@ CHIP_ERROR EventManagement::EvictEvent(TLVCircularBuffer & apBuffer, void * apAp
 
     ReturnErrorOnFailure(aReader.EnterContainer(containerType1));
     EventEnvelopeContext context;
-    constexpr bool recurse = false;
-    CHIP_ERROR err         = TLV::Utilities::Iterate(aReader, FetchEventParameters, &context, recurse);
-    if (err == CHIP_END_OF_TLV)
+    CHIP_ERROR err;
+    // Only the event number and priority are needed here, and both precede the timestamp and data, so stop as soon as the
+    // priority has been read and let ExitContainer skip the rest without decoding the path or the payload.
+    while ((err = aReader.Next()) == CHIP_NO_ERROR)
     {
-        err = CHIP_NO_ERROR;
+        if (aReader.GetTag() == TLV::ContextTag(EventDataIB::Tag::kEventNumber))
+        {
+            ReturnErrorOnFailure(aReader.Get(context.mEventNumber));
+        }
+        else if (aReader.GetTag() == TLV::ContextTag(EventDataIB::Tag::kPriority))
+        {
+            uint16_t extPriority; // Note: the type here matches the type case in EventManagement::LogEvent, priority section
+            ReturnErrorOnFailure(aReader.Get(extPriority));
+            context.mPriority = static_cast<PriorityLevel>(extPriority);
+            break;
+        }
     }
-    ReturnErrorOnFailure(err);
+    VerifyOrReturnError(err == CHIP_NO_ERROR || err == CHIP_END_OF_TLV, err);
 
     ReturnErrorOnFailure(aReader.ExitContainer(containerType1));
     ReturnErrorOnFailure(aReader.ExitContainer(containerType));
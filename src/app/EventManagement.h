@@ -412,7 +412,6 @@ private:
     };
 
     void VendEventNumber();
-    CHIP_ERROR CalculateEventSize(EventLoggingDelegate * apDelegate, const EventOptions * apOptions, uint32_t & requiredSize);
     /**
      * @brief Helper function for writing event header and data according to event
      *   logging protocol.
@@ -433,12 +432,14 @@ private:
     CHIP_ERROR LogEventPrivate(EventLoggingDelegate * apDelegate, const EventOptions & aEventOptions, EventNumber & aEventNumber);
 
     /**
-     * @brief copy the event outright to next buffer with higher priority
+     * @brief move the head event of a buffer outright to the next buffer with higher priority
      *
      * @param[in] apEventBuffer  CircularEventBuffer
      *
+     * @param[in] aEventLength   The encoded length of the head event, as measured by EvictEvent.
+     *
      */
-    CHIP_ERROR CopyToNextBuffer(CircularEventBuffer * apEventBuffer);
+    CHIP_ERROR MoveHeadToNextBuffer(CircularEventBuffer * apEventBuffer, size_t aEventLength);
 
     /**
      * @brief Ensure that:
@@ -512,10 +513,6 @@ private:
      * requires, and return.
      */
     static CHIP_ERROR EvictEvent(chip::TLV::TLVCircularBuffer & aBuffer, void * apAppData, TLV::TLVReader & aReader);
-    static CHIP_ERROR AlwaysFail(chip::TLV::TLVCircularBuffer & aBuffer, void * apAppData, TLV::TLVReader & aReader)
-    {
-        return CHIP_ERROR_NO_MEMORY;
-    };
 
     /**
      * @brief Check whether the event instance represented by the EventEnvelopeContext should be included in the report.
@@ -1587,6 +1587,7 @@ CHIP_ERROR InteractionModelEngine::RegisterCommandHandler(CommandHandlerInterfac
 
     handler->SetNext(mCommandHandlerList);
     mCommandHandlerList = handler;
+    mCommandHandlerListGeneration++;
 
     return CHIP_NO_ERROR;
 }
@@ -1609,6 +1610,7 @@ void InteractionModelEngine::UnregisterCommandHandlers(EndpointId endpointId)
             }
 
             cur->SetNext(nullptr);
+            mCommandHandlerListGeneration++;
         }
         else
         {
@@ -1636,6 +1638,7 @@ CHIP_ERROR InteractionModelEngine::UnregisterCommandHandler(CommandHandlerInterf
             }
 
             cur->SetNext(nullptr);
+            mCommandHandlerListGeneration++;
 
             return CHIP_NO_ERROR;
         }
@@ -207,6 +207,12 @@ public:
     CommandHandlerInterface * FindCommandHandler(EndpointId endpointId, ClusterId clusterId);
     void UnregisterCommandHandlers(EndpointId endpointId);
 
+    /**
+     * Returns a counter that changes whenever a CommandHandlerInterface is registered or unregistered, so that data derived
+     * from the registered handlers can tell when it is stale.
+     */
+    uint32_t GetCommandHandlerListGeneration() const { return mCommandHandlerListGeneration; }
+
     /*
      * Register an application callback to be notified of notable events when handling reads/subscribes.
      */
@@ -571,6 +577,7 @@ private:
     Messaging::ExchangeManager * mpExchangeMgr = nullptr;
 
     CommandHandlerInterface * mCommandHandlerList = nullptr;
+    uint32_t mCommandHandlerListGeneration        = 0;
 
     ObjectPool<CommandHandler, CHIP_IM_MAX_NUM_COMMAND_HANDLER> mCommandHandlerObjs;
     ObjectPool<TimedHandler, CHIP_IM_MAX_NUM_TIMED_HANDLER> mTimedHandlers;
@@ -683,6 +690,16 @@ CHIP_ERROR ReadSingleClusterData(const Access::SubjectDescriptor & aSubjectDescr
  */
 bool ConcreteAttributePathExists(const ConcreteAttributePath & aPath);
 
+#if CHIP_IM_REPORT_BUILDER_THREADS > 0
+/**
+ *  Check whether ReadSingleClusterData may read the attribute on a report builder thread, concurrently with other reads,
+ *  while the Matter thread holds the stack lock.  The reporting engine reads any other attribute on the Matter thread.
+ *  @param[in]    aPath                 The concrete path of the data being read.
+ *  @retval  boolean   true if the attribute can be read concurrently.
+ */
+bool IsConcurrentReadSafe(const ConcreteAttributePath & aPath);
+#endif
+
 /**
  *  Get the registered attribute access override. nullptr when attribute access override is not found.
  *
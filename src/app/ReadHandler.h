@@ -66,6 +66,7 @@ class Engine;
 class TestReportingEngine;
 class ReportScheduler;
 class TestReportScheduler;
+class TimerContext;
 } // namespace reporting
 
 class InteractionModelEngine;
@@ -572,6 +573,9 @@ private:
     // TODO (#27675): Merge all observers into one and that one will dispatch the callbacks to the right place.
     Observer * mObserver = nullptr;
 
+    // Scheduling node of this handler, set and cleared by the ReportScheduler so it can find it without searching its pool.
+    reporting::TimerContext * mReportSchedulerNode = nullptr;
+
 #if CHIP_CONFIG_PERSIST_SUBSCRIPTIONS
     // Callbacks to handle server-initiated session success/failure
     chip::Callback::Callback<OnDeviceConnected> mOnConnectedCallback;
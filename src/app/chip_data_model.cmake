@@ -142,6 +142,7 @@ function(chip_configure_data_model APP_TARGET)
         ${CHIP_APP_BASE_DIR}/icd/ICDMonitoringTable.cpp
         ${CHIP_APP_BASE_DIR}/icd/ICDManagementServer.cpp
         ${CHIP_APP_BASE_DIR}/util/DataModelHandler.cpp
+        ${CHIP_APP_BASE_DIR}/util/GlobalAttributeListCache.cpp
         ${CHIP_APP_BASE_DIR}/util/ember-compatibility-functions.cpp
         ${CHIP_APP_BASE_DIR}/util/generic-callback-stubs.cpp
         ${CHIP_APP_BASE_DIR}/util/message.cpp
@@ -64,6 +64,10 @@ public:
     /// Returns appropriately mapped CHIP_ERROR if applicable (may return CHIP_IM_GLOBAL_STATUS errors)
     CHIP_ERROR Write(const ConcreteDataAttributePath & aPath, AttributeValueDecoder & aDecoder) override;
 
+    /// Batches the storage updates for all entries changed by an ACL write
+    void OnListWriteBegin(const ConcreteAttributePath & aPath) override;
+    void OnListWriteEnd(const ConcreteAttributePath & aPath, bool aWriteWasSuccessful) override;
+
 public:
     void OnEntryChanged(const SubjectDescriptor * subjectDescriptor, FabricIndex fabric, size_t index, const Entry * entry,
                         ChangeType changeType) override;
@@ -229,6 +233,23 @@ CHIP_ERROR AccessControlAttribute::WriteImpl(const ConcreteDataAttributePath & a
     return CHIP_NO_ERROR;
 }
 
+void AccessControlAttribute::OnListWriteBegin(const ConcreteAttributePath & aPath)
+{
+    if (aPath.mAttributeId == AccessControlCluster::Attributes::Acl::Id)
+    {
+        Server::GetInstance().GetAclStorage().BeginBatch();
+    }
+}
+
+void AccessControlAttribute::OnListWriteEnd(const ConcreteAttributePath & aPath, bool aWriteWasSuccessful)
+{
+    // Entries changed before a failure remain changed in AccessControl, so they are stored either way.
+    if (aPath.mAttributeId == AccessControlCluster::Attributes::Acl::Id)
+    {
+        Server::GetInstance().GetAclStorage().EndBatch();
+    }
+}
+
 CHIP_ERROR AccessControlAttribute::WriteAcl(const ConcreteDataAttributePath & aPath, AttributeValueDecoder & aDecoder)
 {
     FabricIndex accessingFabricIndex = aDecoder.AccessingFabricIndex();
@@ -189,10 +189,19 @@ CHIP_ERROR BindingManager::NotifyBoundClusterChanged(EndpointId endpoint, Cluste
         {
             if (iter->type == EMBER_UNICAST_BINDING)
             {
+                const ScopedNodeId peer(iter->nodeId, iter->fabricIndex);
+
+                // When several bindings of this (endpoint, cluster) target the same peer, a single session lookup is
+                // enough: HandleDeviceConnected delivers every pending entry for that peer once the session is ready.
+                const bool connectionRequested = mPendingNotificationMap.HasPendingNotificationsForNode(peer, bindingContext);
+
                 error = mPendingNotificationMap.AddPendingNotification(iter.GetIndex(), bindingContext);
                 SuccessOrExit(error);
-                error = EstablishConnection(ScopedNodeId(iter->nodeId, iter->fabricIndex));
-                SuccessOrExit(error);
+                if (!connectionRequested)
+                {
+                    error = EstablishConnection(peer);
+                    SuccessOrExit(error);
+                }
             }
             else if (iter->type == EMBER_MULTICAST_BINDING)
             {
@@ -87,8 +87,10 @@ CHIP_ERROR PendingNotificationMap::AddPendingNotification(uint8_t bindingEntryId
         // We know that the RemoveEntry above did not do anything so we don't need to try restoring it.
         return CHIP_ERROR_NO_MEMORY;
     }
-    mPendingBindingEntries[mNumEntries] = bindingEntryId;
-    mPendingContexts[mNumEntries]       = context;
+    const EmberBindingTableEntry & entry = BindingTable::GetInstance().GetAt(bindingEntryId);
+    mPendingBindingEntries[mNumEntries]  = bindingEntryId;
+    mPendingContexts[mNumEntries]        = context;
+    mPendingPeers[mNumEntries]           = ScopedNodeId(entry.nodeId, entry.fabricIndex);
     if (context)
     {
         context->IncrementConsumersNumber();
@@ -106,6 +108,7 @@ void PendingNotificationMap::RemoveEntry(uint8_t bindingEntryId)
         {
             mPendingBindingEntries[newEntryCount] = mPendingBindingEntries[i];
             mPendingContexts[newEntryCount]       = mPendingContexts[i];
+            mPendingPeers[newEntryCount]          = mPendingPeers[i];
             newEntryCount++;
         }
         else if (mPendingContexts[i] != nullptr)
@@ -121,11 +124,11 @@ void PendingNotificationMap::RemoveAllEntriesForNode(const ScopedNodeId & nodeId
     uint8_t newEntryCount = 0;
     for (int i = 0; i < mNumEntries; i++)
     {
-        EmberBindingTableEntry entry = BindingTable::GetInstance().GetAt(mPendingBindingEntries[i]);
-        if (entry.fabricIndex != nodeId.GetFabricIndex() || entry.nodeId != nodeId.GetNodeId())
+        if (mPendingPeers[i] != nodeId)
         {
             mPendingBindingEntries[newEntryCount] = mPendingBindingEntries[i];
             mPendingContexts[newEntryCount]       = mPendingContexts[i];
+            mPendingPeers[newEntryCount]          = mPendingPeers[i];
             newEntryCount++;
         }
         else if (mPendingContexts[i] != nullptr)
@@ -141,11 +144,11 @@ void PendingNotificationMap::RemoveAllEntriesForFabric(FabricIndex fabric)
     uint8_t newEntryCount = 0;
     for (int i = 0; i < mNumEntries; i++)
     {
-        EmberBindingTableEntry entry = BindingTable::GetInstance().GetAt(mPendingBindingEntries[i]);
-        if (entry.fabricIndex != fabric)
+        if (mPendingPeers[i].GetFabricIndex() != fabric)
         {
             mPendingBindingEntries[newEntryCount] = mPendingBindingEntries[i];
             mPendingContexts[newEntryCount]       = mPendingContexts[i];
+            mPendingPeers[newEntryCount]          = mPendingPeers[i];
             newEntryCount++;
         }
         else if (mPendingContexts[i] != nullptr)
@@ -156,4 +159,16 @@ void PendingNotificationMap::RemoveAllEntriesForFabric(FabricIndex fabric)
     mNumEntries = newEntryCount;
 }
 
+bool PendingNotificationMap::HasPendingNotificationsForNode(const ScopedNodeId & nodeId, PendingNotificationContext * context)
+{
+    for (int i = 0; i < mNumEntries; i++)
+    {
+        if (mPendingContexts[i] == context && mPendingPeers[i] == nodeId)
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
 } // namespace chip
@@ -111,6 +111,14 @@ public:
 
     void RemoveAllEntriesForFabric(FabricIndex fabric);
 
+    /*
+     * Returns true if there is at least one pending entry for the given peer that uses the given context.
+     *
+     * Since every call to BindingManager::NotifyBoundClusterChanged uses its own context, this answers whether the peer was
+     * already asked for in the notification of one (endpoint, cluster), without going back to the binding table.
+     */
+    bool HasPendingNotificationsForNode(const ScopedNodeId & nodeId, PendingNotificationContext * context);
+
     void RegisterPendingNotificationContextReleaseHandler(PendingNotificationContextReleaseHandler handler)
     {
         mPendingNotificationContextReleaseHandler = handler;
@@ -124,6 +132,9 @@ public:
 private:
     uint8_t mPendingBindingEntries[kMaxPendingNotifications];
     PendingNotificationContext * mPendingContexts[kMaxPendingNotifications];
+    // The peer of each pending entry, copied from the binding table when the entry is added. Bindings are removed from the
+    // map before they are removed from the table, so this stays in sync with it.
+    ScopedNodeId mPendingPeers[kMaxPendingNotifications];
     PendingNotificationContextReleaseHandler mPendingNotificationContextReleaseHandler;
 
     uint8_t mNumEntries = 0;
@@ -111,47 +111,17 @@ CHIP_ERROR DescriptorAttrAccess::ReadPartsAttribute(EndpointId endpoint, Attribu
             return CHIP_NO_ERROR;
         });
     }
-    else if (IsFlatCompositionForEndpoint(endpoint))
+    else if (IsFlatCompositionForEndpoint(endpoint) || IsTreeCompositionForEndpoint(endpoint))
     {
-        err = aEncoder.EncodeList([endpoint](const auto & encoder) -> CHIP_ERROR {
-            for (uint16_t index = 0; index < emberAfEndpointCount(); index++)
-            {
-                if (!emberAfEndpointIndexIsEnabled(index))
-                    continue;
-
-                uint16_t childIndex = index;
-                while (childIndex != chip::kInvalidListIndex)
-                {
-                    EndpointId parentEndpointId = emberAfParentEndpointFromIndex(childIndex);
-                    if (parentEndpointId == chip::kInvalidEndpointId)
-                        break;
-
-                    if (parentEndpointId == endpoint)
-                    {
-                        ReturnErrorOnFailure(encoder.Encode(emberAfEndpointFromIndex(index)));
-                        break;
-                    }
-
-                    childIndex = emberAfIndexFromEndpoint(parentEndpointId);
-                }
-            }
+        // Flat composition lists every endpoint below this one, tree composition only its direct children.
+        Span<const EndpointId> parts;
+        ReturnErrorOnFailure(IsFlatCompositionForEndpoint(endpoint) ? GetDescendantEndpoints(endpoint, parts)
+                                                                    : GetChildEndpoints(endpoint, parts));
 
-            return CHIP_NO_ERROR;
-        });
-    }
-    else if (IsTreeCompositionForEndpoint(endpoint))
-    {
-        err = aEncoder.EncodeList([endpoint](const auto & encoder) -> CHIP_ERROR {
-            for (uint16_t index = 0; index < emberAfEndpointCount(); index++)
+        err = aEncoder.EncodeList([parts](const auto & encoder) -> CHIP_ERROR {
+            for (EndpointId part : parts)
             {
-                if (!emberAfEndpointIndexIsEnabled(index))
-                    continue;
-
-                EndpointId parentEndpointId = emberAfParentEndpointFromIndex(index);
-                if (parentEndpointId == endpoint)
-                {
-                    ReturnErrorOnFailure(encoder.Encode(emberAfEndpointFromIndex(index)));
-                }
+                ReturnErrorOnFailure(encoder.Encode(part));
             }
 
             return CHIP_NO_ERROR;
@@ -0,0 +1,222 @@
+/**
+ *
+ *    Copyright (c) 2023 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#include "door-lock-credential-index.h"
+
+#include <lib/support/CHIPMem.h>
+#include <lib/support/CodeUtils.h>
+
+#include <algorithm>
+#include <string.h>
+
+namespace {
+
+constexpr size_t kInitialCapacity = 16;
+
+template <typename T>
+CHIP_ERROR InsertAt(T *& array, size_t & count, size_t & capacity, size_t position, const T & value)
+{
+    if (count == capacity)
+    {
+        size_t newCapacity = (0 == capacity) ? kInitialCapacity : capacity * 2;
+        auto * grown       = static_cast<T *>(chip::Platform::MemoryRealloc(array, newCapacity * sizeof(T)));
+        VerifyOrReturnError(nullptr != grown, CHIP_ERROR_NO_MEMORY);
+        array    = grown;
+        capacity = newCapacity;
+    }
+
+    memmove(&array[position + 1], &array[position], (count - position) * sizeof(T));
+    array[position] = value;
+    ++count;
+    return CHIP_NO_ERROR;
+}
+
+template <typename T>
+void RemoveAt(T * array, size_t & count, size_t position)
+{
+    memmove(&array[position], &array[position + 1], (count - position - 1) * sizeof(T));
+    --count;
+}
+
+} // namespace
+
+void DoorLockCredentialIndex::Clear()
+{
+    chip::Platform::MemoryFree(mEntries);
+    chip::Platform::MemoryFree(mData);
+    mEntries       = nullptr;
+    mEntryCount    = 0;
+    mEntryCapacity = 0;
+    mData          = nullptr;
+    mDataCount     = 0;
+    mDataCapacity  = 0;
+    mMaxUserIndex  = 0;
+    mBuilt         = false;
+}
+
+CHIP_ERROR DoorLockCredentialIndex::SetCredentialData(CredentialTypeEnum credentialType, uint16_t credentialIndex,
+                                                      const chip::ByteSpan & credentialData)
+{
+    const uint32_t key      = KeyOf(credentialType, credentialIndex);
+    const uint32_t dataHash = HashData(credentialData);
+    const size_t position   = LowerBound(key);
+
+    CHIP_ERROR err = CHIP_NO_ERROR;
+    if (position < mEntryCount && mEntries[position].key == key)
+    {
+        Entry & entry = mEntries[position];
+        if (entry.hasData)
+        {
+            RemoveDataEntry(entry.dataHash, key);
+        }
+        entry.dataHash = dataHash;
+        entry.hasData  = true;
+    }
+    else
+    {
+        err = InsertAt(mEntries, mEntryCount, mEntryCapacity, position, Entry{ key, dataHash, 0, true });
+    }
+
+    if (CHIP_NO_ERROR == err)
+    {
+        err = AddDataEntry(dataHash, key);
+    }
+    if (CHIP_NO_ERROR != err)
+    {
+        Clear();
+    }
+    return err;
+}
+
+void DoorLockCredentialIndex::ClearCredentialData(CredentialTypeEnum credentialType, uint16_t credentialIndex)
+{
+    const uint32_t key    = KeyOf(credentialType, credentialIndex);
+    const size_t position = LowerBound(key);
+    VerifyOrReturn(position < mEntryCount && mEntries[position].key == key);
+
+    Entry & entry = mEntries[position];
+    if (entry.hasData)
+    {
+        RemoveDataEntry(entry.dataHash, key);
+        entry.hasData = false;
+    }
+    if (0 == entry.userIndex)
+    {
+        RemoveAt(mEntries, mEntryCount, position);
+    }
+}
+
+CHIP_ERROR DoorLockCredentialIndex::SetUserCredentials(uint16_t userIndex, const CredentialStruct * credentials,
+                                                       size_t totalCredentials)
+{
+    // Release whatever the user owned before; slots that are not occupied either are forgotten. Users above
+    // mMaxUserIndex never owned anything, which keeps populating the index in user order linear.
+    for (size_t i = 0; userIndex <= mMaxUserIndex && i < mEntryCount;)
+    {
+        if (mEntries[i].userIndex == userIndex)
+        {
+            mEntries[i].userIndex = 0;
+            if (!mEntries[i].hasData)
+            {
+                RemoveAt(mEntries, mEntryCount, i);
+                continue;
+            }
+        }
+        ++i;
+    }
+
+    for (size_t i = 0; i < totalCredentials; ++i)
+    {
+        const uint32_t key    = KeyOf(credentials[i].credentialType, credentials[i].credentialIndex);
+        const size_t position = LowerBound(key);
+        if (position < mEntryCount && mEntries[position].key == key)
+        {
+            mEntries[position].userIndex = userIndex;
+            continue;
+        }
+
+        CHIP_ERROR err = InsertAt(mEntries, mEntryCount, mEntryCapacity, position, Entry{ key, 0, userIndex, false });
+        if (CHIP_NO_ERROR != err)
+        {
+            Clear();
+            return err;
+        }
+    }
+
+    if (totalCredentials > 0 && userIndex > mMaxUserIndex)
+    {
+        mMaxUserIndex = userIndex;
+    }
+    return CHIP_NO_ERROR;
+}
+
+bool DoorLockCredentialIndex::FindUser(CredentialTypeEnum credentialType, uint16_t credentialIndex, uint16_t & userIndex) const
+{
+    const Entry * entry = FindEntry(KeyOf(credentialType, credentialIndex));
+    VerifyOrReturnValue(nullptr != entry && 0 != entry->userIndex, false);
+
+    userIndex = entry->userIndex;
+    return true;
+}
+
+uint32_t DoorLockCredentialIndex::HashData(const chip::ByteSpan & credentialData)
+{
+    // FNV-1a: cheap and well spread for short inputs such as PIN codes and RFID UIDs.
+    uint32_t hash = 2166136261u;
+    for (uint8_t byte : credentialData)
+    {
+        hash = (hash ^ byte) * 16777619u;
+    }
+    return hash;
+}
+
+size_t DoorLockCredentialIndex::LowerBound(uint32_t key) const
+{
+    const Entry * found =
+        std::lower_bound(mEntries, mEntries + mEntryCount, key, [](const Entry & entry, uint32_t k) { return entry.key < k; });
+    return static_cast<size_t>(found - mEntries);
+}
+
+size_t DoorLockCredentialIndex::LowerBound(const DataEntry & dataEntry) const
+{
+    const DataEntry * found = std::lower_bound(mData, mData + mDataCount, dataEntry, [](const DataEntry & a, const DataEntry & b) {
+        return (a.dataHash != b.dataHash) ? (a.dataHash < b.dataHash) : (a.key < b.key);
+    });
+    return static_cast<size_t>(found - mData);
+}
+
+const DoorLockCredentialIndex::Entry * DoorLockCredentialIndex::FindEntry(uint32_t key) const
+{
+    const size_t position = LowerBound(key);
+    VerifyOrReturnValue(position < mEntryCount && mEntries[position].key == key, nullptr);
+    return &mEntries[position];
+}
+
+CHIP_ERROR DoorLockCredentialIndex::AddDataEntry(uint32_t dataHash, uint32_t key)
+{
+    const DataEntry dataEntry{ dataHash, key };
+    return InsertAt(mData, mDataCount, mDataCapacity, LowerBound(dataEntry), dataEntry);
+}
+
+void DoorLockCredentialIndex::RemoveDataEntry(uint32_t dataHash, uint32_t key)
+{
+    const size_t position = LowerBound(DataEntry{ dataHash, key });
+    if (position < mDataCount && mData[position].dataHash == dataHash && mData[position].key == key)
+    {
+        RemoveAt(mData, mDataCount, position);
+    }
+}
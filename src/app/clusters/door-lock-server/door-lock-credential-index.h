@@ -0,0 +1,162 @@
+/**
+ *
+ *    Copyright (c) 2023 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/****************************************************************************
+ * @file
+ * @brief In-memory index of the Door Lock users/credentials database, used by
+ *        the Door Lock Server to resolve credentials without scanning every user.
+ *******************************************************************************
+ ******************************************************************************/
+
+#pragma once
+
+#include <app-common/zap-generated/cluster-objects.h>
+#include <lib/core/CHIPError.h>
+#include <lib/support/Iterators.h>
+#include <lib/support/Span.h>
+
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * @brief Maps (credential type, credential index) to the owning user index, and credential data hashes to credentials.
+ *
+ * The index does not keep credential data, only a non-cryptographic hash of it, so every candidate returned by a data
+ * lookup must still be compared against the credential stored by the application.
+ *
+ * All mutators either succeed or drop the whole index (IsBuilt() turns false), so a failed update never leaves a
+ * partially updated index behind.
+ */
+class DoorLockCredentialIndex
+{
+public:
+    using CredentialTypeEnum = chip::app::Clusters::DoorLock::CredentialTypeEnum;
+    using CredentialStruct   = chip::app::Clusters::DoorLock::Structs::CredentialStruct::Type;
+
+    DoorLockCredentialIndex() = default;
+    ~DoorLockCredentialIndex() { Clear(); }
+
+    DoorLockCredentialIndex(const DoorLockCredentialIndex &)             = delete;
+    DoorLockCredentialIndex & operator=(const DoorLockCredentialIndex &) = delete;
+
+    /**
+     * @brief Whether the index reflects the whole database and may be trusted for lookups, including misses.
+     */
+    bool IsBuilt() const { return mBuilt; }
+
+    /**
+     * @brief Marks the index as complete, once it has been populated from the database.
+     */
+    void MarkBuilt() { mBuilt = true; }
+
+    /**
+     * @brief Drops all entries and releases the memory used by the index.
+     */
+    void Clear();
+
+    /**
+     * @brief Records that the credential slot is occupied with the given data.
+     */
+    CHIP_ERROR SetCredentialData(CredentialTypeEnum credentialType, uint16_t credentialIndex,
+                                 const chip::ByteSpan & credentialData);
+
+    /**
+     * @brief Records that the credential slot is no longer occupied.
+     */
+    void ClearCredentialData(CredentialTypeEnum credentialType, uint16_t credentialIndex);
+
+    /**
+     * @brief Replaces the list of credentials associated with the user. An empty list removes the user.
+     */
+    CHIP_ERROR SetUserCredentials(uint16_t userIndex, const CredentialStruct * credentials, size_t totalCredentials);
+
+    /**
+     * @brief Finds the user the credential is associated with.
+     *
+     * @return true if some user owns the credential.
+     */
+    bool FindUser(CredentialTypeEnum credentialType, uint16_t credentialIndex, uint16_t & userIndex) const;
+
+    /**
+     * @brief Calls handler(credentialIndex, userIndex) for every credential of the given type that belongs to a user and
+     *        whose data hash matches the given data, until the handler returns Loop::Break.
+     */
+    template <typename Handler>
+    chip::Loop ForEachDataCandidate(CredentialTypeEnum credentialType, const chip::ByteSpan & credentialData, Handler handler) const
+    {
+        const uint32_t dataHash = HashData(credentialData);
+        for (size_t i = LowerBound(DataEntry{ dataHash, 0 }); i < mDataCount && mData[i].dataHash == dataHash; ++i)
+        {
+            const Entry * entry = FindEntry(mData[i].key);
+            if (nullptr == entry || 0 == entry->userIndex || TypeOf(entry->key) != credentialType)
+            {
+                continue;
+            }
+            if (handler(IndexOf(entry->key), entry->userIndex) == chip::Loop::Break)
+            {
+                return chip::Loop::Break;
+            }
+        }
+        return chip::Loop::Finish;
+    }
+
+    /**
+     * @brief Number of credentials known to the index.
+     */
+    size_t Count() const { return mEntryCount; }
+
+private:
+    struct Entry
+    {
+        uint32_t key;       ///< Credential type in the high half, credential index in the low half.
+        uint32_t dataHash;  ///< Hash of the credential data, valid when hasData is set.
+        uint16_t userIndex; ///< Owning user, 0 when the credential is not associated with any user.
+        bool hasData;       ///< Whether the credential slot is occupied.
+    };
+
+    struct DataEntry
+    {
+        uint32_t dataHash;
+        uint32_t key;
+    };
+
+    static uint32_t KeyOf(CredentialTypeEnum credentialType, uint16_t credentialIndex)
+    {
+        return (static_cast<uint32_t>(credentialType) << 16) | credentialIndex;
+    }
+    static CredentialTypeEnum TypeOf(uint32_t key) { return static_cast<CredentialTypeEnum>(key >> 16); }
+    static uint16_t IndexOf(uint32_t key) { return static_cast<uint16_t>(key & 0xFFFF); }
+    static uint32_t HashData(const chip::ByteSpan & credentialData);
+
+    size_t LowerBound(uint32_t key) const;
+    size_t LowerBound(const DataEntry & dataEntry) const;
+    const Entry * FindEntry(uint32_t key) const;
+
+    CHIP_ERROR AddDataEntry(uint32_t dataHash, uint32_t key);
+    void RemoveDataEntry(uint32_t dataHash, uint32_t key);
+
+    Entry * mEntries      = nullptr; ///< Sorted by key.
+    size_t mEntryCount    = 0;
+    size_t mEntryCapacity = 0;
+
+    DataEntry * mData    = nullptr; ///< Occupied credentials, sorted by data hash then key.
+    size_t mDataCount    = 0;
+    size_t mDataCapacity = 0;
+
+    uint16_t mMaxUserIndex = 0; ///< Highest user index that has been given credentials.
+    bool mBuilt            = false;
+};
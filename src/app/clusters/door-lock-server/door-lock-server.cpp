@@ -95,6 +95,9 @@ void DoorLockServer::InitServer(chip::EndpointId endpointId)
     {
         ep.lockoutEndTimestamp    = ep.lockoutEndTimestamp.zero();
         ep.wrongCodeEntryAttempts = 0;
+#if DOOR_LOCK_SERVER_CREDENTIAL_INDEX
+        ep.credentialIndex.Clear();
+#endif // DOOR_LOCK_SERVER_CREDENTIAL_INDEX
     }
 }
 
@@ -1360,6 +1363,17 @@ chip::BitFlags<Feature> DoorLockServer::GetFeatures(chip::EndpointId endpointId)
     return featureMap;
 }
 
+void DoorLockServer::ResetCredentialIndex(chip::EndpointId endpointId)
+{
+#if DOOR_LOCK_SERVER_CREDENTIAL_INDEX
+    auto endpointContext = getContext(endpointId);
+    if (nullptr != endpointContext)
+    {
+        endpointContext->credentialIndex.Clear();
+    }
+#endif // DOOR_LOCK_SERVER_CREDENTIAL_INDEX
+}
+
 bool DoorLockServer::OnFabricRemoved(chip::EndpointId endpointId, chip::FabricIndex fabricIndex)
 {
     ChipLogProgress(Zcl, "[OnFabricRemoved] Handling a fabric removal from the door lock server [endpointId=%d,fabricIndex=%d]",
@@ -1708,6 +1722,30 @@ bool DoorLockServer::findUnoccupiedCredentialSlot(chip::EndpointId endpointId, C
 bool DoorLockServer::findUserIndexByCredential(chip::EndpointId endpointId, CredentialTypeEnum credentialType,
                                                uint16_t credentialIndex, uint16_t & userIndex)
 {
+    auto * index = getCredentialIndex(endpointId);
+    if (nullptr != index)
+    {
+        uint16_t indexedUserIndex = 0;
+        VerifyOrReturnValue(index->FindUser(credentialType, credentialIndex, indexedUserIndex), false);
+
+        // Make sure the application database still agrees with the index before trusting it
+        EmberAfPluginDoorLockUserInfo user;
+        if (emberAfPluginDoorLockGetUser(endpointId, indexedUserIndex, user) && UserStatusEnum::kAvailable != user.userStatus)
+        {
+            for (const auto & credential : user.credentials)
+            {
+                if (credential.credentialIndex == credentialIndex && credential.credentialType == credentialType)
+                {
+                    userIndex = indexedUserIndex;
+                    return true;
+                }
+            }
+        }
+
+        ChipLogError(Zcl, "[findUserIndexByCredential] Credential index is out of date, dropping it [endpointId=%d]", endpointId);
+        index->Clear();
+    }
+
     uint16_t maxNumberOfUsers = 0;
     VerifyOrReturnError(GetAttribute(endpointId, Attributes::NumberOfTotalUsersSupported::Id,
                                      Attributes::NumberOfTotalUsersSupported::Get, maxNumberOfUsers),
@@ -1746,6 +1784,44 @@ bool DoorLockServer::findUserIndexByCredential(chip::EndpointId endpointId, Cred
                                                chip::ByteSpan credentialData, uint16_t & userIndex, uint16_t & credentialIndex,
                                                EmberAfPluginDoorLockUserInfo & userInfo)
 {
+    auto * index = getCredentialIndex(endpointId);
+    if (nullptr != index)
+    {
+        bool outOfDate      = false;
+        auto checkCandidate = [&](uint16_t candidateCredentialIndex, uint16_t candidateUserIndex) {
+            // The index only keeps a hash of the data, so compare against the stored credential
+            EmberAfPluginDoorLockCredentialInfo credentialInfo;
+            EmberAfPluginDoorLockUserInfo user;
+            if (!emberAfPluginDoorLockGetCredential(endpointId, candidateCredentialIndex, credentialType, credentialInfo) ||
+                DlCredentialStatus::kOccupied != credentialInfo.status ||
+                !emberAfPluginDoorLockGetUser(endpointId, candidateUserIndex, user) ||
+                UserStatusEnum::kAvailable == user.userStatus)
+            {
+                outOfDate = true;
+                return Loop::Break;
+            }
+
+            if (!credentialInfo.credentialData.data_equal(credentialData))
+            {
+                return Loop::Continue;
+            }
+
+            userIndex       = candidateUserIndex;
+            credentialIndex = candidateCredentialIndex;
+            userInfo        = user;
+            return Loop::Break;
+        };
+
+        auto result = index->ForEachDataCandidate(credentialType, credentialData, checkCandidate);
+        if (!outOfDate)
+        {
+            return Loop::Break == result;
+        }
+
+        ChipLogError(Zcl, "[findUserIndexByCredential] Credential index is out of date, dropping it [endpointId=%d]", endpointId);
+        index->Clear();
+    }
+
     uint16_t maxNumberOfUsers = 0;
     VerifyOrReturnError(GetAttribute(endpointId, Attributes::NumberOfTotalUsersSupported::Id,
                                      Attributes::NumberOfTotalUsersSupported::Get, maxNumberOfUsers),
@@ -1806,6 +1882,97 @@ bool DoorLockServer::findUserIndexByCredential(chip::EndpointId endpointId, Cred
     return false;
 }
 
+DoorLockCredentialIndex * DoorLockServer::getCredentialIndex(chip::EndpointId endpointId)
+{
+#if DOOR_LOCK_SERVER_CREDENTIAL_INDEX
+    auto endpointContext = getContext(endpointId);
+    VerifyOrReturnValue(nullptr != endpointContext, nullptr);
+
+    auto & index = endpointContext->credentialIndex;
+    VerifyOrReturnValue(!index.IsBuilt(), &index);
+
+    // Populate the index with one pass over the database; lookups fall back to scanning it if that fails.
+    uint16_t maxNumberOfUsers = 0;
+    VerifyOrReturnValue(GetAttribute(endpointId, Attributes::NumberOfTotalUsersSupported::Id,
+                                     Attributes::NumberOfTotalUsersSupported::Get, maxNumberOfUsers),
+                        nullptr);
+
+    index.Clear();
+    for (uint16_t i = 1; i <= maxNumberOfUsers; ++i)
+    {
+        EmberAfPluginDoorLockUserInfo user;
+        if (!emberAfPluginDoorLockGetUser(endpointId, i, user))
+        {
+            ChipLogError(Zcl, "[getCredentialIndex] Unable to get user: app error [endpointId=%d,userIndex=%d]", endpointId, i);
+            index.Clear();
+            return nullptr;
+        }
+
+        if (UserStatusEnum::kAvailable == user.userStatus)
+        {
+            continue;
+        }
+
+        for (const auto & credential : user.credentials)
+        {
+            EmberAfPluginDoorLockCredentialInfo credentialInfo;
+            if (emberAfPluginDoorLockGetCredential(endpointId, credential.credentialIndex, credential.credentialType,
+                                                   credentialInfo) &&
+                DlCredentialStatus::kOccupied == credentialInfo.status)
+            {
+                CHIP_ERROR err =
+                    index.SetCredentialData(credential.credentialType, credential.credentialIndex, credentialInfo.credentialData);
+                VerifyOrReturnValue(CHIP_NO_ERROR == err, nullptr);
+            }
+        }
+
+        CHIP_ERROR err = index.SetUserCredentials(i, user.credentials.data(), user.credentials.size());
+        VerifyOrReturnValue(CHIP_NO_ERROR == err, nullptr);
+    }
+
+    ChipLogProgress(Zcl, "[getCredentialIndex] Credential index built [endpointId=%d,credentials=%u]", endpointId,
+                    static_cast<unsigned int>(index.Count()));
+    index.MarkBuilt();
+    return &index;
+#else
+    return nullptr;
+#endif // DOOR_LOCK_SERVER_CREDENTIAL_INDEX
+}
+
+void DoorLockServer::indexCredential(chip::EndpointId endpointId, CredentialTypeEnum credentialType, uint16_t credentialIndex,
+                                     DlCredentialStatus credentialStatus, const chip::ByteSpan & credentialData)
+{
+#if DOOR_LOCK_SERVER_CREDENTIAL_INDEX
+    auto endpointContext = getContext(endpointId);
+    // An index that is not built yet will pick the change up from the database when it is
+    VerifyOrReturn(nullptr != endpointContext && endpointContext->credentialIndex.IsBuilt());
+
+    auto & index = endpointContext->credentialIndex;
+    if (DlCredentialStatus::kOccupied != credentialStatus)
+    {
+        index.ClearCredentialData(credentialType, credentialIndex);
+    }
+    else if (CHIP_NO_ERROR != index.SetCredentialData(credentialType, credentialIndex, credentialData))
+    {
+        ChipLogError(Zcl, "[indexCredential] Unable to update credential index, dropping it [endpointId=%d]", endpointId);
+    }
+#endif // DOOR_LOCK_SERVER_CREDENTIAL_INDEX
+}
+
+void DoorLockServer::indexUserCredentials(chip::EndpointId endpointId, uint16_t userIndex, const CredentialStruct * credentials,
+                                          size_t totalCredentials)
+{
+#if DOOR_LOCK_SERVER_CREDENTIAL_INDEX
+    auto endpointContext = getContext(endpointId);
+    VerifyOrReturn(nullptr != endpointContext && endpointContext->credentialIndex.IsBuilt());
+
+    if (CHIP_NO_ERROR != endpointContext->credentialIndex.SetUserCredentials(userIndex, credentials, totalCredentials))
+    {
+        ChipLogError(Zcl, "[indexUserCredentials] Unable to update credential index, dropping it [endpointId=%d]", endpointId);
+    }
+#endif // DOOR_LOCK_SERVER_CREDENTIAL_INDEX
+}
+
 EmberAfStatus DoorLockServer::createUser(chip::EndpointId endpointId, chip::FabricIndex creatorFabricIdx, chip::NodeId sourceNodeId,
                                          uint16_t userIndex, const Nullable<chip::CharSpan> & userName,
                                          const Nullable<uint32_t> & userUniqueId, const Nullable<UserStatusEnum> & userStatus,
@@ -1852,6 +2019,7 @@ EmberAfStatus DoorLockServer::createUser(chip::EndpointId endpointId, chip::Fabr
                         static_cast<unsigned int>(newTotalCredentials));
         return EMBER_ZCL_STATUS_FAILURE;
     }
+    indexUserCredentials(endpointId, userIndex, newCredentials, newTotalCredentials);
 
     ChipLogProgress(Zcl,
                     "[createUser] User created "
@@ -1972,6 +2140,8 @@ Status DoorLockServer::clearUser(chip::EndpointId endpointId, chip::FabricIndex
                          endpointId, userIndex, credential.credentialIndex, to_underlying(credential.credentialType));
             return Status::Failure;
         }
+        indexCredential(endpointId, credential.credentialType, credential.credentialIndex, DlCredentialStatus::kAvailable,
+                        chip::ByteSpan());
     }
 
     // Clear all the user schedules
@@ -1991,6 +2161,7 @@ Status DoorLockServer::clearUser(chip::EndpointId endpointId, chip::FabricIndex
     {
         return Status::Failure;
     }
+    indexUserCredentials(endpointId, userIndex, nullptr, 0);
 
     if (sendUserChangeEvent)
     {
@@ -2084,6 +2255,8 @@ DlStatus DoorLockServer::createNewCredentialAndUser(chip::EndpointId endpointId,
                         static_cast<unsigned int>(credentialData.size()));
         return DlStatus::kFailure;
     }
+    indexCredential(endpointId, credential.credentialType, credential.credentialIndex, DlCredentialStatus::kOccupied,
+                    credentialData);
 
     ChipLogProgress(Zcl,
                     "[SetCredential] Credential and user were created "
@@ -2149,6 +2322,8 @@ DlStatus DoorLockServer::createNewCredentialAndAddItToUser(chip::EndpointId endp
                         static_cast<unsigned int>(credentialData.size()));
         return DlStatus::kFailure;
     }
+    indexCredential(endpointId, credential.credentialType, credential.credentialIndex, DlCredentialStatus::kOccupied,
+                    credentialData);
 
     return DlStatus::kSuccess;
 }
@@ -2226,6 +2401,7 @@ DlStatus DoorLockServer::addCredentialToUser(chip::EndpointId endpointId, chip::
                         static_cast<unsigned int>(user.credentials.size()));
         return DlStatus::kFailure;
     }
+    indexUserCredentials(endpointId, userIndex, newCredentials.Get(), user.credentials.size() + 1);
 
     ChipLogProgress(Zcl,
                     "[AddCredentialToUser] Credential added to user "
@@ -2284,6 +2460,7 @@ DlStatus DoorLockServer::modifyCredentialForUser(chip::EndpointId endpointId, ch
                     static_cast<unsigned int>(user.credentials.size()));
                 return DlStatus::kFailure;
             }
+            indexUserCredentials(endpointId, userIndex, newCredentials.Get(), user.credentials.size());
 
             ChipLogProgress(Zcl,
                             "[ModifyUserCredential] User credential modified "
@@ -2404,6 +2581,7 @@ DlStatus DoorLockServer::modifyProgrammingPIN(chip::EndpointId endpointId, chip:
                         static_cast<unsigned int>(credentialData.size()));
         return DlStatus::kFailure;
     }
+    indexCredential(endpointId, credentialType, credentialIndex, existingCredential.status, credentialData);
 
     ChipLogProgress(Zcl,
                     "[SetCredential] Successfully         modified the credential "
@@ -2449,6 +2627,7 @@ DlStatus DoorLockServer::modifyCredential(chip::EndpointId endpointId, chip::Fab
 
             return DlStatus::kFailure;
         }
+        indexCredential(endpointId, credentialType, credentialIndex, existingCredential.status, credentialData);
 
         ChipLogProgress(Zcl,
                         "[SetCredential] Successfully modified the credential "
@@ -2839,6 +3018,7 @@ Status DoorLockServer::clearCredential(chip::EndpointId endpointId, chip::Fabric
                      endpointId, to_underlying(credentialType), credentialIndex, modifier);
         return Status::Failure;
     }
+    indexCredential(endpointId, credentialType, credentialIndex, DlCredentialStatus::kAvailable, chip::ByteSpan());
 
     uint8_t maxCredentialsPerUser;
     if (!GetNumberOfCredentialsSupportedPerUser(endpointId, maxCredentialsPerUser))
@@ -2895,6 +3075,7 @@ Status DoorLockServer::clearCredential(chip::EndpointId endpointId, chip::Fabric
                      static_cast<unsigned int>(newCredentialsCount));
         return Status::Failure;
     }
+    indexUserCredentials(endpointId, relatedUserIndex, newCredentials.Get(), newCredentialsCount);
 
     ChipLogProgress(Zcl,
                     "[clearCredential] Successfully clear credential and related user "
@@ -24,6 +24,8 @@
 
 #pragma once
 
+#include "door-lock-credential-index.h"
+
 #include <app-common/zap-generated/cluster-objects.h>
 #include <app/CommandHandler.h>
 #include <app/ConcreteCommandPath.h>
@@ -36,6 +38,16 @@
 #define DOOR_LOCK_SERVER_ENDPOINT 1
 #endif
 
+/**
+ * When enabled, the server keeps an in-memory index of the users/credentials database so that resolving a credential
+ * (e.g. checking the PIN of a Lock/Unlock Door command) does not fetch every user from the application. Applications
+ * that enable it and change users or credentials other than through the cluster commands must call
+ * DoorLockServer::ResetCredentialIndex() afterwards.
+ */
+#ifndef DOOR_LOCK_SERVER_CREDENTIAL_INDEX
+#define DOOR_LOCK_SERVER_CREDENTIAL_INDEX 0
+#endif
+
 using chip::Optional;
 using chip::app::Clusters::DoorLock::AlarmCodeEnum;
 using chip::app::Clusters::DoorLock::CredentialRuleEnum;
@@ -76,6 +88,7 @@ static constexpr size_t DOOR_LOCK_MAX_USER_NAME_SIZE = 10; /**< Maximum size of
 static constexpr size_t DOOR_LOCK_USER_NAME_BUFFER_SIZE =
     DOOR_LOCK_MAX_USER_NAME_SIZE + 1; /**< Maximum size of the user name string (in bytes). */
 
+enum class DlCredentialStatus : uint8_t;
 struct EmberAfPluginDoorLockCredentialInfo;
 struct EmberAfPluginDoorLockUserInfo;
 
@@ -83,6 +96,9 @@ struct EmberAfDoorLockEndpointContext
 {
     chip::System::Clock::Timestamp lockoutEndTimestamp;
     int wrongCodeEntryAttempts;
+#if DOOR_LOCK_SERVER_CREDENTIAL_INDEX
+    DoorLockCredentialIndex credentialIndex;
+#endif // DOOR_LOCK_SERVER_CREDENTIAL_INDEX
 };
 
 /**
@@ -215,6 +231,15 @@ public:
         mOnFabricRemovedCustomCallback = callback;
     }
 
+    /**
+     * @brief Drops the credential index of the endpoint, so that it gets rebuilt from the application database on the
+     *        next lookup. Must be called when the application changes users or credentials on its own. Does nothing
+     *        unless DOOR_LOCK_SERVER_CREDENTIAL_INDEX is enabled.
+     *
+     * @param endpointId endpoint whose users or credentials were changed
+     */
+    void ResetCredentialIndex(chip::EndpointId endpointId);
+
     bool OnFabricRemoved(chip::EndpointId endpointId, chip::FabricIndex fabricIndex);
 
     static void DoorLockOnAutoRelockCallback(chip::System::Layer *, void * callbackContext);
@@ -274,6 +299,12 @@ private:
     bool findUserIndexByCredential(chip::EndpointId endpointId, CredentialTypeEnum credentialType, chip::ByteSpan credentialData,
                                    uint16_t & userIndex, uint16_t & credentialIndex, EmberAfPluginDoorLockUserInfo & userInfo);
 
+    DoorLockCredentialIndex * getCredentialIndex(chip::EndpointId endpointId);
+    void indexCredential(chip::EndpointId endpointId, CredentialTypeEnum credentialType, uint16_t credentialIndex,
+                         DlCredentialStatus credentialStatus, const chip::ByteSpan & credentialData);
+    void indexUserCredentials(chip::EndpointId endpointId, uint16_t userIndex, const CredentialStruct * credentials,
+                              size_t totalCredentials);
+
     EmberAfStatus createUser(chip::EndpointId endpointId, chip::FabricIndex creatorFabricIdx, chip::NodeId sourceNodeId,
                              uint16_t userIndex, const Nullable<chip::CharSpan> & userName, const Nullable<uint32_t> & userUniqueId,
                              const Nullable<UserStatusEnum> & userStatus, const Nullable<UserTypeEnum> & userType,
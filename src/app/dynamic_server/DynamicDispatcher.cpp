@@ -134,6 +134,13 @@ bool ConcreteAttributePathExists(const ConcreteAttributePath & aPath)
     return DetermineAttributeStatus(aPath, /* aIsWrite = */ false) == Status::UnsupportedAccess;
 }
 
+#if CHIP_IM_REPORT_BUILDER_THREADS > 0
+bool IsConcurrentReadSafe(const ConcreteAttributePath & aPath)
+{
+    return false;
+}
+#endif
+
 Status ServerClusterCommandExists(const ConcreteCommandPath & aPath)
 {
     // TODO: Consider making this configurable for applications that are not
@@ -138,10 +138,12 @@ void ICDManager::UpdateOperationState(OperationalState state)
         mOperationalState = OperationalState::IdleMode;
 
         // When the active mode interval is 0, we stay in idleMode until a notification brings the icd into active mode
+        System::Clock::Timeout idleModeDuration = System::Clock::kZero;
         if (ICDManagementServer::GetInstance().GetActiveModeIntervalMs() > 0)
         {
             uint32_t idleModeInterval = ICDManagementServer::GetInstance().GetIdleModeIntervalSec();
-            DeviceLayer::SystemLayer().StartTimer(System::Clock::Seconds32(idleModeInterval), OnIdleModeDone, this);
+            idleModeDuration          = System::Clock::Seconds32(idleModeInterval);
+            DeviceLayer::SystemLayer().StartTimer(idleModeDuration, OnIdleModeDone, this);
         }
 
         System::Clock::Milliseconds32 slowPollInterval = GetSlowPollingInterval();
@@ -159,6 +161,8 @@ void ICDManager::UpdateOperationState(OperationalState state)
         {
             ChipLogError(AppServer, "Failed to set Polling Interval: err %" CHIP_ERROR_FORMAT, err.Format());
         }
+
+        mStateObserver->OnEnterIdleMode(idleModeDuration);
     }
     else if (state == OperationalState::ActiveMode)
     {
@@ -16,6 +16,8 @@
  */
 #pragma once
 
+#include <system/SystemClock.h>
+
 #ifndef ICD_SLEEP_TIME_JITTER_MS
 #define ICD_SLEEP_TIME_JITTER_MS (CHIP_CONFIG_ICD_IDLE_MODE_INTERVAL_SEC * 0.75)
 #endif
@@ -33,6 +35,10 @@ public:
     virtual ~ICDStateObserver() {}
     virtual void OnEnterActiveMode()  = 0;
     virtual void OnTransitionToIdle() = 0;
+    /// @brief Called when the ICD enters idle mode
+    /// @param aIdleModeDuration Time after which the ICD goes back to active mode on its own, zero if it stays idle until
+    ///                          something else brings it back to active mode
+    virtual void OnEnterIdleMode(System::Clock::Timeout aIdleModeDuration) = 0;
 };
 
 } // namespace app
@@ -34,10 +34,31 @@ using namespace chip::Access;
 namespace chip {
 namespace app {
 namespace reporting {
+
+namespace {
+
+// Reserved size for the MoreChunks boolean flag, which takes up 1 byte for the control tag and 1 byte for the context tag.
+constexpr uint32_t kReservedSizeForMoreChunksFlag = 1 + 1;
+
+// Reserved size for the uint8_t InteractionModelRevision flag, which takes up 1 byte for the control tag and 1 byte for the
+// context tag, 1 byte for value
+constexpr uint32_t kReservedSizeForIMRevision = 1 + 1 + 1;
+
+// Reserved size for the end of report message, which is an end-of-container (i.e 1 byte for the control tag).
+constexpr uint32_t kReservedSizeForEndOfReportMessage = 1;
+
+// Reserved size for an empty EventReportIBs, so we can at least check if there are any events need to be reported.
+constexpr uint32_t kReservedSizeForEventReportIBs = 3; // type, tag, end of container
+
+} // namespace
+
 CHIP_ERROR Engine::Init()
 {
     mNumReportsInFlight = 0;
     mCurReadHandlerIdx  = 0;
+#if CHIP_IM_REPORT_BUILDER_THREADS > 0
+    ReturnErrorOnFailure(SetReportBuilderThreadCount(CHIP_IM_REPORT_BUILDER_THREADS));
+#endif
     return CHIP_NO_ERROR;
 }
 
@@ -46,11 +67,23 @@ void Engine::Shutdown()
     // Flush out the event buffer synchronously
     ScheduleUrgentEventDeliverySync();
 
+#if CHIP_IM_REPORT_BUILDER_THREADS > 0
+    mReportBuilderPool.Stop();
+#endif
+
     mNumReportsInFlight = 0;
     mCurReadHandlerIdx  = 0;
     mGlobalDirtySet.ReleaseAll();
 }
 
+#if CHIP_IM_REPORT_BUILDER_THREADS > 0
+CHIP_ERROR Engine::SetReportBuilderThreadCount(size_t aThreadCount)
+{
+    mReportBuilderPool.Stop();
+    return mReportBuilderPool.Start(aThreadCount);
+}
+#endif
+
 bool Engine::IsClusterDataVersionMatch(const ObjectList<DataVersionFilter> * aDataVersionFilterList,
                                        const ConcreteReadAttributePath & aPath)
 {
@@ -76,6 +109,17 @@ Engine::RetrieveClusterData(const SubjectDescriptor & aSubjectDescriptor, bool a
                             AttributeReportIBs::Builder & aAttributeReportIBs, const ConcreteReadAttributePath & aPath,
                             AttributeValueEncoder::AttributeEncodeState * aEncoderState)
 {
+#if CHIP_IM_REPORT_BUILDER_THREADS > 0
+    if (ReportBuilderPool::IsBuilderThread() && !IsConcurrentReadSafe(aPath))
+    {
+        CHIP_ERROR err = CHIP_NO_ERROR;
+        mReportBuilderPool.RunOnCallerThread([&] {
+            err = RetrieveClusterData(aSubjectDescriptor, aIsFabricFiltered, aAttributeReportIBs, aPath, aEncoderState);
+        });
+        return err;
+    }
+#endif
+
     ChipLogDetail(DataManagement, "<RE:Run> Cluster %" PRIx32 ", Attribute %" PRIx32 " is dirty", aPath.mClusterId,
                   aPath.mAttributeId);
     MatterPreAttributeReadCallback(aPath);
@@ -89,6 +133,29 @@ static bool IsOutOfWriterSpaceError(CHIP_ERROR err)
     return err == CHIP_ERROR_NO_MEMORY || err == CHIP_ERROR_BUFFER_TOO_SMALL;
 }
 
+bool Engine::IsAttributePathDirty(const ConcreteAttributePath & aPath, uint64_t aGeneration)
+{
+    // We don't need to worry about paths that were already marked dirty before the last time this read handler
+    // started a report that it completed: those paths already got reported.
+    auto isDirty = [&](const AttributePathParamsWithGeneration & dirtyPath) {
+        return dirtyPath.IsAttributePathSupersetOf(aPath) && dirtyPath.mGeneration > aGeneration;
+    };
+
+#if CHIP_IM_REPORT_BUILDER_THREADS > 0
+    if (ReportBuilderPool::IsBuilderThread())
+    {
+        for (size_t i = 0; i < mDirtySetSnapshotSize; i++)
+        {
+            VerifyOrReturnValue(!isDirty(mDirtySetSnapshot[i]), true);
+        }
+        return false;
+    }
+#endif
+
+    return Loop::Break ==
+        mGlobalDirtySet.ForEachActiveObject([&](auto * dirtyPath) { return isDirty(*dirtyPath) ? Loop::Break : Loop::Continue; });
+}
+
 CHIP_ERROR Engine::BuildSingleReportDataAttributeReportIBs(ReportDataMessage::Builder & aReportDataBuilder,
                                                            ReadHandler * apReadHandler, bool * apHasMoreChunks,
                                                            bool * apHasEncodedData)
@@ -139,23 +206,8 @@ CHIP_ERROR Engine::BuildSingleReportDataAttributeReportIBs(ReportDataMessage::Bu
         {
             if (!apReadHandler->IsPriming())
             {
-                bool concretePathDirty = false;
                 // TODO: Optimize this implementation by making the iterator only emit intersected paths.
-                mGlobalDirtySet.ForEachActiveObject([&](auto * dirtyPath) {
-                    if (dirtyPath->IsAttributePathSupersetOf(readPath))
-                    {
-                        // We don't need to worry about paths that were already marked dirty before the last time this read handler
-                        // started a report that it completed: those paths already got reported.
-                        if (dirtyPath->mGeneration > apReadHandler->mPreviousReportsBeginGeneration)
-                        {
-                            concretePathDirty = true;
-                            return Loop::Break;
-                        }
-                    }
-                    return Loop::Continue;
-                });
-
-                if (!concretePathDirty)
+                if (!IsAttributePathDirty(readPath, apReadHandler->mPreviousReportsBeginGeneration))
                 {
                     // This attribute is not dirty, we just skip this one.
                     continue;
@@ -362,6 +414,18 @@ CHIP_ERROR Engine::BuildSingleReportDataEventReports(ReportDataMessage::Builder
     EventManagement & eventManager = EventManagement::GetInstance();
     bool hasMoreChunks             = false;
 
+#if CHIP_IM_REPORT_BUILDER_THREADS > 0
+    if (ReportBuilderPool::IsBuilderThread() && apReadHandler->GetEventPathList() != nullptr)
+    {
+        // Events are only ever fetched on the Matter thread.
+        mReportBuilderPool.RunOnCallerThread([&] {
+            err = BuildSingleReportDataEventReports(aReportDataBuilder, apReadHandler, aBufferIsUsed, apHasMoreChunks,
+                                                    apHasEncodedData);
+        });
+        return err;
+    }
+#endif
+
     aReportDataBuilder.Checkpoint(backup);
 
     VerifyOrExit(apReadHandler->GetEventPathList() != nullptr, );
@@ -460,60 +524,62 @@ exit:
 
 CHIP_ERROR Engine::BuildAndSendSingleReportData(ReadHandler * apReadHandler)
 {
-    CHIP_ERROR err = CHIP_NO_ERROR;
-    chip::System::PacketBufferTLVWriter reportDataWriter;
-    ReportDataMessage::Builder reportDataBuilder;
+    PendingReport report;
+    report.mError = PrepareReport(report, apReadHandler);
+    if (report.mError == CHIP_NO_ERROR)
+    {
+        BuildReport(report);
+    }
+    return SendBuiltReport(report);
+}
+
+CHIP_ERROR Engine::PrepareReport(PendingReport & aReport, ReadHandler * apReadHandler)
+{
     chip::System::PacketBufferHandle bufHandle = System::PacketBufferHandle::New(chip::app::kMaxSecureSduLengthBytes);
     uint16_t reservedSize                      = 0;
-    bool hasMoreChunks                         = false;
-    bool needCloseReadHandler                  = false;
-
-    // Reserved size for the MoreChunks boolean flag, which takes up 1 byte for the control tag and 1 byte for the context tag.
-    const uint32_t kReservedSizeForMoreChunksFlag = 1 + 1;
-
-    // Reserved size for the uint8_t InteractionModelRevision flag, which takes up 1 byte for the control tag and 1 byte for the
-    // context tag, 1 byte for value
-    const uint32_t kReservedSizeForIMRevision = 1 + 1 + 1;
-
-    // Reserved size for the end of report message, which is an end-of-container (i.e 1 byte for the control tag).
-    const uint32_t kReservedSizeForEndOfReportMessage = 1;
 
-    // Reserved size for an empty EventReportIBs, so we can at least check if there are any events need to be reported.
-    const uint32_t kReservedSizeForEventReportIBs = 3; // type, tag, end of container
+    aReport.mpReadHandler = apReadHandler;
 
-    VerifyOrExit(apReadHandler != nullptr, err = CHIP_ERROR_INVALID_ARGUMENT);
-    VerifyOrExit(apReadHandler->GetSession() != nullptr, err = CHIP_ERROR_INCORRECT_STATE);
-    VerifyOrExit(!bufHandle.IsNull(), err = CHIP_ERROR_NO_MEMORY);
+    VerifyOrReturnError(apReadHandler != nullptr, CHIP_ERROR_INVALID_ARGUMENT);
+    VerifyOrReturnError(apReadHandler->GetSession() != nullptr, CHIP_ERROR_INCORRECT_STATE);
+    VerifyOrReturnError(!bufHandle.IsNull(), CHIP_ERROR_NO_MEMORY);
 
     if (bufHandle->AvailableDataLength() > kMaxSecureSduLengthBytes)
     {
         reservedSize = static_cast<uint16_t>(bufHandle->AvailableDataLength() - kMaxSecureSduLengthBytes);
     }
 
-    reportDataWriter.Init(std::move(bufHandle));
+    aReport.mWriter.Init(std::move(bufHandle));
 
 #if CONFIG_BUILD_FOR_HOST_UNIT_TEST
-    reportDataWriter.ReserveBuffer(mReservedSize);
+    aReport.mWriter.ReserveBuffer(mReservedSize);
 #endif
 
     // Always limit the size of the generated packet to fit within kMaxSecureSduLengthBytes regardless of the available buffer
     // capacity.
     // Also, we need to reserve some extra space for the MIC field.
-    reportDataWriter.ReserveBuffer(static_cast<uint32_t>(reservedSize + chip::Crypto::CHIP_CRYPTO_AEAD_MIC_LENGTH_BYTES));
+    aReport.mWriter.ReserveBuffer(static_cast<uint32_t>(reservedSize + chip::Crypto::CHIP_CRYPTO_AEAD_MIC_LENGTH_BYTES));
 
     // Create a report data.
-    err = reportDataBuilder.Init(&reportDataWriter);
-    SuccessOrExit(err);
+    ReturnErrorOnFailure(aReport.mBuilder.Init(&aReport.mWriter));
 
     if (apReadHandler->IsType(ReadHandler::InteractionType::Subscribe))
     {
         SubscriptionId subscriptionId = 0;
         apReadHandler->GetSubscriptionId(subscriptionId);
-        reportDataBuilder.SubscriptionId(subscriptionId);
+        aReport.mBuilder.SubscriptionId(subscriptionId);
     }
 
-    SuccessOrExit(err = reportDataWriter.ReserveBuffer(kReservedSizeForMoreChunksFlag + kReservedSizeForIMRevision +
-                                                       kReservedSizeForEndOfReportMessage + kReservedSizeForEventReportIBs));
+    return aReport.mWriter.ReserveBuffer(kReservedSizeForMoreChunksFlag + kReservedSizeForIMRevision +
+                                         kReservedSizeForEndOfReportMessage + kReservedSizeForEventReportIBs);
+}
+
+void Engine::BuildReport(PendingReport & aReport)
+{
+    CHIP_ERROR err                                 = CHIP_NO_ERROR;
+    ReadHandler * readHandler                      = aReport.mpReadHandler;
+    chip::System::PacketBufferTLVWriter & writer   = aReport.mWriter;
+    ReportDataMessage::Builder & reportDataBuilder = aReport.mBuilder;
 
     {
         bool hasMoreChunksForAttributes = false;
@@ -521,37 +587,31 @@ CHIP_ERROR Engine::BuildAndSendSingleReportData(ReadHandler * apReadHandler)
         bool hasEncodedAttributes       = false;
         bool hasEncodedEvents           = false;
 
-        err = BuildSingleReportDataAttributeReportIBs(reportDataBuilder, apReadHandler, &hasMoreChunksForAttributes,
+        err = BuildSingleReportDataAttributeReportIBs(reportDataBuilder, readHandler, &hasMoreChunksForAttributes,
                                                       &hasEncodedAttributes);
         SuccessOrExit(err);
-        SuccessOrExit(err = reportDataWriter.UnreserveBuffer(kReservedSizeForEventReportIBs));
-        err = BuildSingleReportDataEventReports(reportDataBuilder, apReadHandler, hasEncodedAttributes, &hasMoreChunksForEvents,
+        SuccessOrExit(err = writer.UnreserveBuffer(kReservedSizeForEventReportIBs));
+        err = BuildSingleReportDataEventReports(reportDataBuilder, readHandler, hasEncodedAttributes, &hasMoreChunksForEvents,
                                                 &hasEncodedEvents);
         SuccessOrExit(err);
 
-        hasMoreChunks = hasMoreChunksForAttributes || hasMoreChunksForEvents;
+        aReport.mHasMoreChunks = hasMoreChunksForAttributes || hasMoreChunksForEvents;
 
-        if (!hasEncodedAttributes && !hasEncodedEvents && hasMoreChunks)
+        if (!hasEncodedAttributes && !hasEncodedEvents && aReport.mHasMoreChunks)
         {
-            ChipLogError(DataManagement,
-                         "No data actually encoded but hasMoreChunks flag is set, close read handler! (attribute too big?)");
-            err = apReadHandler->SendStatusReport(Protocols::InteractionModel::Status::ResourceExhausted);
-            if (err == CHIP_NO_ERROR)
-            {
-                needCloseReadHandler = true;
-            }
+            aReport.mIsTooLarge = true;
             ExitNow();
         }
     }
 
     SuccessOrExit(err = reportDataBuilder.GetError());
-    SuccessOrExit(err = reportDataWriter.UnreserveBuffer(kReservedSizeForMoreChunksFlag + kReservedSizeForIMRevision +
-                                                         kReservedSizeForEndOfReportMessage));
-    if (hasMoreChunks)
+    SuccessOrExit(err = writer.UnreserveBuffer(kReservedSizeForMoreChunksFlag + kReservedSizeForIMRevision +
+                                               kReservedSizeForEndOfReportMessage));
+    if (aReport.mHasMoreChunks)
     {
         reportDataBuilder.MoreChunkedMessages(true);
     }
-    else if (apReadHandler->IsType(ReadHandler::InteractionType::Read))
+    else if (readHandler->IsType(ReadHandler::InteractionType::Read))
     {
         reportDataBuilder.SuppressResponse(true);
     }
@@ -564,19 +624,43 @@ CHIP_ERROR Engine::BuildAndSendSingleReportData(ReadHandler * apReadHandler)
     //
     VerifyOrDie(reportDataBuilder.GetError() == CHIP_NO_ERROR);
 
-    err = reportDataWriter.Finalize(&bufHandle);
+    err = writer.Finalize(&aReport.mPayload);
+
+exit:
+    aReport.mError = err;
+}
+
+CHIP_ERROR Engine::SendBuiltReport(PendingReport & aReport)
+{
+    CHIP_ERROR err              = aReport.mError;
+    ReadHandler * readHandler   = aReport.mpReadHandler;
+    bool needCloseReadHandler   = false;
+
+    VerifyOrReturnError(readHandler != nullptr, err);
     SuccessOrExit(err);
 
-    ChipLogDetail(DataManagement, "<RE> Sending report (payload has %" PRIu32 " bytes)...", reportDataWriter.GetLengthWritten());
-    err = SendReport(apReadHandler, std::move(bufHandle), hasMoreChunks);
+    if (aReport.mIsTooLarge)
+    {
+        ChipLogError(DataManagement,
+                     "No data actually encoded but hasMoreChunks flag is set, close read handler! (attribute too big?)");
+        err = readHandler->SendStatusReport(Protocols::InteractionModel::Status::ResourceExhausted);
+        if (err == CHIP_NO_ERROR)
+        {
+            needCloseReadHandler = true;
+        }
+        ExitNow();
+    }
+
+    ChipLogDetail(DataManagement, "<RE> Sending report (payload has %" PRIu32 " bytes)...", aReport.mWriter.GetLengthWritten());
+    err = SendReport(readHandler, std::move(aReport.mPayload), aReport.mHasMoreChunks);
     VerifyOrExit(err == CHIP_NO_ERROR,
                  ChipLogError(DataManagement, "<RE> Error sending out report data with %" CHIP_ERROR_FORMAT "!", err.Format()));
 
     ChipLogDetail(DataManagement, "<RE> ReportsInFlight = %" PRIu32 " with readHandler %" PRIu32 ", RE has %s", mNumReportsInFlight,
-                  mCurReadHandlerIdx, hasMoreChunks ? "more messages" : "no more messages");
+                  mCurReadHandlerIdx, aReport.mHasMoreChunks ? "more messages" : "no more messages");
 
 exit:
-    if (err != CHIP_NO_ERROR || (apReadHandler->IsType(ReadHandler::InteractionType::Read) && !hasMoreChunks) ||
+    if (err != CHIP_NO_ERROR || (readHandler->IsType(ReadHandler::InteractionType::Read) && !aReport.mHasMoreChunks) ||
         needCloseReadHandler)
     {
         //
@@ -584,12 +668,50 @@ exit:
         // any further activity on this exchange. The EC layer will automatically close our EC, so shutdown the ReadHandler
         // gracefully.
         //
-        apReadHandler->Close();
+        readHandler->Close();
     }
 
     return err;
 }
 
+#if CHIP_IM_REPORT_BUILDER_THREADS > 0
+CHIP_ERROR Engine::BuildAndSendPendingReports(PendingReport * apReports, size_t aReportCount)
+{
+    CHIP_ERROR err = CHIP_NO_ERROR;
+
+    for (size_t i = 0; i < aReportCount; i++)
+    {
+        apReports[i].mError = PrepareReport(apReports[i], apReports[i].mpReadHandler);
+    }
+
+    mDirtySetSnapshotSize = 0;
+    mGlobalDirtySet.ForEachActiveObject([&](auto * dirtyPath) {
+        mDirtySetSnapshot[mDirtySetSnapshotSize++] = *dirtyPath;
+        return Loop::Continue;
+    });
+
+    mReportBuilderPool.Run(aReportCount, [&](size_t aIndex) {
+        if (apReports[aIndex].mError == CHIP_NO_ERROR)
+        {
+            BuildReport(apReports[aIndex]);
+        }
+    });
+
+    for (size_t i = 0; i < aReportCount; i++)
+    {
+        mRunningReadHandler = apReports[i].mpReadHandler;
+        CHIP_ERROR sendErr  = SendBuiltReport(apReports[i]);
+        mRunningReadHandler = nullptr;
+        if (err == CHIP_NO_ERROR)
+        {
+            err = sendErr;
+        }
+    }
+
+    return err;
+}
+#endif
+
 void Engine::Run(System::Layer * aSystemLayer, void * apAppState)
 {
     Engine * const pEngine = reinterpret_cast<Engine *>(apAppState);
@@ -633,27 +755,77 @@ void Engine::Run()
     // We may be deallocating read handlers as we go.  Track how many we had
     // initially, so we make sure to go through all of them.
     size_t initialAllocated = imEngine->mReadHandlers.Allocated();
-    while ((mNumReportsInFlight < CHIP_IM_MAX_REPORTS_IN_FLIGHT) && (numReadHandled < initialAllocated))
+    if (initialAllocated > 0)
     {
-        ReadHandler * readHandler = imEngine->ActiveHandlerAt(mCurReadHandlerIdx % (uint32_t) imEngine->mReadHandlers.Allocated());
-        VerifyOrDie(readHandler != nullptr);
+        // Resume after the last handler we serviced: first walk the handlers from that position to the end of the pool, then
+        // wrap around to the ones before it.  Walking the pool directly avoids looking every handler up by its index.
+        //
+        // Handlers that are not ready are skipped rather than kept off a separate ready queue: whether a subscription is
+        // reportable depends on the current time as well as on its dirty state, so such a queue would have to be updated from
+        // every report scheduler timer and every SetDirty, which already visits each handler.  The pool is bounded by
+        // CHIP_IM_MAX_NUM_READS + CHIP_IM_MAX_NUM_SUBSCRIPTIONS, and skipping a handler is a constant-time scheduler lookup.
+        uint32_t startIdx          = static_cast<uint32_t>(mCurReadHandlerIdx % initialAllocated);
+        bool failed                = false;
+        uint32_t numPendingReports = 0;
+#if CHIP_IM_REPORT_BUILDER_THREADS > 0
+        PendingReport pendingReports[CHIP_IM_MAX_REPORTS_IN_FLIGHT];
+#endif
 
-        if (readHandler->ShouldReportUnscheduled() || imEngine->GetReportScheduler()->IsReportableNow(readHandler))
-        {
-            mRunningReadHandler = readHandler;
-            CHIP_ERROR err      = BuildAndSendSingleReportData(readHandler);
-            mRunningReadHandler = nullptr;
-            if (err != CHIP_NO_ERROR)
+        auto processHandler = [&](ReadHandler * readHandler) {
+            if ((mNumReportsInFlight + numPendingReports >= CHIP_IM_MAX_REPORTS_IN_FLIGHT) || (numReadHandled >= initialAllocated))
+            {
+                return Loop::Break;
+            }
+
+            if (readHandler->ShouldReportUnscheduled() || imEngine->GetReportScheduler()->IsReportableNow(readHandler))
             {
-                return;
+#if CHIP_IM_REPORT_BUILDER_THREADS > 0
+                if (mReportBuilderPool.GetThreadCount() > 0)
+                {
+                    // Built together once every handler to report on is known, see BuildAndSendPendingReports.
+                    pendingReports[numPendingReports++].mpReadHandler = readHandler;
+                    numReadHandled++;
+                    mCurReadHandlerIdx++;
+                    return Loop::Continue;
+                }
+#endif
+                mRunningReadHandler = readHandler;
+                CHIP_ERROR err      = BuildAndSendSingleReportData(readHandler);
+                mRunningReadHandler = nullptr;
+                if (err != CHIP_NO_ERROR)
+                {
+                    failed = true;
+                    return Loop::Break;
+                }
             }
+
+            numReadHandled++;
+            // If readHandler removed itself from our list, we also decremented
+            // mCurReadHandlerIdx to account for that removal, so it's safe to
+            // increment here.
+            mCurReadHandlerIdx++;
+            return Loop::Continue;
+        };
+
+        uint32_t position  = 0;
+        mCurReadHandlerIdx = startIdx;
+        Loop result        = imEngine->mReadHandlers.ForEachActiveObject([&](ReadHandler * readHandler) {
+            return (position++ < startIdx) ? Loop::Continue : processHandler(readHandler);
+        });
+        VerifyOrReturn(!failed);
+
+        if (result != Loop::Break && startIdx > 0)
+        {
+            position = 0;
+            imEngine->mReadHandlers.ForEachActiveObject([&](ReadHandler * readHandler) {
+                return (position++ < startIdx) ? processHandler(readHandler) : Loop::Break;
+            });
+            VerifyOrReturn(!failed);
         }
 
-        numReadHandled++;
-        // If readHandler removed itself from our list, we also decremented
-        // mCurReadHandlerIdx to account for that removal, so it's safe to
-        // increment here.
-        mCurReadHandlerIdx++;
+#if CHIP_IM_REPORT_BUILDER_THREADS > 0
+        VerifyOrReturn(BuildAndSendPendingReports(pendingReports, numPendingReports) == CHIP_NO_ERROR);
+#endif
     }
 
     //
@@ -27,6 +27,9 @@
 #include <access/AccessControl.h>
 #include <app/MessageDef/ReportDataMessage.h>
 #include <app/ReadHandler.h>
+#if CHIP_IM_REPORT_BUILDER_THREADS > 0
+#include <app/reporting/ReportBuilderPool.h>
+#endif
 #include <app/util/basic-types.h>
 #include <lib/core/CHIPCore.h>
 #include <lib/support/CodeUtils.h>
@@ -72,6 +75,14 @@ public:
     void SetMaxAttributesPerChunk(uint32_t aMaxAttributesPerChunk) { mMaxAttributesPerChunk = aMaxAttributesPerChunk; }
 #endif
 
+#if CHIP_IM_REPORT_BUILDER_THREADS > 0
+    /**
+     * Changes the number of threads building reports, CHIP_IM_REPORT_BUILDER_THREADS at most. 0 builds them on the Matter
+     * thread.
+     */
+    CHIP_ERROR SetReportBuilderThreadCount(size_t aThreadCount);
+#endif
+
     /**
      * Should be invoked when the device receives a Status report, or when the Report data request times out.
      * This allows the engine to do some clean-up.
@@ -152,12 +163,56 @@ private:
         uint64_t mGeneration = 0;
     };
 
+    /**
+     * A report between the steps of BuildAndSendSingleReportData.
+     */
+    struct PendingReport
+    {
+        ReadHandler * mpReadHandler = nullptr;
+        System::PacketBufferTLVWriter mWriter;
+        ReportDataMessage::Builder mBuilder;
+        System::PacketBufferHandle mPayload;
+        CHIP_ERROR mError   = CHIP_NO_ERROR;
+        bool mHasMoreChunks = false;
+        // Not even the first chunk of data fits in a report.
+        bool mIsTooLarge = false;
+    };
+
     /**
      * Build Single Report Data including attribute changes and event data stream, and send out
      *
      */
     CHIP_ERROR BuildAndSendSingleReportData(ReadHandler * apReadHandler);
 
+    /**
+     * Allocates the buffer of the report and starts its message.
+     */
+    CHIP_ERROR PrepareReport(PendingReport & aReport, ReadHandler * apReadHandler);
+
+    /**
+     * Encodes the attributes and events of the report into its payload, setting its mError on failure.  This may run on a
+     * report builder thread.
+     */
+    void BuildReport(PendingReport & aReport);
+
+    /**
+     * Sends the built report, and closes its read handler if it failed or was the last one of a read.
+     */
+    CHIP_ERROR SendBuiltReport(PendingReport & aReport);
+
+#if CHIP_IM_REPORT_BUILDER_THREADS > 0
+    /**
+     * Builds the reports on the report builder threads, then sends them in order.  Returns the first error, after sending
+     * the other reports anyway.
+     */
+    CHIP_ERROR BuildAndSendPendingReports(PendingReport * apReports, size_t aReportCount);
+#endif
+
+    /**
+     * Whether the path was marked dirty after aGeneration.
+     */
+    bool IsAttributePathDirty(const ConcreteAttributePath & aPath, uint64_t aGeneration);
+
     CHIP_ERROR BuildSingleReportDataAttributeReportIBs(ReportDataMessage::Builder & reportDataBuilder, ReadHandler * apReadHandler,
                                                        bool * apHasMoreChunks, bool * apHasEncodedData);
     CHIP_ERROR BuildSingleReportDataEventReports(ReportDataMessage::Builder & reportDataBuilder, ReadHandler * apReadHandler,
@@ -261,6 +316,16 @@ private:
     ObjectPool<AttributePathParamsWithGeneration, CHIP_IM_SERVER_MAX_NUM_DIRTY_SET> mGlobalDirtySet;
 #endif
 
+#if CHIP_IM_REPORT_BUILDER_THREADS > 0
+    ReportBuilderPool mReportBuilderPool;
+
+    /**
+     * mGlobalDirtySet as it was when the report builder threads started, since they cannot iterate the pool concurrently.
+     */
+    AttributePathParamsWithGeneration mDirtySetSnapshot[CHIP_IM_SERVER_MAX_NUM_DIRTY_SET];
+    size_t mDirtySetSnapshotSize = 0;
+#endif
+
     /**
      * A generation counter for the dirty attrbute set.
      * ReadHandlers can save the generation value when generating reports.
@@ -0,0 +1,157 @@
+/*
+ *
+ *    Copyright (c) 2023 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#include <app/reporting/ReportBuilderPool.h>
+
+#include <lib/support/CodeUtils.h>
+#include <platform/LockTracker.h>
+
+namespace chip {
+namespace app {
+namespace reporting {
+
+namespace {
+thread_local bool tIsBuilderThread = false;
+} // namespace
+
+bool ReportBuilderPool::IsBuilderThread()
+{
+    return tIsBuilderThread;
+}
+
+CHIP_ERROR ReportBuilderPool::Start(size_t aThreadCount)
+{
+    VerifyOrReturnError(mThreadCount == 0, CHIP_ERROR_INCORRECT_STATE);
+    VerifyOrReturnError(aThreadCount <= kMaxThreads, CHIP_ERROR_INVALID_ARGUMENT);
+
+    mStopping = false;
+    for (; mThreadCount < aThreadCount; mThreadCount++)
+    {
+        mThreads[mThreadCount] = std::thread(&ReportBuilderPool::BuilderMain, this);
+    }
+    return CHIP_NO_ERROR;
+}
+
+void ReportBuilderPool::Stop()
+{
+    VerifyOrReturn(mThreadCount > 0);
+
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        mStopping = true;
+    }
+    mJobsPosted.notify_all();
+
+    for (; mThreadCount > 0; mThreadCount--)
+    {
+        mThreads[mThreadCount - 1].join();
+    }
+}
+
+void ReportBuilderPool::Run(size_t aJobCount, Job aJob, void * apContext)
+{
+    if (mThreadCount == 0)
+    {
+        for (size_t i = 0; i < aJobCount; i++)
+        {
+            aJob(i, apContext);
+        }
+        return;
+    }
+
+    std::unique_lock<std::mutex> lock(mMutex);
+    mJob          = aJob;
+    mpJobContext  = apContext;
+    mJobCount     = aJobCount;
+    mNextJob      = 0;
+    mFinishedJobs = 0;
+    mJobsPosted.notify_all();
+
+    // The builders cannot post a call once every job is done, so no call is left behind when this returns.
+    while (mFinishedJobs < mJobCount)
+    {
+        if (mCall == nullptr)
+        {
+            mCallerWakeUp.wait(lock);
+            continue;
+        }
+
+        Call call           = mCall;
+        void * pCallContext = mpCallContext;
+        lock.unlock();
+        call(pCallContext);
+        lock.lock();
+
+        mCall = nullptr;
+        mFinishedCalls++;
+        mCallDone.notify_all();
+    }
+
+    mJob         = nullptr;
+    mpJobContext = nullptr;
+}
+
+void ReportBuilderPool::RunOnCallerThread(Call aCall, void * apContext)
+{
+    if (!IsBuilderThread())
+    {
+        aCall(apContext);
+        return;
+    }
+
+    std::unique_lock<std::mutex> lock(mMutex);
+    mCallDone.wait(lock, [this] { return mCall == nullptr; });
+
+    mCall           = aCall;
+    mpCallContext   = apContext;
+    uint64_t ticket = ++mPostedCalls;
+    mCallerWakeUp.notify_one();
+
+    mCallDone.wait(lock, [this, ticket] { return mFinishedCalls >= ticket; });
+}
+
+void ReportBuilderPool::BuilderMain()
+{
+    tIsBuilderThread = true;
+#if CHIP_STACK_LOCK_TRACKING_ENABLED
+    // Jobs only run while the thread that called Run holds the stack lock for them.
+    Platform::Internal::SetChipStackLockSharedWithCurrentThread(true);
+#endif
+
+    std::unique_lock<std::mutex> lock(mMutex);
+    while (true)
+    {
+        mJobsPosted.wait(lock, [this] { return mStopping || (mJob != nullptr && mNextJob < mJobCount); });
+        VerifyOrReturn(!mStopping);
+
+        size_t index       = mNextJob++;
+        Job job            = mJob;
+        void * pJobContext = mpJobContext;
+        lock.unlock();
+        job(index, pJobContext);
+        lock.lock();
+
+        if (++mFinishedJobs == mJobCount)
+        {
+            mCallerWakeUp.notify_one();
+        }
+    }
+}
+
+} // namespace reporting
+} // namespace app
+} // namespace chip
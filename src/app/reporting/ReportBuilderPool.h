@@ -0,0 +1,121 @@
+/*
+ *
+ *    Copyright (c) 2023 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ * @file
+ *   Threads building the reports of the reporting engine while the Matter thread holds the stack lock.
+ */
+
+#pragma once
+
+#include <lib/core/CHIPConfig.h>
+#include <lib/core/CHIPError.h>
+
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+
+namespace chip {
+namespace app {
+namespace reporting {
+
+/**
+ * Runs a batch of jobs on up to CHIP_IM_REPORT_BUILDER_THREADS threads.
+ *
+ * The thread calling Run, which must hold the stack lock, waits for the whole batch. Nothing else can take the stack lock
+ * meanwhile, so the jobs see the data model exactly as it was when the batch started, and may read whatever is safe to read
+ * concurrently. A job that needs something else runs it through RunOnCallerThread, which hands it to the waiting thread.
+ */
+class ReportBuilderPool
+{
+public:
+    static constexpr size_t kMaxThreads = CHIP_IM_REPORT_BUILDER_THREADS;
+
+    using Job  = void (*)(size_t aIndex, void * apContext);
+    using Call = void (*)(void * apContext);
+
+    ~ReportBuilderPool() { Stop(); }
+
+    /**
+     * Starts aThreadCount threads. 0 keeps running the jobs on the calling thread.
+     */
+    CHIP_ERROR Start(size_t aThreadCount);
+
+    void Stop();
+
+    size_t GetThreadCount() const { return mThreadCount; }
+
+    /**
+     * Runs aJob for every index below aJobCount, and returns when all of them are done.
+     */
+    void Run(size_t aJobCount, Job aJob, void * apContext);
+
+    template <typename Lambda>
+    void Run(size_t aJobCount, const Lambda & aLambda)
+    {
+        Run(
+            aJobCount, [](size_t aIndex, void * apContext) { (*static_cast<const Lambda *>(apContext))(aIndex); },
+            const_cast<Lambda *>(&aLambda));
+    }
+
+    /**
+     * Runs aCall on the thread that called Run, and returns once it is done. Calls from any other thread than a builder thread
+     * run right away.
+     */
+    void RunOnCallerThread(Call aCall, void * apContext);
+
+    template <typename Lambda>
+    void RunOnCallerThread(const Lambda & aLambda)
+    {
+        RunOnCallerThread([](void * apContext) { (*static_cast<const Lambda *>(apContext))(); }, const_cast<Lambda *>(&aLambda));
+    }
+
+    static bool IsBuilderThread();
+
+private:
+    void BuilderMain();
+
+    std::thread mThreads[kMaxThreads];
+    size_t mThreadCount = 0;
+
+    std::mutex mMutex;
+    // Signaled when a batch starts or the pool stops.
+    std::condition_variable mJobsPosted;
+    // Signaled when the batch is done or a call is posted.
+    std::condition_variable mCallerWakeUp;
+    // Signaled when a posted call is done.
+    std::condition_variable mCallDone;
+    bool mStopping = false;
+
+    Job mJob             = nullptr;
+    void * mpJobContext  = nullptr;
+    size_t mJobCount     = 0;
+    size_t mNextJob      = 0;
+    size_t mFinishedJobs = 0;
+
+    // Calls are handed over one at a time, and run in the order of their ticket.
+    Call mCall              = nullptr;
+    void * mpCallContext    = nullptr;
+    uint64_t mPostedCalls   = 0;
+    uint64_t mFinishedCalls = 0;
+};
+
+} // namespace reporting
+} // namespace app
+} // namespace chip
@@ -112,8 +112,10 @@ public:
         {
             uint16_t minInterval, maxInterval;
             aReadHandler->GetReportingIntervals(minInterval, maxInterval);
+            mScheduler->RemoveFromTimestampOrder(this);
             mMinTimestamp = now + System::Clock::Seconds16(minInterval);
             mMaxTimestamp = now + System::Clock::Seconds16(maxInterval);
+            mScheduler->AddToTimestampOrder(this);
         }
 
         void TimerFired() override
@@ -124,12 +126,13 @@ public:
 
         System::Clock::Timestamp GetMinTimestamp() const { return mMinTimestamp; }
         System::Clock::Timestamp GetMaxTimestamp() const { return mMaxTimestamp; }
+        const ReportScheduler * GetScheduler() const { return mScheduler; }
 
     private:
         ReadHandler * mReadHandler;
         ReportScheduler * mScheduler;
-        Timestamp mMinTimestamp;
-        Timestamp mMaxTimestamp;
+        Timestamp mMinTimestamp = System::Clock::kZero;
+        Timestamp mMaxTimestamp = System::Clock::kZero;
 
         BitFlags<ReadHandlerNodeFlags> mFlags;
     };
@@ -182,20 +185,44 @@ protected:
     /// @return Node Address if node was found, nullptr otherwise
     ReadHandlerNode * FindReadHandlerNode(const ReadHandler * aReadHandler)
     {
-        ReadHandlerNode * foundNode = nullptr;
-        mNodesPool.ForEachActiveObject([&foundNode, aReadHandler](ReadHandlerNode * node) {
-            if (node->GetReadHandler() == aReadHandler)
-            {
-                foundNode = node;
-                return Loop::Break;
-            }
-
-            return Loop::Continue;
-        });
-        return foundNode;
+        // The handler keeps a pointer to its node, so this does not need to walk the node pool. A handler can only be
+        // registered with one scheduler at a time, make sure the node belongs to this one.
+        ReadHandlerNode * node = static_cast<ReadHandlerNode *>(aReadHandler->mReportSchedulerNode);
+        return (nullptr != node && node->GetScheduler() == this) ? node : nullptr;
     }
 
-    ObjectPool<ReadHandlerNode, CHIP_IM_MAX_NUM_READS + CHIP_IM_MAX_NUM_SUBSCRIPTIONS> mNodesPool;
+    /// @brief Create the ReadHandlerNode for a given ReadHandler and link the handler to it
+    /// @return Node Address if the node could be allocated, nullptr otherwise
+    ReadHandlerNode * CreateReadHandlerNode(ReadHandler * aReadHandler, const Timestamp & now)
+    {
+        ReadHandlerNode * node = mNodesPool.CreateObject(aReadHandler, this, now);
+        if (nullptr != node)
+        {
+            aReadHandler->mReportSchedulerNode = node;
+        }
+        return node;
+    }
+
+    /// @brief Release a ReadHandlerNode and unlink its ReadHandler from it
+    void ReleaseReadHandlerNode(ReadHandlerNode * aNode)
+    {
+        ReadHandler * readHandler = aNode->GetReadHandler();
+        if (readHandler->mReportSchedulerNode == aNode)
+        {
+            readHandler->mReportSchedulerNode = nullptr;
+        }
+        RemoveFromTimestampOrder(aNode);
+        mNodesPool.ReleaseObject(aNode);
+    }
+
+    /// @brief Hooks for schedulers that keep their nodes ordered by timestamp. A node is added each time its min and max
+    /// timestamps are set, including when it is created, and removed before they change or it is released.
+    virtual void AddToTimestampOrder(ReadHandlerNode * aNode) {}
+    virtual void RemoveFromTimestampOrder(ReadHandlerNode * aNode) {}
+
+    static constexpr size_t kMaxReadHandlerNodes = CHIP_IM_MAX_NUM_READS + CHIP_IM_MAX_NUM_SUBSCRIPTIONS;
+
+    ObjectPool<ReadHandlerNode, kMaxReadHandlerNodes> mNodesPool;
     TimerDelegate * mTimerDelegate;
 };
 }; // namespace reporting
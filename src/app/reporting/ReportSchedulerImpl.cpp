@@ -40,6 +40,8 @@ ReportSchedulerImpl::ReportSchedulerImpl(TimerDelegate * aTimerDelegate) : Repor
 
 void ReportSchedulerImpl::OnTransitionToIdle() {}
 
+void ReportSchedulerImpl::OnEnterIdleMode(Timeout aIdleModeDuration) {}
+
 /// @brief Method that triggers a report emission on each ReadHandler that is not blocked on its min interval.
 ///        Each read handler that is not blocked is immediately marked dirty so that it will report as soon as possible.
 void ReportSchedulerImpl::OnEnterActiveMode()
@@ -70,7 +72,7 @@ void ReportSchedulerImpl::OnSubscriptionEstablished(ReadHandler * aReadHandler)
 
     // The NodePool is the same size as the ReadHandler pool from the IM Engine, so we don't need a check for size here since if a
     // ReadHandler was created, space should be available.
-    newNode = mNodesPool.CreateObject(aReadHandler, this, now);
+    newNode = CreateReadHandlerNode(aReadHandler, now);
 
     ChipLogProgress(DataManagement,
                     "Registered a ReadHandler that will schedule a report between system Timestamp: %" PRIu64
@@ -116,7 +118,7 @@ void ReportSchedulerImpl::OnReadHandlerDestroyed(ReadHandler * aReadHandler)
     // Nothing to remove if the handler is not found in the list
     VerifyOrReturn(nullptr != removeNode);
 
-    mNodesPool.ReleaseObject(removeNode);
+    ReleaseReadHandlerNode(removeNode);
 }
 
 CHIP_ERROR ReportSchedulerImpl::ScheduleReport(Timeout timeout, ReadHandlerNode * node, const Timestamp & now)
@@ -35,6 +35,7 @@ public:
     // ICDStateObserver
     void OnEnterActiveMode() override;
     void OnTransitionToIdle() override;
+    void OnEnterIdleMode(Timeout aIdleModeDuration) override;
 
     // ReadHandlerObserver
     void OnSubscriptionEstablished(ReadHandler * aReadHandler) final;
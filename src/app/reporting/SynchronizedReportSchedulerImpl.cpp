@@ -19,6 +19,8 @@
 #include <app/reporting/SynchronizedReportSchedulerImpl.h>
 #include <lib/support/logging/CHIPLogging.h>
 
+#include <algorithm>
+
 namespace chip {
 namespace app {
 namespace reporting {
@@ -35,7 +37,7 @@ void SynchronizedReportSchedulerImpl::OnReadHandlerDestroyed(ReadHandler * aRead
     // Nothing to remove if the handler is not found in the list
     VerifyOrReturn(nullptr != removeNode);
 
-    mNodesPool.ReleaseObject(removeNode);
+    ReleaseReadHandlerNode(removeNode);
 
     if (!mNodesPool.Allocated())
     {
@@ -44,19 +46,70 @@ void SynchronizedReportSchedulerImpl::OnReadHandlerDestroyed(ReadHandler * aRead
     }
 }
 
+void SynchronizedReportSchedulerImpl::OnEnterActiveMode()
+{
+    mICDWakeTimestamp.ClearValue();
+
+    // The ICD woke up, either on its own or for something else, and the report that was held back for it can go out with it.
+    bool reportDeferred = mReportDeferredToICDWake;
+    if (reportDeferred)
+    {
+        mReportDeferredToICDWake = false;
+        mDeferredReportCount++;
+    }
+
+    ReportSchedulerImpl::OnEnterActiveMode();
+
+    if (reportDeferred)
+    {
+        RescheduleReport();
+    }
+}
+
 void SynchronizedReportSchedulerImpl::OnTransitionToIdle()
 {
     Timestamp now               = mTimerDelegate->GetCurrentMonotonicTimestamp();
     uint32_t targetIdleInterval = static_cast<uint32_t>(ICD_SLEEP_TIME_JITTER_MS);
-    VerifyOrReturn(now >= mTestNextReportTimestamp);
+    // Only a report that is still pending can be brought forward
+    VerifyOrReturn(IsReportScheduled() && mTestNextReportTimestamp >= now);
     if (((mTestNextReportTimestamp - now) < Seconds16(targetIdleInterval)) && (now > mNextMinTimestamp))
     {
         // If the next report is due in less than the idle mode interval and we are past the min interval, we can just send it now
+        // instead of waking up again for it shortly after going idle.
+        mCoalescedReportCount++;
         CancelReport();
         TimerFired();
     }
 }
 
+void SynchronizedReportSchedulerImpl::OnEnterIdleMode(Timeout aIdleModeDuration)
+{
+    if (aIdleModeDuration == kZero)
+    {
+        mICDWakeTimestamp.ClearValue();
+        return;
+    }
+
+    mICDWakeTimestamp.SetValue(mTimerDelegate->GetCurrentMonotonicTimestamp() + aIdleModeDuration);
+
+    // A report due while the ICD is idle can now wait for it to wake up
+    if (IsReportScheduled())
+    {
+        RescheduleReport();
+    }
+}
+
+/// @brief Recalculates the common report timeout and restarts the report timer with it
+void SynchronizedReportSchedulerImpl::RescheduleReport()
+{
+    VerifyOrReturn(mNodesPool.Allocated());
+
+    Timestamp now = mTimerDelegate->GetCurrentMonotonicTimestamp();
+    Timeout timeout;
+    VerifyOrReturn(CalculateNextReportTimeout(timeout, now) == CHIP_NO_ERROR);
+    ScheduleReport(timeout, nullptr, now);
+}
+
 CHIP_ERROR SynchronizedReportSchedulerImpl::ScheduleReport(Timeout timeout, ReadHandlerNode * node, const Timestamp & now)
 {
     // Cancel Report if it is currently scheduled
@@ -76,6 +129,7 @@ void SynchronizedReportSchedulerImpl::CancelReport()
 {
     // We don't need to take action on the handler, since the timer is common here
     mTimerDelegate->CancelTimer(this);
+    mReportDeferredToICDWake = false;
 }
 
 /// @brief Checks if the timer is active for the ReportScheduler
@@ -84,6 +138,54 @@ bool SynchronizedReportSchedulerImpl::IsReportScheduled()
     return mTimerDelegate->IsTimerActive(this);
 }
 
+void SynchronizedReportSchedulerImpl::AddToTimestampOrder(ReadHandlerNode * aNode)
+{
+    mNodesByMin.Add(aNode);
+    mNodesByMax.Add(aNode);
+}
+
+void SynchronizedReportSchedulerImpl::RemoveFromTimestampOrder(ReadHandlerNode * aNode)
+{
+    mNodesByMin.Remove(aNode);
+    mNodesByMax.Remove(aNode);
+}
+
+void SynchronizedReportSchedulerImpl::NodeOrder::Add(ReadHandlerNode * aNode)
+{
+    // The order holds the same nodes as the node pool, so it cannot be full
+    VerifyOrDie(mCount < kMaxReadHandlerNodes);
+
+    size_t index = static_cast<size_t>(UpperBound((aNode->*mKey)()) - begin());
+    std::move_backward(mNodes + index, mNodes + mCount, mNodes + mCount + 1);
+    mNodes[index] = aNode;
+    mCount++;
+}
+
+void SynchronizedReportSchedulerImpl::NodeOrder::Remove(ReadHandlerNode * aNode)
+{
+    // The timestamp of the node has not changed since it was added, so it is among the nodes with that timestamp. Nodes that
+    // were never added are not found.
+    Timestamp timestamp = (aNode->*mKey)();
+    auto first          = std::lower_bound(begin(), end(), timestamp,
+                                           [this](const ReadHandlerNode * node, const Timestamp & t) { return (node->*mKey)() < t; });
+
+    for (size_t index = static_cast<size_t>(first - begin()); index < mCount && (mNodes[index]->*mKey)() == timestamp; index++)
+    {
+        if (mNodes[index] == aNode)
+        {
+            std::move(mNodes + index + 1, mNodes + mCount, mNodes + index);
+            mCount--;
+            return;
+        }
+    }
+}
+
+ReadHandlerNode * const * SynchronizedReportSchedulerImpl::NodeOrder::UpperBound(const Timestamp & aTimestamp) const
+{
+    return std::upper_bound(begin(), end(), aTimestamp,
+                            [this](const Timestamp & t, const ReadHandlerNode * node) { return t < (node->*mKey)(); });
+}
+
 /// @brief Find the smallest maximum interval possible and set it as the common maximum
 /// @return NO_ERROR if the smallest maximum interval was found, error otherwise, INVALID LIST LENGTH if the list is empty
 CHIP_ERROR SynchronizedReportSchedulerImpl::FindNextMaxInterval(const Timestamp & now)
@@ -91,14 +193,12 @@ CHIP_ERROR SynchronizedReportSchedulerImpl::FindNextMaxInterval(const Timestamp
     VerifyOrReturnError(mNodesPool.Allocated(), CHIP_ERROR_INVALID_LIST_LENGTH);
     System::Clock::Timestamp earliest = now + Seconds16::max();
 
-    mNodesPool.ForEachActiveObject([&earliest, now](ReadHandlerNode * node) {
-        if (node->GetMaxTimestamp() < earliest && node->GetMaxTimestamp() > now)
-        {
-            earliest = node->GetMaxTimestamp();
-        }
-
-        return Loop::Continue;
-    });
+    // Nodes are sorted by max timestamp, the first one after now is the earliest
+    auto next = mNodesByMax.UpperBound(now);
+    if (next != mNodesByMax.end())
+    {
+        earliest = std::min(earliest, (*next)->GetMaxTimestamp());
+    }
 
     mNextMaxTimestamp = earliest;
 
@@ -114,16 +214,22 @@ CHIP_ERROR SynchronizedReportSchedulerImpl::FindNextMinInterval(const Timestamp
     VerifyOrReturnError(mNodesPool.Allocated(), CHIP_ERROR_INVALID_LIST_LENGTH);
     System::Clock::Timestamp latest = now;
 
-    mNodesPool.ForEachActiveObject([&latest, this](ReadHandlerNode * node) {
-        if (node->GetMinTimestamp() > latest && this->IsReadHandlerReportable(node->GetReadHandler()) &&
-            node->GetMinTimestamp() <= this->mNextMaxTimestamp)
+    // Nodes are sorted by min timestamp. Walk back from the last one that is not above the max for any handler, the first
+    // reportable one after now is the latest.
+    for (auto it = mNodesByMin.UpperBound(mNextMaxTimestamp); it != mNodesByMin.begin();)
+    {
+        ReadHandlerNode * node = *(--it);
+        if (node->GetMinTimestamp() <= latest)
         {
-            // We do not want the new min to be set above the max for any handler
-            latest = node->GetMinTimestamp();
+            break;
         }
 
-        return Loop::Continue;
-    });
+        if (IsReadHandlerReportable(node->GetReadHandler()))
+        {
+            latest = node->GetMinTimestamp();
+            break;
+        }
+    }
 
     mNextMinTimestamp = latest;
 
@@ -134,28 +240,47 @@ CHIP_ERROR SynchronizedReportSchedulerImpl::CalculateNextReportTimeout(Timeout &
                                                                        const Timestamp & now)
 {
     VerifyOrReturnError(nullptr != FindReadHandlerNode(aNode->GetReadHandler()), CHIP_ERROR_INVALID_ARGUMENT);
+    return CalculateNextReportTimeout(timeout, now);
+}
+
+/// @brief Calculates the common report timeout. While the ICD is idle, a report that would wake it up before it wakes up on
+/// its own is held back until then, as long as no handler goes past its max interval in the meantime.
+CHIP_ERROR SynchronizedReportSchedulerImpl::CalculateNextReportTimeout(Timeout & timeout, const Timestamp & now)
+{
     ReturnErrorOnFailure(FindNextMaxInterval(now));
     ReturnErrorOnFailure(FindNextMinInterval(now));
     bool reportableNow   = false;
     bool reportableAtMin = false;
+    bool canDefer        = mICDWakeTimestamp.HasValue() && mICDWakeTimestamp.Value() <= mNextMaxTimestamp;
 
-    mNodesPool.ForEachActiveObject([&reportableNow, &reportableAtMin, this, now](ReadHandlerNode * node) {
-        if (!node->IsEngineRunScheduled())
+    // Unless its engine run is already scheduled, a handler can only be reportable now, or at the common min, once its min
+    // timestamp is past. That is only the case for nodes up to the common max, which is after now.
+    auto last = mNodesByMin.UpperBound(mNextMaxTimestamp);
+    for (auto it = mNodesByMin.begin(); it != last; ++it)
+    {
+        ReadHandlerNode * node = *it;
+        if (node->IsEngineRunScheduled())
         {
-            if (node->IsReportableNow(now))
-            {
-                reportableNow = true;
-                return Loop::Break;
-            }
+            continue;
+        }
 
-            if (this->IsReadHandlerReportable(node->GetReadHandler()) && node->GetMinTimestamp() <= this->mNextMaxTimestamp)
+        if (node->IsReportableNow(now))
+        {
+            reportableNow = true;
+            // A handler that is already past its max interval cannot wait for the ICD to wake up
+            canDefer = canDefer && node->GetMaxTimestamp() > now;
+            if (!canDefer)
             {
-                reportableAtMin = true;
+                break;
             }
+            continue;
         }
 
-        return Loop::Continue;
-    });
+        if (IsReadHandlerReportable(node->GetReadHandler()))
+        {
+            reportableAtMin = true;
+        }
+    }
 
     // Find out if any handler is reportable now
 
@@ -173,6 +298,12 @@ CHIP_ERROR SynchronizedReportSchedulerImpl::CalculateNextReportTimeout(Timeout &
         timeout = mNextMaxTimestamp - now;
     }
 
+    mReportDeferredToICDWake = canDefer && now + timeout < mICDWakeTimestamp.Value();
+    if (mReportDeferredToICDWake)
+    {
+        timeout = mICDWakeTimestamp.Value() - now;
+    }
+
     return CHIP_NO_ERROR;
 }
 
@@ -182,13 +313,21 @@ void SynchronizedReportSchedulerImpl::TimerFired()
 {
     Timestamp now = mTimerDelegate->GetCurrentMonotonicTimestamp();
 
+    if (mReportDeferredToICDWake)
+    {
+        mReportDeferredToICDWake = false;
+        mDeferredReportCount++;
+    }
+
     InteractionModelEngine::GetInstance()->GetReportingEngine().ScheduleRun();
 
-    mNodesPool.ForEachActiveObject([now](ReadHandlerNode * node) {
-        if (node->GetMinTimestamp() <= now)
-        {
-            node->SetCanBeSynced(true);
-        }
+    // Nodes whose min timestamp is still ahead can neither be synced nor reportable now, unless their engine run is already
+    // scheduled.
+    auto last = mNodesByMin.UpperBound(now);
+    for (auto it = mNodesByMin.begin(); it != last; ++it)
+    {
+        ReadHandlerNode * node = *it;
+        node->SetCanBeSynced(true);
 
         if (node->IsReportableNow(now))
         {
@@ -196,9 +335,7 @@ void SynchronizedReportSchedulerImpl::TimerFired()
             ChipLogProgress(DataManagement, "Handler: %p with min: %" PRIu64 " and max: %" PRIu64 "", (node),
                             node->GetMinTimestamp().count(), node->GetMaxTimestamp().count());
         }
-
-        return Loop::Continue;
-    });
+    }
 }
 
 } // namespace reporting
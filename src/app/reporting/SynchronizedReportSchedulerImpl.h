@@ -19,6 +19,7 @@
 #pragma once
 
 #include <app/reporting/ReportSchedulerImpl.h>
+#include <lib/core/Optional.h>
 
 namespace chip {
 namespace app {
@@ -38,28 +39,78 @@ public:
     SynchronizedReportSchedulerImpl(TimerDelegate * aTimerDelegate) : ReportSchedulerImpl(aTimerDelegate) {}
     ~SynchronizedReportSchedulerImpl() override { UnregisterAllHandlers(); }
 
+    void OnEnterActiveMode() override;
     void OnTransitionToIdle() override;
+    void OnEnterIdleMode(Timeout aIdleModeDuration) override;
 
     bool IsReportScheduled();
 
+    /// @brief Number of reports that were sent when the ICD transitioned to idle instead of waking it up again shortly after
+    uint32_t GetCoalescedReportCount() const { return mCoalescedReportCount; }
+
+    /// @brief Number of reports that were held back while the ICD was idle and sent once it woke up, instead of waking it up
+    /// on their own
+    uint32_t GetDeferredReportCount() const { return mDeferredReportCount; }
+
     void TimerFired() override;
 
 protected:
     CHIP_ERROR ScheduleReport(System::Clock::Timeout timeout, ReadHandlerNode * node, const Timestamp & now) override;
     void CancelReport();
 
+    void AddToTimestampOrder(ReadHandlerNode * aNode) override;
+    void RemoveFromTimestampOrder(ReadHandlerNode * aNode) override;
+
 private:
     friend class chip::app::reporting::TestReportScheduler;
 
+    /// @brief The registered nodes sorted by one of their timestamps, so that the common min and max can be found without
+    /// visiting every node. Nodes with the same timestamp are kept in the order they were added.
+    class NodeOrder
+    {
+    public:
+        using Key = Timestamp (ReadHandlerNode::*)() const;
+
+        NodeOrder(Key aKey) : mKey(aKey) {}
+
+        void Add(ReadHandlerNode * aNode);
+        void Remove(ReadHandlerNode * aNode);
+
+        ReadHandlerNode * const * begin() const { return mNodes; }
+        ReadHandlerNode * const * end() const { return mNodes + mCount; }
+
+        /// @brief First node whose timestamp is after aTimestamp, or end() if there is none
+        ReadHandlerNode * const * UpperBound(const Timestamp & aTimestamp) const;
+
+    private:
+        Key mKey;
+        ReadHandlerNode * mNodes[kMaxReadHandlerNodes];
+        size_t mCount = 0;
+    };
+
     CHIP_ERROR FindNextMinInterval(const Timestamp & now);
     CHIP_ERROR FindNextMaxInterval(const Timestamp & now);
     CHIP_ERROR CalculateNextReportTimeout(Timeout & timeout, ReadHandlerNode * aReadHandlerNode, const Timestamp & now) override;
+    CHIP_ERROR CalculateNextReportTimeout(Timeout & timeout, const Timestamp & now);
+    void RescheduleReport();
 
     Timestamp mNextMaxTimestamp = Milliseconds64(0);
     Timestamp mNextMinTimestamp = Milliseconds64(0);
 
     // Timestamp of the next report to be scheduled, only used for testing
     Timestamp mTestNextReportTimestamp = Milliseconds64(0);
+
+    // Timestamp at which the ICD goes back to active mode on its own, only set while it is idle
+    Optional<Timestamp> mICDWakeTimestamp;
+
+    // Whether the scheduled report was held back until mICDWakeTimestamp
+    bool mReportDeferredToICDWake = false;
+
+    uint32_t mCoalescedReportCount = 0;
+    uint32_t mDeferredReportCount  = 0;
+
+    NodeOrder mNodesByMin{ &ReadHandlerNode::GetMinTimestamp };
+    NodeOrder mNodesByMax{ &ReadHandlerNode::GetMaxTimestamp };
 };
 
 } // namespace reporting
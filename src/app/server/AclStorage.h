@@ -151,6 +151,20 @@ public:
      * ACL entries in persistent storage as they are changed.
      */
     virtual CHIP_ERROR Init(PersistentStorageDelegate & persistentStorage, ConstFabricIterator first, ConstFabricIterator last) = 0;
+
+    /**
+     * Starts a batch of ACL changes, such as a whole ACL attribute write. Implementations may
+     * hold back persisting changes made during the batch and commit them together in EndBatch.
+     *
+     * Batches may nest; changes are committed when the outermost batch ends.
+     */
+    virtual void BeginBatch() {}
+
+    /**
+     * Ends a batch started with BeginBatch. Whatever the outcome of the changes made during the
+     * batch, storage is brought in sync with the entries held by AccessControl.
+     */
+    virtual void EndBatch() {}
 };
 
 } // namespace app
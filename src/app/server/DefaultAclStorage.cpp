@@ -18,6 +18,8 @@
 #include <app/server/DefaultAclStorage.h>
 
 #include <lib/support/DefaultStorageKeyAllocator.h>
+#include <lib/support/SafeInt.h>
+#include <lib/support/ScopedBuffer.h>
 
 using namespace chip;
 using namespace chip::app;
@@ -62,10 +64,187 @@ end structure                           1               0x18
 */
 
 // TODO(#14455): get actual values for max subjects/targets
-constexpr int kEncodedEntryOverheadBytes = 17 + 8;
-constexpr int kEncodedEntrySubjectBytes  = 9 * CHIP_CONFIG_EXAMPLE_ACCESS_CONTROL_MAX_SUBJECTS_PER_ENTRY;
-constexpr int kEncodedEntryTargetBytes   = 14 * CHIP_CONFIG_EXAMPLE_ACCESS_CONTROL_MAX_TARGETS_PER_ENTRY;
-constexpr int kEncodedEntryTotalBytes    = kEncodedEntryOverheadBytes + kEncodedEntrySubjectBytes + kEncodedEntryTargetBytes;
+constexpr size_t kEncodedEntryOverheadBytes = 17 + 8;
+constexpr size_t kEncodedEntrySubjectBytes  = 9 * CHIP_CONFIG_EXAMPLE_ACCESS_CONTROL_MAX_SUBJECTS_PER_ENTRY;
+constexpr size_t kEncodedEntryTargetBytes   = 14 * CHIP_CONFIG_EXAMPLE_ACCESS_CONTROL_MAX_TARGETS_PER_ENTRY;
+constexpr size_t kEncodedEntryTotalBytes    = kEncodedEntryOverheadBytes + kEncodedEntrySubjectBytes + kEncodedEntryTargetBytes;
+
+// A fabric's entries are stored as one anonymous list (start and end control bytes) of entries encoded as above.
+constexpr size_t kEncodedListOverheadBytes = 2;
+
+size_t EncodedListMaxBytes(size_t entryCount)
+{
+    return kEncodedListOverheadBytes + entryCount * kEncodedEntryTotalBytes;
+}
+
+/**
+ * Writes all entries of the fabric, as currently held by AccessControl, as the fabric's single
+ * ACL record. A fabric without entries keeps an empty record, so that the record always
+ * supersedes anything left in the older per-entry layout.
+ */
+CHIP_ERROR StoreFabricAcl(PersistentStorageDelegate & persistentStorage, FabricIndex fabric)
+{
+    const auto key = DefaultStorageKeyAllocator::AccessControlAclList(fabric);
+
+    size_t count;
+    ReturnErrorOnFailure(GetAccessControl().GetEntryCount(fabric, count));
+
+    const size_t capacity = EncodedListMaxBytes(count);
+    VerifyOrReturnError(CanCastTo<uint16_t>(capacity), CHIP_ERROR_BUFFER_TOO_SMALL);
+    Platform::ScopedMemoryBuffer<uint8_t> buffer;
+    VerifyOrReturnError(buffer.Alloc(capacity), CHIP_ERROR_NO_MEMORY);
+
+    TLV::TLVWriter writer;
+    TLV::TLVType listType;
+    writer.Init(buffer.Get(), capacity);
+    ReturnErrorOnFailure(writer.StartContainer(TLV::AnonymousTag(), TLV::kTLVType_List, listType));
+    for (size_t index = 0; index < count; ++index)
+    {
+        Entry entry;
+        ReturnErrorOnFailure(GetAccessControl().ReadEntry(fabric, index, entry));
+        EncodableEntry encodableEntry(entry);
+        ReturnErrorOnFailure(encodableEntry.EncodeForWrite(writer, TLV::AnonymousTag()));
+    }
+    ReturnErrorOnFailure(writer.EndContainer(listType));
+    ReturnErrorOnFailure(writer.Finalize());
+
+    return persistentStorage.SyncSetKeyValue(key.KeyName(), buffer.Get(), static_cast<uint16_t>(writer.GetLengthWritten()));
+}
+
+/**
+ * Decodes the entry the reader is positioned on and adds it to AccessControl for the fabric.
+ */
+CHIP_ERROR LoadEntry(TLV::TLVReader & reader, FabricIndex fabric)
+{
+    AclStorage::DecodableEntry decodableEntry;
+    ReturnErrorOnFailure(decodableEntry.Decode(reader));
+
+    Entry & entry = decodableEntry.GetEntry();
+    ReturnErrorOnFailure(entry.SetFabricIndex(fabric));
+
+    return GetAccessControl().CreateEntry(nullptr, fabric, nullptr, entry);
+}
+
+/**
+ * Loads the fabric's entries from its single ACL record.
+ *
+ * @retval #CHIP_ERROR_PERSISTED_STORAGE_VALUE_NOT_FOUND if the fabric has no such record.
+ */
+CHIP_ERROR LoadFabricAcl(PersistentStorageDelegate & persistentStorage, FabricIndex fabric, size_t & count)
+{
+    size_t maxCount;
+    ReturnErrorOnFailure(GetAccessControl().GetMaxEntriesPerFabric(maxCount));
+    if (maxCount == 0)
+    {
+        maxCount = CHIP_CONFIG_EXAMPLE_ACCESS_CONTROL_MAX_ENTRIES_PER_FABRIC;
+    }
+
+    const size_t capacity = EncodedListMaxBytes(maxCount);
+    VerifyOrReturnError(CanCastTo<uint16_t>(capacity), CHIP_ERROR_BUFFER_TOO_SMALL);
+    Platform::ScopedMemoryBuffer<uint8_t> buffer;
+    VerifyOrReturnError(buffer.Alloc(capacity), CHIP_ERROR_NO_MEMORY);
+
+    uint16_t size = static_cast<uint16_t>(capacity);
+    ReturnErrorOnFailure(
+        persistentStorage.SyncGetKeyValue(DefaultStorageKeyAllocator::AccessControlAclList(fabric).KeyName(), buffer.Get(), size));
+
+    TLV::TLVReader reader;
+    TLV::TLVType listType;
+    reader.Init(buffer.Get(), size);
+    ReturnErrorOnFailure(reader.Next(TLV::kTLVType_List, TLV::AnonymousTag()));
+    ReturnErrorOnFailure(reader.EnterContainer(listType));
+
+    CHIP_ERROR err;
+    while ((err = reader.Next()) == CHIP_NO_ERROR)
+    {
+        ReturnErrorOnFailure(LoadEntry(reader, fabric));
+        count++;
+    }
+    VerifyOrReturnError(err == CHIP_END_OF_TLV, err);
+
+    return reader.ExitContainer(listType);
+}
+
+/**
+ * Deletes whatever is left of the fabric's entries in the older layout, which stores each entry
+ * under its own key. Keys are deleted from the last one down, so that an interrupted deletion
+ * leaves keys starting at index 0, which the next call finds again.
+ */
+CHIP_ERROR DeleteLegacyFabricAcl(PersistentStorageDelegate & persistentStorage, FabricIndex fabric)
+{
+    size_t legacyCount = 0;
+    while (persistentStorage.SyncDoesKeyExist(DefaultStorageKeyAllocator::AccessControlAclEntry(fabric, legacyCount).KeyName()))
+    {
+        legacyCount++;
+    }
+
+    while (legacyCount > 0)
+    {
+        legacyCount--;
+        ReturnErrorOnFailure(
+            persistentStorage.SyncDeleteKeyValue(DefaultStorageKeyAllocator::AccessControlAclEntry(fabric, legacyCount).KeyName()));
+    }
+
+    return CHIP_NO_ERROR;
+}
+
+/**
+ * Loads the fabric's entries from the older layout and moves them to a single ACL record.
+ *
+ * The record is written and the old keys are deleted in one storage transaction. On backends
+ * without transactions the record is written first: once it exists, the fabric is loaded from it
+ * and any old keys still present are deleted, so they can never be loaded again.
+ */
+CHIP_ERROR MigrateLegacyFabricAcl(PersistentStorageDelegate & persistentStorage, FabricIndex fabric, size_t & count)
+{
+    size_t legacyCount = 0;
+
+    for (;; ++legacyCount)
+    {
+        uint8_t buffer[kEncodedEntryTotalBytes] = { 0 };
+        uint16_t size                           = static_cast<uint16_t>(sizeof(buffer));
+        CHIP_ERROR err                          = persistentStorage.SyncGetKeyValue(
+            DefaultStorageKeyAllocator::AccessControlAclEntry(fabric, legacyCount).KeyName(), buffer, size);
+        if (err == CHIP_ERROR_PERSISTED_STORAGE_VALUE_NOT_FOUND)
+        {
+            break;
+        }
+        ReturnErrorOnFailure(err);
+
+        TLV::TLVReader reader;
+        reader.Init(buffer, size);
+        ReturnErrorOnFailure(reader.Next());
+        ReturnErrorOnFailure(LoadEntry(reader, fabric));
+    }
+
+    VerifyOrReturnError(legacyCount > 0, CHIP_NO_ERROR);
+
+    CHIP_ERROR transactionErr = persistentStorage.BeginTransaction();
+    CHIP_ERROR err            = StoreFabricAcl(persistentStorage, fabric);
+    if (err == CHIP_NO_ERROR)
+    {
+        err = DeleteLegacyFabricAcl(persistentStorage, fabric);
+    }
+    if (transactionErr == CHIP_NO_ERROR)
+    {
+        if (err == CHIP_NO_ERROR)
+        {
+            err = persistentStorage.CommitTransaction();
+        }
+        else
+        {
+            persistentStorage.AbortTransaction();
+        }
+    }
+    ReturnErrorOnFailure(err);
+
+    ChipLogProgress(DataManagement, "DefaultAclStorage: migrated %u entries for fabric %u", static_cast<unsigned>(legacyCount),
+                    static_cast<unsigned>(fabric));
+    count += legacyCount;
+    return CHIP_NO_ERROR;
+}
+
+constexpr unsigned kPendingBitsPerWord = 32;
 
 class : public EntryListener
 {
@@ -75,55 +254,60 @@ public:
     {
         CHIP_ERROR err;
 
-        uint8_t buffer[kEncodedEntryTotalBytes] = { 0 };
-
         VerifyOrExit(mPersistentStorage != nullptr, err = CHIP_ERROR_INCORRECT_STATE);
 
-        if (changeType == ChangeType::kRemoved)
+        if (mBatchDepth > 0)
         {
-            // Shuffle down entries past index, then delete entry at last index.
-            while (true)
-            {
-                uint16_t size = static_cast<uint16_t>(sizeof(buffer));
-                err           = mPersistentStorage->SyncGetKeyValue(
-                    DefaultStorageKeyAllocator::AccessControlAclEntry(fabric, index + 1).KeyName(), buffer, size);
-                if (err == CHIP_ERROR_PERSISTED_STORAGE_VALUE_NOT_FOUND)
-                {
-                    break;
-                }
-                SuccessOrExit(err);
-                SuccessOrExit(err = mPersistentStorage->SyncSetKeyValue(
-                                  DefaultStorageKeyAllocator::AccessControlAclEntry(fabric, index).KeyName(), buffer, size));
-                index++;
-            }
-            SuccessOrExit(err = mPersistentStorage->SyncDeleteKeyValue(
-                              DefaultStorageKeyAllocator::AccessControlAclEntry(fabric, index).KeyName()));
-        }
-        else
-        {
-            // Write added/updated entry at index.
-            VerifyOrExit(entry != nullptr, err = CHIP_ERROR_INCORRECT_STATE);
-            TLV::TLVWriter writer;
-            writer.Init(buffer);
-            EncodableEntry encodableEntry(*entry);
-            SuccessOrExit(err = encodableEntry.EncodeForWrite(writer, TLV::AnonymousTag()));
-            SuccessOrExit(err = mPersistentStorage->SyncSetKeyValue(
-                              DefaultStorageKeyAllocator::AccessControlAclEntry(fabric, index).KeyName(), buffer,
-                              static_cast<uint16_t>(writer.GetLengthWritten())));
+            // Stored once when the batch ends, whatever else changes in the fabric meanwhile.
+            mPendingFabrics[fabric / kPendingBitsPerWord] |= static_cast<uint32_t>(1u << (fabric % kPendingBitsPerWord));
+            return;
         }
 
+        SuccessOrExit(err = StoreFabricAcl(*mPersistentStorage, fabric));
+
         return;
 
     exit:
         ChipLogError(DataManagement, "DefaultAclStorage: failed %" CHIP_ERROR_FORMAT, err.Format());
     }
 
+    void BeginBatch() { mBatchDepth++; }
+
+    void EndBatch()
+    {
+        VerifyOrReturn(mBatchDepth > 0);
+        VerifyOrReturn(--mBatchDepth == 0);
+        VerifyOrReturn(mPersistentStorage != nullptr);
+
+        for (unsigned fabric = kMinValidFabricIndex; fabric <= kMaxValidFabricIndex; fabric++)
+        {
+            uint32_t & word     = mPendingFabrics[fabric / kPendingBitsPerWord];
+            const uint32_t mask = static_cast<uint32_t>(1u << (fabric % kPendingBitsPerWord));
+            if ((word & mask) == 0)
+            {
+                continue;
+            }
+            word &= ~mask;
+
+            CHIP_ERROR err = StoreFabricAcl(*mPersistentStorage, static_cast<FabricIndex>(fabric));
+            if (err != CHIP_NO_ERROR)
+            {
+                ChipLogError(DataManagement, "DefaultAclStorage: failed %" CHIP_ERROR_FORMAT, err.Format());
+            }
+        }
+    }
+
     // Must initialize before use.
     void Init(PersistentStorageDelegate & persistentStorage) { mPersistentStorage = &persistentStorage; }
 
 private:
     PersistentStorageDelegate * mPersistentStorage = nullptr;
 
+    unsigned mBatchDepth = 0;
+
+    // Fabrics changed during the current batch, one bit per fabric index.
+    uint32_t mPendingFabrics[(kMaxValidFabricIndex + kPendingBitsPerWord) / kPendingBitsPerWord] = {};
+
 } sEntryListener;
 
 } // namespace
@@ -143,31 +327,17 @@ CHIP_ERROR DefaultAclStorage::Init(PersistentStorageDelegate & persistentStorage
     for (auto it = first; it != last; ++it)
     {
         auto fabric = it->GetFabricIndex();
-        for (size_t index = 0; /**/; ++index)
+        err         = LoadFabricAcl(persistentStorage, fabric, count);
+        if (err == CHIP_NO_ERROR)
         {
-            uint8_t buffer[kEncodedEntryTotalBytes] = { 0 };
-            uint16_t size                           = static_cast<uint16_t>(sizeof(buffer));
-            err = persistentStorage.SyncGetKeyValue(DefaultStorageKeyAllocator::AccessControlAclEntry(fabric, index).KeyName(),
-                                                    buffer, size);
-            if (err == CHIP_ERROR_PERSISTED_STORAGE_VALUE_NOT_FOUND)
-            {
-                break;
-            }
-            SuccessOrExit(err);
-
-            TLV::TLVReader reader;
-            reader.Init(buffer, size);
-            SuccessOrExit(err = reader.Next());
-
-            DecodableEntry decodableEntry;
-            SuccessOrExit(err = decodableEntry.Decode(reader));
-
-            Entry & entry = decodableEntry.GetEntry();
-            SuccessOrExit(err = entry.SetFabricIndex(fabric));
-
-            SuccessOrExit(err = GetAccessControl().CreateEntry(nullptr, fabric, nullptr, entry));
-            count++;
+            // Left over if a migration without storage transactions was interrupted.
+            err = DeleteLegacyFabricAcl(persistentStorage, fabric);
+        }
+        else if (err == CHIP_ERROR_PERSISTED_STORAGE_VALUE_NOT_FOUND)
+        {
+            err = MigrateLegacyFabricAcl(persistentStorage, fabric, count);
         }
+        SuccessOrExit(err);
     }
 
     ChipLogProgress(DataManagement, "DefaultAclStorage: %u entries loaded", (unsigned) count);
@@ -182,5 +352,15 @@ exit:
     return err;
 }
 
+void DefaultAclStorage::BeginBatch()
+{
+    sEntryListener.BeginBatch();
+}
+
+void DefaultAclStorage::EndBatch()
+{
+    sEntryListener.EndBatch();
+}
+
 } // namespace app
 } // namespace chip
@@ -29,8 +29,14 @@ public:
      * Initialize must be called. It loads ACL entries for all fabrics from persistent storage,
      * then installs a listener for the access control system module to maintain ACL entries in
      * persistent storage so they remain in sync with entries in the access control system module.
+     *
+     * Each fabric's entries are stored together as one record, which is rewritten once per change,
+     * or once per batch. Fabrics still stored in the older one-key-per-entry layout are migrated.
      */
     CHIP_ERROR Init(PersistentStorageDelegate & persistentStorage, ConstFabricIterator first, ConstFabricIterator last) override;
+
+    void BeginBatch() override;
+    void EndBatch() override;
 };
 
 } // namespace app
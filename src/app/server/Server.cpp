@@ -239,6 +239,13 @@ CHIP_ERROR Server::Init(const ServerInitParams & initParams)
                                      CHIP_DEVICE_CONFIG_EVENT_ID_COUNTER_EPOCH);
     SuccessOrExit(err);
 
+#if CHIP_DEVICE_CONFIG_EVENT_ID_COUNTER_PRE_ADVANCE_HEADROOM > 0
+    err = sGlobalEventIdCounter.EnablePreAdvance(
+        [](AsyncWorkFunct work, intptr_t arg) { return PlatformMgr().ScheduleWork(work, arg); },
+        CHIP_DEVICE_CONFIG_EVENT_ID_COUNTER_PRE_ADVANCE_HEADROOM);
+    SuccessOrExit(err);
+#endif
+
     {
         ::chip::app::LogStorageResources logStorageResources[] = {
             { &sDebugEventBuffer[0], sizeof(sDebugEventBuffer), ::chip::app::PriorityLevel::Debug },
@@ -337,6 +337,8 @@ public:
 
     PersistentStorageDelegate & GetPersistentStorage() { return *mDeviceStorage; }
 
+    app::AclStorage & GetAclStorage() { return *mAclStorage; }
+
     app::FailSafeContext & GetFailSafeContext() { return mFailSafeContext; }
 
     TestEventTriggerDelegate * GetTestEventTriggerDelegate() { return mTestEventTriggerDelegate; }
@@ -470,8 +472,16 @@ private:
                              static_cast<unsigned>(fabricIndex), aclErr.Format());
             }
 
-            //  Remove ACL extension entry for the given fabricIndex.
+            // Remove the fabric's ACL record, which DefaultAclStorage keeps even when it holds no entries.
             auto & storage = mServer->GetPersistentStorage();
+            aclErr         = storage.SyncDeleteKeyValue(DefaultStorageKeyAllocator::AccessControlAclList(fabricIndex).KeyName());
+            if (aclErr != CHIP_NO_ERROR && aclErr != CHIP_ERROR_PERSISTED_STORAGE_VALUE_NOT_FOUND)
+            {
+                ChipLogError(AppServer, "Warning, failed to delete ACL record for fabric index 0x%x: %" CHIP_ERROR_FORMAT,
+                             static_cast<unsigned>(fabricIndex), aclErr.Format());
+            }
+
+            //  Remove ACL extension entry for the given fabricIndex.
             aclErr = storage.SyncDeleteKeyValue(DefaultStorageKeyAllocator::AccessControlExtensionEntry(fabricIndex).KeyName());
 
             if (aclErr != CHIP_NO_ERROR && aclErr != CHIP_ERROR_PERSISTED_STORAGE_VALUE_NOT_FOUND)
@@ -143,6 +143,13 @@ bool ConcreteAttributePathExists(const ConcreteAttributePath & aPath)
     return aPath.mClusterId != kTestDeniedClusterId1;
 }
 
+#if CHIP_IM_REPORT_BUILDER_THREADS > 0
+bool IsConcurrentReadSafe(const ConcreteAttributePath & aPath)
+{
+    return false;
+}
+#endif
+
 Protocols::InteractionModel::Status CheckEventSupportStatus(const ConcreteEventPath & aPath)
 {
     if (aPath.mClusterId == kTestDeniedClusterId1)
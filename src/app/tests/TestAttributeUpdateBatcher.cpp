@@ -0,0 +1,221 @@
+/*
+ *
+ *    Copyright (c) 2023 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#include <app-common/zap-generated/attribute-type.h>
+#include <app/reporting/reporting.h>
+#include <app/util/AttributeUpdateBatcher.h>
+#include <app/util/attribute-table.h>
+#include <lib/support/CHIPMem.h>
+#include <lib/support/CodeUtils.h>
+#include <lib/support/UnitTestRegistration.h>
+#include <platform/CHIPDeviceLayer.h>
+
+#include <nlunit-test.h>
+
+#include <vector>
+
+using namespace chip;
+using namespace chip::app;
+using namespace chip::DeviceLayer;
+
+namespace {
+
+constexpr size_t kBatchSize = CHIP_IM_ATTRIBUTE_UPDATE_BATCH_SIZE;
+
+const ConcreteAttributePath kPathA(1, 0x0006, 0x0000);
+const ConcreteAttributePath kPathB(1, 0x0008, 0x0000);
+const ConcreteAttributePath kFailingPath(2, 0x0006, 0x0000);
+const ConcreteAttributePath kIgnoredPath(3, 0x0006, 0x0000);
+
+// What the attribute store and the reporting engine were asked to do, in order.
+struct Event
+{
+    enum Kind
+    {
+        kWrite,
+        kReport,
+    } mKind;
+    ConcreteAttributePath mPath;
+    uint8_t mValue;
+};
+
+std::vector<Event> gEvents;
+
+size_t CountEvents(Event::Kind kind)
+{
+    size_t count = 0;
+    for (auto & event : gEvents)
+    {
+        count += (event.mKind == kind) ? 1 : 0;
+    }
+    return count;
+}
+
+// The batcher under test. Static, since work it schedules on the Matter thread keeps pointing at it.
+AttributeUpdateBatcher gBatcher;
+
+void ApplyStagedUpdates()
+{
+    gEvents.clear();
+    PlatformMgr().LockChipStack();
+    gBatcher.ApplyStagedUpdates();
+    PlatformMgr().UnlockChipStack();
+}
+
+void TestCoalescing(nlTestSuite * inSuite, void * inContext)
+{
+    NL_TEST_ASSERT(inSuite, gBatcher.StageUpdate(kPathA, ZCL_INT8U_ATTRIBUTE_TYPE, static_cast<uint8_t>(1)) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, gBatcher.StageUpdate(kPathB, ZCL_INT8U_ATTRIBUTE_TYPE, static_cast<uint8_t>(2)) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, gBatcher.StageUpdate(kPathA, ZCL_INT8U_ATTRIBUTE_TYPE, static_cast<uint8_t>(3)) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, gBatcher.StageUpdate(kPathA, ZCL_INT8U_ATTRIBUTE_TYPE, static_cast<uint8_t>(4)) == CHIP_NO_ERROR);
+
+    ApplyStagedUpdates();
+
+    // Every value is stored, but each path is reported once.
+    NL_TEST_ASSERT(inSuite, CountEvents(Event::kWrite) == 4);
+    NL_TEST_ASSERT(inSuite, CountEvents(Event::kReport) == 2);
+
+    // Nothing is left for the next pass.
+    ApplyStagedUpdates();
+    NL_TEST_ASSERT(inSuite, gEvents.empty());
+}
+
+void TestApplyOrdering(nlTestSuite * inSuite, void * inContext)
+{
+    NL_TEST_ASSERT(inSuite, gBatcher.StageUpdate(kPathA, ZCL_INT8U_ATTRIBUTE_TYPE, static_cast<uint8_t>(1)) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, gBatcher.StageUpdate(kPathB, ZCL_INT8U_ATTRIBUTE_TYPE, static_cast<uint8_t>(2)) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, gBatcher.StageUpdate(kFailingPath, ZCL_INT8U_ATTRIBUTE_TYPE, static_cast<uint8_t>(3)) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, gBatcher.StageUpdate(kPathA, ZCL_INT8U_ATTRIBUTE_TYPE, static_cast<uint8_t>(4)) == CHIP_NO_ERROR);
+
+    ApplyStagedUpdates();
+
+    // Values are written in the order they were staged, so the last one staged for a path wins, and reports only go out
+    // once every value is stored. A value the attribute store rejected is not reported.
+    NL_TEST_ASSERT(inSuite, gEvents.size() == 6);
+    if (gEvents.size() == 6)
+    {
+        NL_TEST_ASSERT(inSuite, gEvents[0].mKind == Event::kWrite && gEvents[0].mPath == kPathA && gEvents[0].mValue == 1);
+        NL_TEST_ASSERT(inSuite, gEvents[1].mKind == Event::kWrite && gEvents[1].mPath == kPathB && gEvents[1].mValue == 2);
+        NL_TEST_ASSERT(inSuite, gEvents[2].mKind == Event::kWrite && gEvents[2].mPath == kFailingPath);
+        NL_TEST_ASSERT(inSuite, gEvents[3].mKind == Event::kWrite && gEvents[3].mPath == kPathA && gEvents[3].mValue == 4);
+        NL_TEST_ASSERT(inSuite, gEvents[4].mKind == Event::kReport && gEvents[4].mPath == kPathA);
+        NL_TEST_ASSERT(inSuite, gEvents[5].mKind == Event::kReport && gEvents[5].mPath == kPathB);
+    }
+}
+
+void TestIgnoredWrite(nlTestSuite * inSuite, void * inContext)
+{
+    NL_TEST_ASSERT(inSuite, gBatcher.StageUpdate(kIgnoredPath, ZCL_INT8U_ATTRIBUTE_TYPE, static_cast<uint8_t>(1)) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, gBatcher.StageUpdate(kPathA, ZCL_INT8U_ATTRIBUTE_TYPE, static_cast<uint8_t>(2)) == CHIP_NO_ERROR);
+
+    ApplyStagedUpdates();
+
+    // The attribute store accepted both writes, but ignored the first one, so only the second is reported.
+    NL_TEST_ASSERT(inSuite, CountEvents(Event::kWrite) == 2);
+    NL_TEST_ASSERT(inSuite, CountEvents(Event::kReport) == 1);
+    if (gEvents.size() == 3)
+    {
+        NL_TEST_ASSERT(inSuite, gEvents[2].mKind == Event::kReport && gEvents[2].mPath == kPathA);
+    }
+}
+
+void TestOverflow(nlTestSuite * inSuite, void * inContext)
+{
+    uint8_t tooLarge[AttributeUpdateBatcher::kMaxValueSize + 1] = {};
+    NL_TEST_ASSERT(inSuite,
+                   gBatcher.StageUpdate(kPathA, ZCL_OCTET_STRING_ATTRIBUTE_TYPE, tooLarge, sizeof(tooLarge)) ==
+                       CHIP_ERROR_INVALID_ARGUMENT);
+
+    // A full queue refuses updates rather than blocking.
+    for (size_t i = 0; i < kBatchSize; i++)
+    {
+        NL_TEST_ASSERT(inSuite,
+                       gBatcher.StageUpdate(kPathA, ZCL_INT8U_ATTRIBUTE_TYPE, static_cast<uint8_t>(i)) == CHIP_NO_ERROR);
+    }
+    NL_TEST_ASSERT(inSuite, gBatcher.StageUpdate(kPathB, ZCL_INT8U_ATTRIBUTE_TYPE, static_cast<uint8_t>(0)) == CHIP_ERROR_NO_MEMORY);
+
+    // Once applied, there is room again.
+    ApplyStagedUpdates();
+    NL_TEST_ASSERT(inSuite, CountEvents(Event::kWrite) == kBatchSize);
+    NL_TEST_ASSERT(inSuite, CountEvents(Event::kReport) == 1);
+    NL_TEST_ASSERT(inSuite, gBatcher.StageUpdate(kPathB, ZCL_INT8U_ATTRIBUTE_TYPE, static_cast<uint8_t>(0)) == CHIP_NO_ERROR);
+
+    ApplyStagedUpdates();
+    NL_TEST_ASSERT(inSuite, CountEvents(Event::kWrite) == 1);
+}
+
+void TestInstance(nlTestSuite * inSuite, void * inContext)
+{
+    AttributeUpdateBatcher * instance = AttributeUpdateBatcher::Instance();
+    NL_TEST_ASSERT(inSuite, instance != nullptr);
+    NL_TEST_ASSERT(inSuite, AttributeUpdateBatcher::Instance() == instance);
+}
+
+int TestSetup(void * inContext)
+{
+    VerifyOrReturnError(chip::Platform::MemoryInit() == CHIP_NO_ERROR, FAILURE);
+    VerifyOrReturnError(PlatformMgr().InitChipStack() == CHIP_NO_ERROR, FAILURE);
+    return SUCCESS;
+}
+
+int TestTeardown(void * inContext)
+{
+    PlatformMgr().Shutdown();
+    chip::Platform::MemoryShutdown();
+    return SUCCESS;
+}
+
+} // namespace
+
+// Stand-ins for the attribute store and the reporting engine, which record what the batcher asked of them.
+EmberAfStatus emAfWriteAttribute(EndpointId endpoint, ClusterId cluster, AttributeId attributeID, uint8_t * data,
+                                 EmberAfAttributeType dataType, bool overrideReadOnlyAndDataType, bool justTest, bool markDirty,
+                                 bool * stored)
+{
+    ConcreteAttributePath path(endpoint, cluster, attributeID);
+    gEvents.push_back({ Event::kWrite, path, data[0] });
+    *stored = (path != kFailingPath && path != kIgnoredPath);
+    return (path == kFailingPath) ? EMBER_ZCL_STATUS_UNSUPPORTED_ENDPOINT : EMBER_ZCL_STATUS_SUCCESS;
+}
+
+void MatterReportingAttributeChangeCallback(const ConcreteAttributePath & aPath)
+{
+    gEvents.push_back({ Event::kReport, aPath, 0 });
+}
+
+int TestAttributeUpdateBatcher()
+{
+    static nlTest sTests[] = {
+        NL_TEST_DEF("TestCoalescing", TestCoalescing),
+        NL_TEST_DEF("TestApplyOrdering", TestApplyOrdering),
+        NL_TEST_DEF("TestIgnoredWrite", TestIgnoredWrite),
+        NL_TEST_DEF("TestOverflow", TestOverflow),
+        NL_TEST_DEF("TestInstance", TestInstance),
+        NL_TEST_SENTINEL(),
+    };
+
+    nlTestSuite theSuite = {
+        "AttributeUpdateBatcher",
+        &sTests[0],
+        TestSetup,
+        TestTeardown,
+    };
+    nlTestRunner(&theSuite, nullptr);
+    return (nlTestRunnerStats(&theSuite));
+}
+
+CHIP_REGISTER_TEST_SUITE(TestAttributeUpdateBatcher)
@@ -29,7 +29,9 @@
 #include <app/data-model/DecodableList.h>
 #include <app/data-model/Decode.h>
 #include <app/tests/AppTestContext.h>
+#include <lib/support/DefaultStorageKeyAllocator.h>
 #include <lib/support/ScopedBuffer.h>
+#include <lib/support/TestPersistentStorageDelegate.h>
 #include <lib/support/UnitTestContext.h>
 #include <lib/support/UnitTestRegistration.h>
 #include <nlunit-test.h>
@@ -684,10 +686,135 @@ void TestCache(nlTestSuite * apSuite, void * apContext)
                              AttributeInstruction(AttributeInstruction::kAttributeB, 0, AttributeInstruction::kData) });
 }
 
+// Encodes the DataVersionFilters the cache would send for a wildcard subscription.
+uint32_t EncodeWildcardFilters(ClusterStateCache & cache, uint8_t * buf, uint32_t bufSize, bool & encodedDataVersionList)
+{
+    AttributePathParams wildcardPath;
+    const Span<AttributePathParams> pathSpan(&wildcardPath, 1);
+
+    TLV::TLVWriter writer;
+    writer.Init(buf, bufSize);
+    DataVersionFilterIBs::Builder builder;
+    NL_TEST_ASSERT(gSuite, builder.Init(&writer) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(gSuite,
+                   cache.GetBufferedCallback().OnUpdateDataVersionFilterList(builder, pathSpan, encodedDataVersionList) ==
+                       CHIP_NO_ERROR);
+    return writer.GetLengthWritten();
+}
+
+/*
+ * This validates that a snapshot restores attribute data, statuses, data versions and the highest received event number, so
+ * a new cache asks for exactly the same DataVersionFilters as the one it was saved from.
+ */
+void TestSnapshot(nlTestSuite * apSuite, void * apContext)
+{
+    AttributeInstructionListType list = {
+        AttributeInstruction(AttributeInstruction::kAttributeA, 0, AttributeInstruction::kData),
+        AttributeInstruction(AttributeInstruction::kAttributeD, 0, AttributeInstruction::kData),
+        AttributeInstruction(AttributeInstruction::kAttributeB, 1, AttributeInstruction::kData),
+        AttributeInstruction(AttributeInstruction::kAttributeC, 1, AttributeInstruction::kStatus),
+    };
+    const ScopedNodeId node(0x1234, 1);
+    const ScopedNodeId otherNode(0x5678, 1);
+    TestPersistentStorageDelegate storage;
+
+    uint8_t savedFilters[200];
+    bool savedEncodedDataVersionList = false;
+    uint32_t savedFiltersLength      = 0;
+
+    {
+        ForwardedDataCallbackValidator dataCallbackValidator;
+        CacheValidator client(list, dataCallbackValidator);
+        ClusterStateCache cache(client);
+
+        // Claim a wildcard path before the report, so that data versions get committed.
+        EncodeWildcardFilters(cache, savedFilters, sizeof(savedFilters), savedEncodedDataVersionList);
+        DataSeriesGenerator generator(&cache.GetBufferedCallback(), list);
+        generator.Generate(dataCallbackValidator);
+        cache.SetHighestReceivedEventNumber(42);
+
+        savedFiltersLength = EncodeWildcardFilters(cache, savedFilters, sizeof(savedFilters), savedEncodedDataVersionList);
+        NL_TEST_ASSERT(apSuite, savedEncodedDataVersionList);
+
+        NL_TEST_ASSERT(apSuite, cache.SaveSnapshot(storage, node) == CHIP_NO_ERROR);
+    }
+
+    ForwardedDataCallbackValidator dataCallbackValidator;
+    CacheValidator client(list, dataCallbackValidator);
+    ClusterStateCache cache(client);
+
+    NL_TEST_ASSERT(apSuite, cache.LoadSnapshot(storage, otherNode) == CHIP_ERROR_PERSISTED_STORAGE_VALUE_NOT_FOUND);
+    NL_TEST_ASSERT(apSuite, cache.LoadSnapshot(storage, node) == CHIP_NO_ERROR);
+
+    // Attribute data and statuses are back.
+    Clusters::UnitTesting::Attributes::Int16u::TypeInfo::DecodableType int16u = 0;
+    NL_TEST_ASSERT(apSuite,
+                   cache.Get<Clusters::UnitTesting::Attributes::Int16u::TypeInfo>(
+                       ConcreteAttributePath(0, Clusters::UnitTesting::Id, Clusters::UnitTesting::Attributes::Int16u::Id),
+                       int16u) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(apSuite, int16u == list[0].mInstructionId);
+
+    Clusters::UnitTesting::Attributes::ListStructOctetString::TypeInfo::DecodableType listValue;
+    NL_TEST_ASSERT(apSuite,
+                   cache.Get<Clusters::UnitTesting::Attributes::ListStructOctetString::TypeInfo>(
+                       ConcreteAttributePath(0, Clusters::UnitTesting::Id,
+                                             Clusters::UnitTesting::Attributes::ListStructOctetString::Id),
+                       listValue) == CHIP_NO_ERROR);
+    size_t listSize = 0;
+    NL_TEST_ASSERT(apSuite, listValue.ComputeSize(&listSize) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(apSuite, listSize == 200);
+
+    StatusIB status;
+    NL_TEST_ASSERT(apSuite,
+                   cache.GetStatus(ConcreteAttributePath(1, Clusters::UnitTesting::Id,
+                                                         Clusters::UnitTesting::Attributes::StructAttr::Id),
+                                   status) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(apSuite, status.mStatus == Protocols::InteractionModel::Status::Failure);
+
+    // So are the data versions and the event number, and with them the filters sent when resubscribing.
+    Optional<DataVersion> version;
+    NL_TEST_ASSERT(apSuite, cache.GetVersion(ConcreteClusterPath(0, Clusters::UnitTesting::Id), version) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(apSuite, version.HasValue() && version.Value() == 1);
+
+    Optional<EventNumber> eventNumber;
+    NL_TEST_ASSERT(apSuite, cache.GetHighestReceivedEventNumber(eventNumber) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(apSuite, eventNumber.HasValue() && eventNumber.Value() == 42);
+
+    uint8_t restoredFilters[200];
+    bool restoredEncodedDataVersionList = false;
+    uint32_t restoredFiltersLength =
+        EncodeWildcardFilters(cache, restoredFilters, sizeof(restoredFilters), restoredEncodedDataVersionList);
+    NL_TEST_ASSERT(apSuite, restoredEncodedDataVersionList);
+    NL_TEST_ASSERT(apSuite, restoredFiltersLength == savedFiltersLength);
+    NL_TEST_ASSERT(apSuite, memcmp(restoredFilters, savedFilters, savedFiltersLength) == 0);
+
+    // A snapshot that cannot be parsed leaves the cache as it was.
+    const uint8_t garbage[] = { 0x15, 0x24, 0x00, 0x01, 0x36, 0x02, 0x15, 0x24, 0x00 };
+    NL_TEST_ASSERT(apSuite,
+                   storage.SyncSetKeyValue(
+                       DefaultStorageKeyAllocator::ClusterStateCacheSnapshot(node.GetFabricIndex(), node.GetNodeId()).KeyName(),
+                       garbage, sizeof(garbage)) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(apSuite, cache.LoadSnapshot(storage, node) != CHIP_NO_ERROR);
+    NL_TEST_ASSERT(apSuite, cache.GetVersion(ConcreteClusterPath(0, Clusters::UnitTesting::Id), version) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(apSuite, version.HasValue() && version.Value() == 1);
+
+    // A snapshot from a newer format is rejected.
+    const uint8_t newerFormat[] = { 0x15, 0x24, 0x00, 0x02, 0x18 };
+    NL_TEST_ASSERT(apSuite,
+                   storage.SyncSetKeyValue(
+                       DefaultStorageKeyAllocator::ClusterStateCacheSnapshot(node.GetFabricIndex(), node.GetNodeId()).KeyName(),
+                       newerFormat, sizeof(newerFormat)) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(apSuite, cache.LoadSnapshot(storage, node) == CHIP_ERROR_VERSION_MISMATCH);
+
+    NL_TEST_ASSERT(apSuite, ClusterStateCache::DeleteSnapshot(storage, node) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(apSuite, storage.GetNumKeys() == 0);
+}
+
 // clang-format off
 const nlTest sTests[] =
 {
     NL_TEST_DEF("TestCache", TestCache),
+    NL_TEST_DEF("TestSnapshot", TestSnapshot),
     NL_TEST_SENTINEL()
 };
 
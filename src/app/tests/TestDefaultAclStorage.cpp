@@ -0,0 +1,363 @@
+/*
+ *
+ *    Copyright (c) 2023 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#include <access/AccessControl.h>
+#include <access/examples/ExampleAccessControlDelegate.h>
+#include <app/server/DefaultAclStorage.h>
+#include <lib/core/TLV.h>
+#include <lib/support/DefaultStorageKeyAllocator.h>
+#include <lib/support/TestPersistentStorageDelegate.h>
+#include <lib/support/UnitTestContext.h>
+#include <lib/support/UnitTestRegistration.h>
+#include <messaging/tests/MessagingContext.h>
+
+#include <nlunit-test.h>
+
+#include <cstdint>
+#include <string>
+
+using namespace chip;
+using namespace chip::Access;
+using namespace chip::app;
+
+using Entry       = AccessControl::Entry;
+using TestContext = Test::LoopbackMessagingContext;
+
+namespace {
+
+class TestDeviceTypeResolver : public AccessControl::DeviceTypeResolver
+{
+public:
+    bool IsDeviceTypeOnEndpoint(DeviceTypeId deviceType, EndpointId endpoint) override { return false; }
+} gDeviceTypeResolver;
+
+// Storage that can fail deleting one key, to interrupt a migration, and that can behave like a backend without
+// transaction support, which applies every change directly.
+class TestStorage : public TestPersistentStorageDelegate
+{
+public:
+    CHIP_ERROR SyncSetKeyValue(const char * key, const void * value, uint16_t size) override
+    {
+        mWriteCount++;
+        return TestPersistentStorageDelegate::SyncSetKeyValue(key, value, size);
+    }
+
+    CHIP_ERROR SyncDeleteKeyValue(const char * key) override
+    {
+        VerifyOrReturnError(mFailingDeleteKey != key, CHIP_ERROR_PERSISTED_STORAGE_FAILED);
+        return TestPersistentStorageDelegate::SyncDeleteKeyValue(key);
+    }
+
+    CHIP_ERROR BeginTransaction() override
+    {
+        return mSupportsTransactions ? TestPersistentStorageDelegate::BeginTransaction() : CHIP_NO_ERROR;
+    }
+
+    CHIP_ERROR CommitTransaction() override
+    {
+        return mSupportsTransactions ? TestPersistentStorageDelegate::CommitTransaction() : CHIP_NO_ERROR;
+    }
+
+    void AbortTransaction() override
+    {
+        if (mSupportsTransactions)
+        {
+            TestPersistentStorageDelegate::AbortTransaction();
+        }
+    }
+
+    bool HasAclRecord(FabricIndex fabric) { return HasKey(DefaultStorageKeyAllocator::AccessControlAclList(fabric).KeyName()); }
+
+    bool HasLegacyEntry(FabricIndex fabric, size_t index)
+    {
+        return HasKey(DefaultStorageKeyAllocator::AccessControlAclEntry(fabric, index).KeyName());
+    }
+
+    std::string mFailingDeleteKey;
+    bool mSupportsTransactions = true;
+    size_t mWriteCount         = 0;
+};
+
+// AccessControl with the example delegate, loaded from storage by DefaultAclStorage as when the device boots.
+class Device
+{
+public:
+    Device()
+    {
+        SetAccessControl(mAccessControl);
+        mInitError = mAccessControl.Init(Examples::GetAccessControlDelegate(), gDeviceTypeResolver);
+    }
+
+    ~Device()
+    {
+        mAccessControl.Finish();
+        ResetAccessControlToDefault();
+    }
+
+    CHIP_ERROR Boot(TestContext & ctx, PersistentStorageDelegate & storage)
+    {
+        ReturnErrorOnFailure(mInitError);
+        return mAclStorage.Init(storage, ctx.GetFabricTable().begin(), ctx.GetFabricTable().end());
+    }
+
+    CHIP_ERROR AddEntry(FabricIndex fabric, NodeId subject)
+    {
+        Entry entry;
+        ReturnErrorOnFailure(MakeEntry(fabric, subject, entry));
+        return mAccessControl.CreateEntry(nullptr, fabric, nullptr, entry);
+    }
+
+    // Stores an entry the way the older one-key-per-entry layout did.
+    CHIP_ERROR StoreLegacyEntry(PersistentStorageDelegate & storage, FabricIndex fabric, size_t index, NodeId subject)
+    {
+        Entry entry;
+        ReturnErrorOnFailure(MakeEntry(fabric, subject, entry));
+
+        uint8_t buffer[256];
+        TLV::TLVWriter writer;
+        writer.Init(buffer, sizeof(buffer));
+        AclStorage::EncodableEntry encodableEntry(entry);
+        ReturnErrorOnFailure(encodableEntry.EncodeForWrite(writer, TLV::AnonymousTag()));
+        ReturnErrorOnFailure(writer.Finalize());
+
+        return storage.SyncSetKeyValue(DefaultStorageKeyAllocator::AccessControlAclEntry(fabric, index).KeyName(), buffer,
+                                       static_cast<uint16_t>(writer.GetLengthWritten()));
+    }
+
+    size_t EntryCount(FabricIndex fabric)
+    {
+        size_t count = 0;
+        return (mAccessControl.GetEntryCount(fabric, count) == CHIP_NO_ERROR) ? count : SIZE_MAX;
+    }
+
+    NodeId Subject(FabricIndex fabric, size_t index)
+    {
+        Entry entry;
+        NodeId subject = kUndefinedNodeId;
+        if (mAccessControl.ReadEntry(fabric, index, entry) != CHIP_NO_ERROR || entry.GetSubject(0, subject) != CHIP_NO_ERROR)
+        {
+            return kUndefinedNodeId;
+        }
+        return subject;
+    }
+
+    AccessControl mAccessControl;
+    DefaultAclStorage mAclStorage;
+
+private:
+    CHIP_ERROR MakeEntry(FabricIndex fabric, NodeId subject, Entry & entry)
+    {
+        ReturnErrorOnFailure(mAccessControl.PrepareEntry(entry));
+        ReturnErrorOnFailure(entry.SetFabricIndex(fabric));
+        ReturnErrorOnFailure(entry.SetPrivilege(Privilege::kAdminister));
+        ReturnErrorOnFailure(entry.SetAuthMode(AuthMode::kCase));
+        return entry.AddSubject(nullptr, subject);
+    }
+
+    CHIP_ERROR mInitError;
+};
+
+constexpr NodeId kSubjects[] = { 0x1111, 0x2222, 0x3333 };
+
+void StoreLegacyEntries(nlTestSuite * inSuite, TestStorage & storage, FabricIndex fabric)
+{
+    Device device;
+    for (size_t index = 0; index < ArraySize(kSubjects); index++)
+    {
+        NL_TEST_ASSERT(inSuite, device.StoreLegacyEntry(storage, fabric, index, kSubjects[index]) == CHIP_NO_ERROR);
+    }
+}
+
+void CheckMigrated(nlTestSuite * inSuite, TestContext & ctx, TestStorage & storage, FabricIndex fabric)
+{
+    Device device;
+    NL_TEST_ASSERT(inSuite, device.Boot(ctx, storage) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, device.EntryCount(fabric) == ArraySize(kSubjects));
+    for (size_t index = 0; index < ArraySize(kSubjects); index++)
+    {
+        NL_TEST_ASSERT(inSuite, device.Subject(fabric, index) == kSubjects[index]);
+        NL_TEST_ASSERT(inSuite, !storage.HasLegacyEntry(fabric, index));
+    }
+    NL_TEST_ASSERT(inSuite, storage.HasAclRecord(fabric));
+}
+
+void TestMigrateLegacyEntries(nlTestSuite * inSuite, void * inContext)
+{
+    TestContext & ctx        = *static_cast<TestContext *>(inContext);
+    const FabricIndex fabric = ctx.GetAliceFabricIndex();
+    TestStorage storage;
+
+    StoreLegacyEntries(inSuite, storage, fabric);
+
+    // Migrated at the first boot, then loaded from the record.
+    CheckMigrated(inSuite, ctx, storage, fabric);
+    CheckMigrated(inSuite, ctx, storage, fabric);
+
+    // A fabric without entries in either layout loads nothing.
+    Device device;
+    NL_TEST_ASSERT(inSuite, device.Boot(ctx, storage) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, device.EntryCount(ctx.GetBobFabricIndex()) == 0);
+}
+
+void TestEmptyFabricKeepsRecord(nlTestSuite * inSuite, void * inContext)
+{
+    TestContext & ctx        = *static_cast<TestContext *>(inContext);
+    const FabricIndex fabric = ctx.GetAliceFabricIndex();
+    TestStorage storage;
+
+    {
+        Device device;
+        NL_TEST_ASSERT(inSuite, device.Boot(ctx, storage) == CHIP_NO_ERROR);
+        NL_TEST_ASSERT(inSuite, device.AddEntry(fabric, kSubjects[0]) == CHIP_NO_ERROR);
+        NL_TEST_ASSERT(inSuite, device.mAccessControl.DeleteEntry(nullptr, fabric, 0) == CHIP_NO_ERROR);
+        NL_TEST_ASSERT(inSuite, device.EntryCount(fabric) == 0);
+    }
+
+    // The empty fabric keeps its record, so entries in the older layout are never loaded again.
+    NL_TEST_ASSERT(inSuite, storage.HasAclRecord(fabric));
+    {
+        Device device;
+        NL_TEST_ASSERT(inSuite, device.StoreLegacyEntry(storage, fabric, 0, kSubjects[1]) == CHIP_NO_ERROR);
+    }
+
+    Device device;
+    NL_TEST_ASSERT(inSuite, device.Boot(ctx, storage) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, device.EntryCount(fabric) == 0);
+    NL_TEST_ASSERT(inSuite, !storage.HasLegacyEntry(fabric, 0));
+}
+
+void CheckInterruptedMigration(nlTestSuite * inSuite, TestContext & ctx, bool supportsTransactions)
+{
+    const FabricIndex fabric = ctx.GetAliceFabricIndex();
+    TestStorage storage;
+    storage.mSupportsTransactions = supportsTransactions;
+
+    StoreLegacyEntries(inSuite, storage, fabric);
+
+    // Power is lost while the old keys are being deleted.
+    storage.mFailingDeleteKey = DefaultStorageKeyAllocator::AccessControlAclEntry(fabric, 1).KeyName();
+    {
+        Device device;
+        NL_TEST_ASSERT(inSuite, device.Boot(ctx, storage) != CHIP_NO_ERROR);
+    }
+
+    if (supportsTransactions)
+    {
+        // Nothing of the migration was kept.
+        NL_TEST_ASSERT(inSuite, !storage.HasAclRecord(fabric));
+        for (size_t index = 0; index < ArraySize(kSubjects); index++)
+        {
+            NL_TEST_ASSERT(inSuite, storage.HasLegacyEntry(fabric, index));
+        }
+    }
+    else
+    {
+        // The record was written first; old keys are deleted from the last one down.
+        NL_TEST_ASSERT(inSuite, storage.HasAclRecord(fabric));
+        NL_TEST_ASSERT(inSuite, storage.HasLegacyEntry(fabric, 0));
+        NL_TEST_ASSERT(inSuite, storage.HasLegacyEntry(fabric, 1));
+        NL_TEST_ASSERT(inSuite, !storage.HasLegacyEntry(fabric, 2));
+    }
+
+    // The next boot completes the migration either way.
+    storage.mFailingDeleteKey.clear();
+    CheckMigrated(inSuite, ctx, storage, fabric);
+
+    // Entries deleted afterwards stay deleted.
+    {
+        Device device;
+        NL_TEST_ASSERT(inSuite, device.Boot(ctx, storage) == CHIP_NO_ERROR);
+        NL_TEST_ASSERT(inSuite, device.mAccessControl.DeleteAllEntriesForFabric(fabric) == CHIP_NO_ERROR);
+    }
+    Device device;
+    NL_TEST_ASSERT(inSuite, device.Boot(ctx, storage) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, device.EntryCount(fabric) == 0);
+}
+
+void TestInterruptedMigration(nlTestSuite * inSuite, void * inContext)
+{
+    TestContext & ctx = *static_cast<TestContext *>(inContext);
+    CheckInterruptedMigration(inSuite, ctx, /* supportsTransactions = */ true);
+    CheckInterruptedMigration(inSuite, ctx, /* supportsTransactions = */ false);
+}
+
+void TestBatch(nlTestSuite * inSuite, void * inContext)
+{
+    TestContext & ctx       = *static_cast<TestContext *>(inContext);
+    const FabricIndex alice = ctx.GetAliceFabricIndex();
+    const FabricIndex bob   = ctx.GetBobFabricIndex();
+    TestStorage storage;
+
+    {
+        Device device;
+        NL_TEST_ASSERT(inSuite, device.Boot(ctx, storage) == CHIP_NO_ERROR);
+
+        // Outside a batch, every change is stored.
+        storage.mWriteCount = 0;
+        NL_TEST_ASSERT(inSuite, device.AddEntry(alice, kSubjects[0]) == CHIP_NO_ERROR);
+        NL_TEST_ASSERT(inSuite, storage.mWriteCount == 1);
+
+        // As for an ACL attribute write: changed fabrics are stored once, when the outermost batch ends.
+        storage.mWriteCount = 0;
+        device.mAclStorage.BeginBatch();
+        NL_TEST_ASSERT(inSuite, device.AddEntry(alice, kSubjects[1]) == CHIP_NO_ERROR);
+        NL_TEST_ASSERT(inSuite, device.AddEntry(alice, kSubjects[2]) == CHIP_NO_ERROR);
+        device.mAclStorage.BeginBatch();
+        NL_TEST_ASSERT(inSuite, device.mAccessControl.DeleteEntry(nullptr, alice, 0) == CHIP_NO_ERROR);
+        NL_TEST_ASSERT(inSuite, device.AddEntry(bob, kSubjects[0]) == CHIP_NO_ERROR);
+        device.mAclStorage.EndBatch();
+        NL_TEST_ASSERT(inSuite, storage.mWriteCount == 0);
+        device.mAclStorage.EndBatch();
+        NL_TEST_ASSERT(inSuite, storage.mWriteCount == 2);
+
+        // Unbalanced ends are ignored.
+        device.mAclStorage.EndBatch();
+        NL_TEST_ASSERT(inSuite, device.AddEntry(bob, kSubjects[1]) == CHIP_NO_ERROR);
+        NL_TEST_ASSERT(inSuite, storage.mWriteCount == 3);
+    }
+
+    Device device;
+    NL_TEST_ASSERT(inSuite, device.Boot(ctx, storage) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, device.EntryCount(alice) == 2);
+    NL_TEST_ASSERT(inSuite, device.Subject(alice, 0) == kSubjects[1]);
+    NL_TEST_ASSERT(inSuite, device.Subject(alice, 1) == kSubjects[2]);
+    NL_TEST_ASSERT(inSuite, device.EntryCount(bob) == 2);
+}
+
+const nlTest sTests[] = {
+    NL_TEST_DEF("TestMigrateLegacyEntries", TestMigrateLegacyEntries),
+    NL_TEST_DEF("TestEmptyFabricKeepsRecord", TestEmptyFabricKeepsRecord),
+    NL_TEST_DEF("TestInterruptedMigration", TestInterruptedMigration),
+    NL_TEST_DEF("TestBatch", TestBatch),
+    NL_TEST_SENTINEL(),
+};
+
+nlTestSuite sSuite = {
+    "TestDefaultAclStorage",
+    &sTests[0],
+    TestContext::Initialize,
+    TestContext::Finalize,
+};
+
+} // namespace
+
+int TestDefaultAclStorage()
+{
+    return chip::ExecuteTestsWithContext<TestContext>(&sSuite);
+}
+
+CHIP_REGISTER_TEST_SUITE(TestDefaultAclStorage)
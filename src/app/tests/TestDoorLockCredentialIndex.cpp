@@ -0,0 +1,287 @@
+/*
+ *
+ *    Copyright (c) 2023 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#include <app/clusters/door-lock-server/door-lock-credential-index.h>
+#include <lib/support/CHIPMem.h>
+#include <lib/support/UnitTestRegistration.h>
+#include <lib/support/logging/CHIPLogging.h>
+
+#include <nlunit-test.h>
+
+#include <chrono>
+#include <stdio.h>
+
+using namespace chip;
+using CredentialTypeEnum = chip::app::Clusters::DoorLock::CredentialTypeEnum;
+using CredentialStruct   = DoorLockCredentialIndex::CredentialStruct;
+
+namespace {
+
+ByteSpan Pin(const char * pin)
+{
+    return ByteSpan(reinterpret_cast<const uint8_t *>(pin), strlen(pin));
+}
+
+// Returns the single user owning a credential of the given type with the given data, or 0.
+uint16_t FindUserByData(const DoorLockCredentialIndex & index, CredentialTypeEnum type, const ByteSpan & data,
+                        uint16_t & credentialIndex)
+{
+    uint16_t found = 0;
+    index.ForEachDataCandidate(type, data, [&](uint16_t candidateCredentialIndex, uint16_t candidateUserIndex) {
+        credentialIndex = candidateCredentialIndex;
+        found           = candidateUserIndex;
+        return Loop::Break;
+    });
+    return found;
+}
+
+void TestUserLookup(nlTestSuite * inSuite, void * inContext)
+{
+    DoorLockCredentialIndex index;
+    uint16_t userIndex = 0;
+
+    const CredentialStruct user1[] = { { CredentialTypeEnum::kPin, 1 }, { CredentialTypeEnum::kRfid, 1 } };
+    const CredentialStruct user2[] = { { CredentialTypeEnum::kPin, 2 } };
+
+    // The server sets the user's credential list before the credential data
+    NL_TEST_ASSERT(inSuite, CHIP_NO_ERROR == index.SetUserCredentials(1, user1, 2));
+    NL_TEST_ASSERT(inSuite, CHIP_NO_ERROR == index.SetCredentialData(CredentialTypeEnum::kPin, 1, Pin("123456")));
+    NL_TEST_ASSERT(inSuite, CHIP_NO_ERROR == index.SetCredentialData(CredentialTypeEnum::kRfid, 1, Pin("\x01\x02\x03\x04")));
+    NL_TEST_ASSERT(inSuite, CHIP_NO_ERROR == index.SetUserCredentials(2, user2, 1));
+    NL_TEST_ASSERT(inSuite, CHIP_NO_ERROR == index.SetCredentialData(CredentialTypeEnum::kPin, 2, Pin("654321")));
+    NL_TEST_ASSERT(inSuite, index.Count() == 3);
+
+    NL_TEST_ASSERT(inSuite, index.FindUser(CredentialTypeEnum::kPin, 1, userIndex) && userIndex == 1);
+    NL_TEST_ASSERT(inSuite, index.FindUser(CredentialTypeEnum::kRfid, 1, userIndex) && userIndex == 1);
+    NL_TEST_ASSERT(inSuite, index.FindUser(CredentialTypeEnum::kPin, 2, userIndex) && userIndex == 2);
+    NL_TEST_ASSERT(inSuite, !index.FindUser(CredentialTypeEnum::kRfid, 2, userIndex));
+    NL_TEST_ASSERT(inSuite, !index.FindUser(CredentialTypeEnum::kFingerprint, 1, userIndex));
+
+    // Removing a credential from the user's list keeps the occupied slot, but it no longer resolves to a user
+    NL_TEST_ASSERT(inSuite, CHIP_NO_ERROR == index.SetUserCredentials(1, user1, 1));
+    NL_TEST_ASSERT(inSuite, !index.FindUser(CredentialTypeEnum::kRfid, 1, userIndex));
+    NL_TEST_ASSERT(inSuite, index.Count() == 3);
+    index.ClearCredentialData(CredentialTypeEnum::kRfid, 1);
+    NL_TEST_ASSERT(inSuite, index.Count() == 2);
+
+    // Clearing a user the way the server does: credentials first, then the user itself
+    index.ClearCredentialData(CredentialTypeEnum::kPin, 1);
+    NL_TEST_ASSERT(inSuite, index.FindUser(CredentialTypeEnum::kPin, 1, userIndex) && userIndex == 1);
+    NL_TEST_ASSERT(inSuite, CHIP_NO_ERROR == index.SetUserCredentials(1, nullptr, 0));
+    NL_TEST_ASSERT(inSuite, !index.FindUser(CredentialTypeEnum::kPin, 1, userIndex));
+    NL_TEST_ASSERT(inSuite, index.Count() == 1);
+
+    index.Clear();
+    NL_TEST_ASSERT(inSuite, index.Count() == 0);
+    NL_TEST_ASSERT(inSuite, !index.FindUser(CredentialTypeEnum::kPin, 2, userIndex));
+}
+
+void TestDataLookup(nlTestSuite * inSuite, void * inContext)
+{
+    DoorLockCredentialIndex index;
+    uint16_t credentialIndex = 0;
+
+    const CredentialStruct user1[] = { { CredentialTypeEnum::kPin, 5 } };
+    const CredentialStruct user2[] = { { CredentialTypeEnum::kRfid, 5 } };
+
+    NL_TEST_ASSERT(inSuite, CHIP_NO_ERROR == index.SetUserCredentials(1, user1, 1));
+    NL_TEST_ASSERT(inSuite, CHIP_NO_ERROR == index.SetCredentialData(CredentialTypeEnum::kPin, 5, Pin("1234")));
+    NL_TEST_ASSERT(inSuite, CHIP_NO_ERROR == index.SetUserCredentials(2, user2, 1));
+    NL_TEST_ASSERT(inSuite, CHIP_NO_ERROR == index.SetCredentialData(CredentialTypeEnum::kRfid, 5, Pin("1234")));
+
+    // Same data under different types resolves by type
+    NL_TEST_ASSERT(inSuite, FindUserByData(index, CredentialTypeEnum::kPin, Pin("1234"), credentialIndex) == 1);
+    NL_TEST_ASSERT(inSuite, credentialIndex == 5);
+    NL_TEST_ASSERT(inSuite, FindUserByData(index, CredentialTypeEnum::kRfid, Pin("1234"), credentialIndex) == 2);
+    NL_TEST_ASSERT(inSuite, FindUserByData(index, CredentialTypeEnum::kPin, Pin("4321"), credentialIndex) == 0);
+
+    // Credentials that do not belong to a user are never reported
+    NL_TEST_ASSERT(inSuite, CHIP_NO_ERROR == index.SetCredentialData(CredentialTypeEnum::kPin, 6, Pin("7777")));
+    NL_TEST_ASSERT(inSuite, FindUserByData(index, CredentialTypeEnum::kPin, Pin("7777"), credentialIndex) == 0);
+
+    // Modifying the data replaces the old hash
+    NL_TEST_ASSERT(inSuite, CHIP_NO_ERROR == index.SetCredentialData(CredentialTypeEnum::kPin, 5, Pin("9999")));
+    NL_TEST_ASSERT(inSuite, FindUserByData(index, CredentialTypeEnum::kPin, Pin("1234"), credentialIndex) == 0);
+    NL_TEST_ASSERT(inSuite, FindUserByData(index, CredentialTypeEnum::kPin, Pin("9999"), credentialIndex) == 1);
+
+    index.ClearCredentialData(CredentialTypeEnum::kPin, 5);
+    NL_TEST_ASSERT(inSuite, FindUserByData(index, CredentialTypeEnum::kPin, Pin("9999"), credentialIndex) == 0);
+}
+
+// A users/credentials database laid out the way lock applications typically keep it: one record per user with its
+// credential list, and one record per credential slot.
+struct MockDatabase
+{
+    static constexpr uint16_t kUsers = 5000;
+
+    struct Credential
+    {
+        char data[9];
+        bool occupied;
+    };
+    struct User
+    {
+        CredentialStruct credentials[2];
+        size_t credentialCount;
+    };
+
+    User users[kUsers + 1];
+    Credential pins[kUsers + 1];
+    Credential rfids[kUsers + 1];
+
+    void Populate()
+    {
+        for (uint16_t i = 1; i <= kUsers; ++i)
+        {
+            snprintf(pins[i].data, sizeof(pins[i].data), "%08u", static_cast<unsigned>(i) * 7919u);
+            snprintf(rfids[i].data, sizeof(rfids[i].data), "R%07u", static_cast<unsigned>(i));
+            pins[i].occupied  = true;
+            rfids[i].occupied = true;
+
+            users[i].credentials[0]  = { CredentialTypeEnum::kPin, i };
+            users[i].credentials[1]  = { CredentialTypeEnum::kRfid, i };
+            users[i].credentialCount = 2;
+        }
+    }
+
+    const Credential & Get(CredentialTypeEnum type, uint16_t index) const
+    {
+        return (type == CredentialTypeEnum::kPin) ? pins[index] : rfids[index];
+    }
+
+    // What the server does without the index: walk every user and compare each of its credentials.
+    uint16_t ScanForPin(const ByteSpan & pin) const
+    {
+        for (uint16_t i = 1; i <= kUsers; ++i)
+        {
+            for (size_t j = 0; j < users[i].credentialCount; ++j)
+            {
+                const auto & credential = users[i].credentials[j];
+                if (credential.credentialType == CredentialTypeEnum::kPin &&
+                    Pin(Get(credential.credentialType, credential.credentialIndex).data).data_equal(pin))
+                {
+                    return i;
+                }
+            }
+        }
+        return 0;
+    }
+
+    // What the server does with the index: check each candidate against the stored credential.
+    uint16_t LookupPin(const DoorLockCredentialIndex & index, const ByteSpan & pin) const
+    {
+        uint16_t found = 0;
+        index.ForEachDataCandidate(CredentialTypeEnum::kPin, pin, [&](uint16_t credentialIndex, uint16_t userIndex) {
+            if (!Pin(pins[credentialIndex].data).data_equal(pin))
+            {
+                return Loop::Continue;
+            }
+            found = userIndex;
+            return Loop::Break;
+        });
+        return found;
+    }
+};
+
+void TestLookupLatency(nlTestSuite * inSuite, void * inContext)
+{
+    constexpr uint16_t kLookups = 2000;
+
+    static MockDatabase db;
+    db.Populate();
+
+    DoorLockCredentialIndex index;
+    auto start = std::chrono::steady_clock::now();
+    for (uint16_t i = 1; i <= MockDatabase::kUsers; ++i)
+    {
+        NL_TEST_ASSERT(inSuite, CHIP_NO_ERROR == index.SetCredentialData(CredentialTypeEnum::kPin, i, Pin(db.pins[i].data)));
+        NL_TEST_ASSERT(inSuite, CHIP_NO_ERROR == index.SetCredentialData(CredentialTypeEnum::kRfid, i, Pin(db.rfids[i].data)));
+        NL_TEST_ASSERT(inSuite, CHIP_NO_ERROR == index.SetUserCredentials(i, db.users[i].credentials, 2));
+    }
+    index.MarkBuilt();
+    auto buildUs = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count();
+    NL_TEST_ASSERT(inSuite, index.Count() == 2u * MockDatabase::kUsers);
+
+    // Every other lookup is a PIN nobody has, which is the worst case for the scan.
+    bool scanCorrect  = true;
+    bool indexCorrect = true;
+    char unknown[9];
+
+    start = std::chrono::steady_clock::now();
+    for (uint16_t i = 1; i <= kLookups; ++i)
+    {
+        const uint16_t user = static_cast<uint16_t>((i * 37u) % MockDatabase::kUsers + 1);
+        snprintf(unknown, sizeof(unknown), "x%07u", static_cast<unsigned>(i));
+        scanCorrect = scanCorrect && db.ScanForPin(Pin(db.pins[user].data)) == user && db.ScanForPin(Pin(unknown)) == 0;
+    }
+    auto scanUs = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count();
+
+    start = std::chrono::steady_clock::now();
+    for (uint16_t i = 1; i <= kLookups; ++i)
+    {
+        const uint16_t user = static_cast<uint16_t>((i * 37u) % MockDatabase::kUsers + 1);
+        snprintf(unknown, sizeof(unknown), "x%07u", static_cast<unsigned>(i));
+        indexCorrect =
+            indexCorrect && db.LookupPin(index, Pin(db.pins[user].data)) == user && db.LookupPin(index, Pin(unknown)) == 0;
+    }
+    auto indexUs = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count();
+
+    NL_TEST_ASSERT(inSuite, scanCorrect);
+    NL_TEST_ASSERT(inSuite, indexCorrect);
+
+    // Lookups by slot must agree with the database as well
+    uint16_t userIndex = 0;
+    NL_TEST_ASSERT(inSuite, index.FindUser(CredentialTypeEnum::kRfid, MockDatabase::kUsers, userIndex));
+    NL_TEST_ASSERT(inSuite, userIndex == MockDatabase::kUsers);
+
+    ChipLogProgress(Zcl, "Door lock credential lookup, %u users: index built in %ld us; %u PIN checks: scan %ld us, index %ld us",
+                    static_cast<unsigned>(MockDatabase::kUsers), static_cast<long>(buildUs), static_cast<unsigned>(2 * kLookups),
+                    static_cast<long>(scanUs), static_cast<long>(indexUs));
+}
+
+int TestSetup(void * inContext)
+{
+    return CHIP_NO_ERROR == chip::Platform::MemoryInit() ? SUCCESS : FAILURE;
+}
+
+int TestTeardown(void * inContext)
+{
+    chip::Platform::MemoryShutdown();
+    return SUCCESS;
+}
+
+} // namespace
+
+/**
+ *   Test Suite. It lists all the test functions.
+ */
+static const nlTest sTests[] = {
+    NL_TEST_DEF("TestUserLookup", TestUserLookup),
+    NL_TEST_DEF("TestDataLookup", TestDataLookup),
+    NL_TEST_DEF("TestLookupLatency", TestLookupLatency),
+    NL_TEST_SENTINEL(),
+};
+
+int TestDoorLockCredentialIndex()
+{
+    nlTestSuite theSuite = { "DoorLockCredentialIndex", &sTests[0], TestSetup, TestTeardown };
+
+    nlTestRunner(&theSuite, nullptr);
+    return (nlTestRunnerStats(&theSuite));
+}
+
+CHIP_REGISTER_TEST_SUITE(TestDoorLockCredentialIndex)
@@ -0,0 +1,175 @@
+/*
+ *
+ *    Copyright (c) 2023 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#include <app/util/EndpointComposition.h>
+#include <lib/support/CHIPMem.h>
+#include <lib/support/UnitTestRegistration.h>
+
+#include <nlunit-test.h>
+
+#include <initializer_list>
+
+using namespace chip;
+using namespace chip::app;
+
+namespace {
+
+constexpr uint16_t kMaxEndpoints = 8;
+constexpr uint16_t kNoParent     = UINT16_MAX;
+
+using Composition = EndpointComposition<kMaxEndpoints>;
+
+bool PartsAre(Span<const EndpointId> parts, std::initializer_list<EndpointId> expected)
+{
+    if (parts.size() != expected.size())
+    {
+        return false;
+    }
+    size_t i = 0;
+    for (EndpointId endpoint : expected)
+    {
+        if (parts[i++] != endpoint)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+void TestChildrenAndDescendants(nlTestSuite * apSuite, void * apContext)
+{
+    // 0 +- 1 +- 2 --- 7
+    //   |   +- 3
+    //   +- 5
+    const EndpointId endpoints[] = { 0, 1, 2, 3, 7, 5 };
+    const uint16_t parentIndex[] = { kNoParent, 0, 1, 1, 2, 0 };
+    Composition composition;
+
+    NL_TEST_ASSERT(apSuite, !composition.IsValid());
+    NL_TEST_ASSERT(apSuite, composition.Build(6, endpoints, parentIndex) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(apSuite, composition.IsValid());
+
+    // Tree composition lists the direct children, flat composition everything below, both in endpoint index order.
+    NL_TEST_ASSERT(apSuite, PartsAre(composition.Children(0), { 1, 5 }));
+    NL_TEST_ASSERT(apSuite, PartsAre(composition.Descendants(0), { 1, 2, 3, 7, 5 }));
+    NL_TEST_ASSERT(apSuite, PartsAre(composition.Children(1), { 2, 3 }));
+    NL_TEST_ASSERT(apSuite, PartsAre(composition.Descendants(1), { 2, 3, 7 }));
+    NL_TEST_ASSERT(apSuite, PartsAre(composition.Children(2), { 7 }));
+    NL_TEST_ASSERT(apSuite, PartsAre(composition.Descendants(2), { 7 }));
+
+    // Leaves, and indices past the built endpoints, have no parts.
+    NL_TEST_ASSERT(apSuite, composition.Children(4).empty());
+    NL_TEST_ASSERT(apSuite, composition.Descendants(4).empty());
+    NL_TEST_ASSERT(apSuite, composition.Descendants(6).empty());
+}
+
+void TestUnlistedEndpoints(nlTestSuite * apSuite, void * apContext)
+{
+    // Endpoint 2 is disabled, so it has no parent, and neither has endpoint 3 below it.
+    const EndpointId endpoints[] = { 0, 1, 2, 3 };
+    const uint16_t parentIndex[] = { kNoParent, 0, kNoParent, kNoParent };
+    Composition composition;
+
+    NL_TEST_ASSERT(apSuite, composition.Build(4, endpoints, parentIndex) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(apSuite, PartsAre(composition.Descendants(0), { 1 }));
+    NL_TEST_ASSERT(apSuite, composition.Children(2).empty());
+
+    // A parent index past the endpoint count is not followed either.
+    const uint16_t staleParentIndex[] = { kNoParent, 0, 0, 4 };
+    NL_TEST_ASSERT(apSuite, composition.Build(4, endpoints, staleParentIndex) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(apSuite, PartsAre(composition.Descendants(0), { 1, 2 }));
+}
+
+void TestRebuild(nlTestSuite * apSuite, void * apContext)
+{
+    const EndpointId endpoints[] = { 0, 1, 2 };
+    const uint16_t flat[]        = { kNoParent, 0, 1 };
+    Composition composition;
+
+    NL_TEST_ASSERT(apSuite, composition.Build(3, endpoints, flat) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(apSuite, PartsAre(composition.Descendants(0), { 1, 2 }));
+
+    // Nothing is listed between invalidating and rebuilding.
+    composition.Invalidate();
+    NL_TEST_ASSERT(apSuite, !composition.IsValid());
+    NL_TEST_ASSERT(apSuite, composition.Children(0).empty());
+    NL_TEST_ASSERT(apSuite, composition.Descendants(0).empty());
+
+    // Endpoint 2 moved under endpoint 0, then endpoint 2 removed.
+    const uint16_t moved[] = { kNoParent, 0, 0 };
+    NL_TEST_ASSERT(apSuite, composition.Build(3, endpoints, moved) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(apSuite, PartsAre(composition.Children(0), { 1, 2 }));
+    NL_TEST_ASSERT(apSuite, composition.Children(1).empty());
+
+    NL_TEST_ASSERT(apSuite, composition.Build(2, endpoints, moved) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(apSuite, PartsAre(composition.Descendants(0), { 1 }));
+    NL_TEST_ASSERT(apSuite, composition.Children(2).empty());
+
+    // No endpoints at all.
+    NL_TEST_ASSERT(apSuite, composition.Build(0, endpoints, moved) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(apSuite, composition.Descendants(0).empty());
+}
+
+void TestInvalidConfigurations(nlTestSuite * apSuite, void * apContext)
+{
+    // Endpoints 1 and 2 are each other's parent. The walk up from them stops rather than looping.
+    const EndpointId endpoints[] = { 0, 1, 2 };
+    const uint16_t cycle[]       = { kNoParent, 2, 1 };
+    Composition composition;
+
+    NL_TEST_ASSERT(apSuite, composition.Build(3, endpoints, cycle) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(apSuite, PartsAre(composition.Children(1), { 2 }));
+    NL_TEST_ASSERT(apSuite, composition.Descendants(0).empty());
+
+    NL_TEST_ASSERT(apSuite, composition.Build(kMaxEndpoints + 1, endpoints, cycle) == CHIP_ERROR_INVALID_ARGUMENT);
+    NL_TEST_ASSERT(apSuite, !composition.IsValid());
+}
+
+int TestSetup(void * inContext)
+{
+    return (chip::Platform::MemoryInit() == CHIP_NO_ERROR) ? SUCCESS : FAILURE;
+}
+
+int TestTeardown(void * inContext)
+{
+    chip::Platform::MemoryShutdown();
+    return SUCCESS;
+}
+
+} // namespace
+
+int TestEndpointComposition()
+{
+    static nlTest sTests[] = {
+        NL_TEST_DEF("TestChildrenAndDescendants", TestChildrenAndDescendants),
+        NL_TEST_DEF("TestUnlistedEndpoints", TestUnlistedEndpoints),
+        NL_TEST_DEF("TestRebuild", TestRebuild),
+        NL_TEST_DEF("TestInvalidConfigurations", TestInvalidConfigurations),
+        NL_TEST_SENTINEL(),
+    };
+
+    nlTestSuite theSuite = {
+        "EndpointComposition",
+        &sTests[0],
+        TestSetup,
+        TestTeardown,
+    };
+    nlTestRunner(&theSuite, nullptr);
+    return (nlTestRunnerStats(&theSuite));
+}
+
+CHIP_REGISTER_TEST_SUITE(TestEndpointComposition)
@@ -317,9 +317,42 @@ static void CheckLogEventWithDiscardLowEvent(nlTestSuite * apSuite, void * apCon
     CheckLogState(apSuite, logMgmt, 3, chip::app::PriorityLevel::Debug);
 }
 
+// Logs a long run of events, each of which has to evict older ones, and reports how long that took.
+static void CheckLogEventThroughput(nlTestSuite * apSuite, void * apContext)
+{
+    constexpr uint32_t kEventCount = 10000;
+    chip::app::EventOptions options;
+    options.mPath     = { kTestEndpointId1, kLivenessClusterId, kLivenessChangeEvent };
+    options.mPriority = chip::app::PriorityLevel::Info;
+    TestEventGenerator testEventGenerator;
+    uint32_t failures = 0;
+
+    chip::app::EventManagement & logMgmt = chip::app::EventManagement::GetInstance();
+    chip::EventNumber firstEventNumber   = logMgmt.GetLastEventNumber();
+
+    auto start = chip::System::SystemClock().GetMonotonicMicroseconds64();
+    for (uint32_t i = 0; i < kEventCount; i++)
+    {
+        chip::EventNumber eventNumber;
+        testEventGenerator.SetStatus(static_cast<int32_t>(i));
+        if (logMgmt.LogEvent(&testEventGenerator, options, eventNumber) != CHIP_NO_ERROR || eventNumber != firstEventNumber + i)
+        {
+            failures++;
+        }
+    }
+    auto elapsed = chip::System::SystemClock().GetMonotonicMicroseconds64() - start;
+
+    NL_TEST_ASSERT(apSuite, failures == 0);
+    NL_TEST_ASSERT(apSuite, logMgmt.GetLastEventNumber() == firstEventNumber + kEventCount);
+
+    ChipLogProgress(EventLogging, "Logged %u events in %u us", static_cast<unsigned>(kEventCount),
+                    static_cast<unsigned>(elapsed.count()));
+}
+
 const nlTest sTests[] = {
     NL_TEST_DEF("CheckLogEventWithEvictToNextBuffer", CheckLogEventWithEvictToNextBuffer),
     NL_TEST_DEF("CheckLogEventWithDiscardLowEvent", CheckLogEventWithDiscardLowEvent),
+    NL_TEST_DEF("CheckLogEventThroughput", CheckLogEventThroughput),
     NL_TEST_SENTINEL(),
 };
 
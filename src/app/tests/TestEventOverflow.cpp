@@ -170,7 +170,89 @@ static void CheckLogEventOverFlow(nlTestSuite * apSuite, void * apContext)
     }
 }
 
-const nlTest sTests[] = { NL_TEST_DEF("CheckLogEventOverFlow", CheckLogEventOverFlow), NL_TEST_SENTINEL() };
+// Returns whether every event held in the buffer has at least the given priority.
+static bool BufferHoldsOnlyPriorityAtLeast(chip::app::CircularEventBuffer & aBuffer, chip::app::PriorityLevel aPriority)
+{
+    chip::TLV::CircularTLVReader reader;
+    CHIP_ERROR err;
+    reader.Init(aBuffer);
+
+    while ((err = reader.Next()) == CHIP_NO_ERROR)
+    {
+        chip::TLV::TLVType reportType;
+        chip::TLV::TLVType dataType;
+        uint16_t priority = 0;
+
+        VerifyOrReturnValue(reader.EnterContainer(reportType) == CHIP_NO_ERROR, false);
+        VerifyOrReturnValue(reader.Next() == CHIP_NO_ERROR, false);
+        VerifyOrReturnValue(reader.EnterContainer(dataType) == CHIP_NO_ERROR, false);
+        while (reader.Next() == CHIP_NO_ERROR)
+        {
+            if (reader.GetTag() == chip::TLV::ContextTag(chip::app::EventDataIB::Tag::kPriority))
+            {
+                VerifyOrReturnValue(reader.Get(priority) == CHIP_NO_ERROR, false);
+            }
+        }
+        VerifyOrReturnValue(priority >= static_cast<uint16_t>(aPriority), false);
+        VerifyOrReturnValue(reader.ExitContainer(dataType) == CHIP_NO_ERROR, false);
+        VerifyOrReturnValue(reader.ExitContainer(reportType) == CHIP_NO_ERROR, false);
+    }
+
+    return err == CHIP_END_OF_TLV;
+}
+
+// Keeps all three buffers overflowing with a debug-heavy mix, so that most writes move events up the buffer chain, and reports
+// the logging throughput.
+static void CheckLogEventOverflowThroughput(nlTestSuite * apSuite, void * apContext)
+{
+    constexpr uint32_t kEventCount = 20000;
+    chip::app::EventOptions options;
+    options.mPath = { 1, 0x00000006, 1 };
+    TestEventGenerator testEventGenerator;
+    uint32_t failures = 0;
+
+    chip::app::EventManagement & logMgmt = chip::app::EventManagement::GetInstance();
+    chip::EventNumber firstEventNumber   = logMgmt.GetLastEventNumber();
+
+    auto start = chip::System::SystemClock().GetMonotonicMicroseconds64();
+    for (uint32_t i = 0; i < kEventCount; i++)
+    {
+        chip::EventNumber eventNumber;
+        switch (i % 8)
+        {
+        case 0:
+            options.mPriority = chip::app::PriorityLevel::Critical;
+            break;
+        case 1:
+        case 4:
+            options.mPriority = chip::app::PriorityLevel::Info;
+            break;
+        default:
+            options.mPriority = chip::app::PriorityLevel::Debug;
+            break;
+        }
+
+        if (logMgmt.LogEvent(&testEventGenerator, options, eventNumber) != CHIP_NO_ERROR || eventNumber != firstEventNumber + i)
+        {
+            failures++;
+        }
+    }
+    auto elapsed = chip::System::SystemClock().GetMonotonicMicroseconds64() - start;
+
+    NL_TEST_ASSERT(apSuite, failures == 0);
+    NL_TEST_ASSERT(apSuite, logMgmt.GetLastEventNumber() == firstEventNumber + kEventCount);
+
+    // Events that get bumped out of a buffer are only kept by the buffers for their own priority and above.
+    NL_TEST_ASSERT(apSuite, BufferHoldsOnlyPriorityAtLeast(gCircularEventBuffer[1], chip::app::PriorityLevel::Info));
+    NL_TEST_ASSERT(apSuite, BufferHoldsOnlyPriorityAtLeast(gCircularEventBuffer[2], chip::app::PriorityLevel::Critical));
+
+    ChipLogProgress(EventLogging, "Logged %u events with overflow in %u us", static_cast<unsigned>(kEventCount),
+                    static_cast<unsigned>(elapsed.count()));
+}
+
+const nlTest sTests[] = { NL_TEST_DEF("CheckLogEventOverFlow", CheckLogEventOverFlow),
+                          NL_TEST_DEF("CheckLogEventOverflowThroughput", CheckLogEventOverflowThroughput),
+                          NL_TEST_SENTINEL() };
 
 // clang-format off
 nlTestSuite sSuite =
@@ -0,0 +1,221 @@
+/*
+ *
+ *    Copyright (c) 2023 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#include <app/util/GlobalAttributeListCache.h>
+#include <lib/support/CHIPMem.h>
+#include <lib/support/CodeUtils.h>
+#include <lib/support/UnitTestRegistration.h>
+
+#include <nlunit-test.h>
+
+using namespace chip;
+using namespace chip::app;
+
+namespace {
+
+constexpr AttributeId kAttributeListId        = 0xFFFB;
+constexpr AttributeId kAcceptedCommandListId  = 0xFFF9;
+constexpr AttributeId kGeneratedCommandListId = 0xFFF8;
+constexpr uint32_t kIds[]                     = { 0, 1, 2, 0xFFF8, 0xFFF9, 0xFFFB, 0xFFFC, 0xFFFD };
+constexpr uint32_t kOtherIds[]                = { 3, 4 };
+constexpr EndpointId kBridgedEndpointCount    = 100;
+constexpr size_t kClustersPerBridgedEndpoint  = 4;
+
+EmberAfCluster sClusters[kClustersPerBridgedEndpoint] = {};
+
+bool HasIds(GlobalAttributeListCache & cache, const EmberAfCluster * cluster, EndpointId endpoint, AttributeId attribute,
+            Span<const uint32_t> expected)
+{
+    Span<const uint32_t> ids;
+    return cache.Find(cluster, endpoint, attribute, ids) && ids.data_equal(expected);
+}
+
+void TestInsertAndFind(nlTestSuite * apSuite, void * apContext)
+{
+    GlobalAttributeListCache cache;
+    Span<const uint32_t> ids;
+
+    NL_TEST_ASSERT(apSuite, !cache.Find(&sClusters[0], kInvalidEndpointId, kAttributeListId, ids));
+
+    NL_TEST_ASSERT(apSuite, cache.Insert(&sClusters[0], kInvalidEndpointId, kAttributeListId, Span<const uint32_t>(kIds)) ==
+                       CHIP_NO_ERROR);
+    NL_TEST_ASSERT(apSuite, cache.Insert(&sClusters[0], 1, kAcceptedCommandListId, Span<const uint32_t>(kOtherIds)) ==
+                       CHIP_NO_ERROR);
+    NL_TEST_ASSERT(apSuite, cache.Insert(&sClusters[0], 1, kGeneratedCommandListId, Span<const uint32_t>()) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(apSuite, cache.EntryCount() == 3);
+
+    NL_TEST_ASSERT(apSuite, HasIds(cache, &sClusters[0], kInvalidEndpointId, kAttributeListId, Span<const uint32_t>(kIds)));
+    NL_TEST_ASSERT(apSuite, HasIds(cache, &sClusters[0], 1, kAcceptedCommandListId, Span<const uint32_t>(kOtherIds)));
+
+    // An empty list is still cached.
+    NL_TEST_ASSERT(apSuite, cache.Find(&sClusters[0], 1, kGeneratedCommandListId, ids) && ids.empty());
+
+    // Keys differing in any part do not match.
+    NL_TEST_ASSERT(apSuite, !cache.Find(&sClusters[1], kInvalidEndpointId, kAttributeListId, ids));
+    NL_TEST_ASSERT(apSuite, !cache.Find(&sClusters[0], 2, kAcceptedCommandListId, ids));
+    NL_TEST_ASSERT(apSuite, !cache.Find(&sClusters[0], 1, kAttributeListId, ids));
+
+    // Inserting again replaces the list.
+    NL_TEST_ASSERT(apSuite, cache.Insert(&sClusters[0], 1, kAcceptedCommandListId, Span<const uint32_t>(kIds)) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(apSuite, cache.EntryCount() == 3);
+    NL_TEST_ASSERT(apSuite, HasIds(cache, &sClusters[0], 1, kAcceptedCommandListId, Span<const uint32_t>(kIds)));
+}
+
+void TestNoEviction(nlTestSuite * apSuite, void * apContext)
+{
+    GlobalAttributeListCache cache;
+
+    // Bridged endpoints of one type share the AttributeList of each of its clusters, while command lists are per endpoint.
+    for (auto & cluster : sClusters)
+    {
+        NL_TEST_ASSERT(apSuite,
+                       cache.Insert(&cluster, kInvalidEndpointId, kAttributeListId, Span<const uint32_t>(kIds)) == CHIP_NO_ERROR);
+    }
+
+    // Many more lists than would fit a small fixed-size cache: all of them stay, whatever order they are read in.
+    for (EndpointId endpoint = 1; endpoint <= kBridgedEndpointCount; endpoint++)
+    {
+        for (auto & cluster : sClusters)
+        {
+            uint32_t ids[] = { endpoint, static_cast<uint32_t>(&cluster - sClusters) };
+            NL_TEST_ASSERT(apSuite,
+                           cache.Insert(&cluster, endpoint, kAcceptedCommandListId, Span<const uint32_t>(ids)) == CHIP_NO_ERROR);
+        }
+    }
+    NL_TEST_ASSERT(apSuite, cache.EntryCount() == (kBridgedEndpointCount + 1) * kClustersPerBridgedEndpoint);
+
+    for (EndpointId endpoint = kBridgedEndpointCount; endpoint >= 1; endpoint--)
+    {
+        for (auto & cluster : sClusters)
+        {
+            NL_TEST_ASSERT(apSuite, HasIds(cache, &cluster, kInvalidEndpointId, kAttributeListId, Span<const uint32_t>(kIds)));
+
+            uint32_t ids[] = { endpoint, static_cast<uint32_t>(&cluster - sClusters) };
+            NL_TEST_ASSERT(apSuite, HasIds(cache, &cluster, endpoint, kAcceptedCommandListId, Span<const uint32_t>(ids)));
+        }
+    }
+}
+
+void TestEndpointConfigurationGeneration(nlTestSuite * apSuite, void * apContext)
+{
+    GlobalAttributeListCache cache;
+    cache.Validate(1, 1);
+
+    NL_TEST_ASSERT(apSuite,
+                   cache.Insert(&sClusters[0], kInvalidEndpointId, kAttributeListId, Span<const uint32_t>(kIds)) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(apSuite, cache.Insert(&sClusters[0], 1, kAcceptedCommandListId, Span<const uint32_t>(kOtherIds)) ==
+                       CHIP_NO_ERROR);
+    NL_TEST_ASSERT(apSuite, cache.Insert(&sClusters[1], 2, kGeneratedCommandListId, Span<const uint32_t>(kOtherIds)) ==
+                       CHIP_NO_ERROR);
+
+    // Same generations: nothing is dropped.
+    cache.Validate(1, 1);
+    NL_TEST_ASSERT(apSuite, cache.EntryCount() == 3);
+
+    // An endpoint being added, removed, enabled or disabled drops the command lists, but not the AttributeList built from
+    // the endpoint type.
+    cache.Validate(2, 1);
+    NL_TEST_ASSERT(apSuite, cache.EntryCount() == 1);
+    NL_TEST_ASSERT(apSuite, HasIds(cache, &sClusters[0], kInvalidEndpointId, kAttributeListId, Span<const uint32_t>(kIds)));
+
+    Span<const uint32_t> ids;
+    NL_TEST_ASSERT(apSuite, !cache.Find(&sClusters[0], 1, kAcceptedCommandListId, ids));
+    NL_TEST_ASSERT(apSuite, !cache.Find(&sClusters[1], 2, kGeneratedCommandListId, ids));
+}
+
+void TestCommandHandlerListGeneration(nlTestSuite * apSuite, void * apContext)
+{
+    GlobalAttributeListCache cache;
+    cache.Validate(1, 1);
+
+    NL_TEST_ASSERT(apSuite,
+                   cache.Insert(&sClusters[0], kInvalidEndpointId, kAttributeListId, Span<const uint32_t>(kIds)) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(apSuite, cache.Insert(&sClusters[0], 1, kAcceptedCommandListId, Span<const uint32_t>(kOtherIds)) ==
+                       CHIP_NO_ERROR);
+
+    // A command handler being registered or unregistered drops the command lists.
+    cache.Validate(1, 2);
+    NL_TEST_ASSERT(apSuite, cache.EntryCount() == 1);
+    NL_TEST_ASSERT(apSuite, HasIds(cache, &sClusters[0], kInvalidEndpointId, kAttributeListId, Span<const uint32_t>(kIds)));
+
+    // Lists cached after that stay until the next change.
+    NL_TEST_ASSERT(apSuite, cache.Insert(&sClusters[0], 1, kAcceptedCommandListId, Span<const uint32_t>(kIds)) == CHIP_NO_ERROR);
+    cache.Validate(1, 2);
+    NL_TEST_ASSERT(apSuite, HasIds(cache, &sClusters[0], 1, kAcceptedCommandListId, Span<const uint32_t>(kIds)));
+}
+
+void TestRemoveCluster(nlTestSuite * apSuite, void * apContext)
+{
+    GlobalAttributeListCache cache;
+
+    for (auto & cluster : sClusters)
+    {
+        NL_TEST_ASSERT(apSuite,
+                       cache.Insert(&cluster, kInvalidEndpointId, kAttributeListId, Span<const uint32_t>(kIds)) == CHIP_NO_ERROR);
+        NL_TEST_ASSERT(apSuite, cache.Insert(&cluster, 1, kAcceptedCommandListId, Span<const uint32_t>(kOtherIds)) == CHIP_NO_ERROR);
+    }
+
+    cache.RemoveCluster(&sClusters[1]);
+    NL_TEST_ASSERT(apSuite, cache.EntryCount() == 2 * (kClustersPerBridgedEndpoint - 1));
+
+    Span<const uint32_t> ids;
+    NL_TEST_ASSERT(apSuite, !cache.Find(&sClusters[1], kInvalidEndpointId, kAttributeListId, ids));
+    NL_TEST_ASSERT(apSuite, !cache.Find(&sClusters[1], 1, kAcceptedCommandListId, ids));
+    NL_TEST_ASSERT(apSuite, HasIds(cache, &sClusters[0], kInvalidEndpointId, kAttributeListId, Span<const uint32_t>(kIds)));
+    NL_TEST_ASSERT(apSuite, HasIds(cache, &sClusters[2], 1, kAcceptedCommandListId, Span<const uint32_t>(kOtherIds)));
+
+    cache.Clear();
+    NL_TEST_ASSERT(apSuite, cache.EntryCount() == 0);
+    NL_TEST_ASSERT(apSuite, !cache.Find(&sClusters[0], kInvalidEndpointId, kAttributeListId, ids));
+}
+
+int Setup(void * inContext)
+{
+    VerifyOrReturnError(Platform::MemoryInit() == CHIP_NO_ERROR, FAILURE);
+    return SUCCESS;
+}
+
+int Teardown(void * inContext)
+{
+    Platform::MemoryShutdown();
+    return SUCCESS;
+}
+
+} // namespace
+
+int TestGlobalAttributeListCache()
+{
+    static nlTest sTests[] = {
+        NL_TEST_DEF("TestInsertAndFind", TestInsertAndFind),
+        NL_TEST_DEF("TestNoEviction", TestNoEviction),
+        NL_TEST_DEF("TestEndpointConfigurationGeneration", TestEndpointConfigurationGeneration),
+        NL_TEST_DEF("TestCommandHandlerListGeneration", TestCommandHandlerListGeneration),
+        NL_TEST_DEF("TestRemoveCluster", TestRemoveCluster),
+        NL_TEST_SENTINEL(),
+    };
+
+    nlTestSuite theSuite = {
+        "GlobalAttributeListCache",
+        &sTests[0],
+        Setup,
+        Teardown,
+    };
+    nlTestRunner(&theSuite, nullptr);
+    return (nlTestRunnerStats(&theSuite));
+}
+
+CHIP_REGISTER_TEST_SUITE(TestGlobalAttributeListCache)
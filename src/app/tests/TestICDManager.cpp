@@ -43,6 +43,7 @@ class TestICDStateObserver : public app::ICDStateObserver
 public:
     void OnEnterActiveMode() {}
     void OnTransitionToIdle() {}
+    void OnEnterIdleMode(System::Clock::Timeout) {}
 };
 
 TestICDStateObserver mICDStateObserver;
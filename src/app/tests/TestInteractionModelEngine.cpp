@@ -22,6 +22,7 @@
  *
  */
 
+#include <app/CommandHandlerInterface.h>
 #include <app/InteractionModelEngine.h>
 #include <app/reporting/tests/MockReportScheduler.h>
 #include <app/tests/AppTestContext.h>
@@ -49,6 +50,7 @@ class TestInteractionModelEngine
 public:
     static void TestAttributePathParamsPushRelease(nlTestSuite * apSuite, void * apContext);
     static void TestRemoveDuplicateConcreteAttribute(nlTestSuite * apSuite, void * apContext);
+    static void TestCommandHandlerListGeneration(nlTestSuite * apSuite, void * apContext);
 #if CHIP_CONFIG_PERSIST_SUBSCRIPTIONS && CHIP_CONFIG_SUBSCRIPTION_TIMEOUT_RESUMPTION
     static void TestSubscriptionResumptionTimer(nlTestSuite * apSuite, void * apContext);
 #endif // CHIP_CONFIG_PERSIST_SUBSCRIPTIONS && CHIP_CONFIG_SUBSCRIPTION_TIMEOUT_RESUMPTION
@@ -229,6 +231,55 @@ void TestInteractionModelEngine::TestRemoveDuplicateConcreteAttribute(nlTestSuit
     InteractionModelEngine::GetInstance()->ReleaseAttributePathList(attributePathParamsList);
 }
 
+namespace {
+
+class TestCommandHandler : public CommandHandlerInterface
+{
+public:
+    TestCommandHandler(EndpointId endpointId) : CommandHandlerInterface(MakeOptional(endpointId), kTestClusterId) {}
+
+    void InvokeCommand(HandlerContext &) override {}
+
+private:
+    static constexpr ClusterId kTestClusterId = 0xFFF1FC01;
+};
+
+} // namespace
+
+void TestInteractionModelEngine::TestCommandHandlerListGeneration(nlTestSuite * apSuite, void * apContext)
+{
+    InteractionModelEngine * engine = InteractionModelEngine::GetInstance();
+    TestCommandHandler handler1(1);
+    TestCommandHandler handler2(2);
+
+    uint32_t generation = engine->GetCommandHandlerListGeneration();
+
+    NL_TEST_ASSERT(apSuite, engine->RegisterCommandHandler(&handler1) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(apSuite, engine->GetCommandHandlerListGeneration() != generation);
+    generation = engine->GetCommandHandlerListGeneration();
+
+    // A rejected registration leaves the list, and so the generation, unchanged.
+    NL_TEST_ASSERT(apSuite, engine->RegisterCommandHandler(&handler1) == CHIP_ERROR_INCORRECT_STATE);
+    NL_TEST_ASSERT(apSuite, engine->GetCommandHandlerListGeneration() == generation);
+
+    NL_TEST_ASSERT(apSuite, engine->RegisterCommandHandler(&handler2) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(apSuite, engine->GetCommandHandlerListGeneration() != generation);
+    generation = engine->GetCommandHandlerListGeneration();
+
+    NL_TEST_ASSERT(apSuite, engine->UnregisterCommandHandler(&handler1) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(apSuite, engine->GetCommandHandlerListGeneration() != generation);
+    generation = engine->GetCommandHandlerListGeneration();
+
+    NL_TEST_ASSERT(apSuite, engine->UnregisterCommandHandler(&handler1) == CHIP_ERROR_KEY_NOT_FOUND);
+    NL_TEST_ASSERT(apSuite, engine->GetCommandHandlerListGeneration() == generation);
+
+    engine->UnregisterCommandHandlers(3);
+    NL_TEST_ASSERT(apSuite, engine->GetCommandHandlerListGeneration() == generation);
+
+    engine->UnregisterCommandHandlers(2);
+    NL_TEST_ASSERT(apSuite, engine->GetCommandHandlerListGeneration() != generation);
+}
+
 #if CHIP_CONFIG_PERSIST_SUBSCRIPTIONS && CHIP_CONFIG_SUBSCRIPTION_TIMEOUT_RESUMPTION
 void TestInteractionModelEngine::TestSubscriptionResumptionTimer(nlTestSuite * apSuite, void * apContext)
 {
@@ -271,6 +322,7 @@ const nlTest sTests[] =
         {
                 NL_TEST_DEF("TestAttributePathParamsPushRelease", chip::app::TestInteractionModelEngine::TestAttributePathParamsPushRelease),
                 NL_TEST_DEF("TestRemoveDuplicateConcreteAttribute", chip::app::TestInteractionModelEngine::TestRemoveDuplicateConcreteAttribute),
+                NL_TEST_DEF("TestCommandHandlerListGeneration", chip::app::TestInteractionModelEngine::TestCommandHandlerListGeneration),
 #if CHIP_CONFIG_PERSIST_SUBSCRIPTIONS && CHIP_CONFIG_SUBSCRIPTION_TIMEOUT_RESUMPTION
                 NL_TEST_DEF("TestSubscriptionResumptionTimer", chip::app::TestInteractionModelEngine::TestSubscriptionResumptionTimer),
 #endif // CHIP_CONFIG_PERSIST_SUBSCRIPTIONS && CHIP_CONFIG_SUBSCRIPTION_TIMEOUT_RESUMPTION
@@ -0,0 +1,117 @@
+/*
+ *
+ *    Copyright (c) 2023 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#include <app/util/LazyClusterInitState.h>
+#include <lib/support/UnitTestRegistration.h>
+
+#include <nlunit-test.h>
+
+using namespace chip;
+using namespace chip::app;
+
+namespace {
+
+constexpr uint8_t kLastTrackedCluster = LazyClusterInitState::kMaxTrackedClusters - 1;
+
+void TestInitOnFirstAccess(nlTestSuite * apSuite, void * apContext)
+{
+    LazyClusterInitState state;
+
+    NL_TEST_ASSERT(apSuite, !state.IsInitialized(0));
+    NL_TEST_ASSERT(apSuite, !state.IsInitialized(kLastTrackedCluster));
+
+    // The first access runs the init callbacks, later ones (including re-entrant ones from the callbacks) do not.
+    NL_TEST_ASSERT(apSuite, state.ClaimInit(kLastTrackedCluster));
+    NL_TEST_ASSERT(apSuite, state.IsInitialized(kLastTrackedCluster));
+    NL_TEST_ASSERT(apSuite, !state.ClaimInit(kLastTrackedCluster));
+
+    // Other clusters are not affected.
+    NL_TEST_ASSERT(apSuite, !state.IsInitialized(0));
+    NL_TEST_ASSERT(apSuite, state.ClaimInit(0));
+
+    // Re-enabling the endpoint initializes its clusters again.
+    state.ClearInitialized();
+    NL_TEST_ASSERT(apSuite, !state.IsInitialized(0));
+    NL_TEST_ASSERT(apSuite, state.ClaimInit(0));
+}
+
+void TestEagerlyInitializedClusters(nlTestSuite * apSuite, void * apContext)
+{
+    LazyClusterInitState state;
+
+    // Client clusters are initialized with the endpoint: accessing them later does not call their callbacks again,
+    // and shutdown still calls theirs.
+    state.SetInitialized(1);
+    NL_TEST_ASSERT(apSuite, state.IsInitialized(1));
+    NL_TEST_ASSERT(apSuite, !state.ClaimInit(1));
+
+    // Clusters past the tracked ones always count as initialized and are never claimed.
+    NL_TEST_ASSERT(apSuite, !LazyClusterInitState::IsTracked(LazyClusterInitState::kMaxTrackedClusters));
+    NL_TEST_ASSERT(apSuite, state.IsInitialized(LazyClusterInitState::kMaxTrackedClusters));
+    NL_TEST_ASSERT(apSuite, !state.ClaimInit(LazyClusterInitState::kMaxTrackedClusters));
+    NL_TEST_ASSERT(apSuite, !state.ClaimInit(UINT8_MAX));
+
+    state.SetAttributeLoadPending(UINT8_MAX);
+    NL_TEST_ASSERT(apSuite, !state.ClaimAttributeLoad(UINT8_MAX));
+}
+
+void TestAttributeLoads(nlTestSuite * apSuite, void * apContext)
+{
+    LazyClusterInitState state;
+
+    // Nothing is loaded on access unless emberAfInitializeAttributes deferred it.
+    NL_TEST_ASSERT(apSuite, !state.ClaimAttributeLoad(2));
+
+    state.SetAttributeLoadPending(2);
+    state.SetAttributeLoadPending(kLastTrackedCluster);
+    NL_TEST_ASSERT(apSuite, state.ClaimAttributeLoad(2));
+    NL_TEST_ASSERT(apSuite, !state.ClaimAttributeLoad(2));
+
+    // Loading attributes and calling init callbacks are tracked separately.
+    NL_TEST_ASSERT(apSuite, !state.IsInitialized(2));
+    NL_TEST_ASSERT(apSuite, state.ClaimInit(2));
+    state.ClearInitialized();
+    NL_TEST_ASSERT(apSuite, state.ClaimAttributeLoad(kLastTrackedCluster));
+
+    // A dynamic endpoint being replaced drops the loads still pending for the previous one.
+    state.SetAttributeLoadPending(3);
+    state.ClearAttributeLoads();
+    NL_TEST_ASSERT(apSuite, !state.ClaimAttributeLoad(3));
+}
+
+} // namespace
+
+int TestLazyClusterInitState()
+{
+    static nlTest sTests[] = {
+        NL_TEST_DEF("TestInitOnFirstAccess", TestInitOnFirstAccess),
+        NL_TEST_DEF("TestEagerlyInitializedClusters", TestEagerlyInitializedClusters),
+        NL_TEST_DEF("TestAttributeLoads", TestAttributeLoads),
+        NL_TEST_SENTINEL(),
+    };
+
+    nlTestSuite theSuite = {
+        "LazyClusterInitState",
+        &sTests[0],
+        nullptr,
+        nullptr,
+    };
+    nlTestRunner(&theSuite, nullptr);
+    return (nlTestRunnerStats(&theSuite));
+}
+
+CHIP_REGISTER_TEST_SUITE(TestLazyClusterInitState)
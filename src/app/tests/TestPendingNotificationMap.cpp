@@ -126,6 +126,48 @@ void TestLRUEntry(nlTestSuite * aSuite, void * aContext)
     NL_TEST_ASSERT(aSuite, node.GetFabricIndex() == 1 && node.GetNodeId() == 1);
 }
 
+void TestHasPendingNotificationsForNode(nlTestSuite * aSuite, void * aContext)
+{
+    PendingNotificationMap pendingMap;
+    ClearBindingTable(BindingTable::GetInstance());
+    CreateDefaultFullBindingTable(BindingTable::GetInstance());
+
+    NL_TEST_ASSERT(aSuite, !pendingMap.HasPendingNotificationsForNode(chip::ScopedNodeId(0, 0), nullptr));
+
+    NL_TEST_ASSERT(aSuite, pendingMap.AddPendingNotification(0, nullptr) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(aSuite, pendingMap.AddPendingNotification(11, nullptr) == CHIP_NO_ERROR);
+
+    NL_TEST_ASSERT(aSuite, pendingMap.HasPendingNotificationsForNode(chip::ScopedNodeId(0, 0), nullptr));
+    NL_TEST_ASSERT(aSuite, pendingMap.HasPendingNotificationsForNode(chip::ScopedNodeId(1, 1), nullptr));
+    NL_TEST_ASSERT(aSuite, !pendingMap.HasPendingNotificationsForNode(chip::ScopedNodeId(1, 0), nullptr));
+    NL_TEST_ASSERT(aSuite, !pendingMap.HasPendingNotificationsForNode(chip::ScopedNodeId(0, 1), nullptr));
+
+    // Entry 5 targets the same peer as entry 0, removing only one of them keeps the peer pending.
+    NL_TEST_ASSERT(aSuite, pendingMap.AddPendingNotification(5, nullptr) == CHIP_NO_ERROR);
+    pendingMap.RemoveEntry(0);
+    NL_TEST_ASSERT(aSuite, pendingMap.HasPendingNotificationsForNode(chip::ScopedNodeId(0, 0), nullptr));
+    pendingMap.RemoveEntry(5);
+    NL_TEST_ASSERT(aSuite, !pendingMap.HasPendingNotificationsForNode(chip::ScopedNodeId(0, 0), nullptr));
+
+    // Entries of another notification do not count. The extra reference keeps the context from being released.
+    chip::PendingNotificationContext context(nullptr, nullptr);
+    context.IncrementConsumersNumber();
+    NL_TEST_ASSERT(aSuite, pendingMap.AddPendingNotification(1, &context) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(aSuite, pendingMap.HasPendingNotificationsForNode(chip::ScopedNodeId(1, 0), &context));
+    NL_TEST_ASSERT(aSuite, !pendingMap.HasPendingNotificationsForNode(chip::ScopedNodeId(1, 0), nullptr));
+    NL_TEST_ASSERT(aSuite, !pendingMap.HasPendingNotificationsForNode(chip::ScopedNodeId(1, 1), &context));
+
+    // The peer is recorded when the entry is added, so lookups and removals no longer read the binding table.
+    ClearBindingTable(BindingTable::GetInstance());
+    NL_TEST_ASSERT(aSuite, pendingMap.HasPendingNotificationsForNode(chip::ScopedNodeId(1, 0), &context));
+    pendingMap.RemoveAllEntriesForNode(chip::ScopedNodeId(1, 0));
+    NL_TEST_ASSERT(aSuite, !pendingMap.HasPendingNotificationsForNode(chip::ScopedNodeId(1, 0), &context));
+    NL_TEST_ASSERT(aSuite, context.GetConsumersNumber() == 1);
+    NL_TEST_ASSERT(aSuite, pendingMap.HasPendingNotificationsForNode(chip::ScopedNodeId(1, 1), nullptr));
+    pendingMap.RemoveAllEntriesForFabric(1);
+    NL_TEST_ASSERT(aSuite, pendingMap.begin() == pendingMap.end());
+}
+
 } // namespace
 
 int TestPeindingNotificationMap()
@@ -134,6 +176,7 @@ int TestPeindingNotificationMap()
         NL_TEST_DEF("TestEmptyMap", TestEmptyMap),
         NL_TEST_DEF("TestAddRemove", TestAddRemove),
         NL_TEST_DEF("TestLRUEntry", TestLRUEntry),
+        NL_TEST_DEF("TestHasPendingNotificationsForNode", TestHasPendingNotificationsForNode),
         NL_TEST_SENTINEL(),
     };
 
@@ -356,6 +356,7 @@ public:
     static void TestSubscribeUrgentWildcardEvent(nlTestSuite * apSuite, void * apContext);
     static void TestSubscribeWildcard(nlTestSuite * apSuite, void * apContext);
     static void TestSubscribePartialOverlap(nlTestSuite * apSuite, void * apContext);
+    static void TestSubscribeSkipsHandlersNotReady(nlTestSuite * apSuite, void * apContext);
     static void TestSubscribeSetDirtyFullyOverlap(nlTestSuite * apSuite, void * apContext);
     static void TestSubscribeEarlyShutdown(nlTestSuite * apSuite, void * apContext);
     static void TestSubscribeInvalidAttributePathRoundtrip(nlTestSuite * apSuite, void * apContext);
@@ -2656,6 +2657,93 @@ void TestReadInteraction::TestSubscribePartialOverlap(nlTestSuite * apSuite, voi
     NL_TEST_ASSERT(apSuite, ctx.GetExchangeManager().GetNumActiveExchanges() == 0);
 }
 
+// Subscribe twice to (E2, C3, A1), with and without a min interval, then setDirty: the engine run only reports to the
+// subscription whose min interval has elapsed, and leaves the other one dirty until it has.
+void TestReadInteraction::TestSubscribeSkipsHandlersNotReady(nlTestSuite * apSuite, void * apContext)
+{
+    TestContext & ctx = *static_cast<TestContext *>(apContext);
+    CHIP_ERROR err    = CHIP_NO_ERROR;
+
+    Messaging::ReliableMessageMgr * rm = ctx.GetExchangeManager().GetReliableMessageMgr();
+    // Shouldn't have anything in the retransmit table when starting the test.
+    NL_TEST_ASSERT(apSuite, rm->TestGetCountRetransTable() == 0);
+
+    MockInteractionModelApp readyDelegate;
+    MockInteractionModelApp notReadyDelegate;
+    ReportSchedulerImpl * reportScheduler = app::reporting::GetDefaultReportScheduler();
+    auto * engine                         = chip::app::InteractionModelEngine::GetInstance();
+    err                                   = engine->Init(&ctx.GetExchangeManager(), &ctx.GetFabricTable(), reportScheduler);
+    NL_TEST_ASSERT(apSuite, err == CHIP_NO_ERROR);
+
+    chip::app::AttributePathParams attributePathParams[1];
+    attributePathParams[0].mEndpointId  = Test::kMockEndpoint2;
+    attributePathParams[0].mClusterId   = Test::MockClusterId(3);
+    attributePathParams[0].mAttributeId = Test::MockAttributeId(1);
+
+    ReadPrepareParams readPrepareParams(ctx.GetSessionBobToAlice());
+    readPrepareParams.mpAttributePathParamsList    = attributePathParams;
+    readPrepareParams.mAttributePathParamsListSize = 1;
+    readPrepareParams.mKeepSubscriptions           = true;
+
+    {
+        app::ReadClient readyClient(chip::app::InteractionModelEngine::GetInstance(), &ctx.GetExchangeManager(), readyDelegate,
+                                    chip::app::ReadClient::InteractionType::Subscribe);
+        app::ReadClient notReadyClient(chip::app::InteractionModelEngine::GetInstance(), &ctx.GetExchangeManager(),
+                                       notReadyDelegate, chip::app::ReadClient::InteractionType::Subscribe);
+
+        readPrepareParams.mMinIntervalFloorSeconds   = 0;
+        readPrepareParams.mMaxIntervalCeilingSeconds = 10;
+        err                                          = readyClient.SendRequest(readPrepareParams);
+        NL_TEST_ASSERT(apSuite, err == CHIP_NO_ERROR);
+        ctx.DrainAndServiceIO();
+
+        readPrepareParams.mMinIntervalFloorSeconds = 5;
+        err                                        = notReadyClient.SendRequest(readPrepareParams);
+        NL_TEST_ASSERT(apSuite, err == CHIP_NO_ERROR);
+        ctx.DrainAndServiceIO();
+
+        NL_TEST_ASSERT(apSuite, readyDelegate.mGotReport && notReadyDelegate.mGotReport);
+        NL_TEST_ASSERT(apSuite, engine->GetNumActiveReadHandlers(ReadHandler::InteractionType::Subscribe) == 2);
+
+        readyDelegate.mGotReport               = false;
+        readyDelegate.mNumAttributeResponse    = 0;
+        notReadyDelegate.mGotReport            = false;
+        notReadyDelegate.mNumAttributeResponse = 0;
+
+        AttributePathParams dirtyPath;
+        dirtyPath.mEndpointId = Test::kMockEndpoint2;
+        dirtyPath.mClusterId  = Test::MockClusterId(3);
+
+        err = engine->GetReportingEngine().SetDirty(dirtyPath);
+        NL_TEST_ASSERT(apSuite, err == CHIP_NO_ERROR);
+        ctx.DrainAndServiceIO();
+
+        // The engine ran for the ready subscription and went past the other one.
+        NL_TEST_ASSERT(apSuite, readyDelegate.mGotReport);
+        NL_TEST_ASSERT(apSuite, readyDelegate.mNumAttributeResponse == 1);
+        NL_TEST_ASSERT(apSuite, !notReadyDelegate.mGotReport);
+
+        // The subscriptions were created in order, so the not-ready one has the second handler.
+        ReadHandler * notReadyHandler = engine->ActiveHandlerAt(1);
+        NL_TEST_ASSERT(apSuite, notReadyHandler != nullptr && notReadyHandler->IsDirty());
+        NL_TEST_ASSERT(apSuite, engine->ActiveHandlerAt(0) != nullptr && !engine->ActiveHandlerAt(0)->IsDirty());
+        NL_TEST_ASSERT(apSuite, notReadyHandler != nullptr && !reportScheduler->IsReportableNow(notReadyHandler));
+
+        // Once its min interval has elapsed, the other subscription gets its report.
+        gMockClock.AdvanceMonotonic(System::Clock::Seconds16(5));
+        ctx.GetIOContext().DriveIO();
+        ctx.DrainAndServiceIO();
+
+        NL_TEST_ASSERT(apSuite, notReadyDelegate.mGotReport);
+        NL_TEST_ASSERT(apSuite, notReadyDelegate.mNumAttributeResponse == 1);
+        NL_TEST_ASSERT(apSuite, notReadyHandler != nullptr && !notReadyHandler->IsDirty());
+    }
+
+    NL_TEST_ASSERT(apSuite, engine->GetNumActiveReadClients() == 0);
+    engine->Shutdown();
+    NL_TEST_ASSERT(apSuite, ctx.GetExchangeManager().GetNumActiveExchanges() == 0);
+}
+
 // Subscribe (E2, C3, A1), then setDirty (wildcard, wildcard, wildcard), receive one attribute after setDirty
 void TestReadInteraction::TestSubscribeSetDirtyFullyOverlap(nlTestSuite * apSuite, void * apContext)
 {
@@ -4967,6 +5055,7 @@ const nlTest sTests[] =
 #endif
     NL_TEST_DEF("TestSubscribeWildcard", chip::app::TestReadInteraction::TestSubscribeWildcard),
     NL_TEST_DEF("TestSubscribePartialOverlap", chip::app::TestReadInteraction::TestSubscribePartialOverlap),
+    NL_TEST_DEF("TestSubscribeSkipsHandlersNotReady", chip::app::TestReadInteraction::TestSubscribeSkipsHandlersNotReady),
     NL_TEST_DEF("TestSubscribeSetDirtyFullyOverlap", chip::app::TestReadInteraction::TestSubscribeSetDirtyFullyOverlap),
     NL_TEST_DEF("TestSubscribeEarlyShutdown", chip::app::TestReadInteraction::TestSubscribeEarlyShutdown),
     NL_TEST_DEF("TestSubscribeInvalidAttributePathRoundtrip", chip::app::TestReadInteraction::TestSubscribeInvalidAttributePathRoundtrip),
@@ -0,0 +1,163 @@
+/*
+ *
+ *    Copyright (c) 2023 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#include <app/reporting/ReportBuilderPool.h>
+#include <lib/core/TLV.h>
+#include <lib/support/CodeUtils.h>
+#include <lib/support/UnitTestRegistration.h>
+#include <lib/support/logging/CHIPLogging.h>
+
+#include <nlunit-test.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+using namespace chip;
+using namespace chip::app::reporting;
+
+namespace {
+
+constexpr size_t kJobCount = 64;
+
+void TestRunWithoutThreads(nlTestSuite * apSuite, void * apContext)
+{
+    ReportBuilderPool pool;
+    size_t runs            = 0;
+    bool onBuilderThread   = false;
+    bool onOtherThread     = false;
+    std::thread::id caller = std::this_thread::get_id();
+
+    pool.Run(kJobCount, [&](size_t aIndex) {
+        NL_TEST_ASSERT(apSuite, aIndex == runs);
+        runs++;
+        onBuilderThread |= ReportBuilderPool::IsBuilderThread();
+        onOtherThread |= (std::this_thread::get_id() != caller);
+    });
+
+    NL_TEST_ASSERT(apSuite, runs == kJobCount);
+    NL_TEST_ASSERT(apSuite, !onBuilderThread);
+    NL_TEST_ASSERT(apSuite, !onOtherThread);
+}
+
+void TestRunOnBuilderThreads(nlTestSuite * apSuite, void * apContext)
+{
+    ReportBuilderPool pool;
+    NL_TEST_ASSERT(apSuite, pool.Start(ReportBuilderPool::kMaxThreads + 1) == CHIP_ERROR_INVALID_ARGUMENT);
+    NL_TEST_ASSERT(apSuite, pool.Start(ReportBuilderPool::kMaxThreads) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(apSuite, pool.Start(1) == CHIP_ERROR_INCORRECT_STATE);
+
+    std::atomic<uint32_t> runs[kJobCount] = {};
+    std::atomic<bool> onCallerThread{ false };
+    std::thread::id caller = std::this_thread::get_id();
+
+    // Calls run one at a time on the caller thread, so they need no synchronization of their own.
+    size_t calls           = 0;
+    bool callOnOtherThread = false;
+
+    for (int batch = 0; batch < 3; batch++)
+    {
+        pool.Run(kJobCount, [&](size_t aIndex) {
+            runs[aIndex]++;
+            onCallerThread = onCallerThread || !ReportBuilderPool::IsBuilderThread();
+            pool.RunOnCallerThread([&] {
+                calls++;
+                callOnOtherThread |= (std::this_thread::get_id() != caller);
+                callOnOtherThread |= ReportBuilderPool::IsBuilderThread();
+            });
+        });
+    }
+
+    for (auto & count : runs)
+    {
+        NL_TEST_ASSERT(apSuite, count == 3);
+    }
+    NL_TEST_ASSERT(apSuite, !onCallerThread);
+    NL_TEST_ASSERT(apSuite, calls == 3 * kJobCount);
+    NL_TEST_ASSERT(apSuite, !callOnOtherThread);
+
+    // Outside of a builder thread, calls run right away.
+    size_t directCalls = 0;
+    pool.RunOnCallerThread([&] { directCalls++; });
+    NL_TEST_ASSERT(apSuite, directCalls == 1);
+
+    pool.Stop();
+    NL_TEST_ASSERT(apSuite, pool.GetThreadCount() == 0);
+}
+
+// Encodes a synthetic report of plain attribute values, standing in for the attribute store reads of BuildReport.
+void EncodeSyntheticReport(size_t aIndex)
+{
+    uint8_t buffer[1024];
+    TLV::TLVWriter writer;
+    TLV::TLVType outer;
+
+    for (uint32_t repeat = 0; repeat < 64; repeat++)
+    {
+        writer.Init(buffer);
+        VerifyOrDie(writer.StartContainer(TLV::AnonymousTag(), TLV::kTLVType_Structure, outer) == CHIP_NO_ERROR);
+        for (uint32_t attribute = 0; attribute < 64; attribute++)
+        {
+            VerifyOrDie(writer.Put(TLV::ContextTag(static_cast<uint8_t>(attribute)),
+                                   static_cast<uint32_t>(aIndex * attribute + repeat)) == CHIP_NO_ERROR);
+        }
+        VerifyOrDie(writer.EndContainer(outer) == CHIP_NO_ERROR);
+    }
+}
+
+void TestBuildScaling(nlTestSuite * apSuite, void * apContext)
+{
+    constexpr size_t kReports = 256;
+    size_t maxThreads         = std::min<size_t>(ReportBuilderPool::kMaxThreads, std::thread::hardware_concurrency());
+
+    for (size_t threads = 0; threads <= maxThreads; threads++)
+    {
+        ReportBuilderPool pool;
+        NL_TEST_ASSERT(apSuite, pool.Start(threads) == CHIP_NO_ERROR);
+
+        auto start = std::chrono::steady_clock::now();
+        pool.Run(kReports, [](size_t aIndex) { EncodeSyntheticReport(aIndex); });
+        auto elapsed = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start);
+
+        ChipLogProgress(DataManagement, "%u builder threads: %u reports in %lld us", static_cast<unsigned>(threads),
+                        static_cast<unsigned>(kReports), static_cast<long long>(elapsed.count()));
+    }
+}
+
+} // namespace
+
+int TestReportBuilderPool()
+{
+    static nlTest sTests[] = {
+        NL_TEST_DEF("TestRunWithoutThreads", TestRunWithoutThreads),
+        NL_TEST_DEF("TestRunOnBuilderThreads", TestRunOnBuilderThreads),
+        NL_TEST_DEF("TestBuildScaling", TestBuildScaling),
+        NL_TEST_SENTINEL(),
+    };
+
+    nlTestSuite theSuite = {
+        "ReportBuilderPool",
+        &sTests[0],
+        nullptr,
+        nullptr,
+    };
+    nlTestRunner(&theSuite, nullptr);
+    return (nlTestRunnerStats(&theSuite));
+}
+
+CHIP_REGISTER_TEST_SUITE(TestReportBuilderPool)
@@ -25,6 +25,8 @@
 #include <lib/support/logging/CHIPLogging.h>
 #include <nlunit-test.h>
 
+#include <algorithm>
+
 namespace {
 
 class TestContext : public chip::Test::AppContext
@@ -824,6 +826,191 @@ public:
         exchangeCtx->Close();
         NL_TEST_ASSERT(aSuite, ctx.GetExchangeManager().GetNumActiveExchanges() == 0);
     }
+
+    static bool IsInOrder(const SynchronizedReportSchedulerImpl::NodeOrder & order,
+                          std::initializer_list<const ReadHandlerNode *> expected)
+    {
+        return static_cast<size_t>(order.end() - order.begin()) == expected.size() &&
+            std::equal(expected.begin(), expected.end(), order.begin());
+    }
+
+    static void TestSynchronizedSchedulerNodeOrder(nlTestSuite * aSuite, void * aContext)
+    {
+        TestContext & ctx = *static_cast<TestContext *>(aContext);
+        NullReadHandlerCallback nullCallback;
+        // exchange context
+        Messaging::ExchangeContext * exchangeCtx = ctx.NewExchangeToAlice(nullptr, false);
+
+        // Read handler pool
+        ObjectPool<ReadHandler, kNumMaxReadHandlers> readHandlerPool;
+
+        // Initialize the mock system time
+        sTestTimerSynchronizedDelegate.SetMockSystemTimestamp(System::Clock::Milliseconds64(0));
+
+        ReadHandler * readHandler1 =
+            readHandlerPool.CreateObject(nullCallback, exchangeCtx, ReadHandler::InteractionType::Subscribe, &syncScheduler);
+        NL_TEST_ASSERT(aSuite, CHIP_NO_ERROR == MockReadHandlerSubscriptionTransaction(readHandler1, &syncScheduler, 0, 3));
+        ReadHandlerNode * node1 = syncScheduler.FindReadHandlerNode(readHandler1);
+
+        ReadHandler * readHandler2 =
+            readHandlerPool.CreateObject(nullCallback, exchangeCtx, ReadHandler::InteractionType::Subscribe, &syncScheduler);
+        NL_TEST_ASSERT(aSuite, CHIP_NO_ERROR == MockReadHandlerSubscriptionTransaction(readHandler2, &syncScheduler, 1, 2));
+        ReadHandlerNode * node2 = syncScheduler.FindReadHandlerNode(readHandler2);
+
+        ReadHandler * readHandler3 =
+            readHandlerPool.CreateObject(nullCallback, exchangeCtx, ReadHandler::InteractionType::Subscribe, &syncScheduler);
+        NL_TEST_ASSERT(aSuite, CHIP_NO_ERROR == MockReadHandlerSubscriptionTransaction(readHandler3, &syncScheduler, 2, 4));
+        ReadHandlerNode * node3 = syncScheduler.FindReadHandlerNode(readHandler3);
+
+        // Nodes are ordered by their min and by their max timestamps as they are registered
+        NL_TEST_ASSERT(aSuite, IsInOrder(syncScheduler.mNodesByMin, { node1, node2, node3 }));
+        NL_TEST_ASSERT(aSuite, IsInOrder(syncScheduler.mNodesByMax, { node2, node1, node3 }));
+
+        // A report moves the node to its new timestamps, after the nodes that already had the same ones
+        sTestTimerSynchronizedDelegate.IncrementMockTimestamp(System::Clock::Milliseconds64(1000));
+        syncScheduler.OnSubscriptionReportSent(readHandler2);
+        NL_TEST_ASSERT(aSuite, node2->GetMinTimestamp() == node3->GetMinTimestamp());
+        NL_TEST_ASSERT(aSuite, node2->GetMaxTimestamp() == node1->GetMaxTimestamp());
+        NL_TEST_ASSERT(aSuite, IsInOrder(syncScheduler.mNodesByMin, { node1, node3, node2 }));
+        NL_TEST_ASSERT(aSuite, IsInOrder(syncScheduler.mNodesByMax, { node1, node2, node3 }));
+
+        // The common max is the earliest max still ahead, and the common min the latest reportable min that does not exceed it
+        Timestamp now = sTestTimerSynchronizedDelegate.GetCurrentMonotonicTimestamp();
+        NL_TEST_ASSERT(aSuite, CHIP_NO_ERROR == syncScheduler.FindNextMaxInterval(now));
+        NL_TEST_ASSERT(aSuite, syncScheduler.mNextMaxTimestamp == node1->GetMaxTimestamp());
+        readHandler3->ForceDirtyState();
+        NL_TEST_ASSERT(aSuite, CHIP_NO_ERROR == syncScheduler.FindNextMinInterval(now));
+        NL_TEST_ASSERT(aSuite, syncScheduler.mNextMinTimestamp == node3->GetMinTimestamp());
+
+        // A destroyed handler leaves both orders
+        syncScheduler.OnReadHandlerDestroyed(readHandler1);
+        NL_TEST_ASSERT(aSuite, IsInOrder(syncScheduler.mNodesByMin, { node3, node2 }));
+        NL_TEST_ASSERT(aSuite, IsInOrder(syncScheduler.mNodesByMax, { node2, node3 }));
+        NL_TEST_ASSERT(aSuite, CHIP_NO_ERROR == syncScheduler.FindNextMaxInterval(now));
+        NL_TEST_ASSERT(aSuite, syncScheduler.mNextMaxTimestamp == node2->GetMaxTimestamp());
+
+        syncScheduler.UnregisterAllHandlers();
+        NL_TEST_ASSERT(aSuite, IsInOrder(syncScheduler.mNodesByMin, {}));
+        NL_TEST_ASSERT(aSuite, IsInOrder(syncScheduler.mNodesByMax, {}));
+        readHandlerPool.ReleaseAll();
+        exchangeCtx->Close();
+        NL_TEST_ASSERT(aSuite, ctx.GetExchangeManager().GetNumActiveExchanges() == 0);
+    }
+
+    static void TestSynchronizedSchedulerTransitionToIdle(nlTestSuite * aSuite, void * aContext)
+    {
+        TestContext & ctx = *static_cast<TestContext *>(aContext);
+        NullReadHandlerCallback nullCallback;
+        // exchange context
+        Messaging::ExchangeContext * exchangeCtx = ctx.NewExchangeToAlice(nullptr, false);
+
+        // Read handler pool
+        ObjectPool<ReadHandler, kNumMaxReadHandlers> readHandlerPool;
+
+        // Initialize the mock system time
+        sTestTimerSynchronizedDelegate.SetMockSystemTimestamp(System::Clock::Milliseconds64(0));
+
+        ReadHandler * readHandler =
+            readHandlerPool.CreateObject(nullCallback, exchangeCtx, ReadHandler::InteractionType::Subscribe, &syncScheduler);
+        NL_TEST_ASSERT(aSuite, CHIP_NO_ERROR == MockReadHandlerSubscriptionTransaction(readHandler, &syncScheduler, 0, 5));
+        ReadHandlerNode * node = syncScheduler.FindReadHandlerNode(readHandler);
+
+        uint32_t coalescedReports = syncScheduler.GetCoalescedReportCount();
+        NL_TEST_ASSERT(aSuite, syncScheduler.IsReportScheduled());
+        NL_TEST_ASSERT(aSuite, syncScheduler.mTestNextReportTimestamp == node->GetMaxTimestamp());
+
+        // The report is due long after the ICD would go idle, it stays scheduled
+        sTestTimerSynchronizedDelegate.IncrementMockTimestamp(System::Clock::Milliseconds64(1000));
+        syncScheduler.OnTransitionToIdle();
+        NL_TEST_ASSERT(aSuite, syncScheduler.IsReportScheduled());
+        NL_TEST_ASSERT(aSuite, syncScheduler.GetCoalescedReportCount() == coalescedReports);
+
+        // The report is due shortly after going idle, it is sent before going idle instead of waking up for it
+        sTestTimerSynchronizedDelegate.IncrementMockTimestamp(System::Clock::Milliseconds64(3500));
+        NL_TEST_ASSERT(aSuite, syncScheduler.IsReportScheduled());
+        syncScheduler.OnTransitionToIdle();
+        NL_TEST_ASSERT(aSuite, !syncScheduler.IsReportScheduled());
+        NL_TEST_ASSERT(aSuite, syncScheduler.IsReportableNow(readHandler));
+        NL_TEST_ASSERT(aSuite, syncScheduler.GetCoalescedReportCount() == coalescedReports + 1);
+
+        // Nothing is pending anymore, transitioning to idle again does nothing
+        syncScheduler.OnTransitionToIdle();
+        NL_TEST_ASSERT(aSuite, syncScheduler.GetCoalescedReportCount() == coalescedReports + 1);
+
+        syncScheduler.UnregisterAllHandlers();
+        readHandlerPool.ReleaseAll();
+        exchangeCtx->Close();
+        NL_TEST_ASSERT(aSuite, ctx.GetExchangeManager().GetNumActiveExchanges() == 0);
+    }
+
+    static void TestSynchronizedSchedulerDeferToICDWake(nlTestSuite * aSuite, void * aContext)
+    {
+        TestContext & ctx = *static_cast<TestContext *>(aContext);
+        NullReadHandlerCallback nullCallback;
+        // exchange context
+        Messaging::ExchangeContext * exchangeCtx = ctx.NewExchangeToAlice(nullptr, false);
+
+        // Read handler pool
+        ObjectPool<ReadHandler, kNumMaxReadHandlers> readHandlerPool;
+
+        // Initialize the mock system time
+        sTestTimerSynchronizedDelegate.SetMockSystemTimestamp(System::Clock::Milliseconds64(0));
+
+        ReadHandler * readHandler =
+            readHandlerPool.CreateObject(nullCallback, exchangeCtx, ReadHandler::InteractionType::Subscribe, &syncScheduler);
+        NL_TEST_ASSERT(aSuite, CHIP_NO_ERROR == MockReadHandlerSubscriptionTransaction(readHandler, &syncScheduler, 0, 10));
+        ReadHandlerNode * node = syncScheduler.FindReadHandlerNode(readHandler);
+
+        uint32_t deferredReports = syncScheduler.GetDeferredReportCount();
+        NL_TEST_ASSERT(aSuite, syncScheduler.mTestNextReportTimestamp == node->GetMaxTimestamp());
+
+        // The ICD wakes up on its own before the max interval, the report at the max interval does not need to move
+        syncScheduler.OnEnterIdleMode(System::Clock::Milliseconds32(4000));
+        NL_TEST_ASSERT(aSuite, syncScheduler.mTestNextReportTimestamp == node->GetMaxTimestamp());
+
+        // A handler that becomes dirty while the ICD is idle waits for it to wake up instead of waking it up
+        sTestTimerSynchronizedDelegate.IncrementMockTimestamp(System::Clock::Milliseconds64(1000));
+        readHandler->ForceDirtyState();
+        NL_TEST_ASSERT(aSuite, syncScheduler.IsReportScheduled());
+        NL_TEST_ASSERT(aSuite, syncScheduler.mTestNextReportTimestamp == System::Clock::Milliseconds64(4000));
+        NL_TEST_ASSERT(aSuite, !node->IsEngineRunScheduled());
+
+        // The report goes out when the ICD wakes up, whichever of the report timer and the ICD comes first
+        sTestTimerSynchronizedDelegate.IncrementMockTimestamp(System::Clock::Milliseconds64(3000));
+        NL_TEST_ASSERT(aSuite, node->IsEngineRunScheduled());
+        NL_TEST_ASSERT(aSuite, syncScheduler.GetDeferredReportCount() == deferredReports + 1);
+        syncScheduler.OnEnterActiveMode();
+        NL_TEST_ASSERT(aSuite, syncScheduler.GetDeferredReportCount() == deferredReports + 1);
+
+        // The ICD wakes up on its own after the max interval, the report cannot wait for it
+        readHandler->ClearForceDirtyFlag();
+        syncScheduler.OnSubscriptionReportSent(readHandler);
+        syncScheduler.OnEnterIdleMode(System::Clock::Milliseconds32(20000));
+        readHandler->ForceDirtyState();
+        NL_TEST_ASSERT(aSuite, !syncScheduler.IsReportScheduled());
+        NL_TEST_ASSERT(aSuite, node->IsEngineRunScheduled());
+        NL_TEST_ASSERT(aSuite, syncScheduler.GetDeferredReportCount() == deferredReports + 1);
+        syncScheduler.OnEnterActiveMode();
+
+        // The ICD is brought back to active mode by something else before it wakes up on its own, the held back report goes out
+        // with it
+        readHandler->ClearForceDirtyFlag();
+        syncScheduler.OnSubscriptionReportSent(readHandler);
+        syncScheduler.OnEnterIdleMode(System::Clock::Milliseconds32(5000));
+        readHandler->ForceDirtyState();
+        NL_TEST_ASSERT(aSuite, syncScheduler.mTestNextReportTimestamp == System::Clock::Milliseconds64(9000));
+        sTestTimerSynchronizedDelegate.IncrementMockTimestamp(System::Clock::Milliseconds64(2000));
+        NL_TEST_ASSERT(aSuite, !node->IsEngineRunScheduled());
+        syncScheduler.OnEnterActiveMode();
+        NL_TEST_ASSERT(aSuite, !syncScheduler.IsReportScheduled());
+        NL_TEST_ASSERT(aSuite, node->IsEngineRunScheduled());
+        NL_TEST_ASSERT(aSuite, syncScheduler.GetDeferredReportCount() == deferredReports + 2);
+
+        syncScheduler.UnregisterAllHandlers();
+        readHandlerPool.ReleaseAll();
+        exchangeCtx->Close();
+        NL_TEST_ASSERT(aSuite, ctx.GetExchangeManager().GetNumActiveExchanges() == 0);
+    }
 };
 
 } // namespace reporting
@@ -841,6 +1028,12 @@ static nlTest sTests[] = {
     NL_TEST_DEF("TestReportTiming", chip::app::reporting::TestReportScheduler::TestReportTiming),
     NL_TEST_DEF("TestObserverCallbacks", chip::app::reporting::TestReportScheduler::TestObserverCallbacks),
     NL_TEST_DEF("TestSynchronizedScheduler", chip::app::reporting::TestReportScheduler::TestSynchronizedScheduler),
+    NL_TEST_DEF("TestSynchronizedSchedulerNodeOrder",
+                chip::app::reporting::TestReportScheduler::TestSynchronizedSchedulerNodeOrder),
+    NL_TEST_DEF("TestSynchronizedSchedulerTransitionToIdle",
+                chip::app::reporting::TestReportScheduler::TestSynchronizedSchedulerTransitionToIdle),
+    NL_TEST_DEF("TestSynchronizedSchedulerDeferToICDWake",
+                chip::app::reporting::TestReportScheduler::TestSynchronizedSchedulerDeferToICDWake),
     NL_TEST_SENTINEL(),
 };
 
@@ -131,6 +131,13 @@ bool ConcreteAttributePathExists(const ConcreteAttributePath & aPath)
     return true;
 }
 
+#if CHIP_IM_REPORT_BUILDER_THREADS > 0
+bool IsConcurrentReadSafe(const ConcreteAttributePath & aPath)
+{
+    return false;
+}
+#endif
+
 Protocols::InteractionModel::Status CheckEventSupportStatus(const ConcreteEventPath & aPath)
 {
     return Protocols::InteractionModel::Status::Success;
@@ -0,0 +1,147 @@
+/*
+ *
+ *    Copyright (c) 2023 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#include <app/util/AttributeUpdateBatcher.h>
+
+#include <app/reporting/reporting.h>
+#include <app/util/attribute-table.h>
+#include <lib/support/CHIPMem.h>
+#include <lib/support/CodeUtils.h>
+#include <lib/support/logging/CHIPLogging.h>
+#include <platform/CHIPDeviceLayer.h>
+#include <platform/LockTracker.h>
+
+#include <string.h>
+
+namespace chip {
+namespace app {
+
+std::atomic<AttributeUpdateBatcher *> AttributeUpdateBatcher::sInstance{ nullptr };
+
+AttributeUpdateBatcher * AttributeUpdateBatcher::Instance()
+{
+    AttributeUpdateBatcher * instance = sInstance.load(std::memory_order_acquire);
+    VerifyOrReturnValue(instance == nullptr, instance);
+
+    // Several threads may get here first; only one allocation is kept.
+    AttributeUpdateBatcher * created = Platform::New<AttributeUpdateBatcher>();
+    VerifyOrReturnValue(created != nullptr, nullptr);
+    if (!sInstance.compare_exchange_strong(instance, created, std::memory_order_acq_rel, std::memory_order_acquire))
+    {
+        Platform::Delete(created);
+        return instance;
+    }
+    return created;
+}
+
+CHIP_ERROR AttributeUpdateBatcher::StageUpdate(const ConcreteAttributePath & path, EmberAfAttributeType type,
+                                               const uint8_t * value, size_t size)
+{
+    VerifyOrReturnError(value != nullptr && size <= kMaxValueSize, CHIP_ERROR_INVALID_ARGUMENT);
+
+    StagedUpdate update;
+    update.mPath = path;
+    update.mType = type;
+    memcpy(update.mValue, value, size);
+
+    VerifyOrReturnError(mStagedUpdates.TryPush(update), CHIP_ERROR_NO_MEMORY);
+
+    ScheduleApply();
+    return CHIP_NO_ERROR;
+}
+
+void AttributeUpdateBatcher::ScheduleApply()
+{
+    // One pending pass picks up everything staged before it runs.
+    VerifyOrReturn(!mApplyScheduled.exchange(true, std::memory_order_acq_rel));
+
+    CHIP_ERROR err = DeviceLayer::PlatformMgr().ScheduleWork(ApplyStagedUpdates, reinterpret_cast<intptr_t>(this));
+    if (err != CHIP_NO_ERROR)
+    {
+        ChipLogError(DataManagement, "Failed to schedule staged attribute updates: %" CHIP_ERROR_FORMAT, err.Format());
+        mApplyScheduled.store(false, std::memory_order_release);
+    }
+}
+
+void AttributeUpdateBatcher::ApplyStagedUpdates(intptr_t context)
+{
+    reinterpret_cast<AttributeUpdateBatcher *>(context)->ApplyStagedUpdates();
+}
+
+void AttributeUpdateBatcher::ApplyStagedUpdates()
+{
+    assertChipStackLockedByCurrentThread();
+
+    // Anything staged from here on schedules another pass.
+    mApplyScheduled.exchange(false, std::memory_order_acq_rel);
+
+    ConcreteAttributePath changedPaths[kBatchSize];
+    size_t changedCount = 0;
+    size_t appliedCount = 0;
+    StagedUpdate update;
+
+    // Bound the pass so a fast producer cannot keep the Matter thread here forever.
+    while (appliedCount < kBatchSize && mStagedUpdates.TryPop(update))
+    {
+        appliedCount++;
+
+        bool stored          = false;
+        EmberAfStatus status = emAfWriteAttribute(update.mPath.mEndpointId, update.mPath.mClusterId, update.mPath.mAttributeId,
+                                                  update.mValue, update.mType,
+                                                  true,     // override read-only?
+                                                  false,    // just test?
+                                                  false,    // mark dirty?
+                                                  &stored); // stored?
+        if (status != EMBER_ZCL_STATUS_SUCCESS)
+        {
+            ChipLogError(DataManagement, "Failed to apply staged update to %u/" ChipLogFormatMEI "/" ChipLogFormatMEI ": 0x%02x",
+                         update.mPath.mEndpointId, ChipLogValueMEI(update.mPath.mClusterId),
+                         ChipLogValueMEI(update.mPath.mAttributeId), static_cast<unsigned>(status));
+            continue;
+        }
+
+        if (!stored)
+        {
+            // A cluster asked for the write to be ignored, so there is nothing to report.
+            continue;
+        }
+
+        bool alreadyChanged = false;
+        for (size_t i = 0; i < changedCount && !alreadyChanged; i++)
+        {
+            alreadyChanged = (changedPaths[i] == update.mPath);
+        }
+        if (!alreadyChanged)
+        {
+            changedPaths[changedCount++] = update.mPath;
+        }
+    }
+
+    for (size_t i = 0; i < changedCount; i++)
+    {
+        MatterReportingAttributeChangeCallback(changedPaths[i]);
+    }
+
+    if (appliedCount == kBatchSize)
+    {
+        // There may be more; updates staged before this pass started did not schedule one of their own.
+        ScheduleApply();
+    }
+}
+
+} // namespace app
+} // namespace chip
@@ -0,0 +1,106 @@
+/*
+ *
+ *    Copyright (c) 2023 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ * @file
+ *   Lets threads other than the Matter thread update attributes without taking the stack lock.
+ */
+
+#pragma once
+
+#include <app/ConcreteAttributePath.h>
+#include <app/util/af-types.h>
+#include <app/util/attribute-storage-null-handling.h>
+#include <lib/core/CHIPConfig.h>
+#include <lib/core/CHIPError.h>
+#include <lib/support/MpscRing.h>
+
+#include <atomic>
+
+namespace chip {
+namespace app {
+
+/**
+ * Stages attribute updates from any thread and applies them on the Matter thread in batches.
+ *
+ * Staging an update never blocks: it goes into a lock-free queue, and the first update staged since the last batch
+ * schedules work on the Matter thread to apply everything staged so far. Within a batch, all values are stored
+ * first, then each distinct attribute is reported as changed once, however many times it was written.
+ *
+ * Values use the attribute store representation, as for emberAfWriteAttribute.
+ */
+class AttributeUpdateBatcher
+{
+public:
+    static constexpr size_t kMaxValueSize = CHIP_IM_ATTRIBUTE_UPDATE_MAX_VALUE_SIZE;
+
+    /**
+     * The batcher shared by the application. Safe to call from any thread.
+     *
+     * It is allocated on first use, since its queue takes a few KB that most applications never need.
+     *
+     * @return nullptr if it could not be allocated.
+     */
+    static AttributeUpdateBatcher * Instance();
+
+    /**
+     * Stage a new value for an attribute. Safe to call from any thread.
+     *
+     * @retval CHIP_ERROR_INVALID_ARGUMENT  The value is larger than kMaxValueSize.
+     * @retval CHIP_ERROR_NO_MEMORY         Too many updates are pending; try again once the Matter thread caught up.
+     */
+    CHIP_ERROR StageUpdate(const ConcreteAttributePath & path, EmberAfAttributeType type, const uint8_t * value, size_t size);
+
+    /**
+     * Convenience overload for numeric attributes, taking the value as the Attributes::X::Set accessors do.
+     */
+    template <typename T>
+    CHIP_ERROR StageUpdate(const ConcreteAttributePath & path, EmberAfAttributeType type, T value)
+    {
+        using Traits = NumericAttributeTraits<T>;
+        typename Traits::StorageType storageValue;
+        Traits::WorkingToStorage(value, storageValue);
+        return StageUpdate(path, type, Traits::ToAttributeStoreRepresentation(storageValue), sizeof(storageValue));
+    }
+
+    /**
+     * Apply the updates staged so far. Must be called with the stack lock held; it normally runs from work scheduled
+     * by StageUpdate.
+     */
+    void ApplyStagedUpdates();
+
+private:
+    struct StagedUpdate
+    {
+        ConcreteAttributePath mPath;
+        EmberAfAttributeType mType;
+        uint8_t mValue[kMaxValueSize];
+    };
+
+    static constexpr size_t kBatchSize = CHIP_IM_ATTRIBUTE_UPDATE_BATCH_SIZE;
+
+    static void ApplyStagedUpdates(intptr_t context);
+    void ScheduleApply();
+
+    static std::atomic<AttributeUpdateBatcher *> sInstance;
+
+    MpscRing<StagedUpdate, kBatchSize> mStagedUpdates;
+    std::atomic<bool> mApplyScheduled{ false };
+};
+
+} // namespace app
+} // namespace chip
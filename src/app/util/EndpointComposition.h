@@ -0,0 +1,150 @@
+/*
+ *
+ *    Copyright (c) 2023 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#pragma once
+
+#include <lib/core/CHIPError.h>
+#include <lib/core/DataModelTypes.h>
+#include <lib/support/CodeUtils.h>
+#include <lib/support/ScopedBuffer.h>
+#include <lib/support/Span.h>
+
+#include <stdint.h>
+#include <string.h>
+
+namespace chip {
+namespace app {
+
+/**
+ * The children and descendants of every endpoint, as listed by the Descriptor PartsList, computed once from the parent
+ * of each endpoint.
+ *
+ * Stored as compressed rows by endpoint index: the children of the endpoint at index i are
+ * mChildren[mChildrenStart[i]] up to mChildren[mChildrenStart[i + 1]], and likewise for descendants. Both are listed in
+ * endpoint index order.
+ */
+template <uint16_t kMaxEndpointCount>
+class EndpointComposition
+{
+public:
+    bool IsValid() const { return mValid; }
+    void Invalidate() { mValid = false; }
+
+    /**
+     * Rebuilds the lists for the endpoints at indices [0, count).
+     *
+     * @param endpoints   The ID of the endpoint at each index.
+     * @param parentIndex The index of the parent of the endpoint at each index. An index of count or more means the
+     *                    endpoint is not listed by any parent, which also ends the chain of ancestors of its children.
+     *
+     * @retval CHIP_ERROR_INVALID_ARGUMENT if count is more than kMaxEndpointCount.
+     * @retval CHIP_ERROR_NO_MEMORY if the descendants could not be allocated.
+     */
+    CHIP_ERROR Build(uint16_t count, const EndpointId * endpoints, const uint16_t * parentIndex)
+    {
+        mValid = false;
+        VerifyOrReturnError(count <= kMaxEndpointCount, CHIP_ERROR_INVALID_ARGUMENT);
+
+        // Count each row into the start of the next one, then turn the counts into offsets.
+        memset(mChildrenStart, 0, sizeof(mChildrenStart));
+        memset(mDescendantsStart, 0, sizeof(mDescendantsStart));
+        for (uint16_t i = 0; i < count; i++)
+        {
+            if (parentIndex[i] < count)
+            {
+                mChildrenStart[parentIndex[i] + 1]++;
+            }
+            // Bounding the depth keeps a misconfigured parent cycle from hanging here.
+            for (uint16_t ancestor = parentIndex[i], depth = 0; ancestor < count && depth < count;
+                 ancestor = parentIndex[ancestor], depth++)
+            {
+                mDescendantsStart[ancestor + 1]++;
+            }
+        }
+        for (uint16_t i = 0; i < count; i++)
+        {
+            mChildrenStart[i + 1] = static_cast<uint16_t>(mChildrenStart[i + 1] + mChildrenStart[i]);
+            mDescendantsStart[i + 1] += mDescendantsStart[i];
+        }
+        mCount = count;
+
+        mDescendants.Free();
+        if (mDescendantsStart[count] > 0)
+        {
+            mDescendants.Alloc(mDescendantsStart[count]);
+            VerifyOrReturnError(mDescendants, CHIP_ERROR_NO_MEMORY);
+        }
+
+        // Fill the rows, using the start of each row as its cursor. That leaves each start at the start of the next row,
+        // so shift them back afterwards.
+        for (uint16_t i = 0; i < count; i++)
+        {
+            if (parentIndex[i] < count)
+            {
+                mChildren[mChildrenStart[parentIndex[i]]++] = endpoints[i];
+            }
+            for (uint16_t ancestor = parentIndex[i], depth = 0; ancestor < count && depth < count;
+                 ancestor = parentIndex[ancestor], depth++)
+            {
+                mDescendants[mDescendantsStart[ancestor]++] = endpoints[i];
+            }
+        }
+        for (uint16_t i = count; i > 0; i--)
+        {
+            mChildrenStart[i]    = mChildrenStart[i - 1];
+            mDescendantsStart[i] = mDescendantsStart[i - 1];
+        }
+        mChildrenStart[0]    = 0;
+        mDescendantsStart[0] = 0;
+
+        mValid = true;
+        return CHIP_NO_ERROR;
+    }
+
+    /**
+     * The endpoints whose parent is the endpoint at the given index. Only valid until the next Build.
+     */
+    Span<const EndpointId> Children(uint16_t index) const
+    {
+        VerifyOrReturnValue(mValid && index < mCount, Span<const EndpointId>());
+        const uint16_t start = mChildrenStart[index];
+        return Span<const EndpointId>(&mChildren[start], static_cast<size_t>(mChildrenStart[index + 1] - start));
+    }
+
+    /**
+     * The endpoints below the endpoint at the given index, at any depth. Only valid until the next Build.
+     */
+    Span<const EndpointId> Descendants(uint16_t index) const
+    {
+        VerifyOrReturnValue(mValid && index < mCount, Span<const EndpointId>());
+        const uint32_t start = mDescendantsStart[index];
+        const uint32_t end   = mDescendantsStart[index + 1];
+        VerifyOrReturnValue(start != end, Span<const EndpointId>());
+        return Span<const EndpointId>(&mDescendants[start], end - start);
+    }
+
+private:
+    bool mValid     = false;
+    uint16_t mCount = 0;
+    uint16_t mChildrenStart[kMaxEndpointCount + 1];
+    uint32_t mDescendantsStart[kMaxEndpointCount + 1];
+    EndpointId mChildren[kMaxEndpointCount];
+    Platform::ScopedMemoryBuffer<EndpointId> mDescendants;
+};
+
+} // namespace app
+} // namespace chip
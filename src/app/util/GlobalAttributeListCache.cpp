@@ -0,0 +1,171 @@
+/*
+ *
+ *    Copyright (c) 2023 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#include <app/util/GlobalAttributeListCache.h>
+
+#include <lib/support/CHIPMem.h>
+#include <lib/support/CodeUtils.h>
+
+#include <cstdint>
+#include <cstring>
+#include <tuple>
+
+namespace chip {
+namespace app {
+
+namespace {
+
+auto EntryKey(const EmberAfCluster * cluster, EndpointId endpoint, AttributeId attribute)
+{
+    return std::make_tuple(reinterpret_cast<uintptr_t>(cluster), endpoint, attribute);
+}
+
+} // namespace
+
+void GlobalAttributeListCache::Validate(uint32_t endpointConfigurationGeneration, uint32_t commandHandlerListGeneration)
+{
+    VerifyOrReturn(endpointConfigurationGeneration != mEndpointConfigurationGeneration ||
+                   commandHandlerListGeneration != mCommandHandlerListGeneration);
+
+    mEndpointConfigurationGeneration = endpointConfigurationGeneration;
+    mCommandHandlerListGeneration    = commandHandlerListGeneration;
+
+    size_t kept = 0;
+    for (size_t i = 0; i < mCount; ++i)
+    {
+        if (mEntries[i].mEndpointId != kInvalidEndpointId)
+        {
+            Platform::MemoryFree(mEntries[i].mIds);
+            continue;
+        }
+        mEntries[kept++] = mEntries[i];
+    }
+    mCount = kept;
+}
+
+bool GlobalAttributeListCache::Find(const EmberAfCluster * cluster, EndpointId endpoint, AttributeId attribute,
+                                    Span<const uint32_t> & ids) const
+{
+    size_t index = LowerBound(cluster, endpoint, attribute);
+    VerifyOrReturnValue(Matches(index, cluster, endpoint, attribute), false);
+    ids = Span<const uint32_t>(mEntries[index].mIds, mEntries[index].mIdCount);
+    return true;
+}
+
+CHIP_ERROR GlobalAttributeListCache::Insert(const EmberAfCluster * cluster, EndpointId endpoint, AttributeId attribute,
+                                            Span<const uint32_t> ids)
+{
+    VerifyOrReturnError(cluster != nullptr, CHIP_ERROR_INVALID_ARGUMENT);
+
+    uint32_t * copy = nullptr;
+    if (!ids.empty())
+    {
+        copy = static_cast<uint32_t *>(Platform::MemoryAlloc(ids.size() * sizeof(uint32_t)));
+        VerifyOrReturnError(copy != nullptr, CHIP_ERROR_NO_MEMORY);
+        memcpy(copy, ids.data(), ids.size() * sizeof(uint32_t));
+    }
+
+    size_t index = LowerBound(cluster, endpoint, attribute);
+    if (Matches(index, cluster, endpoint, attribute))
+    {
+        Platform::MemoryFree(mEntries[index].mIds);
+    }
+    else
+    {
+        if (mCount == mCapacity)
+        {
+            size_t capacity = (mCapacity == 0) ? 8 : mCapacity * 2;
+            auto * entries  = static_cast<Entry *>(Platform::MemoryRealloc(mEntries, capacity * sizeof(Entry)));
+            if (entries == nullptr)
+            {
+                Platform::MemoryFree(copy);
+                return CHIP_ERROR_NO_MEMORY;
+            }
+            mEntries  = entries;
+            mCapacity = capacity;
+        }
+        memmove(&mEntries[index + 1], &mEntries[index], (mCount - index) * sizeof(Entry));
+        mCount++;
+    }
+
+    Entry & entry      = mEntries[index];
+    entry.mCluster     = cluster;
+    entry.mEndpointId  = endpoint;
+    entry.mAttributeId = attribute;
+    entry.mIds         = copy;
+    entry.mIdCount     = ids.size();
+    return CHIP_NO_ERROR;
+}
+
+void GlobalAttributeListCache::RemoveCluster(const EmberAfCluster * cluster)
+{
+    size_t index = LowerBound(cluster, 0, 0);
+    while (index < mCount && mEntries[index].mCluster == cluster)
+    {
+        RemoveAt(index);
+    }
+}
+
+void GlobalAttributeListCache::Clear()
+{
+    for (size_t i = 0; i < mCount; ++i)
+    {
+        Platform::MemoryFree(mEntries[i].mIds);
+    }
+    Platform::MemoryFree(mEntries);
+    mEntries  = nullptr;
+    mCount    = 0;
+    mCapacity = 0;
+}
+
+size_t GlobalAttributeListCache::LowerBound(const EmberAfCluster * cluster, EndpointId endpoint, AttributeId attribute) const
+{
+    const auto key = EntryKey(cluster, endpoint, attribute);
+    size_t low     = 0;
+    size_t high    = mCount;
+    while (low < high)
+    {
+        size_t middle       = low + (high - low) / 2;
+        const Entry & entry = mEntries[middle];
+        if (EntryKey(entry.mCluster, entry.mEndpointId, entry.mAttributeId) < key)
+        {
+            low = middle + 1;
+        }
+        else
+        {
+            high = middle;
+        }
+    }
+    return low;
+}
+
+bool GlobalAttributeListCache::Matches(size_t index, const EmberAfCluster * cluster, EndpointId endpoint,
+                                       AttributeId attribute) const
+{
+    return index < mCount && mEntries[index].mCluster == cluster && mEntries[index].mEndpointId == endpoint &&
+        mEntries[index].mAttributeId == attribute;
+}
+
+void GlobalAttributeListCache::RemoveAt(size_t index)
+{
+    Platform::MemoryFree(mEntries[index].mIds);
+    memmove(&mEntries[index], &mEntries[index + 1], (mCount - index - 1) * sizeof(Entry));
+    mCount--;
+}
+
+} // namespace app
+} // namespace chip
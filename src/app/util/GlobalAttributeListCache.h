@@ -0,0 +1,103 @@
+/*
+ *
+ *    Copyright (c) 2023 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ * @file
+ *   Keeps the ids of AttributeList, AcceptedCommandList and GeneratedCommandList values ready to encode.
+ */
+
+#pragma once
+
+#include <app/util/af-types.h>
+#include <lib/core/CHIPError.h>
+#include <lib/core/DataModelTypes.h>
+#include <lib/support/Span.h>
+
+namespace chip {
+namespace app {
+
+/**
+ * Ids of global list attributes, so that reading them does not walk the cluster metadata or call into a
+ * CommandHandlerInterface every time.
+ *
+ * An AttributeList only depends on the cluster metadata of an endpoint type, so it is stored once per EmberAfCluster,
+ * with kInvalidEndpointId as the endpoint, and shared by every endpoint of that type.  It stays until RemoveCluster is
+ * called for that EmberAfCluster.
+ *
+ * Command lists enumerated by a CommandHandlerInterface are stored per endpoint, and are all dropped when either the
+ * endpoint configuration generation or the command handler list generation passed to Validate changes.
+ *
+ * Entries are never evicted to make room for others, so reading every list of a large bridge does not keep rebuilding
+ * them.  They are kept sorted and looked up by binary search.
+ */
+class GlobalAttributeListCache
+{
+public:
+    GlobalAttributeListCache() = default;
+    ~GlobalAttributeListCache() { Clear(); }
+
+    GlobalAttributeListCache(const GlobalAttributeListCache &)             = delete;
+    GlobalAttributeListCache & operator=(const GlobalAttributeListCache &) = delete;
+
+    /**
+     * Drops all per-endpoint entries if either generation differs from the ones of the previous call.
+     */
+    void Validate(uint32_t endpointConfigurationGeneration, uint32_t commandHandlerListGeneration);
+
+    /**
+     * Returns true and sets ids if a list is stored for the given cluster, endpoint and attribute.
+     */
+    bool Find(const EmberAfCluster * cluster, EndpointId endpoint, AttributeId attribute, Span<const uint32_t> & ids) const;
+
+    /**
+     * Stores a copy of ids for the given cluster, endpoint and attribute, replacing any previous list.
+     */
+    CHIP_ERROR Insert(const EmberAfCluster * cluster, EndpointId endpoint, AttributeId attribute, Span<const uint32_t> ids);
+
+    /**
+     * Drops every list stored for cluster, e.g. once no endpoint uses its endpoint type anymore.
+     */
+    void RemoveCluster(const EmberAfCluster * cluster);
+
+    void Clear();
+
+    size_t EntryCount() const { return mCount; }
+
+private:
+    struct Entry
+    {
+        const EmberAfCluster * mCluster;
+        EndpointId mEndpointId;
+        AttributeId mAttributeId;
+        uint32_t * mIds;
+        size_t mIdCount;
+    };
+
+    // Index of the first entry not ordered before the given key.
+    size_t LowerBound(const EmberAfCluster * cluster, EndpointId endpoint, AttributeId attribute) const;
+    bool Matches(size_t index, const EmberAfCluster * cluster, EndpointId endpoint, AttributeId attribute) const;
+    void RemoveAt(size_t index);
+
+    Entry * mEntries                          = nullptr;
+    size_t mCount                             = 0;
+    size_t mCapacity                          = 0;
+    uint32_t mEndpointConfigurationGeneration = 0;
+    uint32_t mCommandHandlerListGeneration    = 0;
+};
+
+} // namespace app
+} // namespace chip
@@ -0,0 +1,106 @@
+/*
+ *
+ *    Copyright (c) 2023 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ * @file
+ *   Per-endpoint bookkeeping of the clusters whose initialization is deferred by CHIP_CONFIG_LAZY_CLUSTER_INIT.
+ */
+
+#pragma once
+
+#include <stdint.h>
+
+namespace chip {
+namespace app {
+
+/**
+ * Tracks, for the clusters of one endpoint, whether their attributes still have to be loaded and whether their init
+ * callbacks have been called.
+ *
+ * Clusters are identified by their index in the endpoint type, so that code which already found the EmberAfCluster
+ * does not have to look it up again by id.  Clusters at kMaxTrackedClusters and past are not tracked: they count as
+ * initialized, and have to be initialized eagerly.
+ */
+class LazyClusterInitState
+{
+public:
+    static constexpr uint8_t kMaxTrackedClusters = 64;
+
+    static constexpr bool IsTracked(uint8_t clusterIndex) { return clusterIndex < kMaxTrackedClusters; }
+
+    /**
+     * Records that the attributes of the cluster have to be loaded before it is first accessed.
+     */
+    void SetAttributeLoadPending(uint8_t clusterIndex)
+    {
+        if (IsTracked(clusterIndex))
+        {
+            mPendingAttributeLoads |= Bit(clusterIndex);
+        }
+    }
+
+    /**
+     * Returns true, once, if the attributes of the cluster have to be loaded now.
+     */
+    bool ClaimAttributeLoad(uint8_t clusterIndex) { return Claim(mPendingAttributeLoads, clusterIndex, true); }
+
+    void ClearAttributeLoads() { mPendingAttributeLoads = 0; }
+
+    /**
+     * Records that the init callbacks of the cluster have been called without going through ClaimInit.
+     */
+    void SetInitialized(uint8_t clusterIndex)
+    {
+        if (IsTracked(clusterIndex))
+        {
+            mInitializedClusters |= Bit(clusterIndex);
+        }
+    }
+
+    /**
+     * Returns true, once, if the init callbacks of the cluster have to be called now.
+     */
+    bool ClaimInit(uint8_t clusterIndex) { return Claim(mInitializedClusters, clusterIndex, false); }
+
+    bool IsInitialized(uint8_t clusterIndex) const
+    {
+        return !IsTracked(clusterIndex) || (mInitializedClusters & Bit(clusterIndex)) != 0;
+    }
+
+    void ClearInitialized() { mInitializedClusters = 0; }
+
+private:
+    static constexpr uint64_t Bit(uint8_t clusterIndex) { return static_cast<uint64_t>(1) << clusterIndex; }
+
+    // The bit is flipped before the caller does the work, since loading attributes and init callbacks access the
+    // cluster again.
+    static bool Claim(uint64_t & bits, uint8_t clusterIndex, bool claimWhenSet)
+    {
+        if (!IsTracked(clusterIndex) || ((bits & Bit(clusterIndex)) != 0) != claimWhenSet)
+        {
+            return false;
+        }
+        bits ^= Bit(clusterIndex);
+        return true;
+    }
+
+    uint64_t mPendingAttributeLoads = 0;
+    uint64_t mInitializedClusters   = 0;
+};
+
+} // namespace app
+} // namespace chip
@@ -31,6 +31,7 @@
 #include <app/util/basic-types.h>
 #include <app/util/types_stub.h> // For various types.
 
+#include <app/util/LazyClusterInitState.h>
 #include <app/util/attribute-metadata.h> // EmberAfAttributeMetadata
 
 #include <app/ConcreteAttributePath.h>
@@ -227,6 +228,13 @@ struct EmberAfDefinedEndpoint
      * Span pointing to a list of tags. Lifetime has to outlive usage, and data is owned by callers.
      */
     chip::Span<const chip::app::Clusters::Descriptor::Structs::SemanticTagStruct::Type> tagList;
+
+#if CHIP_CONFIG_LAZY_CLUSTER_INIT
+    /**
+     * Which clusters of endpointType have loaded their attributes and called their init callbacks.
+     */
+    chip::app::LazyClusterInitState lazyClusterInit;
+#endif // CHIP_CONFIG_LAZY_CLUSTER_INIT
 };
 
 // Cluster specific types
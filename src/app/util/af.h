@@ -40,6 +40,7 @@
 #include <lib/core/DataModelTypes.h>
 #include <lib/support/Iterators.h>
 #include <lib/support/SafeInt.h>
+#include <lib/support/Span.h>
 
 /** @name Attribute Storage */
 // @{
@@ -328,5 +329,29 @@ bool IsFlatCompositionForEndpoint(EndpointId endpoint);
  */
 bool IsTreeCompositionForEndpoint(EndpointId endpoint);
 
+/**
+ * @brief Gets the enabled endpoints whose parent is the given endpoint, in endpoint index order.
+ *
+ * The span stays valid until the endpoint configuration changes. Must be called with the stack lock held.
+ *
+ * @retval CHIP_ERROR_INVALID_ARGUMENT if the endpoint is not enabled.
+ */
+CHIP_ERROR GetChildEndpoints(EndpointId endpoint, Span<const EndpointId> & children);
+
+/**
+ * @brief Gets the enabled endpoints below the given endpoint at any depth, in endpoint index order.
+ *
+ * The span stays valid until the endpoint configuration changes. Must be called with the stack lock held.
+ *
+ * @retval CHIP_ERROR_INVALID_ARGUMENT if the endpoint is not enabled.
+ * @retval CHIP_ERROR_NO_MEMORY if the lists could not be rebuilt after a configuration change.
+ */
+CHIP_ERROR GetDescendantEndpoints(EndpointId endpoint, Span<const EndpointId> & descendants);
+
+/**
+ * @brief Returns a counter that changes whenever endpoints are added, removed, enabled, disabled or re-parented.
+ */
+uint32_t GetEndpointConfigurationGeneration();
+
 } // namespace app
 } // namespace chip
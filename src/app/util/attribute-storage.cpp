@@ -19,6 +19,7 @@
 #include <app/AttributePersistenceProvider.h>
 #include <app/InteractionModelEngine.h>
 #include <app/reporting/reporting.h>
+#include <app/util/EndpointComposition.h>
 #include <app/util/af.h>
 #include <app/util/attribute-storage.h>
 #include <app/util/config.h>
@@ -67,6 +68,26 @@ uint8_t singletonAttributeData[ACTUAL_SINGLETONS_SIZE];
 
 uint16_t emberEndpointCount = 0;
 
+// Children and descendants of every enabled endpoint, as used by the Descriptor PartsList. Rebuilt on the first lookup
+// after the endpoint configuration changes.
+EndpointComposition<MAX_ENDPOINT_COUNT> sEndpointComposition;
+
+// Bumped on every change to the set of endpoints, their types, or their parents, so that data derived from the
+// endpoint configuration elsewhere can tell when it is stale.
+uint32_t sEndpointConfigurationGeneration = 0;
+
+void EndpointConfigurationChanged()
+{
+    sEndpointComposition.Invalidate();
+    sEndpointConfigurationGeneration++;
+}
+
+#if CHIP_CONFIG_LAZY_CLUSTER_INIT
+// Set while emAfLoadAttributeDefaults writes attribute values, so that those writes do not initialize the cluster
+// before all of its attributes are loaded.
+bool sLoadingAttributeDefaults = false;
+#endif // CHIP_CONFIG_LAZY_CLUSTER_INIT
+
 // If we have attributes that are more than 4 bytes, then
 // we need this data block for the defaults
 #if (defined(GENERATED_DEFAULTS) && GENERATED_DEFAULTS_COUNT)
@@ -200,6 +221,8 @@ void emberAfEndpointConfigure()
         // Increment currentDataVersions by 1 (slot) for every server cluster
         // this endpoint has.
         currentDataVersions += emberAfClusterCountByIndex(ep, /* server = */ true);
+
+        emAfCacheGlobalAttributeLists(emAfEndpoints[ep].endpointType);
     }
 
 #if CHIP_DEVICE_CONFIG_DYNAMIC_ENDPOINT_COUNT
@@ -214,11 +237,14 @@ void emberAfEndpointConfigure()
         }
     }
 #endif
+
+    EndpointConfigurationChanged();
 }
 
 void emberAfSetDynamicEndpointCount(uint16_t dynamicEndpointCount)
 {
     emberEndpointCount = static_cast<uint16_t>(FIXED_ENDPOINT_COUNT + dynamicEndpointCount);
+    EndpointConfigurationChanged();
 }
 
 uint16_t emberAfGetDynamicIndexFromEndpoint(EndpointId id)
@@ -276,8 +302,12 @@ EmberAfStatus emberAfSetDynamicEndpoint(uint16_t index, EndpointId id, const Emb
     // Start the endpoint off as disabled.
     emAfEndpoints[index].bitmask.Clear(EmberAfEndpointOptions::isEnabled);
     emAfEndpoints[index].parentEndpointId = parentEndpointId;
+#if CHIP_CONFIG_LAZY_CLUSTER_INIT
+    emAfEndpoints[index].lazyClusterInit.ClearAttributeLoads();
+#endif // CHIP_CONFIG_LAZY_CLUSTER_INIT
 
     emberAfSetDynamicEndpointCount(MAX_ENDPOINT_COUNT - FIXED_ENDPOINT_COUNT);
+    emAfCacheGlobalAttributeLists(ep);
 
     // Initialize the data versions.
     size_t dataSize = sizeof(DataVersion) * serverClusterCount;
@@ -308,6 +338,20 @@ EndpointId emberAfClearDynamicEndpoint(uint16_t index)
         ep = emAfEndpoints[index].endpoint;
         emberAfEndpointEnableDisable(ep, false);
         emAfEndpoints[index].endpoint = kInvalidEndpointId;
+        EndpointConfigurationChanged();
+
+        // Drop the cached AttributeLists of the endpoint type once no endpoint refers to it, since it may then be freed or
+        // reused for different clusters.
+        bool typeInUse = false;
+        for (uint16_t i = 0; i < emberEndpointCount && !typeInUse; i++)
+        {
+            typeInUse = (emAfEndpoints[i].endpoint != kInvalidEndpointId &&
+                         emAfEndpoints[i].endpointType == emAfEndpoints[index].endpointType);
+        }
+        if (!typeInUse)
+        {
+            emAfUncacheGlobalAttributeLists(emAfEndpoints[index].endpointType);
+        }
     }
 
     return ep;
@@ -383,23 +427,84 @@ EmberAfStatus emAfClusterPreAttributeChangedCallback(const app::ConcreteAttribut
     return status;
 }
 
+static void initializeCluster(EmberAfDefinedEndpoint * definedEndpoint, const EmberAfCluster * cluster)
+{
+    EmberAfGenericClusterFunction f;
+    emberAfClusterInitCallback(definedEndpoint->endpoint, cluster->clusterId);
+    f = emberAfFindClusterFunction(cluster, CLUSTER_MASK_INIT_FUNCTION);
+    if (f != nullptr)
+    {
+        ((EmberAfInitFunction) f)(definedEndpoint->endpoint);
+    }
+}
+
+#if CHIP_CONFIG_LAZY_CLUSTER_INIT
+// Only server clusters are initialized on first access: client clusters are never accessed through the attribute
+// store or the Interaction Model, so nothing would ever initialize them.
+static bool isLazilyInitializedCluster(const EmberAfCluster * cluster, uint8_t clusterIndex)
+{
+    return emberAfClusterIsServer(cluster) && LazyClusterInitState::IsTracked(clusterIndex);
+}
+
+static void ensureClusterInitialized(EmberAfDefinedEndpoint * definedEndpoint, uint8_t clusterIndex)
+{
+    // Writes of the defaults being loaded.  The cluster is initialized once all of them are done.
+    VerifyOrReturn(!sLoadingAttributeDefaults);
+
+    const EmberAfCluster * cluster = &(definedEndpoint->endpointType->cluster[clusterIndex]);
+    if (definedEndpoint->lazyClusterInit.ClaimAttributeLoad(clusterIndex))
+    {
+        emAfLoadAttributeDefaults(definedEndpoint->endpoint, false, MakeOptional(cluster->clusterId));
+    }
+
+    if (definedEndpoint->lazyClusterInit.ClaimInit(clusterIndex))
+    {
+        initializeCluster(definedEndpoint, cluster);
+    }
+}
+#endif // CHIP_CONFIG_LAZY_CLUSTER_INIT
+
 static void initializeEndpoint(EmberAfDefinedEndpoint * definedEndpoint)
 {
     uint8_t clusterIndex;
     const EmberAfEndpointType * epType = definedEndpoint->endpointType;
+#if CHIP_CONFIG_LAZY_CLUSTER_INIT
+    definedEndpoint->lazyClusterInit.ClearInitialized();
+#endif // CHIP_CONFIG_LAZY_CLUSTER_INIT
     for (clusterIndex = 0; clusterIndex < epType->clusterCount; clusterIndex++)
     {
         const EmberAfCluster * cluster = &(epType->cluster[clusterIndex]);
-        EmberAfGenericClusterFunction f;
-        emberAfClusterInitCallback(definedEndpoint->endpoint, cluster->clusterId);
-        f = emberAfFindClusterFunction(cluster, CLUSTER_MASK_INIT_FUNCTION);
-        if (f != nullptr)
+#if CHIP_CONFIG_LAZY_CLUSTER_INIT
+        if (isLazilyInitializedCluster(cluster, clusterIndex))
         {
-            ((EmberAfInitFunction) f)(definedEndpoint->endpoint);
+            // Deferred until the cluster is first accessed.
+            continue;
         }
+        definedEndpoint->lazyClusterInit.SetInitialized(clusterIndex);
+#endif // CHIP_CONFIG_LAZY_CLUSTER_INIT
+        initializeCluster(definedEndpoint, cluster);
     }
 }
 
+void emberAfEnsureClusterInitialized(EndpointId endpoint, const EmberAfCluster * cluster)
+{
+#if CHIP_CONFIG_LAZY_CLUSTER_INIT
+    uint16_t index = emberAfIndexFromEndpoint(endpoint);
+    if (index == kEmberInvalidEndpointIndex || cluster == nullptr)
+    {
+        return;
+    }
+
+    // The state is indexed by the position of the cluster in the endpoint type, so the cluster is not looked up again.
+    const EmberAfEndpointType * epType = emAfEndpoints[index].endpointType;
+    if (cluster < epType->cluster || cluster >= epType->cluster + epType->clusterCount)
+    {
+        return;
+    }
+    ensureClusterInitialized(&(emAfEndpoints[index]), static_cast<uint8_t>(cluster - epType->cluster));
+#endif // CHIP_CONFIG_LAZY_CLUSTER_INIT
+}
+
 static void shutdownEndpoint(EmberAfDefinedEndpoint * definedEndpoint)
 {
     // Call shutdown callbacks from clusters, mainly for canceling pending timers
@@ -407,6 +512,12 @@ static void shutdownEndpoint(EmberAfDefinedEndpoint * definedEndpoint)
     const EmberAfEndpointType * epType = definedEndpoint->endpointType;
     for (clusterIndex = 0; clusterIndex < epType->clusterCount; clusterIndex++)
     {
+#if CHIP_CONFIG_LAZY_CLUSTER_INIT
+        if (!definedEndpoint->lazyClusterInit.IsInitialized(clusterIndex))
+        {
+            continue;
+        }
+#endif // CHIP_CONFIG_LAZY_CLUSTER_INIT
         const EmberAfCluster * cluster  = &(epType->cluster[clusterIndex]);
         EmberAfGenericClusterFunction f = emberAfFindClusterFunction(cluster, CLUSTER_MASK_SHUTDOWN_FUNCTION);
         if (f != nullptr)
@@ -592,6 +703,9 @@ EmberAfStatus emAfReadOrWriteAttribute(EmberAfAttributeSearchRecord * attRecord,
                 const EmberAfCluster * cluster = &(endpointType->cluster[clusterIndex]);
                 if (emAfMatchCluster(cluster, attRecord))
                 { // Got the cluster
+#if CHIP_CONFIG_LAZY_CLUSTER_INIT
+                    ensureClusterInitialized(&(emAfEndpoints[ep]), clusterIndex);
+#endif // CHIP_CONFIG_LAZY_CLUSTER_INIT
                     uint16_t attrIndex;
                     for (attrIndex = 0; attrIndex < cluster->attributeCount; attrIndex++)
                     {
@@ -935,8 +1049,11 @@ bool emberAfEndpointEnableDisable(EndpointId endpoint, bool enable)
 
     if (currentlyEnabled != enable)
     {
+        // Data derived from the endpoint configuration is dropped once the endpoint counts as enabled or disabled, so
+        // that a rebuild from the init or shutdown callbacks does not bring back the old state.
         if (enable)
         {
+            EndpointConfigurationChanged();
             initializeEndpoint(&(emAfEndpoints[index]));
             MatterReportingAttributeChangeCallback(endpoint);
         }
@@ -944,6 +1061,7 @@ bool emberAfEndpointEnableDisable(EndpointId endpoint, bool enable)
         {
             shutdownEndpoint(&(emAfEndpoints[index]));
             emAfEndpoints[index].bitmask.Clear(EmberAfEndpointOptions::isEnabled);
+            EndpointConfigurationChanged();
         }
 
         EndpointId parentEndpointId = emberAfParentEndpointFromIndex(index);
@@ -1187,11 +1305,46 @@ uint8_t emberAfGetClustersFromEndpoint(EndpointId endpoint, ClusterId * clusterL
 
 void emberAfInitializeAttributes(EndpointId endpoint)
 {
+#if CHIP_CONFIG_LAZY_CLUSTER_INIT
+    // Attributes of lazily initialized clusters are loaded when the cluster is first accessed, the others right away.
+    for (uint16_t ep = 0; ep < emberAfEndpointCount(); ep++)
+    {
+        EmberAfDefinedEndpoint * de = &(emAfEndpoints[ep]);
+        if (de->endpointType == nullptr ||
+            (endpoint != EMBER_BROADCAST_ENDPOINT && (de->endpoint != endpoint || !emberAfEndpointIndexIsEnabled(ep))))
+        {
+            continue;
+        }
+        for (uint8_t clusterIndex = 0; clusterIndex < de->endpointType->clusterCount; clusterIndex++)
+        {
+            const EmberAfCluster * cluster = &(de->endpointType->cluster[clusterIndex]);
+            if (isLazilyInitializedCluster(cluster, clusterIndex))
+            {
+                de->lazyClusterInit.SetAttributeLoadPending(clusterIndex);
+            }
+            else
+            {
+                emAfLoadAttributeDefaults(de->endpoint, false, MakeOptional(cluster->clusterId));
+            }
+        }
+    }
+#else
     emAfLoadAttributeDefaults(endpoint, false);
+#endif // CHIP_CONFIG_LAZY_CLUSTER_INIT
 }
 
 void emberAfResetAttributes(EndpointId endpoint)
 {
+#if CHIP_CONFIG_LAZY_CLUSTER_INIT
+    // The defaults replace whatever was still to be loaded from storage on first access.
+    for (uint16_t ep = 0; ep < emberAfEndpointCount(); ep++)
+    {
+        if (endpoint == EMBER_BROADCAST_ENDPOINT || emAfEndpoints[ep].endpoint == endpoint)
+        {
+            emAfEndpoints[ep].lazyClusterInit.ClearAttributeLoads();
+        }
+    }
+#endif // CHIP_CONFIG_LAZY_CLUSTER_INIT
     emAfLoadAttributeDefaults(endpoint, true);
 }
 
@@ -1206,6 +1359,10 @@ void emAfLoadAttributeDefaults(EndpointId endpoint, bool ignoreStorage, Optional
     auto * attrStorage = ignoreStorage ? nullptr : app::GetAttributePersistenceProvider();
     // Don't check whether we actually have an attrStorage here, because it's OK
     // to have one if none of our attributes have NVM storage.
+#if CHIP_CONFIG_LAZY_CLUSTER_INIT
+    bool wasLoadingAttributeDefaults = sLoadingAttributeDefaults;
+    sLoadingAttributeDefaults        = true;
+#endif // CHIP_CONFIG_LAZY_CLUSTER_INIT
 
     for (ep = 0; ep < epCount; ep++)
     {
@@ -1215,7 +1372,7 @@ void emAfLoadAttributeDefaults(EndpointId endpoint, bool ignoreStorage, Optional
             ep = emberAfIndexFromEndpoint(endpoint);
             if (ep == kEmberInvalidEndpointIndex)
             {
-                return;
+                break;
             }
         }
         de = &(emAfEndpoints[ep]);
@@ -1340,6 +1497,10 @@ void emAfLoadAttributeDefaults(EndpointId endpoint, bool ignoreStorage, Optional
             break;
         }
     }
+
+#if CHIP_CONFIG_LAZY_CLUSTER_INIT
+    sLoadingAttributeDefaults = wasLoadingAttributeDefaults;
+#endif // CHIP_CONFIG_LAZY_CLUSTER_INIT
 }
 
 // 'data' argument may be null, since we changed the ptrToDefaultValue
@@ -1456,6 +1617,7 @@ CHIP_ERROR SetParentEndpointForEndpoint(EndpointId childEndpoint, EndpointId par
         return CHIP_ERROR_INVALID_ARGUMENT;
     }
     emAfEndpoints[childIndex].parentEndpointId = parentEndpoint;
+    EndpointConfigurationChanged();
     return CHIP_NO_ERROR;
 }
 
@@ -1503,6 +1665,61 @@ bool IsTreeCompositionForEndpoint(EndpointId endpoint)
     return emAfEndpoints[index].bitmask.Has(EmberAfEndpointOptions::isTreeComposition);
 }
 
+namespace {
+
+CHIP_ERROR BuildEndpointComposition()
+{
+    const uint16_t count = emberAfEndpointCount();
+
+    // A disabled endpoint, or one whose parent is missing or disabled, is not listed by any parent.
+    EndpointId endpoints[MAX_ENDPOINT_COUNT];
+    uint16_t parentIndex[MAX_ENDPOINT_COUNT];
+    for (uint16_t i = 0; i < count; i++)
+    {
+        endpoints[i]   = emAfEndpoints[i].endpoint;
+        parentIndex[i] = emberAfEndpointIndexIsEnabled(i) ? emberAfIndexFromEndpoint(emAfEndpoints[i].parentEndpointId)
+                                                          : kEmberInvalidEndpointIndex;
+    }
+    return sEndpointComposition.Build(count, endpoints, parentIndex);
+}
+
+CHIP_ERROR LookUpEndpointComposition(EndpointId endpoint, uint16_t & index)
+{
+    assertChipStackLockedByCurrentThread();
+
+    index = emberAfIndexFromEndpoint(endpoint);
+    VerifyOrReturnError(index != kEmberInvalidEndpointIndex, CHIP_ERROR_INVALID_ARGUMENT);
+
+    if (!sEndpointComposition.IsValid())
+    {
+        ReturnErrorOnFailure(BuildEndpointComposition());
+    }
+    return CHIP_NO_ERROR;
+}
+
+} // namespace
+
+CHIP_ERROR GetChildEndpoints(EndpointId endpoint, Span<const EndpointId> & children)
+{
+    uint16_t index;
+    ReturnErrorOnFailure(LookUpEndpointComposition(endpoint, index));
+    children = sEndpointComposition.Children(index);
+    return CHIP_NO_ERROR;
+}
+
+CHIP_ERROR GetDescendantEndpoints(EndpointId endpoint, Span<const EndpointId> & descendants)
+{
+    uint16_t index;
+    ReturnErrorOnFailure(LookUpEndpointComposition(endpoint, index));
+    descendants = sEndpointComposition.Descendants(index);
+    return CHIP_NO_ERROR;
+}
+
+uint32_t GetEndpointConfigurationGeneration()
+{
+    return sEndpointConfigurationGeneration;
+}
+
 } // namespace app
 } // namespace chip
 
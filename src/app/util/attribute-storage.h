@@ -88,12 +88,23 @@ extern uint8_t attributeDefaults[]; // storage bucked for > 2b default values
 
 void emAfCallInits(void);
 
+// Makes sure the given server cluster, as found in the endpoint type of endpoint, has loaded its attributes and
+// called its init callbacks.  This only does any work when CHIP_CONFIG_LAZY_CLUSTER_INIT is enabled and the cluster
+// has not been accessed yet.  Looking up an attribute through the attribute store (e.g.
+// emberAfLocateAttributeMetadata) does the same for the cluster of that attribute.
+void emberAfEnsureClusterInitialized(chip::EndpointId endpoint, const EmberAfCluster * cluster);
+
 #define emberAfClusterIsClient(cluster) ((bool) (((cluster)->mask & CLUSTER_MASK_CLIENT) != 0))
 #define emberAfClusterIsServer(cluster) ((bool) (((cluster)->mask & CLUSTER_MASK_SERVER) != 0))
 
 // Initial configuration
 void emberAfEndpointConfigure(void);
 
+// Builds the cached AttributeList values of the server clusters of an endpoint type, and drops them once no endpoint
+// uses the type anymore.  These do nothing unless CHIP_CONFIG_CACHE_GLOBAL_ATTRIBUTE_LISTS is enabled.
+void emAfCacheGlobalAttributeLists(const EmberAfEndpointType * endpointType);
+void emAfUncacheGlobalAttributeLists(const EmberAfEndpointType * endpointType);
+
 EmberAfStatus emAfReadOrWriteAttribute(EmberAfAttributeSearchRecord * attRecord, const EmberAfAttributeMetadata ** metadata,
                                        uint8_t * buffer, uint16_t readLength, bool write);
 
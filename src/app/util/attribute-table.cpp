@@ -159,6 +159,24 @@ static bool IsNullValue(const uint8_t * data, uint16_t dataLen, bool isAttribute
 EmberAfStatus emAfWriteAttribute(EndpointId endpoint, ClusterId cluster, AttributeId attributeID, uint8_t * data,
                                  EmberAfAttributeType dataType, bool overrideReadOnlyAndDataType, bool justTest)
 {
+    return emAfWriteAttribute(endpoint, cluster, attributeID, data, dataType, overrideReadOnlyAndDataType, justTest,
+                              true,     // mark dirty?
+                              nullptr); // stored?
+}
+
+// if false is passed for markDirty, the caller takes over reporting the
+// change through MatterReportingAttributeChangeCallback; this lets several
+// writes to the same attribute be reported once. *stored, if given, tells
+// whether the value was actually written, and so needs reporting.
+EmberAfStatus emAfWriteAttribute(EndpointId endpoint, ClusterId cluster, AttributeId attributeID, uint8_t * data,
+                                 EmberAfAttributeType dataType, bool overrideReadOnlyAndDataType, bool justTest, bool markDirty,
+                                 bool * stored)
+{
+    if (stored != nullptr)
+    {
+        *stored = false;
+    }
+
     const EmberAfAttributeMetadata * metadata = nullptr;
     EmberAfAttributeSearchRecord record;
     record.endpoint      = endpoint;
@@ -280,7 +298,15 @@ EmberAfStatus emAfWriteAttribute(EndpointId endpoint, ClusterId cluster, Attribu
         // The callee will weed out attributes that do not need to be stored.
         emAfSaveAttributeToStorageIfNeeded(data, endpoint, cluster, metadata);
 
-        MatterReportingAttributeChangeCallback(endpoint, cluster, attributeID);
+        if (stored != nullptr)
+        {
+            *stored = true;
+        }
+
+        if (markDirty)
+        {
+            MatterReportingAttributeChangeCallback(endpoint, cluster, attributeID);
+        }
 
         // Post write attribute callback for all attributes changes, regardless
         // of cluster.
@@ -28,5 +28,12 @@ EmberAfStatus emberAfWriteAttributeExternal(chip::EndpointId endpoint, chip::Clu
 EmberAfStatus emAfWriteAttribute(chip::EndpointId endpoint, chip::ClusterId cluster, chip::AttributeId attributeID, uint8_t * data,
                                  EmberAfAttributeType dataType, bool overrideReadOnlyAndDataType, bool justTest);
 
+// Same, but when markDirty is false the change is not reported; the caller is
+// responsible for calling MatterReportingAttributeChangeCallback when
+// *stored is set, which is not the case for a write that was ignored.
+EmberAfStatus emAfWriteAttribute(chip::EndpointId endpoint, chip::ClusterId cluster, chip::AttributeId attributeID, uint8_t * data,
+                                 EmberAfAttributeType dataType, bool overrideReadOnlyAndDataType, bool justTest, bool markDirty,
+                                 bool * stored);
+
 EmberAfStatus emAfReadAttribute(chip::EndpointId endpoint, chip::ClusterId cluster, chip::AttributeId attributeID,
                                 uint8_t * dataPtr, uint16_t readLength, EmberAfAttributeType * dataType);
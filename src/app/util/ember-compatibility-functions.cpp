@@ -31,6 +31,7 @@
 #include <app/att-storage.h>
 #include <app/reporting/Engine.h>
 #include <app/reporting/reporting.h>
+#include <app/util/GlobalAttributeListCache.h>
 #include <app/util/af.h>
 #include <app/util/attribute-storage-null-handling.h>
 #include <app/util/attribute-storage.h>
@@ -43,6 +44,7 @@
 #include <lib/core/TLV.h>
 #include <lib/support/CodeUtils.h>
 #include <lib/support/SafeInt.h>
+#include <lib/support/ScopedBuffer.h>
 #include <lib/support/TypeTraits.h>
 #include <platform/LockTracker.h>
 #include <protocols/interaction_model/Constants.h>
@@ -51,7 +53,9 @@
 
 #include <zap-generated/endpoint_config.h>
 
+#include <cstring>
 #include <limits>
+#include <utility>
 
 using namespace chip;
 using namespace chip::app;
@@ -153,9 +157,18 @@ EmberAfAttributeType BaseType(EmberAfAttributeType type)
 
 using namespace chip::app::Compatibility;
 
+#if CHIP_IM_REPORT_BUILDER_THREADS > 0 && CHIP_CONFIG_LAZY_CLUSTER_INIT
+#error "CHIP_IM_REPORT_BUILDER_THREADS reads attributes concurrently, which would initialize clusters concurrently"
+#endif
+
 namespace {
 // Common buffer for ReadSingleClusterData & WriteSingleClusterData
+#if CHIP_IM_REPORT_BUILDER_THREADS > 0
+// Report builder threads run ReadSingleClusterData concurrently.
+thread_local uint8_t attributeData[kAttributeReadBufferSize];
+#else
 uint8_t attributeData[kAttributeReadBufferSize];
+#endif
 
 template <typename T>
 CHIP_ERROR attributeBufferToNumericTlvData(TLV::TLVWriter & writer, bool isNullable)
@@ -194,6 +207,9 @@ Protocols::InteractionModel::Status ServerClusterCommandExists(const ConcreteCom
         return Status::UnsupportedCluster;
     }
 
+    // The cluster init callbacks may register the command handler looked up below.
+    emberAfEnsureClusterInitialized(aCommandPath.mEndpointId, cluster);
+
     auto * commandHandler =
         InteractionModelEngine::GetInstance()->FindCommandHandler(aCommandPath.mEndpointId, aCommandPath.mClusterId);
     if (commandHandler)
@@ -310,6 +326,155 @@ protected:
     const EmberAfCluster * mCluster;
 };
 
+typedef CHIP_ERROR (CommandHandlerInterface::*CommandListEnumerator)(const ConcreteClusterPath & cluster,
+                                                                     CommandHandlerInterface::CommandIdCallback callback,
+                                                                     void * context);
+
+// Calls aFunction with each id of the AttributeList of aCluster, in ascending order.
+template <typename Function>
+CHIP_ERROR ForEachAttributeListEntry(const EmberAfCluster * aCluster, Function & aFunction)
+{
+    const size_t count     = aCluster->attributeCount;
+    bool addedExtraGlobals = false;
+    for (size_t i = 0; i < count; ++i)
+    {
+        AttributeId id              = aCluster->attributes[i].attributeId;
+        constexpr auto lastGlobalId = GlobalAttributesNotInMetadata[ArraySize(GlobalAttributesNotInMetadata) - 1];
+#if CHIP_CONFIG_ENABLE_EVENTLIST_ATTRIBUTE
+        // The GlobalAttributesNotInMetadata shouldn't have any gaps in their ids here.
+        static_assert(lastGlobalId - GlobalAttributesNotInMetadata[0] == ArraySize(GlobalAttributesNotInMetadata) - 1,
+                      "Ids in GlobalAttributesNotInMetadata not consecutive");
+#else
+        // If EventList is not supported. The GlobalAttributesNotInMetadata is missing one id here.
+        static_assert(lastGlobalId - GlobalAttributesNotInMetadata[0] == ArraySize(GlobalAttributesNotInMetadata),
+                      "Ids in GlobalAttributesNotInMetadata not consecutive (except EventList)");
+#endif // CHIP_CONFIG_ENABLE_EVENTLIST_ATTRIBUTE
+        if (!addedExtraGlobals && id > lastGlobalId)
+        {
+            for (const auto & globalId : GlobalAttributesNotInMetadata)
+            {
+                ReturnErrorOnFailure(aFunction(globalId));
+            }
+            addedExtraGlobals = true;
+        }
+        ReturnErrorOnFailure(aFunction(id));
+    }
+    if (!addedExtraGlobals)
+    {
+        for (const auto & globalId : GlobalAttributesNotInMetadata)
+        {
+            ReturnErrorOnFailure(aFunction(globalId));
+        }
+    }
+    return CHIP_NO_ERROR;
+}
+
+// Calls aFunction with each command id in a command list of the cluster at aClusterPath, as enumerated by aHandler.
+// Returns CHIP_ERROR_NOT_IMPLEMENTED if aHandler is null or does not enumerate that list.
+template <typename Function>
+CHIP_ERROR ForEachHandlerCommand(CommandHandlerInterface * aHandler, const ConcreteClusterPath & aClusterPath,
+                                 CommandListEnumerator aEnumerator, Function & aFunction)
+{
+    VerifyOrReturnError(aHandler != nullptr, CHIP_ERROR_NOT_IMPLEMENTED);
+
+    struct Context
+    {
+        Function & function;
+        CHIP_ERROR err;
+    } context{ aFunction, CHIP_NO_ERROR };
+    CHIP_ERROR err = (aHandler->*aEnumerator)(
+        aClusterPath,
+        [](CommandId command, void * closure) -> Loop {
+            auto * ctx = static_cast<Context *>(closure);
+            ctx->err   = ctx->function(command);
+            if (ctx->err != CHIP_NO_ERROR)
+            {
+                return Loop::Break;
+            }
+            return Loop::Continue;
+        },
+        &context);
+    VerifyOrReturnError(err != CHIP_ERROR_NOT_IMPLEMENTED, err);
+    return context.err;
+}
+
+// Calls aFunction with each command id in aClusterCommandList, a command list from the cluster metadata.
+template <typename Function>
+CHIP_ERROR ForEachMetadataCommand(const CommandId * aClusterCommandList, Function & aFunction)
+{
+    for (const CommandId * cmd = aClusterCommandList; cmd != nullptr && *cmd != kInvalidCommandId; cmd++)
+    {
+        ReturnErrorOnFailure(aFunction(*cmd));
+    }
+    return CHIP_NO_ERROR;
+}
+
+#if CHIP_CONFIG_CACHE_GLOBAL_ATTRIBUTE_LISTS
+
+GlobalAttributeListCache sGlobalListCache;
+
+// Returns the cache after dropping the command lists built for a different endpoint configuration or set of command
+// handlers.
+GlobalAttributeListCache & GlobalListCache()
+{
+    sGlobalListCache.Validate(GetEndpointConfigurationGeneration(),
+                              InteractionModelEngine::GetInstance()->GetCommandHandlerListGeneration());
+    return sGlobalListCache;
+}
+
+// Collects ids into a buffer that grows as needed, so that a list is only generated once to cache it.
+class IdCollector
+{
+public:
+    CHIP_ERROR operator()(uint32_t id)
+    {
+        if (mCount == mIds.AllocatedSize())
+        {
+            Platform::ScopedMemoryBufferWithSize<uint32_t> ids;
+            VerifyOrReturnError(ids.Alloc(mCount == 0 ? kInitialSize : mCount * 2), CHIP_ERROR_NO_MEMORY);
+            if (mCount > 0)
+            {
+                memcpy(ids.Get(), mIds.Get(), mCount * sizeof(uint32_t));
+            }
+            mIds = std::move(ids);
+        }
+        mIds[mCount++] = id;
+        return CHIP_NO_ERROR;
+    }
+
+    Span<const uint32_t> Ids() const { return Span<const uint32_t>(mIds.Get(), mCount); }
+
+private:
+    static constexpr size_t kInitialSize = 16;
+
+    Platform::ScopedMemoryBufferWithSize<uint32_t> mIds;
+    size_t mCount = 0;
+};
+
+CHIP_ERROR EncodeIds(AttributeValueEncoder & aEncoder, Span<const uint32_t> aIds)
+{
+    return aEncoder.EncodeList([aIds](const auto & encoder) {
+        for (uint32_t id : aIds)
+        {
+            ReturnErrorOnFailure(encoder.Encode(id));
+        }
+        return CHIP_NO_ERROR;
+    });
+}
+
+// Builds and caches the AttributeList of aCluster, which is shared by every endpoint using its endpoint type.
+CHIP_ERROR CacheAttributeList(const EmberAfCluster * aCluster, Span<const uint32_t> & aIds)
+{
+    IdCollector collector;
+    ReturnErrorOnFailure(ForEachAttributeListEntry(aCluster, collector));
+    ReturnErrorOnFailure(sGlobalListCache.Insert(aCluster, kInvalidEndpointId, Clusters::Globals::Attributes::AttributeList::Id,
+                                                 collector.Ids()));
+    VerifyOrDie(sGlobalListCache.Find(aCluster, kInvalidEndpointId, Clusters::Globals::Attributes::AttributeList::Id, aIds));
+    return CHIP_NO_ERROR;
+}
+
+#endif // CHIP_CONFIG_CACHE_GLOBAL_ATTRIBUTE_LISTS
+
 class GlobalAttributeReader : public MandatoryGlobalAttributeReader
 {
 public:
@@ -318,11 +483,8 @@ public:
     CHIP_ERROR Read(const ConcreteReadAttributePath & aPath, AttributeValueEncoder & aEncoder) override;
 
 private:
-    typedef CHIP_ERROR (CommandHandlerInterface::*CommandListEnumerator)(const ConcreteClusterPath & cluster,
-                                                                         CommandHandlerInterface::CommandIdCallback callback,
-                                                                         void * context);
-    static CHIP_ERROR EncodeCommandList(const ConcreteClusterPath & aClusterPath, AttributeValueEncoder & aEncoder,
-                                        CommandListEnumerator aEnumerator, const CommandId * aClusterCommandList);
+    CHIP_ERROR EncodeCommandList(const ConcreteReadAttributePath & aPath, AttributeValueEncoder & aEncoder,
+                                 CommandListEnumerator aEnumerator, const CommandId * aClusterCommandList);
 };
 
 CHIP_ERROR GlobalAttributeReader::Read(const ConcreteReadAttributePath & aPath, AttributeValueEncoder & aEncoder)
@@ -330,42 +492,20 @@ CHIP_ERROR GlobalAttributeReader::Read(const ConcreteReadAttributePath & aPath,
     using namespace Clusters::Globals::Attributes;
     switch (aPath.mAttributeId)
     {
-    case AttributeList::Id:
+    case AttributeList::Id: {
+#if CHIP_CONFIG_CACHE_GLOBAL_ATTRIBUTE_LISTS
+        Span<const uint32_t> ids;
+        if (GlobalListCache().Find(mCluster, kInvalidEndpointId, AttributeList::Id, ids) ||
+            CacheAttributeList(mCluster, ids) == CHIP_NO_ERROR)
+        {
+            return EncodeIds(aEncoder, ids);
+        }
+#endif // CHIP_CONFIG_CACHE_GLOBAL_ATTRIBUTE_LISTS
         return aEncoder.EncodeList([this](const auto & encoder) {
-            const size_t count     = mCluster->attributeCount;
-            bool addedExtraGlobals = false;
-            for (size_t i = 0; i < count; ++i)
-            {
-                AttributeId id              = mCluster->attributes[i].attributeId;
-                constexpr auto lastGlobalId = GlobalAttributesNotInMetadata[ArraySize(GlobalAttributesNotInMetadata) - 1];
-#if CHIP_CONFIG_ENABLE_EVENTLIST_ATTRIBUTE
-                // The GlobalAttributesNotInMetadata shouldn't have any gaps in their ids here.
-                static_assert(lastGlobalId - GlobalAttributesNotInMetadata[0] == ArraySize(GlobalAttributesNotInMetadata) - 1,
-                              "Ids in GlobalAttributesNotInMetadata not consecutive");
-#else
-                // If EventList is not supported. The GlobalAttributesNotInMetadata is missing one id here.
-                static_assert(lastGlobalId - GlobalAttributesNotInMetadata[0] == ArraySize(GlobalAttributesNotInMetadata),
-                              "Ids in GlobalAttributesNotInMetadata not consecutive (except EventList)");
-#endif // CHIP_CONFIG_ENABLE_EVENTLIST_ATTRIBUTE
-                if (!addedExtraGlobals && id > lastGlobalId)
-                {
-                    for (const auto & globalId : GlobalAttributesNotInMetadata)
-                    {
-                        ReturnErrorOnFailure(encoder.Encode(globalId));
-                    }
-                    addedExtraGlobals = true;
-                }
-                ReturnErrorOnFailure(encoder.Encode(id));
-            }
-            if (!addedExtraGlobals)
-            {
-                for (const auto & globalId : GlobalAttributesNotInMetadata)
-                {
-                    ReturnErrorOnFailure(encoder.Encode(globalId));
-                }
-            }
-            return CHIP_NO_ERROR;
+            auto encodeId = [&encoder](uint32_t id) { return encoder.Encode(id); };
+            return ForEachAttributeListEntry(mCluster, encodeId);
         });
+    }
 #if CHIP_CONFIG_ENABLE_EVENTLIST_ATTRIBUTE
     case EventList::Id:
         return aEncoder.EncodeList([this](const auto & encoder) {
@@ -393,44 +533,36 @@ CHIP_ERROR GlobalAttributeReader::Read(const ConcreteReadAttributePath & aPath,
     }
 }
 
-CHIP_ERROR GlobalAttributeReader::EncodeCommandList(const ConcreteClusterPath & aClusterPath, AttributeValueEncoder & aEncoder,
-                                                    GlobalAttributeReader::CommandListEnumerator aEnumerator,
-                                                    const CommandId * aClusterCommandList)
+CHIP_ERROR GlobalAttributeReader::EncodeCommandList(const ConcreteReadAttributePath & aPath, AttributeValueEncoder & aEncoder,
+                                                    CommandListEnumerator aEnumerator, const CommandId * aClusterCommandList)
 {
-    return aEncoder.EncodeList([&](const auto & encoder) {
-        auto * commandHandler =
-            InteractionModelEngine::GetInstance()->FindCommandHandler(aClusterPath.mEndpointId, aClusterPath.mClusterId);
-        if (commandHandler)
-        {
-            struct Context
-            {
-                decltype(encoder) & commandIdEncoder;
-                CHIP_ERROR err;
-            } context{ encoder, CHIP_NO_ERROR };
-            CHIP_ERROR err = (commandHandler->*aEnumerator)(
-                aClusterPath,
-                [](CommandId command, void * closure) -> Loop {
-                    auto * ctx = static_cast<Context *>(closure);
-                    ctx->err   = ctx->commandIdEncoder.Encode(command);
-                    if (ctx->err != CHIP_NO_ERROR)
-                    {
-                        return Loop::Break;
-                    }
-                    return Loop::Continue;
-                },
-                &context);
-            if (err != CHIP_ERROR_NOT_IMPLEMENTED)
-            {
-                return context.err;
-            }
-            // Else fall through to the list in aClusterCommandList.
-        }
+#if CHIP_CONFIG_CACHE_GLOBAL_ATTRIBUTE_LISTS
+    Span<const uint32_t> ids;
+    if (GlobalListCache().Find(mCluster, aPath.mEndpointId, aPath.mAttributeId, ids))
+    {
+        return EncodeIds(aEncoder, ids);
+    }
+#endif // CHIP_CONFIG_CACHE_GLOBAL_ATTRIBUTE_LISTS
 
-        for (const CommandId * cmd = aClusterCommandList; cmd != nullptr && *cmd != kInvalidCommandId; cmd++)
-        {
-            ReturnErrorOnFailure(encoder.Encode(*cmd));
-        }
-        return CHIP_NO_ERROR;
+    auto * commandHandler = InteractionModelEngine::GetInstance()->FindCommandHandler(aPath.mEndpointId, aPath.mClusterId);
+
+#if CHIP_CONFIG_CACHE_GLOBAL_ATTRIBUTE_LISTS
+    // Only lists enumerated by a handler are cached, per endpoint.  Lists from the cluster metadata are encoded straight
+    // from it.
+    IdCollector collector;
+    if (ForEachHandlerCommand(commandHandler, aPath, aEnumerator, collector) == CHIP_NO_ERROR)
+    {
+        // If the list cannot be cached, the next read enumerates it again.
+        LogErrorOnFailure(sGlobalListCache.Insert(mCluster, aPath.mEndpointId, aPath.mAttributeId, collector.Ids()));
+        return EncodeIds(aEncoder, collector.Ids());
+    }
+#endif // CHIP_CONFIG_CACHE_GLOBAL_ATTRIBUTE_LISTS
+
+    return aEncoder.EncodeList([&](const auto & encoder) {
+        auto encodeId  = [&encoder](uint32_t id) { return encoder.Encode(id); };
+        CHIP_ERROR err = ForEachHandlerCommand(commandHandler, aPath, aEnumerator, encodeId);
+        VerifyOrReturnError(err == CHIP_ERROR_NOT_IMPLEMENTED, err);
+        return ForEachMetadataCommand(aClusterCommandList, encodeId);
     });
 }
 
@@ -511,6 +643,24 @@ bool ConcreteAttributePathExists(const ConcreteAttributePath & aPath)
     return (emberAfLocateAttributeMetadata(aPath.mEndpointId, aPath.mClusterId, aPath.mAttributeId) != nullptr);
 }
 
+#if CHIP_IM_REPORT_BUILDER_THREADS > 0
+bool IsConcurrentReadSafe(const ConcreteAttributePath & aPath)
+{
+    // Global attributes not in metadata and attribute access interfaces are read through application code.
+    for (auto & attr : GlobalAttributesNotInMetadata)
+    {
+        VerifyOrReturnValue(attr != aPath.mAttributeId, false);
+    }
+    VerifyOrReturnValue(GetAttributeAccessOverride(aPath.mEndpointId, aPath.mClusterId) == nullptr, false);
+
+    // Attributes in the attribute store are only written with the stack lock held, externally stored ones are up to the
+    // application.
+    const EmberAfAttributeMetadata * attributeMetadata =
+        emberAfLocateAttributeMetadata(aPath.mEndpointId, aPath.mClusterId, aPath.mAttributeId);
+    return attributeMetadata != nullptr && !attributeMetadata->IsExternal();
+}
+#endif
+
 CHIP_ERROR ReadSingleClusterData(const SubjectDescriptor & aSubjectDescriptor, bool aIsFabricFiltered,
                                  const ConcreteReadAttributePath & aPath, AttributeReportIBs::Builder & aAttributeReports,
                                  AttributeValueEncoder::AttributeEncodeState * apEncoderState)
@@ -546,6 +696,13 @@ CHIP_ERROR ReadSingleClusterData(const SubjectDescriptor & aSubjectDescriptor, b
         return SendFailureStatus(aPath, aAttributeReports, UnsupportedAttributeStatus(aPath), nullptr);
     }
 
+    // The cluster init callbacks may register the attribute access or command handler interfaces used below. Finding
+    // attributeMetadata already did that for its cluster.
+    if (attributeCluster != nullptr)
+    {
+        emberAfEnsureClusterInitialized(aPath.mEndpointId, attributeCluster);
+    }
+
     // Check access control. A failed check will disallow the operation, and may or may not generate an attribute report
     // depending on whether the path was expanded.
 
@@ -966,6 +1123,8 @@ const EmberAfAttributeMetadata * GetAttributeMetadata(const ConcreteAttributePat
 CHIP_ERROR WriteSingleClusterData(const SubjectDescriptor & aSubjectDescriptor, const ConcreteDataAttributePath & aPath,
                                   TLV::TLVReader & aReader, WriteHandler * apWriteHandler)
 {
+    // Finding the metadata also initializes the cluster, whose init callbacks may register the attribute access
+    // interface used below.
     const EmberAfAttributeMetadata * attributeMetadata = GetAttributeMetadata(aPath);
 
     if (attributeMetadata == nullptr)
@@ -1139,3 +1298,30 @@ void MatterReportingAttributeChangeCallback(EndpointId endpoint)
 
     InteractionModelEngine::GetInstance()->GetReportingEngine().SetDirty(info);
 }
+
+void emAfCacheGlobalAttributeLists(const EmberAfEndpointType * endpointType)
+{
+#if CHIP_CONFIG_CACHE_GLOBAL_ATTRIBUTE_LISTS
+    for (uint8_t i = 0; i < endpointType->clusterCount; i++)
+    {
+        const EmberAfCluster * cluster = &endpointType->cluster[i];
+        Span<const uint32_t> ids;
+        if (emberAfClusterIsServer(cluster) &&
+            !sGlobalListCache.Find(cluster, kInvalidEndpointId, Clusters::Globals::Attributes::AttributeList::Id, ids))
+        {
+            // A list that could not be built now is built on its first read instead.
+            LogErrorOnFailure(CacheAttributeList(cluster, ids));
+        }
+    }
+#endif // CHIP_CONFIG_CACHE_GLOBAL_ATTRIBUTE_LISTS
+}
+
+void emAfUncacheGlobalAttributeLists(const EmberAfEndpointType * endpointType)
+{
+#if CHIP_CONFIG_CACHE_GLOBAL_ATTRIBUTE_LISTS
+    for (uint8_t i = 0; i < endpointType->clusterCount; i++)
+    {
+        sGlobalListCache.RemoveCluster(&endpointType->cluster[i]);
+    }
+#endif // CHIP_CONFIG_CACHE_GLOBAL_ATTRIBUTE_LISTS
+}
@@ -24,6 +24,7 @@
 #include <app/util/config.h>
 #include <app/util/generic-callbacks.h>
 #include <lib/core/CHIPConfig.h>
+#include <system/SystemClock.h>
 
 // TODO: figure out a clear path for compile-time codegen
 #include <app/PluginApplicationCallbacks.h>
@@ -104,11 +105,17 @@ EmberAfDifferenceType emberAfGetDifference(uint8_t * pData, EmberAfDifferenceTyp
 // ****************************************
 void emberAfInit()
 {
+    const System::Clock::Milliseconds64 startTime = System::SystemClock().GetMonotonicMilliseconds64();
+
     emberAfInitializeAttributes(EMBER_BROADCAST_ENDPOINT);
 
     MATTER_PLUGINS_INIT
 
     emAfCallInits();
+
+    ChipLogProgress(Zcl, "Cluster initialization took %" PRIu64 " ms%s",
+                    static_cast<uint64_t>((System::SystemClock().GetMonotonicMilliseconds64() - startTime).count()),
+                    CHIP_CONFIG_LAZY_CLUSTER_INIT ? " (lazy cluster init enabled)" : "");
 }
 
 // Cluster init functions that don't have a cluster implementation to define
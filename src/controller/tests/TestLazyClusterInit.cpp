@@ -0,0 +1,172 @@
+/*
+ *
+ *    Copyright (c) 2023 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *      This file implements unit tests for the clusters initialized on first access with CHIP_CONFIG_LAZY_CLUSTER_INIT,
+ *      through the attribute store.
+ *
+ */
+
+#include <app-common/zap-generated/ids/Clusters.h>
+#include <app/tests/AppTestContext.h>
+#include <app/util/attribute-storage.h>
+#include <app/util/attribute-table.h>
+#include <app/util/endpoint-config-defines.h>
+#include <lib/support/UnitTestContext.h>
+#include <lib/support/UnitTestRegistration.h>
+#include <nlunit-test.h>
+
+using TestContext = chip::Test::AppContext;
+
+using namespace chip;
+using namespace chip::app;
+
+namespace {
+
+constexpr EndpointId kTestEndpointId      = 1;
+constexpr ClusterId kTestClusterId        = Clusters::UnitTesting::Id;
+constexpr AttributeId kFirstAttributeId   = 0x0000;
+constexpr AttributeId kSecondAttributeId  = 0x0001;
+constexpr AttributeId kClusterInitialized = kInvalidAttributeId;
+
+// Attributes of the test cluster written by the attribute store, and kClusterInitialized for its init callback, in order.
+AttributeId sEvents[8];
+size_t sEventCount = 0;
+
+void RecordEvent(AttributeId event)
+{
+    if (sEventCount < ArraySize(sEvents))
+    {
+        sEvents[sEventCount++] = event;
+    }
+}
+
+void TestClusterInitCallback(EndpointId endpoint)
+{
+    RecordEvent(kClusterInitialized);
+
+    // Accessing the cluster from its init callback does not initialize it again.
+    emberAfReadAttribute(endpoint, kTestClusterId, kSecondAttributeId, nullptr, 0);
+}
+
+const EmberAfGenericClusterFunction testClusterFunctions[] = {
+    (EmberAfGenericClusterFunction) TestClusterInitCallback,
+};
+
+// Unlike DECLARE_DYNAMIC_ATTRIBUTE, these have defaults for the attribute store to load.
+const EmberAfAttributeMetadata testClusterAttrs[] = {
+    { ZAP_SIMPLE_DEFAULT(1), kFirstAttributeId, 1, ZAP_TYPE(INT8U), 0 },
+    { ZAP_SIMPLE_DEFAULT(2), kSecondAttributeId, 1, ZAP_TYPE(INT8U), 0 },
+    { ZAP_EMPTY_DEFAULT(), 0xFFFD, 2, ZAP_TYPE(INT16U), ZAP_ATTRIBUTE_MASK(EXTERNAL_STORAGE) }, /* cluster revision */
+};
+
+const EmberAfCluster testEndpointClusters[] = {
+    { kTestClusterId, testClusterAttrs, ArraySize(testClusterAttrs), 0,
+      ZAP_CLUSTER_MASK(SERVER) | ZAP_CLUSTER_MASK(INIT_FUNCTION), testClusterFunctions, nullptr, nullptr },
+};
+
+const EmberAfEndpointType testEndpoint = { testEndpointClusters, ArraySize(testEndpointClusters), 0 };
+
+void SetUpTestEndpoint(nlTestSuite * apSuite, Span<DataVersion> dataVersionStorage)
+{
+    sEventCount = 0;
+
+    // The server cluster is not initialized with the endpoint, and its attributes are loaded on its first access.
+    NL_TEST_ASSERT(apSuite,
+                   emberAfSetDynamicEndpoint(0, kTestEndpointId, &testEndpoint, dataVersionStorage) == EMBER_ZCL_STATUS_SUCCESS);
+    emberAfInitializeAttributes(kTestEndpointId);
+    NL_TEST_ASSERT(apSuite, sEventCount == 0);
+}
+
+void TestLoadAttributesBeforeInit(nlTestSuite * apSuite, void * apContext)
+{
+    DataVersion dataVersionStorage[ArraySize(testEndpointClusters)];
+    SetUpTestEndpoint(apSuite, Span<DataVersion>(dataVersionStorage));
+
+    // The first access loads every attribute of the cluster, and only then calls its init callback.
+    emberAfReadAttribute(kTestEndpointId, kTestClusterId, kFirstAttributeId, nullptr, 0);
+    NL_TEST_ASSERT(apSuite, sEventCount == 3);
+    NL_TEST_ASSERT(apSuite, sEvents[0] == kFirstAttributeId);
+    NL_TEST_ASSERT(apSuite, sEvents[1] == kSecondAttributeId);
+    NL_TEST_ASSERT(apSuite, sEvents[2] == kClusterInitialized);
+
+    // Later accesses do neither.
+    emberAfReadAttribute(kTestEndpointId, kTestClusterId, kSecondAttributeId, nullptr, 0);
+    NL_TEST_ASSERT(apSuite, sEventCount == 3);
+
+    emberAfClearDynamicEndpoint(0);
+}
+
+void TestResetDropsPendingLoads(nlTestSuite * apSuite, void * apContext)
+{
+    DataVersion dataVersionStorage[ArraySize(testEndpointClusters)];
+    SetUpTestEndpoint(apSuite, Span<DataVersion>(dataVersionStorage));
+
+    // Resetting writes the defaults without initializing the cluster.
+    emberAfResetAttributes(kTestEndpointId);
+    NL_TEST_ASSERT(apSuite, sEventCount == 2);
+    NL_TEST_ASSERT(apSuite, sEvents[0] == kFirstAttributeId);
+    NL_TEST_ASSERT(apSuite, sEvents[1] == kSecondAttributeId);
+
+    // The first access then only initializes the cluster: the values it would have loaded were replaced by the reset.
+    emberAfReadAttribute(kTestEndpointId, kTestClusterId, kFirstAttributeId, nullptr, 0);
+    NL_TEST_ASSERT(apSuite, sEventCount == 3);
+    NL_TEST_ASSERT(apSuite, sEvents[2] == kClusterInitialized);
+
+    emberAfClearDynamicEndpoint(0);
+}
+
+// clang-format off
+const nlTest sTests[] =
+{
+    NL_TEST_DEF("TestLoadAttributesBeforeInit", TestLoadAttributesBeforeInit),
+    NL_TEST_DEF("TestResetDropsPendingLoads", TestResetDropsPendingLoads),
+    NL_TEST_SENTINEL()
+};
+
+// clang-format on
+
+// clang-format off
+nlTestSuite sSuite =
+{
+    "TestLazyClusterInit",
+    &sTests[0],
+    TestContext::Initialize,
+    TestContext::Finalize
+};
+// clang-format on
+
+} // namespace
+
+// The attribute store checks write access before storing any value, including the defaults it loads.
+bool emberAfAttributeWriteAccessCallback(EndpointId endpoint, ClusterId clusterId, AttributeId attributeId)
+{
+    if (endpoint == kTestEndpointId && clusterId == kTestClusterId)
+    {
+        RecordEvent(attributeId);
+    }
+    return true;
+}
+
+int TestLazyClusterInit()
+{
+    return chip::ExecuteTestsWithContext<TestContext>(&sSuite);
+}
+
+CHIP_REGISTER_TEST_SUITE(TestLazyClusterInit)
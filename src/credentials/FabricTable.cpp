@@ -1882,6 +1882,16 @@ CHIP_ERROR FabricTable::CommitPendingFabricData()
         ChipLogError(FabricProvisioning, "Failed to store commit marker, may be inconsistent if reboot happens during fail-safe!");
     }
 
+    // Storage backends that support it persist the whole commit atomically. The commit marker above stays
+    // outside, since it is what allows cleaning up after a reboot on backends that apply each write directly.
+    CHIP_ERROR transactionErr = mStorage->BeginTransaction();
+    if (transactionErr != CHIP_NO_ERROR)
+    {
+        ChipLogError(FabricProvisioning, "Failed to start storage transaction, committing key by key: %" CHIP_ERROR_FORMAT,
+                     transactionErr.Format());
+    }
+    const bool inTransaction = (transactionErr == CHIP_NO_ERROR);
+
     {
         // This scope block is to illustrate the complete commit transaction
         // state. We can see it contains a LARGE number of items...
@@ -1941,6 +1951,11 @@ CHIP_ERROR FabricTable::CommitPendingFabricData()
                 mPendingFabric.Reset();
 
                 ChipLogError(FabricProvisioning, "Aborting commit in middle of transaction for testing.");
+                // Keep what was written so far, as a backend without transaction support would have.
+                if (inTransaction)
+                {
+                    (void) mStorage->CommitTransaction();
+                }
                 return CHIP_ERROR_INTERNAL;
             }
         }
@@ -1982,6 +1997,23 @@ CHIP_ERROR FabricTable::CommitPendingFabricData()
         stickyError = (stickyError != CHIP_NO_ERROR) ? stickyError : fabricIndexErr;
     }
 
+    if (inTransaction)
+    {
+        if (stickyError == CHIP_NO_ERROR)
+        {
+            stickyError = mStorage->CommitTransaction();
+            if (stickyError != CHIP_NO_ERROR)
+            {
+                ChipLogError(FabricProvisioning, "Failed to commit storage transaction: %" CHIP_ERROR_FORMAT, stickyError.Format());
+            }
+        }
+        else
+        {
+            // Drop the partial commit, so that the clean-up below starts from the state before it.
+            mStorage->AbortTransaction();
+        }
+    }
+
     // Commit must have same side-effect as reverting all pending data
     mStateFlags.ClearAll();
     mFabricIndexWithPendingState = kUndefinedFabricIndex;
@@ -561,6 +561,43 @@ void TestEndpointIterator(nlTestSuite * apSuite, void * apContext)
         NL_TEST_ASSERT(apSuite, count == it->Count());
         it->Release();
     }
+
+    // Iterate a single group of fabric 1
+
+    std::set<std::pair<GroupId, EndpointId>> expected_g2 = {
+        { kGroup2, kEndpointId1 },
+        { kGroup2, kEndpointId2 },
+        { kGroup2, kEndpointId3 },
+    };
+
+    it = provider->IterateEndpoints(kFabric1, MakeOptional(kGroup2));
+    NL_TEST_ASSERT(apSuite, it);
+    if (it)
+    {
+        count = 0;
+        GroupEndpoint output;
+        NL_TEST_ASSERT(apSuite, expected_g2.size() == it->Count());
+        while (it->Next(output) && count < expected_g2.size())
+        {
+            std::pair<chip::GroupId, chip::EndpointId> mapping(output.group_id, output.endpoint_id);
+            NL_TEST_ASSERT(apSuite, expected_g2.count(mapping) > 0);
+            count++;
+        }
+        NL_TEST_ASSERT(apSuite, count == it->Count());
+        it->Release();
+    }
+
+    // Iterate a group not present in fabric 2
+
+    it = provider->IterateEndpoints(kFabric2, MakeOptional(kGroup1));
+    NL_TEST_ASSERT(apSuite, it);
+    if (it)
+    {
+        GroupEndpoint output;
+        NL_TEST_ASSERT(apSuite, 0 == it->Count());
+        NL_TEST_ASSERT(apSuite, !it->Next(output));
+        it->Release();
+    }
 }
 
 void TestGroupKeys(nlTestSuite * apSuite, void * apContext)
@@ -91,6 +91,16 @@
 #define CHIP_DEVICE_CONFIG_MAX_EVENT_QUEUE_SIZE 100
 #endif
 
+/**
+ * CHIP_DEVICE_CONFIG_EVENT_QUEUE_RING_SIZE
+ *
+ * The number of events held in the lock-free ring of the event queue used on POSIX platforms.
+ * Further events spill into a slower overflow queue until the chip task catches up. Must be a power of two.
+ */
+#ifndef CHIP_DEVICE_CONFIG_EVENT_QUEUE_RING_SIZE
+#define CHIP_DEVICE_CONFIG_EVENT_QUEUE_RING_SIZE 256
+#endif
+
 /**
  * CHIP_DEVICE_CONFIG_ENABLE_BG_EVENT_PROCESSING
  *
@@ -1193,6 +1203,20 @@
 #define CHIP_DEVICE_CONFIG_EVENT_ID_COUNTER_EPOCH (0x10000)
 #endif
 
+/**
+ *  @def CHIP_DEVICE_CONFIG_EVENT_ID_COUNTER_PRE_ADVANCE_HEADROOM
+ *
+ *  @brief
+ *    How many event numbers before the end of an epoch the start of the
+ *    following epoch gets persisted, from scheduled work instead of from
+ *    the event logging path.
+ *
+ *    Note: set to 0 to always persist synchronously when the epoch runs out.
+ */
+#ifndef CHIP_DEVICE_CONFIG_EVENT_ID_COUNTER_PRE_ADVANCE_HEADROOM
+#define CHIP_DEVICE_CONFIG_EVENT_ID_COUNTER_PRE_ADVANCE_HEADROOM (CHIP_DEVICE_CONFIG_EVENT_ID_COUNTER_EPOCH / 4)
+#endif
+
 /**
  * @def CHIP_DEVICE_CONFIG_EVENT_LOGGING_UTC_TIMESTAMPS
  *
@@ -170,10 +170,44 @@ public:
      */
     CHIP_ERROR Delete(const char * key);
 
+    /**
+     * @brief
+     * Starts a transaction: the Put and Delete calls that follow, up to the
+     * matching CommitTransaction, are made persistent together. Platforms
+     * without transaction support apply every change immediately, in which
+     * case the transaction calls succeed without giving atomicity.
+     *
+     * @return CHIP_NO_ERROR the transaction was started.
+     *         CHIP_ERROR_INCORRECT_STATE a transaction is already open.
+     */
+    CHIP_ERROR BeginTransaction();
+
+    /**
+     * @brief
+     * Makes all changes of the open transaction persistent at once.
+     *
+     * @return CHIP_NO_ERROR the changes were committed.
+     *         CHIP_ERROR_INCORRECT_STATE no transaction is open.
+     *         CHIP_ERROR_PERSISTED_STORAGE_FAILED failed to write the changes,
+     *                                             none of them are kept.
+     */
+    CHIP_ERROR CommitTransaction();
+
+    /**
+     * @brief
+     * Discards all changes of the open transaction, if any.
+     */
+    void AbortTransaction();
+
 private:
     using ImplClass = ::chip::DeviceLayer::PersistedStorage::KeyValueStoreManagerImpl;
 
 protected:
+    // Defaults for platforms without transaction support.
+    CHIP_ERROR _BeginTransaction() { return CHIP_NO_ERROR; }
+    CHIP_ERROR _CommitTransaction() { return CHIP_NO_ERROR; }
+    void _AbortTransaction() {}
+
     // Construction/destruction limited to subclasses.
     KeyValueStoreManager()  = default;
     ~KeyValueStoreManager() = default;
@@ -233,6 +267,21 @@ inline CHIP_ERROR KeyValueStoreManager::Delete(const char * key)
     return static_cast<ImplClass *>(this)->_Delete(key);
 }
 
+inline CHIP_ERROR KeyValueStoreManager::BeginTransaction()
+{
+    return static_cast<ImplClass *>(this)->_BeginTransaction();
+}
+
+inline CHIP_ERROR KeyValueStoreManager::CommitTransaction()
+{
+    return static_cast<ImplClass *>(this)->_CommitTransaction();
+}
+
+inline void KeyValueStoreManager::AbortTransaction()
+{
+    static_cast<ImplClass *>(this)->_AbortTransaction();
+}
+
 } // namespace PersistedStorage
 } // namespace DeviceLayer
 } // namespace chip
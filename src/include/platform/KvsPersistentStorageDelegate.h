@@ -103,6 +103,26 @@ public:
         return mKvsManager->Delete(key);
     }
 
+    CHIP_ERROR BeginTransaction() override
+    {
+        VerifyOrReturnError(mKvsManager != nullptr, CHIP_ERROR_INCORRECT_STATE);
+        return mKvsManager->BeginTransaction();
+    }
+
+    CHIP_ERROR CommitTransaction() override
+    {
+        VerifyOrReturnError(mKvsManager != nullptr, CHIP_ERROR_INCORRECT_STATE);
+        return mKvsManager->CommitTransaction();
+    }
+
+    void AbortTransaction() override
+    {
+        if (mKvsManager != nullptr)
+        {
+            mKvsManager->AbortTransaction();
+        }
+    }
+
 protected:
     DeviceLayer::PersistedStorage::KeyValueStoreManager * mKvsManager = nullptr;
 };
@@ -17,6 +17,7 @@
 
 #pragma once
 
+#include <lib/core/CHIPConfig.h>
 #include <platform/CHIPDeviceBuildConfig.h>
 
 /// Defines support for asserting that the chip stack is locked by the current thread via
@@ -38,6 +39,12 @@ namespace Internal {
 
 void AssertChipStackLockedByCurrentThread(const char * file, int line);
 
+#if CHIP_IM_REPORT_BUILDER_THREADS > 0
+/// Lets the current thread pass the assertion while another thread holds the chip stack lock on its behalf, as it does for
+/// the report builder threads of the reporting engine.
+void SetChipStackLockSharedWithCurrentThread(bool shared);
+#endif
+
 } // namespace Internal
 
 #define assertChipStackLockedByCurrentThread() ::chip::Platform::Internal::AssertChipStackLockedByCurrentThread(__FILE__, __LINE__)
@@ -164,9 +164,10 @@ CHIP_ERROR GenericPlatformManagerImpl_POSIX<ImplClass>::_PostEvent(const ChipDev
     SystemLayer().ScheduleWork(&_DispatchEventViaScheduleWork, eventCopyP);
     return CHIP_NO_ERROR;
 #else
-    mChipEventQueue.Push(*event);
-
-    SystemLayerSocketsLoop().Signal(); // Trigger wake select on CHIP thread
+    if (mChipEventQueue.Push(*event))
+    {
+        SystemLayerSocketsLoop().Signal(); // Trigger wake select on CHIP thread
+    }
     return CHIP_NO_ERROR;
 #endif // CHIP_SYSTEM_CONFIG_USE_LIBEV
 }
@@ -176,9 +177,12 @@ CHIP_ERROR GenericPlatformManagerImpl_POSIX<ImplClass>::_PostEvent(const ChipDev
 template <class ImplClass>
 void GenericPlatformManagerImpl_POSIX<ImplClass>::ProcessDeviceEvents()
 {
-    while (!mChipEventQueue.Empty())
+    ChipDeviceEvent event;
+
+    // Anything posted from here on signals the loop again, even if it is too late to be picked up below.
+    mChipEventQueue.ClearPendingWake();
+    while (mChipEventQueue.TryPopFront(event))
     {
-        const ChipDeviceEvent event = mChipEventQueue.PopFront();
         Impl()->DispatchEvent(&event);
     }
 }
@@ -211,6 +215,14 @@ void GenericPlatformManagerImpl_POSIX<ImplClass>::_RunEventLoop()
     Impl()->LockChipStack();
 
     SystemLayerSocketsLoop().EventLoopBegins();
+
+    // Events posted while no loop was running may have had their wake-up coalesced into one that never got
+    // delivered; make sure the first wait does not block on them.
+    if (mChipEventQueue.ClearPendingWake())
+    {
+        SystemLayerSocketsLoop().Signal();
+    }
+
     do
     {
         SystemLayerSocketsLoop().PrepareEvents();
@@ -121,6 +121,23 @@
 #define CHIP_CONFIG_MEMORY_MGMT_MALLOC 1
 #endif // CHIP_CONFIG_MEMORY_MGMT_MALLOC
 
+/**
+ *  @def CHIP_CONFIG_MEMORY_MGMT_SIZE_CLASS
+ *
+ *  @brief
+ *    Enable (1) or disable (0) the chip-provided size-class
+ *    implementation of Matter memory-management functions, which
+ *    serves small requests in constant time from per-size free
+ *    lists and passes larger ones on to malloc.
+ *
+ *  @note This configuration requires
+ *        #CHIP_CONFIG_MEMORY_MGMT_MALLOC.
+ *
+ */
+#ifndef CHIP_CONFIG_MEMORY_MGMT_SIZE_CLASS
+#define CHIP_CONFIG_MEMORY_MGMT_SIZE_CLASS 0
+#endif // CHIP_CONFIG_MEMORY_MGMT_SIZE_CLASS
+
 /**
  *  @}
  */
@@ -129,6 +146,10 @@
 #error "Please assert exactly one of CHIP_CONFIG_MEMORY_MGMT_PLATFORM or CHIP_CONFIG_MEMORY_MGMT_MALLOC."
 #endif // ((CHIP_CONFIG_MEMORY_MGMT_PLATFORM + CHIP_CONFIG_MEMORY_MGMT_MALLOC) != 1)
 
+#if CHIP_CONFIG_MEMORY_MGMT_SIZE_CLASS && !CHIP_CONFIG_MEMORY_MGMT_MALLOC
+#error "CHIP_CONFIG_MEMORY_MGMT_SIZE_CLASS requires CHIP_CONFIG_MEMORY_MGMT_MALLOC."
+#endif
+
 #if !CHIP_CONFIG_MEMORY_MGMT_MALLOC && CHIP_SYSTEM_CONFIG_USE_BSD_IFADDRS
 #error "!CHIP_CONFIG_MEMORY_MGMT_MALLOC but getifaddrs() uses malloc()"
 #endif
@@ -163,6 +184,35 @@
 #define CHIP_CONFIG_MEMORY_DEBUG_DMALLOC 0
 #endif // CHIP_CONFIG_MEMORY_DEBUG_DMALLOC
 
+/**
+ *  @def CHIP_CONFIG_MEMORY_SIZE_CLASS_SLAB_SIZE
+ *
+ *  @brief
+ *    Size, in bytes, of the slabs the size-class allocator carves
+ *    into blocks when a size class runs out of free blocks.
+ *
+ *  @note Only used with #CHIP_CONFIG_MEMORY_MGMT_SIZE_CLASS.
+ *
+ */
+#ifndef CHIP_CONFIG_MEMORY_SIZE_CLASS_SLAB_SIZE
+#define CHIP_CONFIG_MEMORY_SIZE_CLASS_SLAB_SIZE 4096
+#endif // CHIP_CONFIG_MEMORY_SIZE_CLASS_SLAB_SIZE
+
+/**
+ *  @def CHIP_CONFIG_MEMORY_SIZE_CLASS_THREAD_CACHE_SIZE
+ *
+ *  @brief
+ *    Number of free blocks per size class that each thread may keep
+ *    for itself, so that most allocations and frees do not contend
+ *    on the heap lock. 0 disables thread caches.
+ *
+ *  @note Only used with #CHIP_CONFIG_MEMORY_MGMT_SIZE_CLASS.
+ *
+ */
+#ifndef CHIP_CONFIG_MEMORY_SIZE_CLASS_THREAD_CACHE_SIZE
+#define CHIP_CONFIG_MEMORY_SIZE_CLASS_THREAD_CACHE_SIZE 0
+#endif // CHIP_CONFIG_MEMORY_SIZE_CLASS_THREAD_CACHE_SIZE
+
 /**
  *  @def CHIP_CONFIG_GLOBALS_LAZY_INIT
  *
@@ -833,6 +883,9 @@ extern const char CHIP_NON_PRODUCTION_MARKER[];
  *      * #CHIP_IM_MAX_NUM_WRITE_HANDLER
  *      * #CHIP_IM_MAX_NUM_WRITE_CLIENT
  *      * #CHIP_IM_MAX_NUM_TIMED_HANDLER
+ *      * #CHIP_IM_ATTRIBUTE_UPDATE_BATCH_SIZE
+ *      * #CHIP_IM_ATTRIBUTE_UPDATE_MAX_VALUE_SIZE
+ *      * #CHIP_IM_REPORT_BUILDER_THREADS
  *
  *  @{
  */
@@ -935,6 +988,50 @@ extern const char CHIP_NON_PRODUCTION_MARKER[];
 #define CHIP_IM_MAX_NUM_TIMED_HANDLER 8
 #endif
 
+/**
+ * @def CHIP_IM_ATTRIBUTE_UPDATE_BATCH_SIZE
+ *
+ * @brief Defines how many attribute updates staged from other threads through
+ *        chip::app::AttributeUpdateBatcher can be pending at once. Must be a
+ *        power of two.
+ */
+#ifndef CHIP_IM_ATTRIBUTE_UPDATE_BATCH_SIZE
+#define CHIP_IM_ATTRIBUTE_UPDATE_BATCH_SIZE 64
+#endif
+
+/**
+ * @def CHIP_IM_ATTRIBUTE_UPDATE_MAX_VALUE_SIZE
+ *
+ * @brief Defines the largest attribute value, in bytes of its attribute store
+ *        representation, that can be staged through chip::app::AttributeUpdateBatcher.
+ */
+#ifndef CHIP_IM_ATTRIBUTE_UPDATE_MAX_VALUE_SIZE
+#define CHIP_IM_ATTRIBUTE_UPDATE_MAX_VALUE_SIZE 16
+#endif
+
+/**
+ * @def CHIP_IM_REPORT_BUILDER_THREADS
+ *
+ * @brief Defines how many threads the reporting engine may use to build the
+ *        reports of one run in parallel, while the Matter thread holds the
+ *        stack lock and only prepares, sends and closes them. 0 builds every
+ *        report on the Matter thread.
+ *
+ *        Builder threads only read attributes whose ReadSingleClusterData is
+ *        safe to run concurrently, see chip::app::IsConcurrentReadSafe. Other
+ *        attributes and all events are still read on the Matter thread. On
+ *        builder threads, the application's MatterPreAttributeReadCallback,
+ *        MatterPostAttributeReadCallback and emberAfAttributeReadAccessCallback
+ *        must be safe to call concurrently.
+ *
+ *        Set through the chip_im_report_builder_threads build argument.
+ *        Requires std::thread, and cannot be combined with
+ *        CHIP_CONFIG_LAZY_CLUSTER_INIT.
+ */
+#ifndef CHIP_IM_REPORT_BUILDER_THREADS
+#define CHIP_IM_REPORT_BUILDER_THREADS 0
+#endif
+
 /**
  * @}
  */
@@ -1586,6 +1683,37 @@ extern const char CHIP_NON_PRODUCTION_MARKER[];
 #define CHIP_CONFIG_SYNCHRONOUS_REPORTS_ENABLED 0
 #endif
 
+/**
+ * @def CHIP_CONFIG_LAZY_CLUSTER_INIT
+ *
+ * @brief Controls whether server clusters are initialized on first access rather than at startup.
+ *
+ * When enabled, loading the attribute defaults and persisted values of a cluster and calling its init callbacks is
+ * deferred until that (endpoint, cluster) is first accessed through the attribute store or the Interaction Model
+ * (read, write or invoke).  Client clusters are still initialized at startup.  This shortens startup on devices with
+ * many endpoints, at the cost of the first access to each cluster.  Only enable this if none of the cluster init
+ * callbacks in use need to run before the cluster is accessed.  GN builds can set it with
+ * chip_config_lazy_cluster_init.
+ */
+#ifndef CHIP_CONFIG_LAZY_CLUSTER_INIT
+#define CHIP_CONFIG_LAZY_CLUSTER_INIT 0
+#endif
+
+/**
+ * @def CHIP_CONFIG_CACHE_GLOBAL_ATTRIBUTE_LISTS
+ *
+ * @brief Keep AttributeList, AcceptedCommandList and GeneratedCommandList values ready to encode.
+ *
+ * Reading these global attributes otherwise rebuilds them from the cluster metadata and the registered
+ * CommandHandlerInterface on every read.  When enabled, the AttributeList of every server cluster is built once per
+ * endpoint type when endpoints are registered, and command lists enumerated by a CommandHandlerInterface are built per
+ * endpoint on their first read.  Nothing is evicted, so the heap used grows with the number of endpoint types and
+ * clusters; this is meant for bridges and other devices with many endpoints and memory to spare.
+ */
+#ifndef CHIP_CONFIG_CACHE_GLOBAL_ATTRIBUTE_LISTS
+#define CHIP_CONFIG_CACHE_GLOBAL_ATTRIBUTE_LISTS 0
+#endif
+
 /**
  * @}
  */
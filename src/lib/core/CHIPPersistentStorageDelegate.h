@@ -110,6 +110,38 @@ public:
         CHIP_ERROR err = SyncGetKeyValue(key, nullptr, size);
         return (err == CHIP_ERROR_BUFFER_TOO_SMALL) || (err == CHIP_NO_ERROR);
     }
+
+    /**
+     * @brief
+     *   Starts a transaction: the SyncSetKeyValue and SyncDeleteKeyValue calls that follow, up to the matching
+     *   CommitTransaction, are made persistent together, so that a power loss keeps either all or none of them.
+     *   Reads made during the transaction see its changes. AbortTransaction discards them instead.
+     *
+     *   Transactions do not nest, and apply to all callers of this delegate while open.
+     *
+     *   The default implementation, used by backends without transaction support, applies every change
+     *   immediately: the transaction calls succeed, but give no atomicity and AbortTransaction cannot undo
+     *   anything. Callers must therefore keep any recovery they need for partially applied changes.
+     *
+     * @return CHIP_NO_ERROR on success, CHIP_ERROR_INCORRECT_STATE if a transaction is already open,
+     *         or another CHIP_ERROR value from implementation on failure.
+     */
+    virtual CHIP_ERROR BeginTransaction() { return CHIP_NO_ERROR; }
+
+    /**
+     * @brief
+     *   Makes all changes of the open transaction persistent at once, and closes the transaction.
+     *
+     * @return CHIP_NO_ERROR on success, CHIP_ERROR_INCORRECT_STATE if no transaction is open,
+     *         or another CHIP_ERROR value from implementation on failure, in which case none of the changes are kept.
+     */
+    virtual CHIP_ERROR CommitTransaction() { return CHIP_NO_ERROR; }
+
+    /**
+     * @brief
+     *   Discards all changes of the open transaction, if any, and closes the transaction.
+     */
+    virtual void AbortTransaction() {}
 };
 
 } // namespace chip
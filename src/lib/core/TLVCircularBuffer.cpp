@@ -39,6 +39,9 @@
 #include <lib/support/CodeUtils.h>
 
 #include <stdint.h>
+#include <string.h>
+
+#include <algorithm>
 
 namespace chip {
 namespace TLV {
@@ -165,6 +168,35 @@ CHIP_ERROR TLVCircularBuffer::EvictHead()
     return CHIP_NO_ERROR;
 }
 
+CHIP_ERROR TLVCircularBuffer::MoveHeadTo(TLVCircularBuffer & outDestination, uint32_t inLength)
+{
+    VerifyOrReturnError(&outDestination != this && inLength <= mQueueLength, CHIP_ERROR_INVALID_ARGUMENT);
+    VerifyOrReturnError(inLength <= outDestination.AvailableDataLength(), CHIP_ERROR_NO_MEMORY);
+
+    while (inLength > 0)
+    {
+        if (mQueueHead == mQueue + mQueueSize)
+        {
+            mQueueHead = mQueue;
+        }
+
+        // copy the longest run that is contiguous in both buffers
+        uint8_t * tail           = outDestination.QueueTail();
+        const uint32_t headRoom  = mQueueSize - static_cast<uint32_t>(mQueueHead - mQueue);
+        const uint32_t tailRoom  = outDestination.mQueueSize - static_cast<uint32_t>(tail - outDestination.mQueue);
+        const uint32_t runLength = std::min(inLength, std::min(headRoom, tailRoom));
+
+        memcpy(tail, mQueueHead, runLength);
+
+        outDestination.mQueueLength += runLength;
+        mQueueHead += runLength;
+        mQueueLength -= runLength;
+        inLength -= runLength;
+    }
+
+    return CHIP_NO_ERROR;
+}
+
 /**
  * @brief
  *  Implements TLVBackingStore::OnInit(TLVWriter) for circular buffers.
@@ -70,6 +70,20 @@ public:
 
     CHIP_ERROR EvictHead();
 
+    /**
+     * @brief
+     *   Moves the oldest @a inLength bytes of this buffer to the tail of @a outDestination.
+     *
+     * The bytes are copied as-is, without being parsed, so @a inLength must cover one or more whole top-level TLV
+     * elements (e.g. the length reported by a reader that was positioned on the head element and skipped over it).
+     *
+     * @retval #CHIP_ERROR_INVALID_ARGUMENT If this buffer holds fewer than @a inLength bytes.
+     * @retval #CHIP_ERROR_NO_MEMORY        If @a outDestination does not have @a inLength bytes available; neither
+     *                                      buffer is modified.
+     * @retval #CHIP_NO_ERROR               On success.
+     */
+    CHIP_ERROR MoveHeadTo(TLVCircularBuffer & outDestination, uint32_t inLength);
+
     // chip::TLV::TLVBackingStore overrides:
     CHIP_ERROR OnInit(TLVReader & reader, const uint8_t *& bufStart, uint32_t & bufLen) override;
     CHIP_ERROR GetNextBuffer(TLVReader & ioReader, const uint8_t *& outBufStart, uint32_t & outBufLen) override;
@@ -2616,6 +2616,56 @@ void CheckCircularTLVBufferEdge(nlTestSuite * inSuite, void * inContext)
 
     TestEnd<TLVReader>(inSuite, reader);
 }
+void CheckCircularTLVBufferMoveHead(nlTestSuite * inSuite, void * inContext)
+{
+    // Both buffers start midway so that the moved elements wrap around
+    // the end of the source and of the destination.
+    uint8_t backingStore[30];
+    uint8_t backingStore1[25];
+    CircularTLVWriter writer;
+    CircularTLVReader reader;
+    TLVCircularBuffer buffer(backingStore, sizeof(backingStore), &(backingStore[20]));
+    TLVCircularBuffer buffer1(backingStore1, sizeof(backingStore1), &(backingStore1[20]));
+    writer.Init(buffer);
+    writer.ImplicitProfileId = TestProfile_2;
+
+    // A 7-byte boolean followed by two 11-byte instances of Encoding3.
+    NL_TEST_ASSERT(inSuite, writer.PutBoolean(ProfileTag(TestProfile_1, 2), true) == CHIP_NO_ERROR);
+    WriteEncoding3(inSuite, writer);
+    WriteEncoding3(inSuite, writer);
+    NL_TEST_ASSERT(inSuite, buffer.DataLength() == 29);
+
+    NL_TEST_ASSERT(inSuite, buffer.MoveHeadTo(buffer1, 7) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, buffer.MoveHeadTo(buffer1, 11) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, buffer.DataLength() == 11);
+    NL_TEST_ASSERT(inSuite, buffer1.DataLength() == 18);
+
+    // Not enough room left in the destination; neither buffer changes.
+    NL_TEST_ASSERT(inSuite, buffer.MoveHeadTo(buffer1, 11) == CHIP_ERROR_NO_MEMORY);
+    NL_TEST_ASSERT(inSuite, buffer.MoveHeadTo(buffer1, 12) == CHIP_ERROR_INVALID_ARGUMENT);
+    NL_TEST_ASSERT(inSuite, buffer.DataLength() == 11);
+    NL_TEST_ASSERT(inSuite, buffer1.DataLength() == 18);
+
+    reader.Init(buffer1);
+    reader.ImplicitProfileId = TestProfile_2;
+
+    TestNext<TLVReader>(inSuite, reader);
+    TEST_GET_NOERROR(inSuite, reader, kTLVType_Boolean, ProfileTag(TestProfile_1, 2), true);
+
+    TestNext<TLVReader>(inSuite, reader);
+    ReadEncoding3(inSuite, reader);
+
+    TestEnd<TLVReader>(inSuite, reader);
+
+    reader.Init(buffer);
+    reader.ImplicitProfileId = TestProfile_2;
+
+    TestNext<TLVReader>(inSuite, reader);
+    ReadEncoding3(inSuite, reader);
+
+    TestEnd<TLVReader>(inSuite, reader);
+}
+
 void CheckTLVPutStringF(nlTestSuite * inSuite, void * inContext)
 {
     const size_t bufsize = 24;
@@ -4616,6 +4666,7 @@ static const nlTest sTests[] =
     NL_TEST_DEF("CHIP Circular TLV buffer, mid-buffer start", CheckCircularTLVBufferStartMidway),
     NL_TEST_DEF("CHIP Circular TLV buffer, straddle",  CheckCircularTLVBufferEvictStraddlingEvent),
     NL_TEST_DEF("CHIP Circular TLV buffer, edge",      CheckCircularTLVBufferEdge),
+    NL_TEST_DEF("CHIP Circular TLV buffer, move head", CheckCircularTLVBufferMoveHead),
     NL_TEST_DEF("CHIP TLV Printf",                     CheckTLVPutStringF),
     NL_TEST_DEF("CHIP TLV String Span",                CheckTLVPutStringSpan),
     NL_TEST_DEF("CHIP TLV Printf, Circular TLV buf",   CheckTLVPutStringFCircular),
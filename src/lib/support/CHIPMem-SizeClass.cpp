@@ -0,0 +1,625 @@
+/*
+ *
+ *    Copyright (c) 2023 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *      This file implements heap memory allocation APIs for CHIP with segregated free lists:
+ *      requests are rounded up to one of a few size classes, each served in O(1) from a free
+ *      list that is refilled a slab at a time. Larger requests are passed on to malloc().
+ *
+ */
+
+#include "CHIPMem.h"
+#include "CHIPMemSizeClass.h"
+
+#include <lib/core/CHIPConfig.h>
+#include <lib/support/VerificationMacrosNoLogging.h>
+#include <system/SystemMutex.h>
+
+#include <algorithm>
+#include <atomic>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#if CHIP_CONFIG_MEMORY_MGMT_SIZE_CLASS
+
+namespace chip {
+namespace Platform {
+
+namespace {
+
+// Largest request served by each class. Multiples of the header size, so that every block stays aligned.
+constexpr size_t kBlockSizes[]    = { 16, 32, 64, 128, 256, 512, 1024 };
+constexpr size_t kNumSizeClasses  = sizeof(kBlockSizes) / sizeof(kBlockSizes[0]);
+constexpr size_t kLargeBlockClass = kNumSizeClasses;
+constexpr size_t kFreeBlock       = SIZE_MAX; // Marks blocks on a free list or in a thread cache.
+
+// Precedes every block handed out, so that free and realloc find the block's class without searching.
+struct alignas(max_align_t) BlockHeader
+{
+    size_t mSizeClass;
+    size_t mLargeSize; // Requested size, for kLargeBlockClass only.
+};
+
+struct alignas(max_align_t) Slab
+{
+    Slab * mNext;
+    size_t mBlocks;
+    bool mFromHeap; // Otherwise carved from the buffer given to MemoryInit().
+};
+
+struct SizeClass
+{
+    BlockHeader * mFreeList = nullptr; // Free blocks are linked through their payload.
+    Slab * mSlabs           = nullptr;
+    size_t mSlabCount       = 0;
+    size_t mBlockCount      = 0;
+
+    // Also updated outside the heap lock when thread caches are enabled.
+    std::atomic<size_t> mInUse{ 0 };
+    std::atomic<size_t> mPeakInUse{ 0 };
+    std::atomic<size_t> mAllocations{ 0 };
+};
+
+SizeClass gSizeClasses[kNumSizeClasses];
+std::atomic<bool> gInitialized{ false };
+uint8_t * gArenaCursor = nullptr;
+uint8_t * gArenaEnd    = nullptr;
+
+#if CHIP_SYSTEM_CONFIG_NO_LOCKING
+
+class HeapLocked
+{
+public:
+    HeapLocked() {}
+    ~HeapLocked() {}
+};
+
+#else
+
+chip::System::Mutex gHeapLock;
+
+class HeapLocked
+{
+public:
+    HeapLocked() { gHeapLock.Lock(); }
+    ~HeapLocked() { gHeapLock.Unlock(); }
+};
+#endif
+
+BlockHeader *& NextFree(BlockHeader * block)
+{
+    return *reinterpret_cast<BlockHeader **>(block + 1);
+}
+
+BlockHeader * HeaderOf(void * p)
+{
+    return static_cast<BlockHeader *>(p) - 1;
+}
+
+size_t SizeClassFor(size_t size)
+{
+    for (size_t i = 0; i < kNumSizeClasses; i++)
+    {
+        if (size <= kBlockSizes[i])
+        {
+            return i;
+        }
+    }
+    return kLargeBlockClass;
+}
+
+size_t BlockCapacity(const BlockHeader * header)
+{
+    return (header->mSizeClass == kLargeBlockClass) ? header->mLargeSize : kBlockSizes[header->mSizeClass];
+}
+
+// Must be called with the heap lock held.
+bool RefillLocked(size_t sizeClass)
+{
+    SizeClass & cls       = gSizeClasses[sizeClass];
+    const size_t stride   = sizeof(BlockHeader) + kBlockSizes[sizeClass];
+    const size_t count    = std::max<size_t>(1, (CHIP_CONFIG_MEMORY_SIZE_CLASS_SLAB_SIZE - sizeof(Slab)) / stride);
+    const size_t slabSize = sizeof(Slab) + count * stride;
+
+    Slab * slab = nullptr;
+    if (gArenaCursor != nullptr && static_cast<size_t>(gArenaEnd - gArenaCursor) >= slabSize)
+    {
+        slab = reinterpret_cast<Slab *>(gArenaCursor);
+        gArenaCursor += slabSize;
+        slab->mFromHeap = false;
+    }
+    else
+    {
+        slab = static_cast<Slab *>(malloc(slabSize));
+        if (slab == nullptr)
+        {
+            return false;
+        }
+        slab->mFromHeap = true;
+    }
+
+    slab->mNext   = cls.mSlabs;
+    slab->mBlocks = count;
+    cls.mSlabs    = slab;
+    cls.mSlabCount++;
+    cls.mBlockCount += count;
+
+    uint8_t * blocks = reinterpret_cast<uint8_t *>(slab + 1);
+    for (size_t i = 0; i < count; i++)
+    {
+        auto * block      = reinterpret_cast<BlockHeader *>(blocks + i * stride);
+        block->mSizeClass = kFreeBlock;
+        NextFree(block)   = cls.mFreeList;
+        cls.mFreeList     = block;
+    }
+    return true;
+}
+
+// Must be called with the heap lock held.
+BlockHeader * TakeLocked(size_t sizeClass)
+{
+    SizeClass & cls = gSizeClasses[sizeClass];
+    if (cls.mFreeList == nullptr && !RefillLocked(sizeClass))
+    {
+        return nullptr;
+    }
+
+    BlockHeader * block = cls.mFreeList;
+    cls.mFreeList       = NextFree(block);
+    return block;
+}
+
+// Must be called with the heap lock held.
+void ReturnLocked(size_t sizeClass, BlockHeader * block)
+{
+    SizeClass & cls = gSizeClasses[sizeClass];
+    NextFree(block) = cls.mFreeList;
+    cls.mFreeList   = block;
+}
+
+size_t LiveBlocks()
+{
+    size_t live = 0;
+    for (auto & cls : gSizeClasses)
+    {
+        live += cls.mInUse.load(std::memory_order_relaxed);
+    }
+    return live;
+}
+
+// Must be called with the heap lock held.
+void ReleaseSlabsLocked()
+{
+    for (auto & cls : gSizeClasses)
+    {
+        while (cls.mSlabs != nullptr)
+        {
+            Slab * slab = cls.mSlabs;
+            cls.mSlabs  = slab->mNext;
+            if (slab->mFromHeap)
+            {
+                free(slab);
+            }
+        }
+        cls.mFreeList   = nullptr;
+        cls.mSlabCount  = 0;
+        cls.mBlockCount = 0;
+    }
+}
+
+// Must be called with the heap lock held. Rebuilds the shared free lists from the slabs, so that free blocks that were
+// held by thread caches are not lost when the caches are dropped.
+void CollectFreeBlocksLocked()
+{
+    for (size_t i = 0; i < kNumSizeClasses; i++)
+    {
+        SizeClass & cls     = gSizeClasses[i];
+        const size_t stride = sizeof(BlockHeader) + kBlockSizes[i];
+
+        cls.mFreeList = nullptr;
+        for (Slab * slab = cls.mSlabs; slab != nullptr; slab = slab->mNext)
+        {
+            uint8_t * blocks = reinterpret_cast<uint8_t *>(slab + 1);
+            for (size_t j = 0; j < slab->mBlocks; j++)
+            {
+                auto * block = reinterpret_cast<BlockHeader *>(blocks + j * stride);
+                if (block->mSizeClass == kFreeBlock)
+                {
+                    NextFree(block) = cls.mFreeList;
+                    cls.mFreeList   = block;
+                }
+            }
+        }
+    }
+}
+
+void CountAllocation(size_t sizeClass)
+{
+    SizeClass & cls = gSizeClasses[sizeClass];
+    cls.mAllocations.fetch_add(1, std::memory_order_relaxed);
+
+    size_t inUse = cls.mInUse.fetch_add(1, std::memory_order_relaxed) + 1;
+    size_t peak  = cls.mPeakInUse.load(std::memory_order_relaxed);
+    while (inUse > peak && !cls.mPeakInUse.compare_exchange_weak(peak, inUse, std::memory_order_relaxed))
+    {
+    }
+}
+
+#if CHIP_CONFIG_MEMORY_SIZE_CLASS_THREAD_CACHE_SIZE > 0
+
+constexpr size_t kThreadCacheSize = CHIP_CONFIG_MEMORY_SIZE_CLASS_THREAD_CACHE_SIZE;
+constexpr size_t kThreadCacheMove = std::max<size_t>(1, kThreadCacheSize / 2);
+
+// Bumped by MemoryAllocatorInit() and MemoryAllocatorShutdown(); blocks cached before that belong to slabs that are gone.
+std::atomic<uint32_t> gGeneration{ 0 };
+
+/**
+ * Per-thread free lists, so that most allocations and frees do not take the heap lock. Blocks move to and from the
+ * shared free lists half a cache at a time.
+ */
+class ThreadCache
+{
+public:
+    ~ThreadCache()
+    {
+        HeapLocked lock;
+        Validate();
+        for (size_t i = 0; i < kNumSizeClasses; i++)
+        {
+            MoveToShared(i, mCount[i]);
+        }
+    }
+
+    BlockHeader * Take(size_t sizeClass)
+    {
+        Validate();
+        if (mCount[sizeClass] == 0)
+        {
+            HeapLocked lock;
+            if (!gInitialized)
+            {
+                return nullptr;
+            }
+            for (size_t i = 0; i < kThreadCacheMove; i++)
+            {
+                BlockHeader * block = TakeLocked(sizeClass);
+                if (block == nullptr)
+                {
+                    break;
+                }
+                Push(sizeClass, block);
+            }
+            if (mCount[sizeClass] == 0)
+            {
+                return nullptr;
+            }
+        }
+
+        BlockHeader * block  = mFreeList[sizeClass];
+        mFreeList[sizeClass] = NextFree(block);
+        mCount[sizeClass]--;
+        return block;
+    }
+
+    void Give(size_t sizeClass, BlockHeader * block)
+    {
+        Validate();
+        Push(sizeClass, block);
+        if (mCount[sizeClass] > kThreadCacheSize)
+        {
+            HeapLocked lock;
+            MoveToShared(sizeClass, kThreadCacheMove);
+        }
+    }
+
+private:
+    void Validate()
+    {
+        uint32_t generation = gGeneration.load(std::memory_order_acquire);
+        if (generation != mGeneration)
+        {
+            memset(mFreeList, 0, sizeof(mFreeList));
+            memset(mCount, 0, sizeof(mCount));
+            mGeneration = generation;
+        }
+    }
+
+    void Push(size_t sizeClass, BlockHeader * block)
+    {
+        NextFree(block)      = mFreeList[sizeClass];
+        mFreeList[sizeClass] = block;
+        mCount[sizeClass]++;
+    }
+
+    // Must be called with the heap lock held.
+    void MoveToShared(size_t sizeClass, size_t count)
+    {
+        for (; count > 0 && mCount[sizeClass] > 0; count--)
+        {
+            BlockHeader * block  = mFreeList[sizeClass];
+            mFreeList[sizeClass] = NextFree(block);
+            mCount[sizeClass]--;
+            if (gInitialized)
+            {
+                ReturnLocked(sizeClass, block);
+            }
+        }
+    }
+
+    BlockHeader * mFreeList[kNumSizeClasses] = {};
+    size_t mCount[kNumSizeClasses]           = {};
+    uint32_t mGeneration                     = 0;
+};
+
+thread_local ThreadCache tThreadCache;
+
+#endif // CHIP_CONFIG_MEMORY_SIZE_CLASS_THREAD_CACHE_SIZE > 0
+
+void * AllocateLarge(size_t size)
+{
+    if (size > SIZE_MAX - sizeof(BlockHeader))
+    {
+        return nullptr;
+    }
+
+    auto * header = static_cast<BlockHeader *>(malloc(sizeof(BlockHeader) + size));
+    if (header == nullptr)
+    {
+        return nullptr;
+    }
+    header->mSizeClass = kLargeBlockClass;
+    header->mLargeSize = size;
+    return header + 1;
+}
+
+} // namespace
+
+CHIP_ERROR MemoryAllocatorInit(void * buf, size_t bufSize)
+{
+    if (gInitialized)
+    {
+        return CHIP_ERROR_INCORRECT_STATE;
+    }
+
+#if !CHIP_SYSTEM_CONFIG_NO_LOCKING
+    CHIP_ERROR err = chip::System::Mutex::Init(gHeapLock);
+    if (err != CHIP_NO_ERROR)
+    {
+        return err;
+    }
+#endif
+
+    HeapLocked lock;
+
+    if (buf != nullptr)
+    {
+        // Slabs are carved out of the given buffer first; malloc() only backs them once it is used up.
+        auto start   = reinterpret_cast<uintptr_t>(buf);
+        auto aligned = (start + alignof(max_align_t) - 1) & ~static_cast<uintptr_t>(alignof(max_align_t) - 1);
+        if (aligned - start < bufSize)
+        {
+            gArenaCursor = reinterpret_cast<uint8_t *>(aligned);
+            gArenaEnd    = static_cast<uint8_t *>(buf) + bufSize;
+        }
+    }
+
+    // Blocks still in use since before the last shutdown keep their slabs, which are reused as they are; their count
+    // carries over so that freeing them later does not underflow it.
+    for (auto & cls : gSizeClasses)
+    {
+        cls.mPeakInUse.store(cls.mInUse.load(std::memory_order_relaxed), std::memory_order_relaxed);
+        cls.mAllocations.store(0, std::memory_order_relaxed);
+    }
+    gInitialized = true;
+
+#if CHIP_CONFIG_MEMORY_SIZE_CLASS_THREAD_CACHE_SIZE > 0
+    gGeneration.fetch_add(1, std::memory_order_release);
+#endif
+
+    return CHIP_NO_ERROR;
+}
+
+void MemoryAllocatorShutdown()
+{
+    HeapLocked lock;
+
+    gInitialized = false;
+    if (LiveBlocks() == 0)
+    {
+        ReleaseSlabsLocked();
+    }
+    else
+    {
+        // Blocks may still be freed after shutdown, as with the other allocators, so their slabs stay until the last
+        // one is freed (or until the next MemoryAllocatorInit() adopts them).
+        CollectFreeBlocksLocked();
+    }
+    gArenaCursor = nullptr;
+    gArenaEnd    = nullptr;
+
+#if CHIP_CONFIG_MEMORY_SIZE_CLASS_THREAD_CACHE_SIZE > 0
+    gGeneration.fetch_add(1, std::memory_order_release);
+#endif
+}
+
+void * MemoryAlloc(size_t size)
+{
+    const size_t sizeClass = SizeClassFor(size);
+    if (sizeClass == kLargeBlockClass)
+    {
+        return AllocateLarge(size);
+    }
+
+    BlockHeader * header = nullptr;
+#if CHIP_CONFIG_MEMORY_SIZE_CLASS_THREAD_CACHE_SIZE > 0
+    header = tThreadCache.Take(sizeClass);
+#else
+    {
+        HeapLocked lock;
+        if (gInitialized)
+        {
+            header = TakeLocked(sizeClass);
+        }
+    }
+#endif
+    if (header == nullptr)
+    {
+        return nullptr;
+    }
+
+    header->mSizeClass = sizeClass;
+    CountAllocation(sizeClass);
+    return header + 1;
+}
+
+void * MemoryCalloc(size_t num, size_t size)
+{
+    size_t total = num * size;
+
+    // check for multiplication overflow
+    if (num != 0 && size != total / num)
+    {
+        return nullptr;
+    }
+
+    void * result = MemoryAlloc(total);
+    if (result != nullptr)
+    {
+        memset(result, 0, total);
+    }
+    return result;
+}
+
+void * MemoryRealloc(void * p, size_t size)
+{
+    if (p == nullptr)
+    {
+        return MemoryAlloc(size);
+    }
+
+    BlockHeader * header  = HeaderOf(p);
+    const size_t capacity = BlockCapacity(header);
+    if (size <= capacity)
+    {
+        return p;
+    }
+
+    if (header->mSizeClass == kLargeBlockClass)
+    {
+        if (size > SIZE_MAX - sizeof(BlockHeader))
+        {
+            return nullptr;
+        }
+        header = static_cast<BlockHeader *>(realloc(header, sizeof(BlockHeader) + size));
+        if (header == nullptr)
+        {
+            return nullptr;
+        }
+        header->mLargeSize = size;
+        return header + 1;
+    }
+
+    void * result = MemoryAlloc(size);
+    if (result != nullptr)
+    {
+        memcpy(result, p, capacity);
+        MemoryFree(p);
+    }
+    return result;
+}
+
+void MemoryFree(void * p)
+{
+    if (p == nullptr)
+    {
+        return;
+    }
+
+    BlockHeader * header   = HeaderOf(p);
+    const size_t sizeClass = header->mSizeClass;
+    if (sizeClass == kLargeBlockClass)
+    {
+        free(header);
+        return;
+    }
+
+    // Logging can use Memory::Alloc, so we can't use logging with our
+    // VerifyOrDie bits here. This also catches blocks that are freed twice.
+    VerifyOrDieWithoutLogging(sizeClass < kNumSizeClasses);
+    header->mSizeClass = kFreeBlock;
+
+#if CHIP_CONFIG_MEMORY_SIZE_CLASS_THREAD_CACHE_SIZE > 0
+    if (gInitialized)
+    {
+        gSizeClasses[sizeClass].mInUse.fetch_sub(1, std::memory_order_relaxed);
+        tThreadCache.Give(sizeClass, header);
+        return;
+    }
+#endif
+
+    HeapLocked lock;
+    gSizeClasses[sizeClass].mInUse.fetch_sub(1, std::memory_order_relaxed);
+    ReturnLocked(sizeClass, header);
+    if (!gInitialized && LiveBlocks() == 0)
+    {
+        // The last block outstanding at shutdown is gone.
+        ReleaseSlabsLocked();
+    }
+}
+
+bool MemoryInternalCheckPointer(const void * p, size_t min_size)
+{
+    if (p == nullptr)
+    {
+        return false;
+    }
+
+    const BlockHeader * header = static_cast<const BlockHeader *>(p) - 1;
+    return header->mSizeClass <= kLargeBlockClass && BlockCapacity(header) >= min_size;
+}
+
+size_t MemorySizeClassCount()
+{
+    return kNumSizeClasses;
+}
+
+CHIP_ERROR MemoryGetSizeClassStats(size_t index, MemorySizeClassStats & stats)
+{
+    if (index >= kNumSizeClasses)
+    {
+        return CHIP_ERROR_INVALID_ARGUMENT;
+    }
+
+    HeapLocked lock;
+
+    const SizeClass & cls = gSizeClasses[index];
+    stats.mBlockSize      = kBlockSizes[index];
+    stats.mSlabCount      = cls.mSlabCount;
+    stats.mBlockCount     = cls.mBlockCount;
+    stats.mInUse          = cls.mInUse.load(std::memory_order_relaxed);
+    stats.mPeakInUse      = cls.mPeakInUse.load(std::memory_order_relaxed);
+    stats.mAllocations    = cls.mAllocations.load(std::memory_order_relaxed);
+    return CHIP_NO_ERROR;
+}
+
+} // namespace Platform
+} // namespace chip
+
+#endif // CHIP_CONFIG_MEMORY_MGMT_SIZE_CLASS
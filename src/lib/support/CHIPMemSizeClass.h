@@ -0,0 +1,61 @@
+/*
+ *
+ *    Copyright (c) 2023 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *      Statistics for the size-class implementation of the CHIP allocation API,
+ *      available when chip_config_memory_management is "sizeclass".
+ *
+ */
+
+#pragma once
+
+#include <lib/core/CHIPError.h>
+
+#include <stddef.h>
+
+namespace chip {
+namespace Platform {
+
+/**
+ * Usage of one size class of the size-class allocator.
+ */
+struct MemorySizeClassStats
+{
+    size_t mBlockSize;   ///< Largest request served by this class, in bytes.
+    size_t mSlabCount;   ///< Slabs carved into blocks of this class so far.
+    size_t mBlockCount;  ///< Blocks of this class in those slabs.
+    size_t mInUse;       ///< Blocks currently handed out.
+    size_t mPeakInUse;   ///< Highest mInUse seen.
+    size_t mAllocations; ///< Total successful allocations from this class.
+};
+
+/**
+ * Number of size classes; requests larger than the largest class are passed on to malloc().
+ */
+extern size_t MemorySizeClassCount();
+
+/**
+ * Read the usage of a size class.
+ *
+ * @retval #CHIP_ERROR_INVALID_ARGUMENT  If index is not below MemorySizeClassCount().
+ * @retval #CHIP_NO_ERROR                On success.
+ */
+extern CHIP_ERROR MemoryGetSizeClassStats(size_t index, MemorySizeClassStats & stats);
+
+} // namespace Platform
+} // namespace chip
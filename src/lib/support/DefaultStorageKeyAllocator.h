@@ -127,6 +127,8 @@ public:
     {
         return StorageKeyName::Formatted("f/%x/ac/0/%x", fabric, static_cast<unsigned>(index));
     }
+    // All ACL entries of a fabric as a single record, replacing the per-entry keys above.
+    static StorageKeyName AccessControlAclList(FabricIndex fabric) { return StorageKeyName::Formatted("f/%x/ac/0", fabric); }
 
     static StorageKeyName AccessControlExtensionEntry(FabricIndex fabric) { return StorageKeyName::Formatted("f/%x/ac/1", fabric); }
 
@@ -206,6 +208,13 @@ public:
     }
     static StorageKeyName SubscriptionResumptionMaxCount() { return StorageKeyName::Formatted("g/sum"); }
 
+    // Controller-side snapshot of the attribute cache of a node
+    static StorageKeyName ClusterStateCacheSnapshot(FabricIndex fabric, NodeId nodeId)
+    {
+        return StorageKeyName::Formatted("f/%x/csc/%08" PRIX32 "%08" PRIX32, fabric, static_cast<uint32_t>(nodeId >> 32),
+                                         static_cast<uint32_t>(nodeId));
+    }
+
     // Number of scenes stored in a given endpoint's scene table, across all fabrics.
     static StorageKeyName EndpointSceneCountKey(EndpointId endpoint) { return StorageKeyName::Formatted("g/scc/e/%x", endpoint); }
 
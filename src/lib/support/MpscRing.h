@@ -0,0 +1,137 @@
+/*
+ *
+ *    Copyright (c) 2023 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *      A bounded, lock-free queue for handing values from any number of threads to a single consumer thread.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <stddef.h>
+#include <stdint.h>
+
+namespace chip {
+
+/**
+ * A fixed-capacity FIFO that any number of producer threads may push to concurrently, without locks, and that a
+ * single consumer thread pops from.
+ *
+ * Each cell carries a sequence number telling whether it is free for the producer claiming a given position, or holds
+ * a value ready for the consumer. A producer that claimed a cell but has not finished writing it holds up the
+ * consumer at that cell until it is done; values pushed by a single thread are always popped in order.
+ *
+ * @tparam T  The value type; it is copied in and out, so should be cheap to copy.
+ * @tparam N  The capacity; must be a power of two.
+ */
+template <typename T, size_t N>
+class MpscRing
+{
+public:
+    static_assert(N > 0 && (N & (N - 1)) == 0, "MpscRing capacity must be a power of two");
+
+    MpscRing()
+    {
+        for (size_t i = 0; i < N; i++)
+        {
+            mCells[i].mSequence.store(i, std::memory_order_relaxed);
+        }
+    }
+
+    MpscRing(const MpscRing &)             = delete;
+    MpscRing & operator=(const MpscRing &) = delete;
+
+    static constexpr size_t Capacity() { return N; }
+
+    /**
+     * Append a value. Safe to call from any thread.
+     *
+     * @return false if the ring is full.
+     */
+    bool TryPush(const T & value)
+    {
+        size_t pos = mEnqueuePos.load(std::memory_order_relaxed);
+        Cell * cell;
+
+        for (;;)
+        {
+            cell            = &mCells[pos & (N - 1)];
+            size_t sequence = cell->mSequence.load(std::memory_order_acquire);
+            auto difference = static_cast<intptr_t>(sequence) - static_cast<intptr_t>(pos);
+
+            if (difference == 0)
+            {
+                if (mEnqueuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                {
+                    break;
+                }
+            }
+            else if (difference < 0)
+            {
+                // The consumer has not freed this cell yet: the ring is full.
+                return false;
+            }
+            else
+            {
+                pos = mEnqueuePos.load(std::memory_order_relaxed);
+            }
+        }
+
+        cell->mValue = value;
+        cell->mSequence.store(pos + 1, std::memory_order_release);
+
+        return true;
+    }
+
+    /**
+     * Remove the oldest value. Must only be called from the consumer thread.
+     *
+     * @return false if there is nothing ready to pop.
+     */
+    bool TryPop(T & value)
+    {
+        Cell & cell = mCells[mDequeuePos & (N - 1)];
+
+        // Either empty, or a producer has claimed the cell but not finished writing to it yet.
+        if (cell.mSequence.load(std::memory_order_acquire) != mDequeuePos + 1)
+        {
+            return false;
+        }
+
+        value = cell.mValue;
+        cell.mSequence.store(mDequeuePos + N, std::memory_order_release);
+        mDequeuePos++;
+
+        return true;
+    }
+
+private:
+    struct Cell
+    {
+        // Equal to the position a producer may claim the cell at, or to that position + 1 once the value is ready.
+        std::atomic<size_t> mSequence;
+        T mValue;
+    };
+
+    Cell mCells[N];
+    std::atomic<size_t> mEnqueuePos{ 0 };
+    size_t mDequeuePos = 0;
+};
+
+} // namespace chip
@@ -55,6 +55,10 @@ namespace chip {
  *   - Output: 200, 201, 202, ...., 299, 300, 301, 302 <reboot/reinit>
  *   - Output: 400, 401 ...
  *
+ * By default, the start of the next epoch is written out synchronously from
+ * Advance() when the current epoch runs out. EnablePreAdvance() moves that
+ * write out of Advance() so callers on hot paths do not wait on storage.
+ *
  */
 template <typename T>
 class PersistedCounter : public MonotonicallyIncreasingCounter<T>
@@ -63,6 +67,11 @@ public:
     PersistedCounter() : mKey(StorageKeyName::Uninitialized()) {}
     ~PersistedCounter() override {}
 
+    /**
+     * Runs work later, outside of the caller's stack frame; same shape as PlatformManager::ScheduleWork.
+     */
+    using ScheduleWorkFunct = CHIP_ERROR (*)(void (*aWork)(intptr_t), intptr_t aArg);
+
     /**
      *  @brief
      *    Initialize a PersistedCounter object.
@@ -134,10 +143,75 @@ public:
             // is valid
             VerifyOrReturnError(MonotonicallyIncreasingCounter<T>::GetValue() < mNextEpoch, CHIP_ERROR_INTERNAL);
         }
+        else if (mScheduleWork != nullptr && !mPreAdvanceScheduled &&
+                 mNextEpoch - MonotonicallyIncreasingCounter<T>::GetValue() <= mPreAdvanceHeadroom)
+        {
+            SchedulePreAdvance();
+        }
+        return CHIP_NO_ERROR;
+    }
+
+    /**
+     *  @brief
+     *    Persist the start of the following epoch ahead of time, rather than from Advance() once the current epoch
+     *    is used up.
+     *
+     *  Once the counter is within aHeadroom values of the next epoch start, Advance() uses aScheduleWork to persist
+     *  the start of the epoch after it. Advance() only writes synchronously if the scheduled write has not completed
+     *  by the time the current epoch runs out. Because at most one epoch is persisted ahead, a reboot skips at most
+     *  two epochs worth of values.
+     *
+     *  The scheduled work must run on the thread that calls Advance(), and the counter must outlive it.
+     *
+     *  @param[in] aScheduleWork  Used to run the write outside of Advance().
+     *  @param[in] aHeadroom      How many values before the next epoch start to schedule the write at.
+     *
+     *  @return CHIP_ERROR_INCORRECT_STATE if the counter is not initialized,
+     *          CHIP_ERROR_INVALID_ARGUMENT if aScheduleWork is null or aHeadroom is not in (0, epoch),
+     *          CHIP_NO_ERROR otherwise
+     */
+    CHIP_ERROR EnablePreAdvance(ScheduleWorkFunct aScheduleWork, T aHeadroom)
+    {
+        VerifyOrReturnError(mStorage != nullptr, CHIP_ERROR_INCORRECT_STATE);
+        VerifyOrReturnError(aScheduleWork != nullptr, CHIP_ERROR_INVALID_ARGUMENT);
+        VerifyOrReturnError(aHeadroom > 0 && aHeadroom < mEpoch, CHIP_ERROR_INVALID_ARGUMENT);
+
+        mScheduleWork       = aScheduleWork;
+        mPreAdvanceHeadroom = aHeadroom;
         return CHIP_NO_ERROR;
     }
 
 private:
+    void SchedulePreAdvance()
+    {
+        mPreAdvanceScheduled = true;
+        if (mScheduleWork(PersistNextEpochStartAhead, reinterpret_cast<intptr_t>(this)) != CHIP_NO_ERROR)
+        {
+            // Advance() falls back to a synchronous write when the epoch runs out.
+            mPreAdvanceScheduled = false;
+        }
+    }
+
+    static void PersistNextEpochStartAhead(intptr_t aContext)
+    {
+        auto * counter                = reinterpret_cast<PersistedCounter *>(aContext);
+        counter->mPreAdvanceScheduled = false;
+
+        // A synchronous write from Advance() may have moved the epoch on in the meantime.
+        if (counter->mNextEpoch - counter->GetValue() > counter->mPreAdvanceHeadroom)
+        {
+            return;
+        }
+
+        // Values below the previously persisted start stay valid until this write succeeds, so a failure (or a
+        // crash during it) is harmless; the next Advance() will try again.
+        CHIP_ERROR err = counter->PersistNextEpochStart(counter->mNextEpoch + counter->mEpoch);
+        if (err != CHIP_NO_ERROR)
+        {
+            ChipLogError(EventLogging, "Failed to persist next counter epoch: %" CHIP_ERROR_FORMAT, err.Format());
+        }
+    }
+
     /**
      *  @brief
      *    Write out the counter value to persistent storage.
@@ -148,7 +222,6 @@ private:
      */
     CHIP_ERROR PersistNextEpochStart(T aStartValue)
     {
-        mNextEpoch = aStartValue;
 #if CHIP_CONFIG_PERSISTED_COUNTER_DEBUG_LOGGING
         // Compiler should optimize these branches.
         if (is_same_v<decltype(T), uint64_t>)
@@ -163,7 +236,11 @@ private:
 #endif
 
         T valueLE = Encoding::LittleEndian::HostSwap<T>(aStartValue);
-        return mStorage->SyncSetKeyValue(mKey.KeyName(), &valueLE, sizeof(valueLE));
+        ReturnErrorOnFailure(mStorage->SyncSetKeyValue(mKey.KeyName(), &valueLE, sizeof(valueLE)));
+
+        // Only move the bound once it is durable, so that values vended meanwhile are always below the persisted start.
+        mNextEpoch = aStartValue;
+        return CHIP_NO_ERROR;
     }
 
     /**
@@ -214,6 +291,10 @@ private:
     StorageKeyName mKey;
     T mEpoch     = 0; // epoch modulus value
     T mNextEpoch = 0; // next epoch start
+
+    ScheduleWorkFunct mScheduleWork = nullptr; // set when pre-advance is enabled
+    T mPreAdvanceHeadroom           = 0;
+    bool mPreAdvanceScheduled       = false;
 };
 
 } // namespace chip
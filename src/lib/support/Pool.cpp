@@ -20,6 +20,10 @@
 #include <lib/support/CodeUtils.h>
 #include <lib/support/Pool.h>
 
+#if CHIP_SYSTEM_CONFIG_POOL_USE_HEAP && __SANITIZE_ADDRESS__
+#include <sanitizer/asan_interface.h>
+#endif
+
 namespace chip {
 
 #if CHIP_SYSTEM_CONFIG_POOL_USE_HEAP
@@ -129,16 +133,151 @@ Loop StaticAllocatorBitmap::ForEachActiveObjectInner(void * context, Lambda lamb
 
 #if CHIP_SYSTEM_CONFIG_POOL_USE_HEAP
 
+namespace {
+
+// Slots start after the slab header, at an offset suitable for any object alignment.
+template <typename Slab>
+constexpr size_t SlabHeaderSize()
+{
+    return (sizeof(Slab) + alignof(std::max_align_t) - 1) / alignof(std::max_align_t) * alignof(std::max_align_t);
+}
+
+} // namespace
+
+void HeapObjectList::LinkSlab(Slab *& list, Slab * slab)
+{
+    slab->mPrev = nullptr;
+    slab->mNext = list;
+    if (list != nullptr)
+    {
+        list->mPrev = slab;
+    }
+    list = slab;
+}
+
+void HeapObjectList::UnlinkSlab(Slab *& list, Slab * slab)
+{
+    if (slab->mPrev != nullptr)
+    {
+        slab->mPrev->mNext = slab->mNext;
+    }
+    else
+    {
+        list = slab->mNext;
+    }
+    if (slab->mNext != nullptr)
+    {
+        slab->mNext->mPrev = slab->mPrev;
+    }
+}
+
+uint8_t * HeapObjectList::SlotStorage(Slab * slab) const
+{
+    return reinterpret_cast<uint8_t *>(slab) + SlabHeaderSize<Slab>();
+}
+
+HeapObjectList::Slab * HeapObjectList::SlabOf(const HeapObjectListNode * node) const
+{
+    auto slab = static_cast<Slab *>(node->mSlab);
+    VerifyOrReturnValue(slab != nullptr && slab->mOwner == this, nullptr);
+
+    const uintptr_t address = reinterpret_cast<uintptr_t>(node);
+    const uintptr_t start   = reinterpret_cast<uintptr_t>(SlotStorage(slab));
+    VerifyOrReturnValue(address >= start && address < start + slab->mSlots * mSlotSize, nullptr);
+    return ((address - start) % mSlotSize == 0) ? slab : nullptr;
+}
+
 HeapObjectListNode * HeapObjectList::FindNode(void * object) const
 {
-    for (HeapObjectListNode * p = mNext; p != this; p = p->mNext)
+    auto node = reinterpret_cast<HeapObjectListNode *>(static_cast<uint8_t *>(object) - mObjectOffset);
+    VerifyOrReturnValue(SlabOf(node) != nullptr, nullptr);
+    return (node->mObject == object) ? node : nullptr;
+}
+
+HeapObjectListNode * HeapObjectList::AllocateNode()
+{
+    Slab * slab = mAvailableSlabs;
+    if (slab == nullptr)
     {
-        if (p->mObject == object)
+        // Double the number of slots with every slab, within bounds, so that large pools need few allocations while
+        // small pools stay small.
+        size_t slots = (mTotalSlots < kMinSlabSlots) ? kMinSlabSlots : mTotalSlots;
+        slots        = (slots > kMaxSlabSlots) ? kMaxSlabSlots : slots;
+        slab         = static_cast<Slab *>(Platform::MemoryAlloc(SlabHeaderSize<Slab>() + slots * mSlotSize));
+        VerifyOrReturnValue(slab != nullptr, nullptr);
+
+        slab->mOwner     = this;
+        slab->mFreeList  = nullptr;
+        slab->mSlots     = slots;
+        slab->mFreeSlots = slots;
+
+        // Push the slots in reverse so they are handed out in address order.
+        uint8_t * storage = SlotStorage(slab);
+        for (size_t i = slots; i > 0; --i)
         {
-            return p;
+            auto node       = new (storage + (i - 1) * mSlotSize) HeapObjectListNode();
+            node->mObject   = nullptr;
+            node->mSlab     = slab;
+            node->mNext     = slab->mFreeList;
+            slab->mFreeList = node;
         }
+
+        LinkSlab(mAvailableSlabs, slab);
+        mTotalSlots += slots;
+        ++mSlabCount;
+    }
+
+    HeapObjectListNode * node = slab->mFreeList;
+    slab->mFreeList           = node->mNext;
+    if (--slab->mFreeSlots == 0)
+    {
+        UnlinkSlab(mAvailableSlabs, slab);
+        LinkSlab(mFullSlabs, slab);
+    }
+    return node;
+}
+
+void HeapObjectList::ReleaseNode(HeapObjectListNode * node)
+{
+    // The node needs to be released immediately if we are not in the middle of iteration.
+    // Otherwise cleanup is deferred until all iteration on this pool completes and it's safe to release nodes.
+    if (mIterationDepth == 0)
+    {
+        node->Remove();
+        FreeNode(node);
+    }
+    else
+    {
+#if __SANITIZE_ADDRESS__
+        // The object is already destroyed; only its node stays reachable until iteration completes.
+        ASAN_POISON_MEMORY_REGION(ObjectStorage(node), mSlotSize - mObjectOffset);
+#endif // __SANITIZE_ADDRESS__
+        mHaveDeferredNodeRemovals = true;
+    }
+}
+
+void HeapObjectList::FreeNode(HeapObjectListNode * node)
+{
+    // Nodes only get here from FindNode() or from this list's own iteration, so the back-pointer is trusted.
+    auto slab = static_cast<Slab *>(node->mSlab);
+
+    node->mNext     = slab->mFreeList;
+    slab->mFreeList = node;
+
+    if (slab->mFreeSlots++ == 0)
+    {
+        UnlinkSlab(mFullSlabs, slab);
+        LinkSlab(mAvailableSlabs, slab);
+    }
+
+    if (slab->mFreeSlots == slab->mSlots)
+    {
+        // None of the slots is in use any more, so give the slab back instead of holding on to the high-water mark.
+        UnlinkSlab(mAvailableSlabs, slab);
+        mTotalSlots -= slab->mSlots;
+        --mSlabCount;
+        Platform::MemoryFree(slab);
     }
-    return nullptr;
 }
 
 Loop HeapObjectList::ForEachNode(void * context, Lambda lambda)
@@ -169,7 +308,7 @@ Loop HeapObjectList::ForEachNode(void * context, Lambda lambda)
             if (p->mObject == nullptr)
             {
                 p->Remove();
-                Platform::Delete(p);
+                FreeNode(p);
             }
             p = next;
         }
@@ -29,11 +29,24 @@
 #include <lib/support/Iterators.h>
 
 #include <atomic>
+#include <cstddef>
 #include <limits>
 #include <new>
 #include <stddef.h>
 #include <utility>
 
+#ifndef __SANITIZE_ADDRESS__
+#ifdef __clang__
+#if __has_feature(address_sanitizer)
+#define __SANITIZE_ADDRESS__ 1
+#else
+#define __SANITIZE_ADDRESS__ 0
+#endif // __has_feature(address_sanitizer)
+#else
+#define __SANITIZE_ADDRESS__ 0
+#endif // __clang__
+#endif // __SANITIZE_ADDRESS__
+
 namespace chip {
 
 namespace internal {
@@ -147,11 +160,35 @@ struct HeapObjectListNode
     void * mObject;
     HeapObjectListNode * mNext;
     HeapObjectListNode * mPrev;
+    void * mSlab; // The slab holding this node, so that releasing it does not need to search for it.
 };
 
+/**
+ * Intrusive list of the live objects of a HeapObjectPool, which also owns the memory those objects live in.
+ *
+ * Each object is stored in a slot right after its list node, so that finding the node of an object is a constant offset
+ * and creating an object takes a single allocation.  Slots are carved out of slabs that grow geometrically as the pool
+ * grows; released slots are kept on their slab's free list for reuse, and a slab is returned to the heap as soon as none
+ * of its slots is in use.
+ *
+ * ASAN builds use a single slot per slab, so that every object is its own heap allocation and use-after-free or double
+ * release of pool objects is reported as it would be for plain heap objects.
+ */
 struct HeapObjectList : HeapObjectListNode
 {
-    HeapObjectList() { mNext = mPrev = this; }
+#if __SANITIZE_ADDRESS__
+    static constexpr size_t kMinSlabSlots = 1;
+    static constexpr size_t kMaxSlabSlots = 1;
+#else
+    static constexpr size_t kMinSlabSlots = 4;
+    static constexpr size_t kMaxSlabSlots = 64;
+#endif // __SANITIZE_ADDRESS__
+
+    HeapObjectList(size_t objectOffset, size_t slotSize) : mObjectOffset(objectOffset), mSlotSize(slotSize)
+    {
+        mNext = mPrev = this;
+        mSlab         = nullptr;
+    }
 
     void Append(HeapObjectListNode * node)
     {
@@ -161,8 +198,29 @@ struct HeapObjectList : HeapObjectListNode
         mPrev        = node;
     }
 
+    /**
+     * Returns an unlinked node whose object storage (see ObjectStorage()) is available, or nullptr if the heap is exhausted.
+     */
+    HeapObjectListNode * AllocateNode();
+
+    /**
+     * Releases the node of an object that has already been destroyed.  If the list is being iterated, unlinking the node
+     * is deferred until all iteration completes.
+     */
+    void ReleaseNode(HeapObjectListNode * node);
+
+    void * ObjectStorage(HeapObjectListNode * node) const { return reinterpret_cast<uint8_t *>(node) + mObjectOffset; }
+
+    /**
+     * Returns the node holding object, or nullptr if object is not a live object of this list.  Takes constant time: the
+     * node's slab back-pointer is checked to be a slab of this list, with the node on one of its slot boundaries, instead
+     * of searching the slabs.  A pointer whose slab was already returned to the heap is read like any other dangling
+     * pointer, and is reported as such by ASAN, where every object has its own slab.
+     */
     HeapObjectListNode * FindNode(void * object) const;
 
+    size_t SlabCount() const { return mSlabCount; }
+
     using Lambda = Loop (*)(void *, void *);
     Loop ForEachNode(void * context, Lambda lambda);
     Loop ForEachNode(void * context, Loop lambda(void * context, const void * object)) const
@@ -172,6 +230,31 @@ struct HeapObjectList : HeapObjectListNode
 
     size_t mIterationDepth         = 0;
     bool mHaveDeferredNodeRemovals = false;
+
+private:
+    struct Slab
+    {
+        const HeapObjectList * mOwner;
+        Slab * mNext;
+        Slab * mPrev;
+        HeapObjectListNode * mFreeList; // Singly linked through mNext.
+        size_t mSlots;
+        size_t mFreeSlots;
+    };
+
+    static void LinkSlab(Slab *& list, Slab * slab);
+    static void UnlinkSlab(Slab *& list, Slab * slab);
+
+    uint8_t * SlotStorage(Slab * slab) const;
+    Slab * SlabOf(const HeapObjectListNode * node) const;
+    void FreeNode(HeapObjectListNode * node);
+
+    const size_t mObjectOffset;
+    const size_t mSlotSize;
+    Slab * mAvailableSlabs = nullptr; // Slabs with at least one free slot.
+    Slab * mFullSlabs      = nullptr;
+    size_t mSlabCount      = 0;
+    size_t mTotalSlots     = 0;
 };
 
 #endif // CHIP_SYSTEM_CONFIG_POOL_USE_HEAP
@@ -320,17 +403,6 @@ public:
     HeapObjectPool() {}
     ~HeapObjectPool()
     {
-#ifndef __SANITIZE_ADDRESS__
-#ifdef __clang__
-#if __has_feature(address_sanitizer)
-#define __SANITIZE_ADDRESS__ 1
-#else
-#define __SANITIZE_ADDRESS__ 0
-#endif // __has_feature(address_sanitizer)
-#else
-#define __SANITIZE_ADDRESS__ 0
-#endif // __clang__
-#endif // __SANITIZE_ADDRESS__
 #if __SANITIZE_ADDRESS__
         // Free all remaining objects so that ASAN can catch specific use-after-free cases.
         ReleaseAll();
@@ -346,17 +418,14 @@ public:
     template <typename... Args>
     T * CreateObject(Args &&... args)
     {
-        T * object = Platform::New<T>(std::forward<Args>(args)...);
-        if (object != nullptr)
+        internal::HeapObjectListNode * node = mObjects.AllocateNode();
+        if (node != nullptr)
         {
-            auto node = Platform::New<internal::HeapObjectListNode>();
-            if (node != nullptr)
-            {
-                node->mObject = object;
-                mObjects.Append(node);
-                IncreaseUsage();
-                return object;
-            }
+            T * object    = new (mObjects.ObjectStorage(node)) T(std::forward<Args>(args)...);
+            node->mObject = object;
+            mObjects.Append(node);
+            IncreaseUsage();
+            return object;
         }
         return nullptr;
     }
@@ -383,19 +452,8 @@ public:
             VerifyOrDie(node != nullptr);
 
             node->mObject = nullptr;
-            Platform::Delete(object);
-
-            // The node needs to be released immediately if we are not in the middle of iteration.
-            // Otherwise cleanup is deferred until all iteration on this pool completes and it's safe to release nodes.
-            if (mObjects.mIterationDepth == 0)
-            {
-                node->Remove();
-                Platform::Delete(node);
-            }
-            else
-            {
-                mObjects.mHaveDeferredNodeRemovals = true;
-            }
+            object->~T();
+            mObjects.ReleaseNode(node);
 
             DecreaseUsage();
         }
@@ -403,6 +461,11 @@ public:
 
     void ReleaseAll() { mObjects.ForEachNode(this, ReleaseObject); }
 
+    /**
+     * Number of heap allocations currently backing the pool's objects.
+     */
+    size_t SlabCount() const { return mObjects.SlabCount(); }
+
     /**
      * @brief
      *   Run a functor for each active object in the pool
@@ -441,7 +504,15 @@ private:
         return Loop::Continue;
     }
 
-    internal::HeapObjectList mObjects;
+    // Each slot holds a list node followed by the object, both suitably aligned.
+    static constexpr size_t RoundUp(size_t size, size_t alignment) { return (size + alignment - 1) / alignment * alignment; }
+    static constexpr size_t kSlotAlignment = alignof(T) > alignof(internal::HeapObjectListNode) ? alignof(T)
+                                                                                                 : alignof(internal::HeapObjectListNode);
+    static constexpr size_t kObjectOffset  = RoundUp(sizeof(internal::HeapObjectListNode), alignof(T));
+    static constexpr size_t kSlotSize      = RoundUp(kObjectOffset + sizeof(T), kSlotAlignment);
+    static_assert(kSlotAlignment <= alignof(std::max_align_t), "HeapObjectPool does not support over-aligned types");
+
+    internal::HeapObjectList mObjects{ kObjectOffset, kSlotSize };
 };
 
 #endif // CHIP_SYSTEM_CONFIG_POOL_USE_HEAP
@@ -126,6 +126,37 @@ public:
         return err;
     }
 
+    CHIP_ERROR BeginTransaction() override
+    {
+        VerifyOrReturnError(!mInTransaction, CHIP_ERROR_INCORRECT_STATE);
+        mTransactionSnapshot = mStorage;
+        mInTransaction       = true;
+        return CHIP_NO_ERROR;
+    }
+
+    CHIP_ERROR CommitTransaction() override
+    {
+        VerifyOrReturnError(mInTransaction, CHIP_ERROR_INCORRECT_STATE);
+        mTransactionSnapshot.clear();
+        mInTransaction = false;
+        return CHIP_NO_ERROR;
+    }
+
+    void AbortTransaction() override
+    {
+        if (mInTransaction)
+        {
+            mStorage = std::move(mTransactionSnapshot);
+            mTransactionSnapshot.clear();
+            mInTransaction = false;
+        }
+    }
+
+    /**
+     * @return true if a transaction is open
+     */
+    virtual bool IsInTransaction() const { return mInTransaction; }
+
     /**
      * @brief Adds a "poison key": a key that, if read/written, implies some bad
      *        behavior occurred.
@@ -272,6 +303,9 @@ protected:
     }
 
     std::map<std::string, std::vector<uint8_t>> mStorage;
+    // Contents of mStorage when the open transaction started, restored if it is aborted.
+    std::map<std::string, std::vector<uint8_t>> mTransactionSnapshot;
+    bool mInTransaction = false;
     std::set<std::string> mPoisonKeys;
     LoggingLevel mLoggingLevel = LoggingLevel::kDisabled;
 };
@@ -196,6 +196,14 @@ void Log(uint8_t module, uint8_t category, const char * msg, ...)
 
 void LogV(uint8_t module, uint8_t category, const char * msg, va_list args)
 {
+#if CHIP_LOG_FILTERING
+    // Checked here rather than in the logging macros so that they stay the same size; this still skips the formatting.
+    if (category > GetModuleLogFilter(static_cast<LogModule>(module)))
+    {
+        return;
+    }
+#endif // CHIP_LOG_FILTERING
+
     const char * moduleName        = GetModuleName(static_cast<LogModule>(module));
     LogRedirectCallback_t redirect = sLogRedirectCallback.load();
     if (redirect != nullptr)
@@ -221,6 +229,28 @@ void SetLogFilter(uint8_t category)
     gLogFilter = category;
 }
 
+// Stored as how far each module filter is below kLogCategory_Max, so that the zero-initialized default lets everything
+// through.
+uint8_t gModuleLogFilterReduction[kLogModule_Max];
+
+uint8_t GetModuleLogFilter(LogModule module)
+{
+    if (module >= kLogModule_Max)
+    {
+        return kLogCategory_Max;
+    }
+    return static_cast<uint8_t>(kLogCategory_Max - gModuleLogFilterReduction[module]);
+}
+
+void SetModuleLogFilter(LogModule module, uint8_t category)
+{
+    if (module < kLogModule_Max)
+    {
+        category                          = (category < kLogCategory_Max) ? category : kLogCategory_Max;
+        gModuleLogFilterReduction[module] = static_cast<uint8_t>(kLogCategory_Max - category);
+    }
+}
+
 #else  // CHIP_LOG_FILTERING
 
 uint8_t GetLogFilter()
@@ -232,6 +262,18 @@ void SetLogFilter(uint8_t category)
 {
     IgnoreUnusedVariable(category);
 }
+
+uint8_t GetModuleLogFilter(LogModule module)
+{
+    IgnoreUnusedVariable(module);
+    return kLogCategory_Max;
+}
+
+void SetModuleLogFilter(LogModule module, uint8_t category)
+{
+    IgnoreUnusedVariable(module);
+    IgnoreUnusedVariable(category);
+}
 #endif // CHIP_LOG_FILTERING
 
 #if CHIP_LOG_FILTERING
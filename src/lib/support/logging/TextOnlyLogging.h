@@ -90,6 +90,11 @@ DLL_EXPORT void SetLogRedirectCallback(LogRedirectCallback_t callback);
 DLL_EXPORT uint8_t GetLogFilter();
 DLL_EXPORT void SetLogFilter(uint8_t category);
 
+// Per-module log filtering (no-op unless CHIP_LOG_FILTERING is enabled). A module filter only narrows the global one;
+// it defaults to kLogCategory_Max, which lets through everything the global filter does.
+DLL_EXPORT uint8_t GetModuleLogFilter(LogModule module);
+DLL_EXPORT void SetModuleLogFilter(LogModule module, uint8_t category);
+
 #if CHIP_ERROR_LOGGING
 /**
  * @def ChipLogError(MOD, MSG, ...)
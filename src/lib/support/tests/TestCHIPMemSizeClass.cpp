@@ -0,0 +1,391 @@
+/*
+ *
+ *    Copyright (c) 2023 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *      This file implements a unit test suite for the size-class
+ *      implementation of the CHIP Memory Management API.
+ *
+ */
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <algorithm>
+#include <chrono>
+
+#include <lib/core/CHIPConfig.h>
+#include <lib/support/CHIPMem.h>
+#include <lib/support/CHIPMemSizeClass.h>
+#include <lib/support/CodeUtils.h>
+#include <lib/support/UnitTestContext.h>
+#include <lib/support/UnitTestRegistration.h>
+#include <lib/support/logging/CHIPLogging.h>
+#include <nlunit-test.h>
+#include <system/SystemConfig.h>
+
+#if CHIP_SYSTEM_CONFIG_POSIX_LOCKING
+#include <pthread.h>
+#endif // CHIP_SYSTEM_CONFIG_POSIX_LOCKING
+
+using namespace chip;
+using namespace chip::Platform;
+
+namespace {
+
+size_t InUse(size_t sizeClass)
+{
+    MemorySizeClassStats stats;
+    VerifyOrDie(MemoryGetSizeClassStats(sizeClass, stats) == CHIP_NO_ERROR);
+    return stats.mInUse;
+}
+
+size_t SlabCount(size_t sizeClass)
+{
+    MemorySizeClassStats stats;
+    VerifyOrDie(MemoryGetSizeClassStats(sizeClass, stats) == CHIP_NO_ERROR);
+    return stats.mSlabCount;
+}
+
+size_t TotalSlabCount()
+{
+    size_t count = 0;
+    for (size_t i = 0; i < MemorySizeClassCount(); i++)
+    {
+        count += SlabCount(i);
+    }
+    return count;
+}
+
+size_t TotalInUse()
+{
+    size_t count = 0;
+    for (size_t i = 0; i < MemorySizeClassCount(); i++)
+    {
+        count += InUse(i);
+    }
+    return count;
+}
+
+void TestSizeClasses(nlTestSuite * inSuite, void * inContext)
+{
+    MemorySizeClassStats stats;
+    size_t previousSize = 0;
+
+    NL_TEST_ASSERT(inSuite, MemorySizeClassCount() > 0);
+    NL_TEST_ASSERT(inSuite, MemoryGetSizeClassStats(MemorySizeClassCount(), stats) == CHIP_ERROR_INVALID_ARGUMENT);
+
+    for (size_t i = 0; i < MemorySizeClassCount(); i++)
+    {
+        NL_TEST_ASSERT(inSuite, MemoryGetSizeClassStats(i, stats) == CHIP_NO_ERROR);
+        NL_TEST_ASSERT(inSuite, stats.mBlockSize > previousSize);
+        previousSize = stats.mBlockSize;
+
+        // Anything from just above the previous class up to the block size lands in this class.
+        size_t before = stats.mInUse;
+        void * p      = MemoryAlloc(stats.mBlockSize);
+        NL_TEST_EXIT_ON_FAILED_ASSERT(inSuite, p != nullptr);
+        NL_TEST_ASSERT(inSuite, reinterpret_cast<uintptr_t>(p) % alignof(max_align_t) == 0);
+        NL_TEST_ASSERT(inSuite, InUse(i) == before + 1);
+        memset(p, 0xA5, stats.mBlockSize);
+        MemoryFree(p);
+        NL_TEST_ASSERT(inSuite, InUse(i) == before);
+    }
+}
+
+void TestBlockReuse(nlTestSuite * inSuite, void * inContext)
+{
+    // A freed block is the next one handed out for its class.
+    void * p1 = MemoryAlloc(24);
+    NL_TEST_EXIT_ON_FAILED_ASSERT(inSuite, p1 != nullptr);
+    MemoryFree(p1);
+
+    void * p2 = MemoryAlloc(20);
+    NL_TEST_ASSERT(inSuite, p2 == p1);
+    MemoryFree(p2);
+}
+
+void TestRealloc(nlTestSuite * inSuite, void * inContext)
+{
+    auto * p = static_cast<uint8_t *>(MemoryAlloc(10));
+    NL_TEST_EXIT_ON_FAILED_ASSERT(inSuite, p != nullptr);
+    for (uint8_t i = 0; i < 10; i++)
+    {
+        p[i] = i;
+    }
+
+    // Growing within the block keeps it in place.
+    NL_TEST_ASSERT(inSuite, MemoryRealloc(p, 16) == p);
+
+    // Growing past it moves to a larger class, then to a large block, keeping the contents.
+    auto * q = static_cast<uint8_t *>(MemoryRealloc(p, 100));
+    NL_TEST_EXIT_ON_FAILED_ASSERT(inSuite, q != nullptr);
+    q = static_cast<uint8_t *>(MemoryRealloc(q, 64 * 1024));
+    NL_TEST_EXIT_ON_FAILED_ASSERT(inSuite, q != nullptr);
+    q = static_cast<uint8_t *>(MemoryRealloc(q, 128 * 1024));
+    NL_TEST_EXIT_ON_FAILED_ASSERT(inSuite, q != nullptr);
+
+    for (uint8_t i = 0; i < 10; i++)
+    {
+        NL_TEST_ASSERT(inSuite, q[i] == i);
+    }
+    NL_TEST_ASSERT(inSuite, MemoryDebugCheckPointer(q, 128 * 1024));
+    MemoryFree(q);
+}
+
+void TestCalloc(nlTestSuite * inSuite, void * inContext)
+{
+    // Dirty a block, then check that calloc clears it when handing it out again.
+    auto * p = static_cast<uint8_t *>(MemoryAlloc(48));
+    NL_TEST_EXIT_ON_FAILED_ASSERT(inSuite, p != nullptr);
+    memset(p, 0xFF, 48);
+    MemoryFree(p);
+
+    p = static_cast<uint8_t *>(MemoryCalloc(6, 8));
+    NL_TEST_EXIT_ON_FAILED_ASSERT(inSuite, p != nullptr);
+    for (size_t i = 0; i < 48; i++)
+    {
+        NL_TEST_ASSERT(inSuite, p[i] == 0);
+    }
+    MemoryFree(p);
+
+    NL_TEST_ASSERT(inSuite, MemoryCalloc(SIZE_MAX / 2, 4) == nullptr);
+}
+
+void TestFreeAfterShutdown(nlTestSuite * inSuite, void * inContext)
+{
+    // Class 0 serves 16-byte requests.
+    const size_t inUse = InUse(0);
+    void * p           = MemoryAlloc(16);
+    void * q           = MemoryAlloc(16);
+    NL_TEST_EXIT_ON_FAILED_ASSERT(inSuite, p != nullptr && q != nullptr);
+    memset(q, 0x5A, 16);
+
+    // Blocks still in use keep their slabs through shutdown, and can be freed afterwards.
+    MemoryShutdown();
+    NL_TEST_ASSERT(inSuite, MemoryAlloc(16) == nullptr);
+    NL_TEST_ASSERT(inSuite, SlabCount(0) > 0);
+    MemoryFree(p);
+    NL_TEST_ASSERT(inSuite, InUse(0) == inUse + 1);
+
+    // A new session adopts the remaining slabs, and the block from the previous one stays counted and intact.
+    NL_TEST_EXIT_ON_FAILED_ASSERT(inSuite, MemoryInit() == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, InUse(0) == inUse + 1);
+    void * r = MemoryAlloc(16);
+    NL_TEST_ASSERT(inSuite, r != nullptr && r != q);
+    NL_TEST_ASSERT(inSuite, static_cast<uint8_t *>(q)[15] == 0x5A);
+    MemoryFree(r);
+    MemoryFree(q);
+    NL_TEST_ASSERT(inSuite, InUse(0) == inUse);
+
+    // Once the last block is freed after shutdown, the slabs go back to the heap.
+    if (TotalInUse() == 0)
+    {
+        p = MemoryAlloc(16);
+        MemoryShutdown();
+        NL_TEST_ASSERT(inSuite, TotalSlabCount() > 0);
+        MemoryFree(p);
+        NL_TEST_ASSERT(inSuite, TotalSlabCount() == 0);
+        NL_TEST_ASSERT(inSuite, InUse(0) == 0);
+        NL_TEST_EXIT_ON_FAILED_ASSERT(inSuite, MemoryInit() == CHIP_NO_ERROR);
+    }
+}
+
+#if CHIP_CONFIG_MEMORY_SIZE_CLASS_THREAD_CACHE_SIZE > 0 && CHIP_SYSTEM_CONFIG_POSIX_LOCKING
+
+constexpr size_t kCrossThreadBlocks = 4 * CHIP_CONFIG_MEMORY_SIZE_CLASS_THREAD_CACHE_SIZE + 1;
+void * gCrossThreadBlocks[kCrossThreadBlocks];
+
+void * AllocateBlocks(void *)
+{
+    for (auto & block : gCrossThreadBlocks)
+    {
+        block = MemoryAlloc(100);
+    }
+    return nullptr;
+}
+
+void * FreeBlocks(void *)
+{
+    for (auto & block : gCrossThreadBlocks)
+    {
+        MemoryFree(block);
+        block = nullptr;
+    }
+    return nullptr;
+}
+
+bool RunOnThread(void * (*function)(void *) )
+{
+    pthread_t thread;
+    return pthread_create(&thread, nullptr, function, nullptr) == 0 && pthread_join(thread, nullptr) == 0;
+}
+
+void TestThreadCache(nlTestSuite * inSuite, void * inContext)
+{
+    // Class 3 serves 100-byte requests.
+    const size_t inUse = InUse(3);
+
+    // Blocks allocated by one thread and freed by another make it back to the shared lists, through the freeing
+    // thread's cache and its exit, so repeating this does not keep adding slabs.
+    NL_TEST_ASSERT(inSuite, RunOnThread(AllocateBlocks) && RunOnThread(FreeBlocks));
+    const size_t slabs = SlabCount(3);
+    for (int i = 0; i < 10; i++)
+    {
+        NL_TEST_ASSERT(inSuite, RunOnThread(AllocateBlocks) && RunOnThread(FreeBlocks));
+    }
+    NL_TEST_ASSERT(inSuite, SlabCount(3) == slabs);
+    NL_TEST_ASSERT(inSuite, InUse(3) == inUse);
+
+    // The calling thread's cache hands back what it was just given.
+    void * p = MemoryAlloc(100);
+    MemoryFree(p);
+    NL_TEST_ASSERT(inSuite, MemoryAlloc(100) == p);
+    MemoryFree(p);
+
+    // Blocks freed on another thread after shutdown bypass the thread caches, which were dropped by the shutdown.
+    NL_TEST_ASSERT(inSuite, RunOnThread(AllocateBlocks));
+    MemoryShutdown();
+    NL_TEST_ASSERT(inSuite, RunOnThread(FreeBlocks));
+    NL_TEST_ASSERT(inSuite, InUse(3) == inUse);
+    NL_TEST_EXIT_ON_FAILED_ASSERT(inSuite, MemoryInit() == CHIP_NO_ERROR);
+
+    // The cache of this thread was dropped too, and the blocks it held are not handed out twice.
+    void * a = MemoryAlloc(100);
+    void * b = MemoryAlloc(100);
+    NL_TEST_ASSERT(inSuite, a != nullptr && b != nullptr && a != b);
+    MemoryFree(a);
+    MemoryFree(b);
+    NL_TEST_ASSERT(inSuite, InUse(3) == inUse);
+}
+
+#endif // CHIP_CONFIG_MEMORY_SIZE_CLASS_THREAD_CACHE_SIZE > 0 && CHIP_SYSTEM_CONFIG_POSIX_LOCKING
+
+// Churns a mix of object sizes with mixed lifetimes, the way exchange contexts, timers and
+// TLV scratch buffers come and go, and reports throughput against malloc() and how much of
+// the slab memory is in use at peak.
+void TestChurnBenchmark(nlTestSuite * inSuite, void * inContext)
+{
+    constexpr size_t kLiveSlots       = 512;
+    constexpr uint32_t kIterations    = 200000;
+    constexpr size_t kObjectSizes[]   = { 24, 40, 64, 96, 160, 200, 320, 700 };
+    constexpr size_t kObjectSizeCount = sizeof(kObjectSizes) / sizeof(kObjectSizes[0]);
+
+    static void * slots[kLiveSlots];
+    size_t peakRequested = 0;
+
+    auto churn = [&](void * (*alloc)(size_t), void (*release)(void *)) {
+        size_t sizes[kLiveSlots] = {};
+        size_t requested         = 0;
+        uint32_t rng             = 12345;
+        memset(slots, 0, sizeof(slots));
+
+        auto start = std::chrono::steady_clock::now();
+        for (uint32_t i = 0; i < kIterations; i++)
+        {
+            rng = rng * 1103515245 + 12345;
+
+            size_t slot = (rng >> 8) % kLiveSlots;
+            if (slots[slot] != nullptr)
+            {
+                release(slots[slot]);
+                requested -= sizes[slot];
+                slots[slot] = nullptr;
+            }
+            else
+            {
+                sizes[slot] = kObjectSizes[(rng >> 20) % kObjectSizeCount];
+                slots[slot] = alloc(sizes[slot]);
+                requested += sizes[slot];
+                peakRequested = std::max(peakRequested, requested);
+            }
+        }
+        auto elapsed = std::chrono::steady_clock::now() - start;
+
+        for (auto & p : slots)
+        {
+            release(p);
+        }
+        return std::chrono::duration_cast<std::chrono::microseconds>(elapsed).count();
+    };
+
+    auto sizeClassUs = churn(MemoryAlloc, MemoryFree);
+    auto mallocUs    = churn(malloc, free);
+
+    size_t slabBytes = 0;
+    for (size_t i = 0; i < MemorySizeClassCount(); i++)
+    {
+        MemorySizeClassStats stats;
+        NL_TEST_ASSERT(inSuite, MemoryGetSizeClassStats(i, stats) == CHIP_NO_ERROR);
+        NL_TEST_ASSERT(inSuite, stats.mPeakInUse <= stats.mBlockCount);
+        slabBytes += stats.mBlockCount * stats.mBlockSize;
+    }
+
+    ChipLogProgress(Support, "Size-class churn: %u ops in %ld us (malloc: %ld us); peak requested %u of %u block bytes",
+                    static_cast<unsigned>(kIterations), static_cast<long>(sizeClassUs), static_cast<long>(mallocUs),
+                    static_cast<unsigned>(peakRequested), static_cast<unsigned>(slabBytes));
+    NL_TEST_ASSERT(inSuite, peakRequested <= slabBytes);
+}
+
+} // namespace
+
+/**
+ *   Test Suite. It lists all the test functions.
+ */
+static const nlTest sTests[] = { NL_TEST_DEF("Test SizeClass::SizeClasses", TestSizeClasses),
+                                 NL_TEST_DEF("Test SizeClass::BlockReuse", TestBlockReuse),
+                                 NL_TEST_DEF("Test SizeClass::Realloc", TestRealloc),
+                                 NL_TEST_DEF("Test SizeClass::Calloc", TestCalloc),
+                                 NL_TEST_DEF("Test SizeClass::FreeAfterShutdown", TestFreeAfterShutdown),
+#if CHIP_CONFIG_MEMORY_SIZE_CLASS_THREAD_CACHE_SIZE > 0 && CHIP_SYSTEM_CONFIG_POSIX_LOCKING
+                                 NL_TEST_DEF("Test SizeClass::ThreadCache", TestThreadCache),
+#endif
+                                 NL_TEST_DEF("Test SizeClass::ChurnBenchmark", TestChurnBenchmark),
+                                 NL_TEST_SENTINEL() };
+
+/**
+ *  Set up the test suite.
+ */
+int TestMemSizeClass_Setup(void * inContext)
+{
+    CHIP_ERROR error = MemoryInit();
+    if (error != CHIP_NO_ERROR)
+        return (FAILURE);
+    return (SUCCESS);
+}
+
+/**
+ *  Tear down the test suite.
+ */
+int TestMemSizeClass_Teardown(void * inContext)
+{
+    MemoryShutdown();
+    return (SUCCESS);
+}
+
+int TestMemSizeClass()
+{
+    nlTestSuite theSuite = { "CHIP Size-Class Memory Allocation tests", &sTests[0], TestMemSizeClass_Setup,
+                             TestMemSizeClass_Teardown };
+
+    nlTestRunner(&theSuite, nullptr);
+
+    return (nlTestRunnerStats(&theSuite));
+}
+
+CHIP_REGISTER_TEST_SUITE(TestMemSizeClass)
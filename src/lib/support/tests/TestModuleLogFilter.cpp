@@ -0,0 +1,111 @@
+/*
+ *
+ *    Copyright (c) 2023 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#include <lib/support/UnitTestRegistration.h>
+#include <lib/support/logging/CHIPLogging.h>
+
+#include <nlunit-test.h>
+
+#include <string>
+#include <vector>
+
+using namespace chip;
+using namespace chip::Logging;
+
+namespace {
+
+std::vector<std::string> gLoggedModules;
+
+ENFORCE_FORMAT(3, 0) void RecordLogLine(const char * module, uint8_t category, const char * msg, va_list args)
+{
+    gLoggedModules.push_back(module);
+}
+
+// Logs one line per (module, category) and returns the modules of the lines that got through.
+std::vector<std::string> LogLines(std::initializer_list<std::pair<LogModule, LogCategory>> lines)
+{
+    gLoggedModules.clear();
+    SetLogRedirectCallback(&RecordLogLine);
+    for (auto & line : lines)
+    {
+        Log(line.first, line.second, "line");
+    }
+    SetLogRedirectCallback(nullptr);
+    return gLoggedModules;
+}
+
+void TestDefaultModuleFilter(nlTestSuite * inSuite, void * inContext)
+{
+    NL_TEST_ASSERT(inSuite, GetModuleLogFilter(kLogModule_Zcl) == kLogCategory_Max);
+    NL_TEST_ASSERT(inSuite, GetModuleLogFilter(kLogModule_Max) == kLogCategory_Max);
+
+    auto logged = LogLines({ { kLogModule_Zcl, kLogCategory_Detail }, { kLogModule_DataManagement, kLogCategory_Progress } });
+    NL_TEST_ASSERT(inSuite, logged.size() == 2);
+}
+
+void TestNarrowedModuleFilter(nlTestSuite * inSuite, void * inContext)
+{
+    SetModuleLogFilter(kLogModule_Zcl, kLogCategory_Error);
+
+#if CHIP_LOG_FILTERING
+    NL_TEST_ASSERT(inSuite, GetModuleLogFilter(kLogModule_Zcl) == kLogCategory_Error);
+
+    // Only the filtered module loses its progress and detail lines.
+    auto logged = LogLines({ { kLogModule_Zcl, kLogCategory_Progress },
+                             { kLogModule_Zcl, kLogCategory_Detail },
+                             { kLogModule_Zcl, kLogCategory_Error },
+                             { kLogModule_DataManagement, kLogCategory_Progress } });
+    NL_TEST_ASSERT(inSuite, logged.size() == 2);
+    NL_TEST_ASSERT(inSuite, logged.size() == 2 && logged[0] == GetModuleName(kLogModule_Zcl));
+    NL_TEST_ASSERT(inSuite, logged.size() == 2 && logged[1] == GetModuleName(kLogModule_DataManagement));
+
+    // Categories past kLogCategory_Max are clamped, and unknown modules ignored.
+    SetModuleLogFilter(kLogModule_Zcl, UINT8_MAX);
+    NL_TEST_ASSERT(inSuite, GetModuleLogFilter(kLogModule_Zcl) == kLogCategory_Max);
+    SetModuleLogFilter(kLogModule_Max, kLogCategory_None);
+    NL_TEST_ASSERT(inSuite, GetModuleLogFilter(kLogModule_Max) == kLogCategory_Max);
+#else
+    // Without CHIP_LOG_FILTERING, module filters cannot be narrowed.
+    NL_TEST_ASSERT(inSuite, GetModuleLogFilter(kLogModule_Zcl) == kLogCategory_Max);
+    auto logged = LogLines({ { kLogModule_Zcl, kLogCategory_Progress } });
+    NL_TEST_ASSERT(inSuite, logged.size() == 1);
+#endif // CHIP_LOG_FILTERING
+
+    SetModuleLogFilter(kLogModule_Zcl, kLogCategory_Max);
+}
+
+} // namespace
+
+int TestModuleLogFilter()
+{
+    static nlTest sTests[] = {
+        NL_TEST_DEF("TestDefaultModuleFilter", TestDefaultModuleFilter),
+        NL_TEST_DEF("TestNarrowedModuleFilter", TestNarrowedModuleFilter),
+        NL_TEST_SENTINEL(),
+    };
+
+    nlTestSuite theSuite = {
+        "ModuleLogFilter",
+        &sTests[0],
+        nullptr,
+        nullptr,
+    };
+    nlTestRunner(&theSuite, nullptr);
+    return (nlTestRunnerStats(&theSuite));
+}
+
+CHIP_REGISTER_TEST_SUITE(TestModuleLogFilter)
@@ -0,0 +1,167 @@
+/*
+ *    Copyright (c) 2023 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#include <lib/support/MpscRing.h>
+#include <lib/support/UnitTestRegistration.h>
+#include <system/SystemConfig.h>
+
+#include <nlunit-test.h>
+
+#if CHIP_SYSTEM_CONFIG_POSIX_LOCKING
+#include <pthread.h>
+#endif // CHIP_SYSTEM_CONFIG_POSIX_LOCKING
+
+namespace {
+
+using namespace chip;
+
+void TestFifoOrder(nlTestSuite * inSuite, void * inContext)
+{
+    MpscRing<uint32_t, 8> ring;
+    uint32_t value;
+
+    NL_TEST_ASSERT(inSuite, !ring.TryPop(value));
+
+    // Go around the ring a few times so that positions wrap.
+    uint32_t next = 0;
+    for (uint32_t round = 0; round < 5; round++)
+    {
+        for (uint32_t i = 0; i < 5; i++)
+        {
+            NL_TEST_ASSERT(inSuite, ring.TryPush(round * 5 + i));
+        }
+        for (uint32_t i = 0; i < 5; i++)
+        {
+            NL_TEST_ASSERT(inSuite, ring.TryPop(value));
+            NL_TEST_ASSERT(inSuite, value == next++);
+        }
+        NL_TEST_ASSERT(inSuite, !ring.TryPop(value));
+    }
+}
+
+void TestFull(nlTestSuite * inSuite, void * inContext)
+{
+    MpscRing<uint32_t, 4> ring;
+    uint32_t value;
+
+    for (uint32_t i = 0; i < ring.Capacity(); i++)
+    {
+        NL_TEST_ASSERT(inSuite, ring.TryPush(i));
+    }
+    NL_TEST_ASSERT(inSuite, !ring.TryPush(100));
+
+    // Popping one frees exactly one cell.
+    NL_TEST_ASSERT(inSuite, ring.TryPop(value) && value == 0);
+    NL_TEST_ASSERT(inSuite, ring.TryPush(4));
+    NL_TEST_ASSERT(inSuite, !ring.TryPush(101));
+
+    for (uint32_t i = 1; i <= 4; i++)
+    {
+        NL_TEST_ASSERT(inSuite, ring.TryPop(value) && value == i);
+    }
+    NL_TEST_ASSERT(inSuite, !ring.TryPop(value));
+}
+
+#if CHIP_SYSTEM_CONFIG_POSIX_LOCKING
+
+constexpr uint32_t kProducerCount     = 4;
+constexpr uint32_t kValuesPerProducer = 10000;
+
+struct ProducedValue
+{
+    uint32_t mProducer;
+    uint32_t mSequence;
+};
+
+MpscRing<ProducedValue, 16> gSharedRing;
+
+void * Produce(void * context)
+{
+    const uint32_t producer = static_cast<uint32_t>(reinterpret_cast<uintptr_t>(context));
+
+    for (uint32_t i = 0; i < kValuesPerProducer;)
+    {
+        if (gSharedRing.TryPush(ProducedValue{ producer, i }))
+        {
+            i++;
+        }
+    }
+
+    return nullptr;
+}
+
+void TestConcurrentProducers(nlTestSuite * inSuite, void * inContext)
+{
+    pthread_t threads[kProducerCount];
+    uint32_t expected[kProducerCount] = {};
+    bool inOrder                      = true;
+
+    for (uint32_t p = 0; p < kProducerCount; p++)
+    {
+        NL_TEST_ASSERT(inSuite, pthread_create(&threads[p], nullptr, Produce, reinterpret_cast<void *>(uintptr_t(p))) == 0);
+    }
+
+    // The ring is much smaller than what gets pushed through it, so producers keep finding it full.
+    for (uint32_t received = 0; received < kProducerCount * kValuesPerProducer;)
+    {
+        ProducedValue value;
+        if (gSharedRing.TryPop(value))
+        {
+            // Keep draining on a mismatch, or the producers would never finish.
+            const uint32_t producer = value.mProducer % kProducerCount;
+            inOrder                 = inOrder && (producer == value.mProducer) && (value.mSequence == expected[producer]);
+            expected[producer]      = value.mSequence + 1;
+            received++;
+        }
+    }
+
+    for (auto & thread : threads)
+    {
+        NL_TEST_ASSERT(inSuite, pthread_join(thread, nullptr) == 0);
+    }
+
+    NL_TEST_ASSERT(inSuite, inOrder);
+    ProducedValue extra;
+    NL_TEST_ASSERT(inSuite, !gSharedRing.TryPop(extra));
+}
+
+#else  // CHIP_SYSTEM_CONFIG_POSIX_LOCKING
+void TestConcurrentProducers(nlTestSuite * inSuite, void * inContext) {}
+#endif // CHIP_SYSTEM_CONFIG_POSIX_LOCKING
+
+} // namespace
+
+#define NL_TEST_DEF_FN(fn) NL_TEST_DEF("Test " #fn, fn)
+/**
+ *   Test Suite. It lists all the test functions.
+ */
+static const nlTest sTests[] = {
+    NL_TEST_DEF_FN(TestFifoOrder),           //
+    NL_TEST_DEF_FN(TestFull),                //
+    NL_TEST_DEF_FN(TestConcurrentProducers), //
+    NL_TEST_SENTINEL(),                      //
+};
+
+int TestMpscRing()
+{
+    nlTestSuite theSuite = { "CHIP MpscRing tests", &sTests[0], nullptr, nullptr };
+
+    nlTestRunner(&theSuite, nullptr);
+    return nlTestRunnerStats(&theSuite);
+}
+
+CHIP_REGISTER_TEST_SUITE(TestMpscRing);
@@ -54,6 +54,48 @@ namespace {
 
 chip::TestPersistentStorageDelegate * sPersistentStore = nullptr;
 
+// Work handed to the counter's scheduler, run explicitly by the tests to model the event loop getting to it (or not).
+void (*sScheduledWork)(intptr_t) = nullptr;
+intptr_t sScheduledArg           = 0;
+int sScheduleCount               = 0;
+
+CHIP_ERROR ScheduleWork(void (*aWork)(intptr_t), intptr_t aArg)
+{
+    sScheduledWork = aWork;
+    sScheduledArg  = aArg;
+    sScheduleCount++;
+    return CHIP_NO_ERROR;
+}
+
+void RunScheduledWork()
+{
+    auto work      = sScheduledWork;
+    sScheduledWork = nullptr;
+    if (work != nullptr)
+    {
+        work(sScheduledArg);
+    }
+}
+
+void ResetScheduledWork()
+{
+    sScheduledWork = nullptr;
+    sScheduledArg  = 0;
+    sScheduleCount = 0;
+}
+
+uint64_t ReadPersistedStart()
+{
+    uint64_t valueLE = 0;
+    uint16_t size    = sizeof(valueLE);
+    if (sPersistentStore->SyncGetKeyValue(chip::DefaultStorageKeyAllocator::IMEventNumber().KeyName(), &valueLE, size) !=
+        CHIP_NO_ERROR)
+    {
+        return 0;
+    }
+    return chip::Encoding::LittleEndian::HostSwap64(valueLE);
+}
+
 } // namespace
 
 struct TestPersistedCounterContext
@@ -173,6 +215,132 @@ static void CheckWriteNextCounterStart(nlTestSuite * inSuite, void * inContext)
     NL_TEST_ASSERT(inSuite, value == 0x20000);
 }
 
+static void CheckPreAdvance(nlTestSuite * inSuite, void * inContext)
+{
+    TestPersistedCounterContext * context = static_cast<TestPersistedCounterContext *>(inContext);
+
+    InitializePersistedStorage(context);
+    ResetScheduledWork();
+
+    chip::PersistedCounter<uint64_t> counter;
+
+    CHIP_ERROR err = counter.Init(sPersistentStore, chip::DefaultStorageKeyAllocator::IMEventNumber(), 0x100);
+    NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, counter.EnablePreAdvance(nullptr, 0x40) == CHIP_ERROR_INVALID_ARGUMENT);
+    NL_TEST_ASSERT(inSuite, counter.EnablePreAdvance(ScheduleWork, 0) == CHIP_ERROR_INVALID_ARGUMENT);
+    NL_TEST_ASSERT(inSuite, counter.EnablePreAdvance(ScheduleWork, 0x100) == CHIP_ERROR_INVALID_ARGUMENT);
+    NL_TEST_ASSERT(inSuite, counter.EnablePreAdvance(ScheduleWork, 0x40) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, ReadPersistedStart() == 0x100);
+
+    // Nothing gets scheduled until the counter reaches the headroom.
+    for (int i = 0; i < 0xBF; i++)
+    {
+        NL_TEST_ASSERT(inSuite, counter.Advance() == CHIP_NO_ERROR);
+    }
+    NL_TEST_ASSERT(inSuite, sScheduleCount == 0);
+
+    NL_TEST_ASSERT(inSuite, counter.Advance() == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, counter.GetValue() == 0xC0);
+    NL_TEST_ASSERT(inSuite, sScheduleCount == 1);
+
+    // Only one write is scheduled at a time.
+    NL_TEST_ASSERT(inSuite, counter.Advance() == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, sScheduleCount == 1);
+    NL_TEST_ASSERT(inSuite, ReadPersistedStart() == 0x100);
+
+    RunScheduledWork();
+    NL_TEST_ASSERT(inSuite, ReadPersistedStart() == 0x200);
+
+    // Crossing the old epoch start no longer touches storage.
+    sPersistentStore->AddPoisonKey(chip::DefaultStorageKeyAllocator::IMEventNumber().KeyName());
+    while (counter.GetValue() < 0x180)
+    {
+        NL_TEST_ASSERT(inSuite, counter.Advance() == CHIP_NO_ERROR);
+    }
+    NL_TEST_ASSERT(inSuite, sScheduleCount == 1);
+    sPersistentStore->ClearPoisonKeys();
+}
+
+static void CheckPreAdvanceFallback(nlTestSuite * inSuite, void * inContext)
+{
+    TestPersistedCounterContext * context = static_cast<TestPersistedCounterContext *>(inContext);
+
+    InitializePersistedStorage(context);
+    ResetScheduledWork();
+
+    chip::PersistedCounter<uint64_t> counter;
+
+    CHIP_ERROR err = counter.Init(sPersistentStore, chip::DefaultStorageKeyAllocator::IMEventNumber(), 0x100);
+    NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, counter.EnablePreAdvance(ScheduleWork, 0x40) == CHIP_NO_ERROR);
+
+    // The scheduled write never gets to run before the epoch is used up: Advance() writes synchronously.
+    for (int i = 0; i < 0x100; i++)
+    {
+        NL_TEST_ASSERT(inSuite, counter.Advance() == CHIP_NO_ERROR);
+    }
+    NL_TEST_ASSERT(inSuite, sScheduleCount == 1);
+    NL_TEST_ASSERT(inSuite, ReadPersistedStart() == 0x200);
+
+    // The stale work then has nothing left to do.
+    RunScheduledWork();
+    NL_TEST_ASSERT(inSuite, ReadPersistedStart() == 0x200);
+
+    // A failed scheduled write leaves the persisted start alone, and is retried.
+    while (counter.GetValue() < 0x1C0)
+    {
+        NL_TEST_ASSERT(inSuite, counter.Advance() == CHIP_NO_ERROR);
+    }
+    NL_TEST_ASSERT(inSuite, sScheduleCount == 2);
+    sPersistentStore->AddPoisonKey(chip::DefaultStorageKeyAllocator::IMEventNumber().KeyName());
+    RunScheduledWork();
+    sPersistentStore->ClearPoisonKeys();
+    NL_TEST_ASSERT(inSuite, ReadPersistedStart() == 0x200);
+
+    NL_TEST_ASSERT(inSuite, counter.Advance() == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, sScheduleCount == 3);
+    RunScheduledWork();
+    NL_TEST_ASSERT(inSuite, ReadPersistedStart() == 0x300);
+}
+
+static void CheckPreAdvanceCrashSafety(nlTestSuite * inSuite, void * inContext)
+{
+    TestPersistedCounterContext * context = static_cast<TestPersistedCounterContext *>(inContext);
+
+    // Crash at every point of an epoch, with and without the scheduled write having run, and check that the counter
+    // never vends a value again after "rebooting".
+    for (uint64_t crashAt = 0xB0; crashAt < 0x110; crashAt += 0x8)
+    {
+        for (bool runScheduledWork : { false, true })
+        {
+            InitializePersistedStorage(context);
+            ResetScheduledWork();
+
+            chip::PersistedCounter<uint64_t> counter, rebooted;
+
+            CHIP_ERROR err = counter.Init(sPersistentStore, chip::DefaultStorageKeyAllocator::IMEventNumber(), 0x100);
+            NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR);
+            NL_TEST_ASSERT(inSuite, counter.EnablePreAdvance(ScheduleWork, 0x40) == CHIP_NO_ERROR);
+
+            while (counter.GetValue() < crashAt)
+            {
+                NL_TEST_ASSERT(inSuite, counter.Advance() == CHIP_NO_ERROR);
+            }
+            if (runScheduledWork)
+            {
+                RunScheduledWork();
+            }
+            uint64_t lastVended = counter.GetValue();
+
+            err = rebooted.Init(sPersistentStore, chip::DefaultStorageKeyAllocator::IMEventNumber(), 0x100);
+            NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR);
+            NL_TEST_ASSERT(inSuite, rebooted.GetValue() > lastVended);
+            // At most two epochs get skipped.
+            NL_TEST_ASSERT(inSuite, rebooted.GetValue() <= lastVended + 0x200);
+        }
+    }
+}
+
 // Test Suite
 
 /**
@@ -182,6 +350,9 @@ static const nlTest sTests[] = {
     NL_TEST_DEF("Out of box Test", CheckOOB),                                 //
     NL_TEST_DEF("Reboot Test", CheckReboot),                                  //
     NL_TEST_DEF("Write Next Counter Start Test", CheckWriteNextCounterStart), //
+    NL_TEST_DEF("Pre-Advance Test", CheckPreAdvance),                         //
+    NL_TEST_DEF("Pre-Advance Fallback Test", CheckPreAdvanceFallback),        //
+    NL_TEST_DEF("Pre-Advance Crash Safety Test", CheckPreAdvanceCrashSafety), //
     NL_TEST_SENTINEL()                                                        //
 };
 
@@ -211,6 +211,134 @@ void TestCreateReleaseStructDynamic(nlTestSuite * inSuite, void * inContext)
 }
 #endif // CHIP_SYSTEM_CONFIG_POOL_USE_HEAP
 
+#if CHIP_SYSTEM_CONFIG_POOL_USE_HEAP
+void TestHeapSlotReuse(nlTestSuite * inSuite, void * inContext)
+{
+    struct alignas(16) S
+    {
+        S(size_t id) : mId(id) {}
+        size_t mId;
+    };
+
+    // Enough objects to span several slabs.
+    constexpr size_t kSize = 300;
+    S * objs[kSize];
+    HeapObjectPool<S> pool;
+
+    for (size_t i = 0; i < kSize; ++i)
+    {
+        objs[i] = pool.CreateObject(i);
+        NL_TEST_ASSERT(inSuite, objs[i] != nullptr);
+        NL_TEST_ASSERT(inSuite, (reinterpret_cast<uintptr_t>(objs[i]) % alignof(S)) == 0);
+    }
+
+    // Released slots are reused before the pool grows further.
+    std::set<S *> released;
+    for (size_t i = 0; i < kSize; i += 3)
+    {
+        released.insert(objs[i]);
+        pool.ReleaseObject(objs[i]);
+    }
+    for (size_t i = 0; i < kSize; i += 3)
+    {
+        objs[i] = pool.CreateObject(i);
+        // ASAN builds give every object its own allocation, which the heap is free to place anywhere.
+        NL_TEST_ASSERT(inSuite, internal::HeapObjectList::kMaxSlabSlots == 1 || released.count(objs[i]) == 1);
+    }
+    NL_TEST_ASSERT(inSuite, pool.Allocated() == kSize);
+
+    // Objects released during iteration are neither visited again nor reused until iteration completes.
+    size_t count = 0;
+    pool.ForEachActiveObject([&](S * object) {
+        ++count;
+        NL_TEST_ASSERT(inSuite, object->mId != kSize);
+        if ((object->mId % 2) == 0)
+        {
+            objs[object->mId] = nullptr;
+            pool.ReleaseObject(object);
+            S * other = pool.CreateObject(kSize);
+            NL_TEST_ASSERT(inSuite, other != object);
+            pool.ReleaseObject(other);
+        }
+        return Loop::Continue;
+    });
+    NL_TEST_ASSERT(inSuite, count >= kSize);
+    NL_TEST_ASSERT(inSuite, pool.Allocated() == kSize / 2);
+    NL_TEST_ASSERT(inSuite, GetNumObjectsInUse(pool) == kSize / 2);
+
+    for (size_t i = 1; i < kSize; i += 2)
+    {
+        NL_TEST_ASSERT(inSuite, objs[i]->mId == i);
+    }
+
+    pool.ReleaseAll();
+    NL_TEST_ASSERT(inSuite, pool.Allocated() == 0);
+    NL_TEST_ASSERT(inSuite, GetNumObjectsInUse(pool) == 0);
+}
+
+void TestHeapSlabReturn(nlTestSuite * inSuite, void * inContext)
+{
+    constexpr size_t kSlabSlots = internal::HeapObjectList::kMaxSlabSlots;
+    constexpr size_t kSize      = 4 * kSlabSlots;
+    uint32_t * objs[kSize];
+    HeapObjectPool<uint32_t> pool;
+
+    NL_TEST_ASSERT(inSuite, pool.SlabCount() == 0);
+    for (size_t i = 0; i < kSize; ++i)
+    {
+        objs[i] = pool.CreateObject(static_cast<uint32_t>(i));
+        NL_TEST_ASSERT(inSuite, objs[i] != nullptr);
+    }
+    const size_t slabs = pool.SlabCount();
+    NL_TEST_ASSERT(inSuite, slabs >= 2);
+
+    // Releasing a few objects keeps their slabs for reuse: new objects take the free slots instead of new slabs.
+    if (kSlabSlots > 1)
+    {
+        pool.ReleaseObject(objs[0]);
+        pool.ReleaseObject(objs[kSize - 1]);
+        NL_TEST_ASSERT(inSuite, pool.SlabCount() == slabs);
+        uint32_t * first = pool.CreateObject(0u);
+        uint32_t * last  = pool.CreateObject(static_cast<uint32_t>(kSize - 1));
+        NL_TEST_ASSERT(inSuite, pool.SlabCount() == slabs);
+        NL_TEST_ASSERT(inSuite, (first == objs[0] && last == objs[kSize - 1]) || (first == objs[kSize - 1] && last == objs[0]));
+        objs[0]         = first;
+        objs[kSize - 1] = last;
+    }
+
+    // A long-lived object only pins its own slab: every slab that empties is returned, even while the pool is not empty.
+    uint32_t * survivor = objs[kSize - 1];
+    for (size_t i = 0; i < kSize; ++i)
+    {
+        if (objs[i] != survivor)
+        {
+            pool.ReleaseObject(objs[i]);
+        }
+    }
+    NL_TEST_ASSERT(inSuite, pool.Allocated() == 1);
+    NL_TEST_ASSERT(inSuite, pool.SlabCount() == 1);
+    NL_TEST_ASSERT(inSuite, *survivor == kSize - 1);
+
+    // Slabs emptied during iteration are returned once iteration completes.
+    for (size_t i = 0; i < kSize - 1; ++i)
+    {
+        objs[i] = pool.CreateObject(static_cast<uint32_t>(i));
+    }
+    pool.ForEachActiveObject([&](uint32_t * object) {
+        if (object != survivor)
+        {
+            pool.ReleaseObject(object);
+        }
+        return Loop::Continue;
+    });
+    NL_TEST_ASSERT(inSuite, pool.SlabCount() == 1);
+
+    pool.ReleaseObject(survivor);
+    NL_TEST_ASSERT(inSuite, pool.Allocated() == 0);
+    NL_TEST_ASSERT(inSuite, pool.SlabCount() == 0);
+}
+#endif // CHIP_SYSTEM_CONFIG_POOL_USE_HEAP
+
 template <ObjectPoolMem P>
 void TestForEachActiveObject(nlTestSuite * inSuite, void * inContext)
 {
@@ -442,6 +570,8 @@ static const nlTest sTests[] = {
     NL_TEST_DEF_FN(TestCreateReleaseStructDynamic),
     NL_TEST_DEF_FN(TestForEachActiveObjectDynamic),
     NL_TEST_DEF_FN(TestPoolInterfaceDynamic),
+    NL_TEST_DEF_FN(TestHeapSlotReuse),
+    NL_TEST_DEF_FN(TestHeapSlabReturn),
 #endif // CHIP_SYSTEM_CONFIG_POOL_USE_HEAP
     NL_TEST_SENTINEL()
     // clang-format on
@@ -341,8 +341,49 @@ void TestClearStorage(nlTestSuite * inSuite, void * inContext)
     NL_TEST_ASSERT(inSuite, size == sizeof(buf));
 }
 
+void TestTransactions(nlTestSuite * inSuite, void * inContext)
+{
+    TestPersistentStorageDelegate storage;
+
+    uint8_t buf[16];
+    uint16_t size;
+    const char * kValue1 = "abcd";
+    const char * kValue2 = "efghij";
+
+    NL_TEST_ASSERT(inSuite, storage.SyncSetKeyValue("kept", kValue1, static_cast<uint16_t>(strlen(kValue1))) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, storage.CommitTransaction() == CHIP_ERROR_INCORRECT_STATE);
+
+    // Changes made in an aborted transaction are visible until the abort, then gone.
+    NL_TEST_ASSERT(inSuite, storage.BeginTransaction() == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, storage.BeginTransaction() == CHIP_ERROR_INCORRECT_STATE);
+    NL_TEST_ASSERT(inSuite, storage.SyncSetKeyValue("kept", kValue2, static_cast<uint16_t>(strlen(kValue2))) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, storage.SyncSetKeyValue("added", kValue2, static_cast<uint16_t>(strlen(kValue2))) == CHIP_NO_ERROR);
+    size = sizeof(buf);
+    NL_TEST_ASSERT(inSuite, storage.SyncGetKeyValue("kept", &buf[0], size) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, size == strlen(kValue2) && 0 == memcmp(&buf[0], kValue2, size));
+    storage.AbortTransaction();
+
+    NL_TEST_ASSERT(inSuite, !storage.IsInTransaction());
+    NL_TEST_ASSERT(inSuite, storage.GetNumKeys() == 1);
+    size = sizeof(buf);
+    NL_TEST_ASSERT(inSuite, storage.SyncGetKeyValue("kept", &buf[0], size) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, size == strlen(kValue1) && 0 == memcmp(&buf[0], kValue1, size));
+
+    // Changes made in a committed transaction stay.
+    NL_TEST_ASSERT(inSuite, storage.BeginTransaction() == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, storage.SyncDeleteKeyValue("kept") == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, storage.SyncSetKeyValue("added", kValue2, static_cast<uint16_t>(strlen(kValue2))) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, storage.CommitTransaction() == CHIP_NO_ERROR);
+    storage.AbortTransaction();
+
+    NL_TEST_ASSERT(inSuite, !storage.HasKey("kept"));
+    NL_TEST_ASSERT(inSuite, storage.HasKey("added"));
+    NL_TEST_ASSERT(inSuite, storage.GetNumKeys() == 1);
+}
+
 const nlTest sTests[] = { NL_TEST_DEF("Test basic API", TestBasicApi),
                           NL_TEST_DEF("Test ClearStorage method of TestPersistentStorageDelegate", TestClearStorage),
+                          NL_TEST_DEF("Test transactions", TestTransactions),
                           NL_TEST_SENTINEL() };
 
 } // namespace
@@ -44,11 +44,20 @@
 
 using namespace chip::System::Clock::Literals;
 
+#if CHIP_CONFIG_MRP_ADAPTIVE_RETRANS_TIMEOUT
+static_assert(CHIP_CONFIG_MRP_ADAPTIVE_MIN_RETRY_INTERVAL > CHIP_CONFIG_RMP_DEFAULT_ACK_TIMEOUT,
+              "The adaptive retransmission floor must leave time for a standalone acknowledgment");
+#endif // CHIP_CONFIG_MRP_ADAPTIVE_RETRANS_TIMEOUT
+
 namespace chip {
 namespace Messaging {
 
 ReliableMessageMgr::RetransTableEntry::RetransTableEntry(ReliableMessageContext * rc) :
-    ec(*rc->GetExchangeContext()), nextRetransTime(0), sendCount(0)
+    ec(*rc->GetExchangeContext()), nextRetransTime(0),
+#if CHIP_CONFIG_MRP_ADAPTIVE_RETRANS_TIMEOUT
+    initialSendTime(0),
+#endif // CHIP_CONFIG_MRP_ADAPTIVE_RETRANS_TIMEOUT
+    sendCount(0)
 {
     ec->SetWaitingForAck(true);
 }
@@ -269,6 +278,9 @@ System::Clock::Timestamp ReliableMessageMgr::GetBackoff(System::Clock::Timestamp
 
 void ReliableMessageMgr::StartRetransmision(RetransTableEntry * entry)
 {
+#if CHIP_CONFIG_MRP_ADAPTIVE_RETRANS_TIMEOUT
+    entry->initialSendTime = System::SystemClock().GetMonotonicTimestamp();
+#endif // CHIP_CONFIG_MRP_ADAPTIVE_RETRANS_TIMEOUT
     CalculateNextRetransTime(*entry);
     StartTimer();
 }
@@ -279,6 +291,24 @@ bool ReliableMessageMgr::CheckAndRemRetransTable(ReliableMessageContext * rc, ui
     mRetransTable.ForEachActiveObject([&](auto * entry) {
         if (entry->ec->GetReliableMessageContext() == rc && entry->retainedBuf.GetMessageCounter() == ackMessageCounter)
         {
+#if CHIP_CONFIG_MRP_ADAPTIVE_RETRANS_TIMEOUT
+            if (entry->ec->HasSessionHandle())
+            {
+                auto & rttEstimator = entry->ec->GetSessionHandle()->GetRttEstimator();
+
+                // An ack for a retransmitted message may answer any of its transmissions, so it is not sampled (Karn's algorithm).
+                if (entry->sendCount == 0)
+                {
+                    rttEstimator.AddSample(std::chrono::duration_cast<System::Clock::Milliseconds32>(
+                        System::SystemClock().GetMonotonicTimestamp() - entry->initialSendTime));
+                }
+                else
+                {
+                    rttEstimator.AddAmbiguousSample();
+                }
+            }
+#endif // CHIP_CONFIG_MRP_ADAPTIVE_RETRANS_TIMEOUT
+
             // Clear the entry from the retransmision table.
             ClearRetransTable(*entry);
 
@@ -467,6 +497,15 @@ void ReliableMessageMgr::CalculateNextRetransTime(RetransTableEntry & entry)
         baseTimeout = entry.ec->GetSessionHandle()->GetMRPBaseTimeout();
     }
 
+#if CHIP_CONFIG_MRP_ADAPTIVE_RETRANS_TIMEOUT
+    // Round-trip times are measured while the peer is awake, so they only ever stand in for its active interval.
+    const auto & session = entry.ec->GetSessionHandle();
+    if (mAdaptiveRetransTimeout && baseTimeout == session->GetRemoteMRPConfig().mActiveRetransTimeout)
+    {
+        baseTimeout = session->GetRttEstimator().GetAdaptiveInterval(baseTimeout, CHIP_CONFIG_MRP_ADAPTIVE_MIN_RETRY_INTERVAL);
+    }
+#endif // CHIP_CONFIG_MRP_ADAPTIVE_RETRANS_TIMEOUT
+
     System::Clock::Timestamp backoff = ReliableMessageMgr::GetBackoff(baseTimeout, entry.sendCount);
     entry.nextRetransTime            = System::SystemClock().GetMonotonicTimestamp() + backoff;
 }
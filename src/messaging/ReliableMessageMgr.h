@@ -63,6 +63,9 @@ public:
         ExchangeHandle ec;                        /**< The context for the stored CHIP message. */
         EncryptedPacketBufferHandle retainedBuf;  /**< The packet buffer holding the CHIP message. */
         System::Clock::Timestamp nextRetransTime; /**< A counter representing the next retransmission time for the message. */
+#if CHIP_CONFIG_MRP_ADAPTIVE_RETRANS_TIMEOUT
+        System::Clock::Timestamp initialSendTime; /**< The time the message was first sent, to measure the round-trip time. */
+#endif // CHIP_CONFIG_MRP_ADAPTIVE_RETRANS_TIMEOUT
         uint8_t sendCount;                        /**< The number of times we have tried to send this entry,
                                                        including both successfully and failure send. */
     };
@@ -184,6 +187,15 @@ public:
      */
     void RegisterSessionUpdateDelegate(SessionUpdateDelegate * sessionUpdateDelegate);
 
+#if CHIP_CONFIG_MRP_ADAPTIVE_RETRANS_TIMEOUT
+    /**
+     *  Enables or disables adapting the base retransmission interval to the round-trip times measured on
+     *  each session, see CHIP_CONFIG_MRP_ADAPTIVE_RETRANS_TIMEOUT.
+     */
+    void SetAdaptiveRetransTimeoutEnabled(bool enabled) { mAdaptiveRetransTimeout = enabled; }
+    bool IsAdaptiveRetransTimeoutEnabled() const { return mAdaptiveRetransTimeout; }
+#endif // CHIP_CONFIG_MRP_ADAPTIVE_RETRANS_TIMEOUT
+
     /**
      * Map a send error code to the error code we should actually use for
      * success checks.  This maps some error codes to CHIP_NO_ERROR as
@@ -233,6 +245,10 @@ private:
     ObjectPool<RetransTableEntry, CHIP_CONFIG_RMP_RETRANS_TABLE_SIZE> mRetransTable;
 
     SessionUpdateDelegate * mSessionUpdateDelegate = nullptr;
+
+#if CHIP_CONFIG_MRP_ADAPTIVE_RETRANS_TIMEOUT
+    bool mAdaptiveRetransTimeout = true;
+#endif // CHIP_CONFIG_MRP_ADAPTIVE_RETRANS_TIMEOUT
 };
 
 } // namespace Messaging
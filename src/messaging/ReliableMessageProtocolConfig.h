@@ -180,6 +180,42 @@ namespace chip {
 #endif
 #endif // CHIP_CONFIG_MRP_RETRY_INTERVAL_SENDER_BOOST
 
+/**
+ *  @def CHIP_CONFIG_MRP_ADAPTIVE_RETRANS_TIMEOUT
+ *
+ *  @brief
+ *    Whether the base retransmission interval used for a peer is shortened
+ *    according to the round-trip times measured on the session.
+ *
+ *  The adaptive interval never exceeds the interval advertised by the peer,
+ *  so it only lowers the latency of recovering from a lost message on fast
+ *  links; all the exchange timeouts derived from the peer parameters remain
+ *  valid. When enabled, every session carries a round-trip time estimator,
+ *  and the adaptation can be turned off again at runtime through
+ *  ReliableMessageMgr::SetAdaptiveRetransTimeoutEnabled(). When disabled,
+ *  neither is compiled in.
+ */
+#ifndef CHIP_CONFIG_MRP_ADAPTIVE_RETRANS_TIMEOUT
+#define CHIP_CONFIG_MRP_ADAPTIVE_RETRANS_TIMEOUT 0
+#endif // CHIP_CONFIG_MRP_ADAPTIVE_RETRANS_TIMEOUT
+
+/**
+ *  @def CHIP_CONFIG_MRP_ADAPTIVE_MIN_RETRY_INTERVAL
+ *
+ *  @brief
+ *    The lowest base retransmission interval the adaptive retransmission
+ *    timeout may use, however short the measured round-trip times are.
+ *
+ *  A peer that does not piggyback its acknowledgment on a response sends a
+ *  standalone one only after CHIP_CONFIG_RMP_DEFAULT_ACK_TIMEOUT, which no
+ *  round-trip time sample accounts for. The floor therefore sits above that
+ *  timeout, with a margin for the transit of the acknowledgment, so that a
+ *  delayed acknowledgment does not cause a spurious retransmission.
+ */
+#ifndef CHIP_CONFIG_MRP_ADAPTIVE_MIN_RETRY_INTERVAL
+#define CHIP_CONFIG_MRP_ADAPTIVE_MIN_RETRY_INTERVAL (CHIP_CONFIG_RMP_DEFAULT_ACK_TIMEOUT + 100_ms32)
+#endif // CHIP_CONFIG_MRP_ADAPTIVE_MIN_RETRY_INTERVAL
+
 inline constexpr System::Clock::Milliseconds32 kDefaultActiveTime = System::Clock::Milliseconds16(4000);
 
 /**
@@ -0,0 +1,90 @@
+/*
+ *
+ *    Copyright (c) 2023 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *      This file implements the round-trip time estimator used by the CHIP
+ *      Reliable Messaging Protocol.
+ *
+ */
+
+#include <messaging/ReliableMessageRttEstimator.h>
+
+#include <algorithm>
+
+namespace chip {
+
+namespace {
+
+// Gains from RFC 6298, section 2: alpha = 1/8, beta = 1/4, K = 4.
+constexpr uint64_t kSmoothedRttWeight  = 8;
+constexpr uint64_t kRttVariationWeight = 4;
+constexpr uint64_t kRttVariationFactor = 4;
+
+// Samples are capped so the arithmetic below cannot overflow; anything longer is well past any MRP timeout.
+constexpr uint32_t kMaxSampleMs = UINT32_MAX / 16;
+
+} // namespace
+
+void ReliableMessageRttEstimator::AddSample(System::Clock::Milliseconds32 rtt)
+{
+    const uint32_t sample = std::min(rtt.count(), kMaxSampleMs);
+
+    if (mStats.mSampleCount == 0)
+    {
+        mSmoothedRtt   = System::Clock::Milliseconds32(sample);
+        mRttVariation  = System::Clock::Milliseconds32(sample / 2);
+        mStats.mMinRtt = System::Clock::Milliseconds32(sample);
+        mStats.mMaxRtt = System::Clock::Milliseconds32(sample);
+    }
+    else
+    {
+        const uint64_t srtt  = mSmoothedRtt.count();
+        const uint64_t delta = (srtt > sample) ? (srtt - sample) : (sample - srtt);
+
+        // RTTVAR is updated before SRTT, since it uses the previous SRTT.
+        mRttVariation = System::Clock::Milliseconds32(static_cast<uint32_t>(
+            ((kRttVariationWeight - 1) * mRttVariation.count() + delta) / kRttVariationWeight));
+        mSmoothedRtt = System::Clock::Milliseconds32(
+            static_cast<uint32_t>(((kSmoothedRttWeight - 1) * srtt + sample) / kSmoothedRttWeight));
+        mStats.mMinRtt = std::min(mStats.mMinRtt, System::Clock::Milliseconds32(sample));
+        mStats.mMaxRtt = std::max(mStats.mMaxRtt, System::Clock::Milliseconds32(sample));
+    }
+
+    mStats.mLatestRtt = System::Clock::Milliseconds32(sample);
+    mStats.mSampleCount++;
+}
+
+System::Clock::Milliseconds32 ReliableMessageRttEstimator::GetRetransTimeout() const
+{
+    return mSmoothedRtt + System::Clock::Milliseconds32(static_cast<uint32_t>(kRttVariationFactor) * mRttVariation.count());
+}
+
+System::Clock::Timestamp ReliableMessageRttEstimator::GetAdaptiveInterval(System::Clock::Timestamp advertisedInterval,
+                                                                          System::Clock::Timestamp minInterval) const
+{
+    if (!HasEstimate() || minInterval >= advertisedInterval)
+    {
+        return advertisedInterval;
+    }
+
+    System::Clock::Timestamp timeout = GetRetransTimeout();
+    return std::min(advertisedInterval, std::max(minInterval, timeout));
+}
+
+} // namespace chip
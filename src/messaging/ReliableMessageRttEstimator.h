@@ -0,0 +1,103 @@
+/*
+ *
+ *    Copyright (c) 2023 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *      This file defines the round-trip time estimator used by the CHIP
+ *      Reliable Messaging Protocol to adapt retransmission timeouts to a peer.
+ *
+ */
+#pragma once
+
+#include <system/SystemClock.h>
+
+#include <stdint.h>
+
+namespace chip {
+
+/**
+ *  @brief
+ *    Round-trip time estimator for a single peer, fed with the time elapsed
+ *    between sending a reliable message and receiving its acknowledgment.
+ *
+ *  The smoothed round-trip time (SRTT) and its variation (RTTVAR) are computed
+ *  as in RFC 6298, and the resulting retransmission timeout is
+ *  SRTT + 4 * RTTVAR. Acknowledgments of retransmitted messages cannot be
+ *  attributed to a single transmission and are not sampled (Karn's algorithm).
+ */
+class ReliableMessageRttEstimator
+{
+public:
+    struct Stats
+    {
+        uint32_t mSampleCount    = 0; ///< Acknowledgments that produced a round-trip time sample.
+        uint32_t mAmbiguousCount = 0; ///< Acknowledgments of retransmitted messages, which were not sampled.
+        System::Clock::Milliseconds32 mLatestRtt{ 0 };
+        System::Clock::Milliseconds32 mMinRtt{ 0 };
+        System::Clock::Milliseconds32 mMaxRtt{ 0 };
+    };
+
+    /**
+     *  Record the round-trip time of a message that was acknowledged after a single transmission.
+     */
+    void AddSample(System::Clock::Milliseconds32 rtt);
+
+    /**
+     *  Record the acknowledgment of a message that was retransmitted, which does not produce a sample.
+     */
+    void AddAmbiguousSample() { mStats.mAmbiguousCount++; }
+
+    bool HasEstimate() const { return mStats.mSampleCount > 0; }
+
+    System::Clock::Milliseconds32 GetSmoothedRtt() const { return mSmoothedRtt; }
+    System::Clock::Milliseconds32 GetRttVariation() const { return mRttVariation; }
+
+    /**
+     *  @brief
+     *    The retransmission timeout computed from the samples so far, SRTT + 4 * RTTVAR.
+     *
+     *  @note Only meaningful once HasEstimate() returns true.
+     */
+    System::Clock::Milliseconds32 GetRetransTimeout() const;
+
+    /**
+     *  @brief
+     *    The base interval to use for the backoff calculation given the one advertised by the peer.
+     *
+     *  The retransmission timeout is clamped between minInterval and advertisedInterval, so that
+     *  the adaptive timeout only ever retransmits earlier than the peer parameters would, and all
+     *  the exchange timeouts derived from those parameters remain valid. Without an estimate, the
+     *  advertised interval is returned unchanged.
+     *
+     *  @param[in] advertisedInterval  The active or idle interval of the peer.
+     *  @param[in] minInterval         The lowest interval the adaptive timeout may use.
+     */
+    System::Clock::Timestamp GetAdaptiveInterval(System::Clock::Timestamp advertisedInterval,
+                                                 System::Clock::Timestamp minInterval) const;
+
+    const Stats & GetStats() const { return mStats; }
+
+    void Reset() { *this = ReliableMessageRttEstimator(); }
+
+private:
+    System::Clock::Milliseconds32 mSmoothedRtt{ 0 };
+    System::Clock::Milliseconds32 mRttVariation{ 0 };
+    Stats mStats;
+};
+
+} // namespace chip
@@ -322,6 +322,11 @@ public:
     static void CheckGetBackoff(nlTestSuite * inSuite, void * inContext);
     static void CheckApplicationResponseDelayed(nlTestSuite * inSuite, void * inContext);
     static void CheckApplicationResponseNeverComes(nlTestSuite * inSuite, void * inContext);
+    static void CheckRttEstimator(nlTestSuite * inSuite, void * inContext);
+#if CHIP_CONFIG_MRP_ADAPTIVE_RETRANS_TIMEOUT
+    static void CheckAdaptiveRetransTimeout(nlTestSuite * inSuite, void * inContext);
+    static void CheckAdaptiveRetransTimeoutWithDelayedAck(nlTestSuite * inSuite, void * inContext);
+#endif // CHIP_CONFIG_MRP_ADAPTIVE_RETRANS_TIMEOUT
     static int InitializeTestCase(void * inContext);
 };
 
@@ -2124,11 +2129,256 @@ void TestReliableMessageProtocol::CheckApplicationResponseNeverComes(nlTestSuite
     NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR);
 }
 
+void TestReliableMessageProtocol::CheckRttEstimator(nlTestSuite * inSuite, void * inContext)
+{
+    ReliableMessageRttEstimator estimator;
+
+    // Without samples, the advertised interval is used as is.
+    NL_TEST_ASSERT(inSuite, !estimator.HasEstimate());
+    NL_TEST_ASSERT(inSuite, estimator.GetAdaptiveInterval(300_ms32, 100_ms32) == 300_ms32);
+
+    // The first sample sets SRTT = R and RTTVAR = R / 2.
+    estimator.AddSample(100_ms32);
+    NL_TEST_ASSERT(inSuite, estimator.HasEstimate());
+    NL_TEST_ASSERT(inSuite, estimator.GetSmoothedRtt() == 100_ms32);
+    NL_TEST_ASSERT(inSuite, estimator.GetRttVariation() == 50_ms32);
+    NL_TEST_ASSERT(inSuite, estimator.GetRetransTimeout() == 300_ms32);
+
+    // A steady round-trip time shrinks the variation, and with it the timeout.
+    estimator.AddSample(100_ms32);
+    NL_TEST_ASSERT(inSuite, estimator.GetSmoothedRtt() == 100_ms32);
+    NL_TEST_ASSERT(inSuite, estimator.GetRttVariation() == 37_ms32);
+    NL_TEST_ASSERT(inSuite, estimator.GetRetransTimeout() == 248_ms32);
+    NL_TEST_ASSERT(inSuite, estimator.GetAdaptiveInterval(300_ms32, 100_ms32) == 248_ms32);
+
+    // The adaptive interval never exceeds the advertised one, nor goes below the floor.
+    NL_TEST_ASSERT(inSuite, estimator.GetAdaptiveInterval(200_ms32, 100_ms32) == 200_ms32);
+    NL_TEST_ASSERT(inSuite, estimator.GetAdaptiveInterval(300_ms32, 280_ms32) == 280_ms32);
+    NL_TEST_ASSERT(inSuite, estimator.GetAdaptiveInterval(50_ms32, 100_ms32) == 50_ms32);
+
+    // A spike moves SRTT by 1/8 of the difference and RTTVAR by 1/4 of its own difference.
+    estimator.AddSample(900_ms32);
+    NL_TEST_ASSERT(inSuite, estimator.GetSmoothedRtt() == 200_ms32);
+    NL_TEST_ASSERT(inSuite, estimator.GetRttVariation() == 227_ms32);
+
+    // Acks of retransmitted messages are counted but not sampled.
+    estimator.AddAmbiguousSample();
+    NL_TEST_ASSERT(inSuite, estimator.GetSmoothedRtt() == 200_ms32);
+
+    const auto & stats = estimator.GetStats();
+    NL_TEST_ASSERT(inSuite, stats.mSampleCount == 3);
+    NL_TEST_ASSERT(inSuite, stats.mAmbiguousCount == 1);
+    NL_TEST_ASSERT(inSuite, stats.mLatestRtt == 900_ms32);
+    NL_TEST_ASSERT(inSuite, stats.mMinRtt == 100_ms32);
+    NL_TEST_ASSERT(inSuite, stats.mMaxRtt == 900_ms32);
+
+    // Very short round-trip times are held at the floor.
+    estimator.Reset();
+    NL_TEST_ASSERT(inSuite, !estimator.HasEstimate());
+    estimator.AddSample(2_ms32);
+    NL_TEST_ASSERT(inSuite, estimator.GetAdaptiveInterval(300_ms32, 100_ms32) == 100_ms32);
+
+    // Absurdly long samples do not overflow the timeout.
+    estimator.AddSample(System::Clock::Milliseconds32(UINT32_MAX));
+    NL_TEST_ASSERT(inSuite, estimator.GetRetransTimeout() >= estimator.GetSmoothedRtt());
+    NL_TEST_ASSERT(inSuite, estimator.GetAdaptiveInterval(300_ms32, 100_ms32) == 300_ms32);
+}
+
+#if CHIP_CONFIG_MRP_ADAPTIVE_RETRANS_TIMEOUT
+/**
+ * Tests the adaptive retransmission timeout with the following scenario:
+ *
+ *      DUT = sender, PEER = remote device
+ *
+ * 1) DUT configured to use peer parameters of active = 1000ms, idle = 1000ms
+ * 2) DUT sends a few messages to PEER, which are acknowledged right away
+ *      - Confirm each ack produced a round-trip time sample
+ * 3) DUT sends a message to PEER
+ *      - Force PEER to drop message
+ *      - Confirm the retransmission happens well before the advertised interval
+ *        would have allowed, but not before the adaptive floor
+ * 4) PEER acknowledges the retransmission
+ *      - Confirm the ack was not sampled, since it may answer either transmission
+ */
+void TestReliableMessageProtocol::CheckAdaptiveRetransTimeout(nlTestSuite * inSuite, void * inContext)
+{
+    TestContext & ctx = *reinterpret_cast<TestContext *>(inContext);
+
+    constexpr uint32_t kAckedMessages              = 3;
+    constexpr System::Clock::Timeout kPeerInterval = 1000_ms32;
+    System::Clock::Timestamp startTime;
+    System::Clock::Timeout timeoutTime;
+    System::Clock::Timeout margin = System::Clock::Timeout(15);
+
+    ReliableMessageMgr * rm = ctx.GetExchangeManager().GetReliableMessageMgr();
+    NL_TEST_ASSERT(inSuite, rm != nullptr);
+    rm->SetAdaptiveRetransTimeoutEnabled(true);
+
+    auto session = ctx.GetSessionBobToAlice();
+    session->AsSecureSession()->SetRemoteMRPConfig({
+        1000_ms32, // CHIP_CONFIG_MRP_LOCAL_IDLE_RETRY_INTERVAL
+        1000_ms32, // CHIP_CONFIG_MRP_LOCAL_ACTIVE_RETRY_INTERVAL
+    });
+    const auto & rttEstimator = session->GetRttEstimator();
+
+    MockAppDelegate mockSender(ctx);
+    auto & loopback               = ctx.GetLoopback();
+    loopback.mSentMessageCount    = 0;
+    loopback.mNumMessagesToDrop   = 0;
+    loopback.mDroppedMessageCount = 0;
+
+    for (uint32_t i = 0; i < kAckedMessages; i++)
+    {
+        chip::System::PacketBufferHandle buffer = chip::MessagePacketBuffer::NewWithData(PAYLOAD, sizeof(PAYLOAD));
+        NL_TEST_ASSERT(inSuite, !buffer.IsNull());
+
+        ExchangeContext * exchange = ctx.NewExchangeToAlice(&mockSender);
+        NL_TEST_ASSERT(inSuite, exchange != nullptr);
+
+        CHIP_ERROR err = exchange->SendMessage(Echo::MsgType::EchoRequest, std::move(buffer));
+        NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR);
+        ctx.DrainAndServiceIO();
+
+        NL_TEST_ASSERT(inSuite, rm->TestGetCountRetransTable() == 0);
+    }
+
+    // Loopback round trips are much shorter than the advertised interval, and even than the adaptive floor.
+    NL_TEST_ASSERT(inSuite, rttEstimator.GetStats().mSampleCount == kAckedMessages);
+    NL_TEST_ASSERT(inSuite, rttEstimator.GetStats().mAmbiguousCount == 0);
+    NL_TEST_ASSERT(inSuite, rttEstimator.GetRetransTimeout() < CHIP_CONFIG_MRP_ADAPTIVE_MIN_RETRY_INTERVAL);
+
+    // Now drop the next message, and time its retransmission.
+    chip::System::PacketBufferHandle buffer = chip::MessagePacketBuffer::NewWithData(PAYLOAD, sizeof(PAYLOAD));
+    NL_TEST_ASSERT(inSuite, !buffer.IsNull());
+
+    ExchangeContext * exchange = ctx.NewExchangeToAlice(&mockSender);
+    NL_TEST_ASSERT(inSuite, exchange != nullptr);
+
+    loopback.mSentMessageCount  = 0;
+    loopback.mNumMessagesToDrop = 1;
+
+    startTime      = System::SystemClock().GetMonotonicTimestamp();
+    CHIP_ERROR err = exchange->SendMessage(Echo::MsgType::EchoRequest, std::move(buffer));
+    NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR);
+    ctx.DrainAndServiceIO();
+
+    NL_TEST_ASSERT(inSuite, loopback.mDroppedMessageCount == 1);
+    NL_TEST_ASSERT(inSuite, rm->TestGetCountRetransTable() == 1);
+
+    // The base interval is held at CHIP_CONFIG_MRP_ADAPTIVE_MIN_RETRY_INTERVAL (should take 330-413ms instead of 1100-1375ms)
+    ctx.GetIOContext().DriveIOUntil(2000_ms32 + retryBoosterTimeout, [&] { return loopback.mSentMessageCount >= 2; });
+    timeoutTime = System::SystemClock().GetMonotonicTimestamp() - startTime;
+    ChipLogProgress(Test, "Adaptive retransmission timeout : %" PRIu32 "ms", timeoutTime.count());
+    NL_TEST_ASSERT(inSuite, timeoutTime >= ReliableMessageMgr::GetBackoff(CHIP_CONFIG_MRP_ADAPTIVE_MIN_RETRY_INTERVAL, 0) - margin);
+    NL_TEST_ASSERT(inSuite, timeoutTime < kPeerInterval + CHIP_CONFIG_MRP_RETRY_INTERVAL_SENDER_BOOST);
+
+    ctx.DrainAndServiceIO();
+
+    // The retransmission was acknowledged, but is not sampled.
+    NL_TEST_ASSERT(inSuite, loopback.mSentMessageCount >= 2);
+    NL_TEST_ASSERT(inSuite, rm->TestGetCountRetransTable() == 0);
+    NL_TEST_ASSERT(inSuite, rttEstimator.GetStats().mSampleCount == kAckedMessages);
+    NL_TEST_ASSERT(inSuite, rttEstimator.GetStats().mAmbiguousCount == 1);
+
+    rm->SetAdaptiveRetransTimeoutEnabled(false);
+}
+
+/**
+ * Tests that the adaptive retransmission timeout leaves time for a delayed standalone ack:
+ *
+ *      DUT = sender, PEER = remote device
+ *
+ * 1) DUT configured to use peer parameters of active = 1000ms, idle = 1000ms, with
+ *    round-trip times measured well below CHIP_CONFIG_MRP_ADAPTIVE_MIN_RETRY_INTERVAL
+ * 2) DUT sends a message to PEER, which does not respond right away
+ * 3) PEER sends a standalone ack after CHIP_CONFIG_RMP_DEFAULT_ACK_TIMEOUT
+ *      - Confirm DUT did not retransmit the message before the ack arrived
+ */
+void TestReliableMessageProtocol::CheckAdaptiveRetransTimeoutWithDelayedAck(nlTestSuite * inSuite, void * inContext)
+{
+    TestContext & ctx = *reinterpret_cast<TestContext *>(inContext);
+
+    ReliableMessageMgr * rm = ctx.GetExchangeManager().GetReliableMessageMgr();
+    NL_TEST_ASSERT(inSuite, rm != nullptr);
+    rm->SetAdaptiveRetransTimeoutEnabled(true);
+
+    auto session = ctx.GetSessionBobToAlice();
+    session->AsSecureSession()->SetRemoteMRPConfig({
+        1000_ms32, // CHIP_CONFIG_MRP_LOCAL_IDLE_RETRY_INTERVAL
+        1000_ms32, // CHIP_CONFIG_MRP_LOCAL_ACTIVE_RETRY_INTERVAL
+    });
+    auto & rttEstimator = session->GetRttEstimator();
+    for (int i = 0; i < 3; i++)
+    {
+        rttEstimator.AddSample(5_ms32);
+    }
+    NL_TEST_ASSERT(inSuite,
+                   rttEstimator.GetAdaptiveInterval(1000_ms32, CHIP_CONFIG_MRP_ADAPTIVE_MIN_RETRY_INTERVAL) ==
+                       CHIP_CONFIG_MRP_ADAPTIVE_MIN_RETRY_INTERVAL);
+
+    MockAppDelegate mockReceiver(ctx);
+    CHIP_ERROR err = ctx.GetExchangeManager().RegisterUnsolicitedMessageHandlerForType(Echo::MsgType::EchoRequest, &mockReceiver);
+    NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR);
+
+    // Keep the receiver exchange open without responding, so that the message is only acked once its ack timer fires.
+    mockReceiver.mTestSuite      = inSuite;
+    mockReceiver.mRetainExchange = true;
+
+    MockAppDelegate mockSender(ctx);
+    ExchangeContext * exchange = ctx.NewExchangeToAlice(&mockSender);
+    NL_TEST_ASSERT(inSuite, exchange != nullptr);
+
+    auto & loopback               = ctx.GetLoopback();
+    loopback.mSentMessageCount    = 0;
+    loopback.mNumMessagesToDrop   = 0;
+    loopback.mDroppedMessageCount = 0;
+
+    chip::System::PacketBufferHandle buffer = chip::MessagePacketBuffer::NewWithData(PAYLOAD, sizeof(PAYLOAD));
+    NL_TEST_ASSERT(inSuite, !buffer.IsNull());
+
+    err = exchange->SendMessage(Echo::MsgType::EchoRequest, std::move(buffer));
+    NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR);
+    ctx.DrainAndServiceIO();
+
+    NL_TEST_ASSERT(inSuite, loopback.mSentMessageCount == 1);
+    NL_TEST_ASSERT(inSuite, mockReceiver.IsOnMessageReceivedCalled);
+    NL_TEST_ASSERT(inSuite, mockReceiver.mExchange != nullptr);
+    NL_TEST_ASSERT(inSuite, mockReceiver.mExchange->GetReliableMessageContext()->IsAckPending());
+    NL_TEST_ASSERT(inSuite, rm->TestGetCountRetransTable() == 1);
+
+    // The standalone ack goes out after CHIP_CONFIG_RMP_DEFAULT_ACK_TIMEOUT, before the first retransmission is due.
+    ctx.GetIOContext().DriveIOUntil(1000_ms32 + retryBoosterTimeout, [&] { return rm->TestGetCountRetransTable() == 0; });
+    ctx.DrainAndServiceIO();
+
+    NL_TEST_ASSERT(inSuite, rm->TestGetCountRetransTable() == 0);
+    NL_TEST_ASSERT(inSuite, loopback.mSentMessageCount == 2); // The message and the standalone ack, no retransmission.
+    NL_TEST_ASSERT(inSuite, loopback.mDroppedMessageCount == 0);
+
+    // The ack answered the only transmission, so it was sampled, delay included.
+    NL_TEST_ASSERT(inSuite, rttEstimator.GetStats().mSampleCount == 4);
+    NL_TEST_ASSERT(inSuite, rttEstimator.GetStats().mAmbiguousCount == 0);
+    NL_TEST_ASSERT(inSuite, rttEstimator.GetStats().mLatestRtt >= CHIP_CONFIG_RMP_DEFAULT_ACK_TIMEOUT);
+
+    mockReceiver.CloseExchangeIfNeeded();
+    err = ctx.GetExchangeManager().UnregisterUnsolicitedMessageHandlerForType(Echo::MsgType::EchoRequest);
+    NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR);
+
+    rm->SetAdaptiveRetransTimeoutEnabled(false);
+}
+#endif // CHIP_CONFIG_MRP_ADAPTIVE_RETRANS_TIMEOUT
+
 int TestReliableMessageProtocol::InitializeTestCase(void * inContext)
 {
     TestContext & ctx = *static_cast<TestContext *>(inContext);
     ctx.GetSessionAliceToBob()->AsSecureSession()->SetRemoteMRPConfig(GetLocalMRPConfig().ValueOr(GetDefaultMRPConfig()));
     ctx.GetSessionBobToAlice()->AsSecureSession()->SetRemoteMRPConfig(GetLocalMRPConfig().ValueOr(GetDefaultMRPConfig()));
+
+#if CHIP_CONFIG_MRP_ADAPTIVE_RETRANS_TIMEOUT
+    // The backoff checks assume the advertised intervals; the adaptive timeout tests enable it themselves.
+    ctx.GetSessionAliceToBob()->GetRttEstimator().Reset();
+    ctx.GetSessionBobToAlice()->GetRttEstimator().Reset();
+    ctx.GetExchangeManager().GetReliableMessageMgr()->SetAdaptiveRetransTimeoutEnabled(false);
+#endif // CHIP_CONFIG_MRP_ADAPTIVE_RETRANS_TIMEOUT
     return SUCCESS;
 }
 
@@ -2186,6 +2436,13 @@ const nlTest sTests[] = {
                 TestReliableMessageProtocol::CheckApplicationResponseDelayed),
     NL_TEST_DEF("Test an application response that never comes, so MRP retransmits run out and then exchange times out",
                 TestReliableMessageProtocol::CheckApplicationResponseNeverComes),
+    NL_TEST_DEF("Test MRP round-trip time estimator", TestReliableMessageProtocol::CheckRttEstimator),
+#if CHIP_CONFIG_MRP_ADAPTIVE_RETRANS_TIMEOUT
+    NL_TEST_DEF("Test that the retransmission timeout adapts to the measured round-trip time",
+                TestReliableMessageProtocol::CheckAdaptiveRetransTimeout),
+    NL_TEST_DEF("Test that the adaptive retransmission timeout waits for a delayed standalone ack",
+                TestReliableMessageProtocol::CheckAdaptiveRetransTimeoutWithDelayedAck),
+#endif // CHIP_CONFIG_MRP_ADAPTIVE_RETRANS_TIMEOUT
     NL_TEST_SENTINEL(),
 };
 
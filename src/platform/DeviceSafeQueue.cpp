@@ -24,30 +24,41 @@
 
 #include <platform/DeviceSafeQueue.h>
 
+#include <lib/support/CodeUtils.h>
+
 namespace chip {
 namespace DeviceLayer {
 namespace Internal {
 
-void DeviceSafeQueue::Push(const ChipDeviceEvent & event)
+bool DeviceSafeQueue::Push(const ChipDeviceEvent & event)
 {
-    std::unique_lock<std::mutex> lock(mEventQueueLock);
-    mEventQueue.push(event);
-}
+    // Once events have spilled over, keep appending there until the consumer drained them, so that this thread's
+    // events are never reordered.
+    if (mOverflowSize.load(std::memory_order_acquire) != 0 || !mRing.TryPush(event))
+    {
+        std::unique_lock<std::mutex> lock(mOverflowLock);
+        mOverflowQueue.push(event);
+        mOverflowSize.fetch_add(1, std::memory_order_release);
+    }
 
-bool DeviceSafeQueue::Empty()
-{
-    std::unique_lock<std::mutex> lock(mEventQueueLock);
-    return mEventQueue.empty();
+    return !mWakePending.exchange(true, std::memory_order_acq_rel);
 }
 
-ChipDeviceEvent DeviceSafeQueue::PopFront()
+bool DeviceSafeQueue::TryPopFront(ChipDeviceEvent & event)
 {
-    std::unique_lock<std::mutex> lock(mEventQueueLock);
+    if (mRing.TryPop(event))
+    {
+        return true;
+    }
+
+    VerifyOrReturnValue(mOverflowSize.load(std::memory_order_acquire) != 0, false);
 
-    const ChipDeviceEvent event = mEventQueue.front();
-    mEventQueue.pop();
+    std::unique_lock<std::mutex> lock(mOverflowLock);
+    event = mOverflowQueue.front();
+    mOverflowQueue.pop();
+    mOverflowSize.fetch_sub(1, std::memory_order_release);
 
-    return event;
+    return true;
 }
 
 } // namespace Internal
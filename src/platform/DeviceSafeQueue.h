@@ -24,10 +24,12 @@
 
 #pragma once
 
+#include <atomic>
 #include <mutex>
 #include <queue>
 
 #include <lib/core/CHIPCore.h>
+#include <lib/support/MpscRing.h>
 #include <platform/CHIPDeviceConfig.h>
 #include <platform/CHIPDeviceEvent.h>
 
@@ -39,9 +41,15 @@ namespace Internal {
  *  @class DeviceSafeQueue
  *
  *  @brief
- *      This class represents a thread-safe message queue implemented with C++ Standard Library, the message queue
- *      is used by the CHIP event loop to hold incoming messages. Each message is sequentially dequeued, decoded,
- *      and then an action is performed.
+ *      This class represents a thread-safe message queue used by the CHIP event loop to hold incoming messages.
+ *      Each message is sequentially dequeued, decoded, and then an action is performed.
+ *
+ *      Any number of threads may push, but only the thread running the event loop may pop. Events go into a
+ *      bounded lock-free ring; should it ever fill up, they spill into a mutex-protected overflow queue until
+ *      the consumer has caught up, so pushing never fails and the order of events posted by a thread is kept.
+ *
+ *      Push() also coalesces wake-ups: it only asks its caller to wake the consumer when no wake-up is already
+ *      pending since the consumer last called ClearPendingWake().
  *
  */
 class DeviceSafeQueue
@@ -50,13 +58,33 @@ public:
     DeviceSafeQueue()  = default;
     ~DeviceSafeQueue() = default;
 
-    void Push(const ChipDeviceEvent & event);
-    bool Empty();
-    ChipDeviceEvent PopFront();
+    /**
+     * Add an event to the queue. Safe to call from any thread.
+     *
+     * @return true if the caller must wake the consumer, false if a wake-up is already on its way.
+     */
+    bool Push(const ChipDeviceEvent & event);
+
+    /**
+     * Remove the oldest event from the queue, if there is one. Must only be called from the consumer thread.
+     */
+    bool TryPopFront(ChipDeviceEvent & event);
+
+    /**
+     * Called by the consumer before draining the queue; events pushed after this will wake it again.
+     *
+     * @return true if a wake-up was pending.
+     */
+    bool ClearPendingWake() { return mWakePending.exchange(false, std::memory_order_acq_rel); }
 
 private:
-    std::queue<ChipDeviceEvent> mEventQueue;
-    std::mutex mEventQueueLock;
+    MpscRing<ChipDeviceEvent, CHIP_DEVICE_CONFIG_EVENT_QUEUE_RING_SIZE> mRing;
+
+    std::queue<ChipDeviceEvent> mOverflowQueue;
+    std::mutex mOverflowLock;
+    std::atomic<size_t> mOverflowSize{ 0 };
+
+    std::atomic<bool> mWakePending{ false };
 
     DeviceSafeQueue(const DeviceSafeQueue &)             = delete;
     DeviceSafeQueue & operator=(const DeviceSafeQueue &) = delete;
@@ -0,0 +1,350 @@
+/*
+ *
+ *    Copyright (c) 2023 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#include <platform/Linux/AsyncLogWriter.h>
+
+#include <lib/support/CHIPMemString.h>
+#include <lib/support/CodeUtils.h>
+#include <lib/support/logging/Constants.h>
+#include <system/SystemError.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdio>
+#include <ctime>
+#include <sched.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+namespace chip {
+namespace DeviceLayer {
+namespace Internal {
+
+namespace {
+
+// How long DrainForAbort waits for another thread to finish writing, in 1 ms steps.
+constexpr int kAbortWriteLockAttempts = 50;
+
+// Formats into a fixed buffer the way snprintf would, truncating but counting the full length, without calling anything
+// that is not async-signal-safe.
+class LineFormatter
+{
+public:
+    LineFormatter(char * buffer, size_t size) : mBuffer(buffer), mSize(size) {}
+
+    void Add(const char * str)
+    {
+        for (; *str != '\0'; str++)
+        {
+            Add(*str);
+        }
+    }
+
+    void Add(char c)
+    {
+        if (mLength + 1 < mSize)
+        {
+            mBuffer[mLength] = c;
+        }
+        mLength++;
+    }
+
+    // Decimal, left-padded with zeros to minDigits.
+    void AddDecimal(uint64_t value, size_t minDigits = 1)
+    {
+        char digits[20];
+        size_t count = 0;
+        do
+        {
+            digits[count++] = static_cast<char>('0' + value % 10);
+            value /= 10;
+        } while (value != 0);
+        for (; minDigits > count; minDigits--)
+        {
+            Add('0');
+        }
+        while (count > 0)
+        {
+            Add(digits[--count]);
+        }
+    }
+
+    void AddDecimal(long long value)
+    {
+        if (value < 0)
+        {
+            Add('-');
+            AddDecimal(static_cast<uint64_t>(-(value + 1)) + 1);
+            return;
+        }
+        AddDecimal(static_cast<uint64_t>(value));
+    }
+
+    // Terminates the buffer, and returns the length the whole line needs, not counting the terminator.
+    size_t Finish()
+    {
+        if (mSize > 0)
+        {
+            mBuffer[std::min(mLength, mSize - 1)] = '\0';
+        }
+        return mLength;
+    }
+
+private:
+    char * mBuffer;
+    size_t mSize;
+    size_t mLength = 0;
+};
+
+} // namespace
+
+CHIP_ERROR AsyncLogWriter::Start()
+{
+    VerifyOrReturnError(!mRunning.load() && !mStopping.load(), CHIP_ERROR_INCORRECT_STATE);
+
+#ifdef __NuttX__
+    mProcessId = static_cast<long long>(getpid());
+#else
+    mProcessId = static_cast<long long>(syscall(SYS_getpid));
+#endif
+    VerifyOrReturnError(sem_init(&mWakeUp, 0, 0) == 0, CHIP_ERROR_POSIX(errno));
+
+    int err = pthread_create(&mThread, nullptr, WriterMain, this);
+    if (err != 0)
+    {
+        sem_destroy(&mWakeUp);
+        return CHIP_ERROR_POSIX(err);
+    }
+    mRunning.store(true);
+    return CHIP_NO_ERROR;
+}
+
+void AsyncLogWriter::Stop()
+{
+    VerifyOrReturn(mRunning.exchange(false));
+
+    // Producers that saw the writer running may still be queueing a line. Wait for them, so that the last pass of the
+    // writer thread below picks up their lines rather than leaving them in the queue.
+    while (mActiveProducers.load() != 0)
+    {
+        sched_yield();
+    }
+
+    mStopping.store(true);
+    sem_post(&mWakeUp);
+    pthread_join(mThread, nullptr);
+    sem_destroy(&mWakeUp);
+}
+
+bool AsyncLogWriter::Log(const char * module, uint8_t category, const char * msg, va_list v)
+{
+    // Registered before checking mRunning, so that Stop either sees this producer or this producer sees it stopped.
+    mActiveProducers.fetch_add(1);
+    if (!mRunning.load())
+    {
+        mActiveProducers.fetch_sub(1);
+        return false;
+    }
+
+    LogLine line;
+    gettimeofday(&line.mTime, nullptr);
+    line.mThreadId = CurrentThreadId();
+    line.mCategory = category;
+    chip::Platform::CopyString(line.mModule, module);
+    vsnprintf(line.mMessage, sizeof(line.mMessage), msg, v);
+
+    if (category == Logging::kLogCategory_Error)
+    {
+        // Error lines are often the last thing logged before chipDie or VerifyOrDie, so do not leave them queued.
+        WriteLines(&line);
+    }
+    else if (!mQueue.TryPush(line))
+    {
+        mDropped.fetch_add(1, std::memory_order_relaxed);
+    }
+    else if (mPending.fetch_add(1, std::memory_order_relaxed) + 1 == kQueueSize / 2)
+    {
+        sem_post(&mWakeUp);
+    }
+
+    mActiveProducers.fetch_sub(1);
+    return true;
+}
+
+void AsyncLogWriter::DrainForAbort()
+{
+    // The interrupted thread may be the one writing, in which case waiting does not help; hence the bound.
+    int savedErrno = errno;
+    for (int attempt = 0; !TryBeginWriting(); attempt++)
+    {
+        if (attempt == kAbortWriteLockAttempts)
+        {
+            errno = savedErrno;
+            return;
+        }
+        struct timespec delay = { 0, 1000000 };
+        nanosleep(&delay, nullptr);
+    }
+    WriteQueuedLinesLocked();
+    Flush();
+    EndWriting();
+    errno = savedErrno;
+}
+
+void * AsyncLogWriter::WriterMain(void * context)
+{
+    auto * writer = static_cast<AsyncLogWriter *>(context);
+    for (;;)
+    {
+        writer->WaitForLines();
+        bool stopping = writer->mStopping.load();
+        writer->WriteLines(nullptr);
+        if (stopping)
+        {
+            return nullptr;
+        }
+    }
+}
+
+long long AsyncLogWriter::CurrentThreadId()
+{
+    // Cached, since it takes a system call.
+#ifdef __NuttX__
+    static thread_local long long sThreadId = static_cast<long long>(gettid());
+#else
+    static thread_local long long sThreadId = static_cast<long long>(syscall(SYS_gettid));
+#endif
+    return sThreadId;
+}
+
+void AsyncLogWriter::WaitForLines()
+{
+    struct timespec deadline;
+    clock_gettime(CLOCK_REALTIME, &deadline);
+    deadline.tv_nsec += kWriteIntervalMs * 1000000;
+    if (deadline.tv_nsec >= 1000000000)
+    {
+        deadline.tv_sec++;
+        deadline.tv_nsec -= 1000000000;
+    }
+    while (sem_timedwait(&mWakeUp, &deadline) != 0 && errno == EINTR)
+    {
+    }
+}
+
+void AsyncLogWriter::WriteLines(const LogLine * extraLine)
+{
+    while (!TryBeginWriting())
+    {
+        sched_yield();
+    }
+    WriteQueuedLinesLocked();
+    if (extraLine != nullptr)
+    {
+        Append(*extraLine);
+    }
+    Flush();
+    EndWriting();
+}
+
+void AsyncLogWriter::WriteQueuedLinesLocked()
+{
+    uint32_t dropped = mDropped.exchange(0, std::memory_order_relaxed);
+    if (dropped > 0)
+    {
+        // Built with async-signal-safe calls only, since this also runs from DrainForAbort.  The notice is not
+        // attributed to a thread.
+        LogLine notice;
+        struct timespec now;
+        clock_gettime(CLOCK_REALTIME, &now);
+        notice.mTime.tv_sec  = now.tv_sec;
+        notice.mTime.tv_usec = static_cast<suseconds_t>(now.tv_nsec / 1000);
+        notice.mThreadId     = 0;
+        notice.mCategory     = Logging::kLogCategory_Error;
+        notice.mModule[0]    = '-';
+        notice.mModule[1]    = '\0';
+        LineFormatter message(notice.mMessage, sizeof(notice.mMessage));
+        message.AddDecimal(static_cast<uint64_t>(dropped));
+        message.Add(" log lines dropped: log queue full");
+        message.Finish();
+        Append(notice);
+    }
+
+    LogLine line;
+    while (mQueue.TryPop(line))
+    {
+        mPending.fetch_sub(1, std::memory_order_relaxed);
+        Append(line);
+    }
+}
+
+void AsyncLogWriter::Append(const LogLine & line)
+{
+    size_t length = Format(line);
+    if (length >= sizeof(mBuffer) - mBufferUsed && mBufferUsed > 0)
+    {
+        // The line does not fit after those already buffered, so write those out first.
+        Flush();
+        length = Format(line);
+    }
+    mBufferUsed += std::min(length, sizeof(mBuffer) - mBufferUsed - 1);
+}
+
+size_t AsyncLogWriter::Format(const LogLine & line)
+{
+    // Same layout as the synchronous path in Logging.cpp:
+    // "[%" PRIu64 ".%06" PRIu64 "][%lld:%lld] CHIP:%s: %s\n"
+    LineFormatter formatter(&mBuffer[mBufferUsed], sizeof(mBuffer) - mBufferUsed);
+    formatter.Add('[');
+    formatter.AddDecimal(static_cast<uint64_t>(line.mTime.tv_sec));
+    formatter.Add('.');
+    formatter.AddDecimal(static_cast<uint64_t>(line.mTime.tv_usec), 6);
+    formatter.Add("][");
+    formatter.AddDecimal(mProcessId);
+    formatter.Add(':');
+    formatter.AddDecimal(line.mThreadId);
+    formatter.Add("] CHIP:");
+    formatter.Add(line.mModule);
+    formatter.Add(": ");
+    formatter.Add(line.mMessage);
+    formatter.Add('\n');
+    return formatter.Finish();
+}
+
+void AsyncLogWriter::Flush()
+{
+    // write() rather than stdio, so that DrainForAbort does not need the stdout lock.
+    size_t written = 0;
+    while (written < mBufferUsed)
+    {
+        ssize_t result = write(mOutputFd, &mBuffer[written], mBufferUsed - written);
+        if (result < 0 && errno == EINTR)
+        {
+            continue;
+        }
+        if (result <= 0)
+        {
+            break;
+        }
+        written += static_cast<size_t>(result);
+    }
+    mBufferUsed = 0;
+}
+
+} // namespace Internal
+} // namespace DeviceLayer
+} // namespace chip
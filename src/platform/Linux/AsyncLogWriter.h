@@ -0,0 +1,141 @@
+/*
+ *
+ *    Copyright (c) 2023 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ * @file
+ *   Writes CHIP log lines to a file descriptor from a background thread.
+ */
+
+#pragma once
+
+#include <lib/core/CHIPConfig.h>
+#include <lib/core/CHIPError.h>
+#include <lib/support/EnforceFormat.h>
+#include <lib/support/MpscRing.h>
+#include <platform/CHIPDeviceConfig.h>
+
+#include <atomic>
+#include <pthread.h>
+#include <semaphore.h>
+#include <stdarg.h>
+#include <stdint.h>
+#include <sys/time.h>
+
+namespace chip {
+namespace DeviceLayer {
+namespace Internal {
+
+/**
+ * Moves writing log lines off the threads that log them.
+ *
+ * The logging thread only takes a timestamp and formats the message into a lock-free queue. A background thread adds
+ * the line prefix and writes the queued lines in batches, waking up when the queue is half full, or after
+ * kWriteIntervalMs otherwise.
+ *
+ * Lines logged as errors are written by the logging thread itself, after the lines queued before them, so they are out
+ * before Log returns even if the process dies right after.  DrainForAbort writes out whatever is still queued when the
+ * process aborts.
+ */
+class AsyncLogWriter
+{
+public:
+    static constexpr size_t kQueueSize     = CHIP_DEVICE_CONFIG_ASYNC_LOGGING_QUEUE_SIZE;
+    static constexpr long kWriteIntervalMs = 20;
+
+    explicit AsyncLogWriter(int outputFd) : mOutputFd(outputFd) {}
+    ~AsyncLogWriter() { Stop(); }
+
+    AsyncLogWriter(const AsyncLogWriter &)             = delete;
+    AsyncLogWriter & operator=(const AsyncLogWriter &) = delete;
+
+    /**
+     * Starts the writer thread.  A writer can only be started once.
+     */
+    CHIP_ERROR Start();
+
+    /**
+     * Stops the writer thread once every line logged so far has been written.  Lines logged from then on are left to
+     * the caller.
+     */
+    void Stop();
+
+    /**
+     * Queues a log line, or writes it right away if it is an error.
+     *
+     * @return false if the writer is not running, in which case the caller should write the line itself.
+     */
+    bool Log(const char * module, uint8_t category, const char * msg, va_list v) ENFORCE_FORMAT(4, 0);
+
+    /**
+     * Writes out the queued lines from a SIGABRT handler.  Gives up if another thread keeps writing for too long,
+     * rather than holding up the abort.
+     *
+     * Only uses atomics and async-signal-safe functions: writing out lines never takes a lock, formats them by hand
+     * rather than through stdio, and goes through write().
+     */
+    void DrainForAbort();
+
+private:
+    static constexpr size_t kWriteBufferSize  = 4096;
+    static constexpr size_t kMaxModuleNameLen = 7;
+
+    static_assert(kWriteBufferSize > CHIP_CONFIG_LOG_MESSAGE_MAX_SIZE + 128, "Log write buffer must fit a whole line");
+
+    struct LogLine
+    {
+        struct timeval mTime;
+        long long mThreadId;
+        uint8_t mCategory;
+        char mModule[kMaxModuleNameLen + 1];
+        char mMessage[CHIP_CONFIG_LOG_MESSAGE_MAX_SIZE];
+    };
+
+    static void * WriterMain(void * context);
+    static long long CurrentThreadId();
+
+    void WaitForLines();
+
+    // Writes the queued lines, then extraLine if not null.  Only one thread at a time pops from the queue.
+    void WriteLines(const LogLine * extraLine);
+    bool TryBeginWriting() { return !mWriting.exchange(true, std::memory_order_acquire); }
+    void EndWriting() { mWriting.store(false, std::memory_order_release); }
+    void WriteQueuedLinesLocked();
+    void Append(const LogLine & line);
+    size_t Format(const LogLine & line);
+    void Flush();
+
+    const int mOutputFd;
+    MpscRing<LogLine, kQueueSize> mQueue;
+    std::atomic<size_t> mPending{ 0 };
+    std::atomic<uint32_t> mDropped{ 0 };
+    std::atomic<bool> mRunning{ false };
+    std::atomic<bool> mStopping{ false };
+    std::atomic<uint32_t> mActiveProducers{ 0 };
+    pthread_t mThread;
+    sem_t mWakeUp;
+    long long mProcessId = 0;
+
+    // Set by whichever thread is popping lines and writing them out.  A flag rather than a mutex, since DrainForAbort
+    // takes it from a signal handler.
+    std::atomic<bool> mWriting{ false };
+    char mBuffer[kWriteBufferSize];
+    size_t mBufferUsed = 0;
+};
+
+} // namespace Internal
+} // namespace DeviceLayer
+} // namespace chip
@@ -55,6 +55,31 @@
 // These are configuration options that are unique to Linux platforms.
 // These can be overridden by the application as needed.
 
+// How long, in milliseconds, the interface statistics read for the network
+// diagnostics clusters are reused before being read again from the system.
+#ifndef CHIP_DEVICE_CONFIG_DIAGNOSTICS_SNAPSHOT_TTL_MS
+#define CHIP_DEVICE_CONFIG_DIAGNOSTICS_SNAPSHOT_TTL_MS 1000
+#endif // CHIP_DEVICE_CONFIG_DIAGNOSTICS_SNAPSHOT_TTL_MS
+
+// How long, in milliseconds, a successful Avahi resolve is reused to answer
+// repeated resolves of the same service. Set to 0 to disable the cache.
+#ifndef CHIP_DEVICE_CONFIG_DNSSD_RESOLVE_CACHE_TTL_MS
+#define CHIP_DEVICE_CONFIG_DNSSD_RESOLVE_CACHE_TTL_MS 2000
+#endif // CHIP_DEVICE_CONFIG_DNSSD_RESOLVE_CACHE_TTL_MS
+
+// When set to 1, log lines are formatted into a queue on the logging thread
+// and written to stdout in batches by a background thread. Lines logged while
+// the queue is full are dropped, and the number dropped is logged once there
+// is room again.
+#ifndef CHIP_DEVICE_CONFIG_ASYNC_LOGGING
+#define CHIP_DEVICE_CONFIG_ASYNC_LOGGING 0
+#endif // CHIP_DEVICE_CONFIG_ASYNC_LOGGING
+
+// Number of log lines the async logger can hold; must be a power of two.
+#ifndef CHIP_DEVICE_CONFIG_ASYNC_LOGGING_QUEUE_SIZE
+#define CHIP_DEVICE_CONFIG_ASYNC_LOGGING_QUEUE_SIZE 256
+#endif // CHIP_DEVICE_CONFIG_ASYNC_LOGGING_QUEUE_SIZE
+
 // ========== Platform-specific Configuration Overrides =========
 
 #ifndef CHIP_DEVICE_CONFIG_CHIP_TASK_STACK_SIZE
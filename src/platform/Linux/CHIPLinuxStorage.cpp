@@ -348,6 +348,29 @@ CHIP_ERROR ChipLinuxStorage::Commit()
     return retval;
 }
 
+/**
+ * Discards all changes that have not been committed, by reading the configuration file back.
+ */
+CHIP_ERROR ChipLinuxStorage::Reload()
+{
+    CHIP_ERROR retval = CHIP_NO_ERROR;
+
+    mLock.lock();
+
+    retval = ChipLinuxStorageIni::RemoveAll();
+
+    if (retval == CHIP_NO_ERROR)
+    {
+        retval = ChipLinuxStorageIni::AddConfig(mConfigPath);
+    }
+
+    mDirty = false;
+
+    mLock.unlock();
+
+    return retval;
+}
+
 } // namespace Internal
 } // namespace DeviceLayer
 } // namespace chip
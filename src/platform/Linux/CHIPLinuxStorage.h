@@ -84,6 +84,7 @@ public:
     CHIP_ERROR ClearValue(const char * key);
     CHIP_ERROR ClearAll();
     CHIP_ERROR Commit();
+    CHIP_ERROR Reload();
     bool HasValue(const char * key);
 
 private:
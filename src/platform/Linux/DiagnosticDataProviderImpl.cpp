@@ -31,6 +31,7 @@
 #include <platform/DiagnosticDataProvider.h>
 #include <platform/Linux/ConnectivityUtils.h>
 #include <platform/Linux/DiagnosticDataProviderImpl.h>
+#include <system/SystemClock.h>
 
 #include <arpa/inet.h>
 #include <dirent.h>
@@ -79,138 +80,191 @@ enum class WiFiStatsCountType
     kWiFiOverrunCount
 };
 
-CHIP_ERROR GetEthernetStatsCount(EthernetStatsCountType type, uint64_t & count)
+// Link statistics of the primary Ethernet and WiFi interfaces.
+struct InterfaceStatsSnapshot
 {
-    CHIP_ERROR err          = CHIP_ERROR_READ_FAILED;
+    System::Clock::Timestamp mTimestamp;
+    bool mValid       = false;
+    bool mHasEthernet = false;
+    bool mHasWiFi     = false;
+    struct rtnl_link_stats mEthernet;
+    struct rtnl_link_stats mWiFi;
+};
+
+InterfaceStatsSnapshot sInterfaceStats;
+
+// Gathers the statistics of all interfaces in a single pass over the system's interface list. The snapshot is reused for
+// CHIP_DEVICE_CONFIG_DIAGNOSTICS_SNAPSHOT_TTL_MS, so that the counters read together (e.g. by a wildcard read of a
+// diagnostics cluster) do not each query the kernel.
+CHIP_ERROR UpdateInterfaceStats(bool forceRefresh)
+{
+    System::Clock::Timestamp now = System::SystemClock().GetMonotonicTimestamp();
+
+    if (!forceRefresh && sInterfaceStats.mValid &&
+        (now - sInterfaceStats.mTimestamp) < System::Clock::Milliseconds32(CHIP_DEVICE_CONFIG_DIAGNOSTICS_SNAPSHOT_TTL_MS))
+    {
+        return CHIP_NO_ERROR;
+    }
+
     struct ifaddrs * ifaddr = nullptr;
 
+    sInterfaceStats.mValid = false;
     if (getifaddrs(&ifaddr) == -1)
     {
         ChipLogError(DeviceLayer, "Failed to get network interfaces");
+        return CHIP_ERROR_READ_FAILED;
     }
-    else
-    {
-        struct ifaddrs * ifa = nullptr;
 
-        // Walk through linked list, maintaining head pointer so we can free list later.
-        for (ifa = ifaddr; ifa != nullptr; ifa = ifa->ifa_next)
+    InterfaceStatsSnapshot snapshot;
+
+    for (struct ifaddrs * ifa = ifaddr; ifa != nullptr && !(snapshot.mHasEthernet && snapshot.mHasWiFi); ifa = ifa->ifa_next)
+    {
+        if (ifa->ifa_addr == nullptr || ifa->ifa_addr->sa_family != AF_PACKET || ifa->ifa_data == nullptr)
         {
-            if (ConnectivityUtils::GetInterfaceConnectionType(ifa->ifa_name) == InterfaceTypeEnum::kEthernet)
-            {
-                ChipLogProgress(DeviceLayer, "Found the primary Ethernet interface:%s", StringOrNullMarker(ifa->ifa_name));
-                break;
-            }
+            continue;
         }
 
-        if (ifa != nullptr)
+        InterfaceTypeEnum type = ConnectivityUtils::GetInterfaceConnectionType(ifa->ifa_name);
+        if (type == InterfaceTypeEnum::kEthernet && !snapshot.mHasEthernet)
         {
-            if (ifa->ifa_addr->sa_family == AF_PACKET && ifa->ifa_data != nullptr)
-            {
-                struct rtnl_link_stats * stats = (struct rtnl_link_stats *) ifa->ifa_data;
-                switch (type)
-                {
-                case EthernetStatsCountType::kEthPacketRxCount:
-                    count = stats->rx_packets;
-                    err   = CHIP_NO_ERROR;
-                    break;
-                case EthernetStatsCountType::kEthPacketTxCount:
-                    count = stats->tx_packets;
-                    err   = CHIP_NO_ERROR;
-                    break;
-                case EthernetStatsCountType::kEthTxErrCount:
-                    count = stats->tx_errors;
-                    err   = CHIP_NO_ERROR;
-                    break;
-                case EthernetStatsCountType::kEthCollisionCount:
-                    count = stats->collisions;
-                    err   = CHIP_NO_ERROR;
-                    break;
-                case EthernetStatsCountType::kEthOverrunCount:
-                    count = stats->rx_over_errors;
-                    err   = CHIP_NO_ERROR;
-                    break;
-                default:
-                    ChipLogError(DeviceLayer, "Unknown Ethernet statistic metric type");
-                    break;
-                }
-            }
+            ChipLogDetail(DeviceLayer, "Found the primary Ethernet interface:%s", StringOrNullMarker(ifa->ifa_name));
+            snapshot.mEthernet    = *static_cast<struct rtnl_link_stats *>(ifa->ifa_data);
+            snapshot.mHasEthernet = true;
+        }
+        else if (type == InterfaceTypeEnum::kWiFi && !snapshot.mHasWiFi)
+        {
+            ChipLogDetail(DeviceLayer, "Found the primary WiFi interface:%s", StringOrNullMarker(ifa->ifa_name));
+            snapshot.mWiFi    = *static_cast<struct rtnl_link_stats *>(ifa->ifa_data);
+            snapshot.mHasWiFi = true;
         }
+    }
 
-        freeifaddrs(ifaddr);
+    freeifaddrs(ifaddr);
+
+    snapshot.mTimestamp = now;
+    snapshot.mValid     = true;
+    sInterfaceStats     = snapshot;
+
+    return CHIP_NO_ERROR;
+}
+
+const struct rtnl_link_stats * GetInterfaceStats(InterfaceTypeEnum type, bool forceRefresh = false)
+{
+    VerifyOrReturnValue(UpdateInterfaceStats(forceRefresh) == CHIP_NO_ERROR, nullptr);
+
+    if (type == InterfaceTypeEnum::kEthernet)
+    {
+        return sInterfaceStats.mHasEthernet ? &sInterfaceStats.mEthernet : nullptr;
+    }
+    if (type == InterfaceTypeEnum::kWiFi)
+    {
+        return sInterfaceStats.mHasWiFi ? &sInterfaceStats.mWiFi : nullptr;
     }
+    return nullptr;
+}
 
-    return err;
+CHIP_ERROR GetEthernetStatsCount(EthernetStatsCountType type, uint64_t & count)
+{
+    const struct rtnl_link_stats * stats = GetInterfaceStats(InterfaceTypeEnum::kEthernet);
+    VerifyOrReturnError(stats != nullptr, CHIP_ERROR_READ_FAILED);
+
+    switch (type)
+    {
+    case EthernetStatsCountType::kEthPacketRxCount:
+        count = stats->rx_packets;
+        break;
+    case EthernetStatsCountType::kEthPacketTxCount:
+        count = stats->tx_packets;
+        break;
+    case EthernetStatsCountType::kEthTxErrCount:
+        count = stats->tx_errors;
+        break;
+    case EthernetStatsCountType::kEthCollisionCount:
+        count = stats->collisions;
+        break;
+    case EthernetStatsCountType::kEthOverrunCount:
+        count = stats->rx_over_errors;
+        break;
+    default:
+        ChipLogError(DeviceLayer, "Unknown Ethernet statistic metric type");
+        return CHIP_ERROR_READ_FAILED;
+    }
+
+    return CHIP_NO_ERROR;
 }
 
 #if CHIP_DEVICE_CONFIG_ENABLE_WIFI
 CHIP_ERROR GetWiFiStatsCount(WiFiStatsCountType type, uint64_t & count)
 {
-    CHIP_ERROR err          = CHIP_ERROR_READ_FAILED;
-    struct ifaddrs * ifaddr = nullptr;
+    const struct rtnl_link_stats * stats = GetInterfaceStats(InterfaceTypeEnum::kWiFi);
+    VerifyOrReturnError(stats != nullptr, CHIP_ERROR_READ_FAILED);
 
-    if (getifaddrs(&ifaddr) == -1)
+    // The usecase of this function is embedded devices,on which we can interact with the WiFi
+    // driver to get the accurate number of muticast and unicast packets accurately.
+    // On Linux simulation, we can only get the total packets received, the total bytes transmitted,
+    // the multicast packets received and receiver ring buff overflow.
+    switch (type)
     {
-        ChipLogError(DeviceLayer, "Failed to get network interfaces");
+    case WiFiStatsCountType::kWiFiUnicastPacketRxCount:
+        count = stats->rx_packets;
+        break;
+    case WiFiStatsCountType::kWiFiUnicastPacketTxCount:
+        count = stats->tx_packets;
+        break;
+    case WiFiStatsCountType::kWiFiMulticastPacketRxCount:
+        count = stats->multicast;
+        break;
+    case WiFiStatsCountType::kWiFiMulticastPacketTxCount:
+        count = 0;
+        break;
+    case WiFiStatsCountType::kWiFiOverrunCount:
+        count = stats->rx_over_errors;
+        break;
+    default:
+        ChipLogError(DeviceLayer, "Unknown WiFi statistic metric type");
+        return CHIP_ERROR_READ_FAILED;
     }
-    else
-    {
-        struct ifaddrs * ifa = nullptr;
 
-        // Walk through linked list, maintaining head pointer so we can free list later.
-        for (ifa = ifaddr; ifa != nullptr; ifa = ifa->ifa_next)
+    return CHIP_NO_ERROR;
+}
+#endif // #if CHIP_DEVICE_CONFIG_ENABLE_WIFI
+
+// Fills in the addresses of an interface from an interface list that has already been retrieved.
+void GetInterfaceAddrs(struct ifaddrs * ifaddr, const char * ifname, NetworkInterface * ifp)
+{
+    uint8_t ipv4Count = 0;
+    uint8_t ipv6Count = 0;
+
+    for (struct ifaddrs * ifa = ifaddr; ifa != nullptr; ifa = ifa->ifa_next)
+    {
+        if (ifa->ifa_addr == nullptr || strcmp(ifname, ifa->ifa_name) != 0)
         {
-            if (ConnectivityUtils::GetInterfaceConnectionType(ifa->ifa_name) == InterfaceTypeEnum::kWiFi)
-            {
-                ChipLogProgress(DeviceLayer, "Found the primary WiFi interface:%s", StringOrNullMarker(ifa->ifa_name));
-                break;
-            }
+            continue;
         }
 
-        if (ifa != nullptr)
+        if (ifa->ifa_addr->sa_family == AF_INET && ipv4Count < kMaxIPv4AddrCount)
         {
-            if (ifa->ifa_addr->sa_family == AF_PACKET && ifa->ifa_data != nullptr)
-            {
-                // The usecase of this function is embedded devices,on which we can interact with the WiFi
-                // driver to get the accurate number of muticast and unicast packets accurately.
-                // On Linux simulation, we can only get the total packets received, the total bytes transmitted,
-                // the multicast packets received and receiver ring buff overflow.
-
-                struct rtnl_link_stats * stats = (struct rtnl_link_stats *) ifa->ifa_data;
-                switch (type)
-                {
-                case WiFiStatsCountType::kWiFiUnicastPacketRxCount:
-                    count = stats->rx_packets;
-                    err   = CHIP_NO_ERROR;
-                    break;
-                case WiFiStatsCountType::kWiFiUnicastPacketTxCount:
-                    count = stats->tx_packets;
-                    err   = CHIP_NO_ERROR;
-                    break;
-                case WiFiStatsCountType::kWiFiMulticastPacketRxCount:
-                    count = stats->multicast;
-                    err   = CHIP_NO_ERROR;
-                    break;
-                case WiFiStatsCountType::kWiFiMulticastPacketTxCount:
-                    count = 0;
-                    err   = CHIP_NO_ERROR;
-                    break;
-                case WiFiStatsCountType::kWiFiOverrunCount:
-                    count = stats->rx_over_errors;
-                    err   = CHIP_NO_ERROR;
-                    break;
-                default:
-                    ChipLogError(DeviceLayer, "Unknown WiFi statistic metric type");
-                    break;
-                }
-            }
+            memcpy(ifp->Ipv4AddressesBuffer[ipv4Count], &((struct sockaddr_in *) ifa->ifa_addr)->sin_addr, kMaxIPv4AddrSize);
+            ifp->Ipv4AddressSpans[ipv4Count] = ByteSpan(ifp->Ipv4AddressesBuffer[ipv4Count], kMaxIPv4AddrSize);
+            ipv4Count++;
+        }
+        else if (ifa->ifa_addr->sa_family == AF_INET6 && ipv6Count < kMaxIPv6AddrCount)
+        {
+            memcpy(ifp->Ipv6AddressesBuffer[ipv6Count], &((struct sockaddr_in6 *) ifa->ifa_addr)->sin6_addr, kMaxIPv6AddrSize);
+            ifp->Ipv6AddressSpans[ipv6Count] = ByteSpan(ifp->Ipv6AddressesBuffer[ipv6Count], kMaxIPv6AddrSize);
+            ipv6Count++;
         }
-
-        freeifaddrs(ifaddr);
     }
 
-    return err;
+    if (ipv4Count > 0)
+    {
+        ifp->IPv4Addresses = DataModel::List<const chip::ByteSpan>(ifp->Ipv4AddressSpans, ipv4Count);
+    }
+    if (ipv6Count > 0)
+    {
+        ifp->IPv6Addresses = DataModel::List<const chip::ByteSpan>(ifp->Ipv6AddressSpans, ipv6Count);
+    }
 }
-#endif // #if CHIP_DEVICE_CONFIG_ENABLE_WIFI
 
 } // namespace
 
@@ -454,7 +508,6 @@ CHIP_ERROR DiagnosticDataProviderImpl::GetNetworkInterfaces(NetworkInterface **
         {
             if (ifa->ifa_addr && ifa->ifa_addr->sa_family == AF_PACKET)
             {
-                uint8_t size           = 0;
                 NetworkInterface * ifp = new NetworkInterface();
 
                 Platform::CopyString(ifp->Name, ifa->ifa_name);
@@ -465,21 +518,7 @@ CHIP_ERROR DiagnosticDataProviderImpl::GetNetworkInterfaces(NetworkInterface **
                 ifp->offPremiseServicesReachableIPv4.SetNull();
                 ifp->offPremiseServicesReachableIPv6.SetNull();
 
-                if (ConnectivityUtils::GetInterfaceIPv4Addrs(ifa->ifa_name, size, ifp) == CHIP_NO_ERROR)
-                {
-                    if (size > 0)
-                    {
-                        ifp->IPv4Addresses = DataModel::List<const chip::ByteSpan>(ifp->Ipv4AddressSpans, size);
-                    }
-                }
-
-                if (ConnectivityUtils::GetInterfaceIPv6Addrs(ifa->ifa_name, size, ifp) == CHIP_NO_ERROR)
-                {
-                    if (size > 0)
-                    {
-                        ifp->IPv6Addresses = DataModel::List<const chip::ByteSpan>(ifp->Ipv6AddressSpans, size);
-                    }
-                }
+                GetInterfaceAddrs(ifaddr, ifa->ifa_name, ifp);
 
                 if (ConnectivityUtils::GetInterfaceHardwareAddrs(ifa->ifa_name, ifp->MacAddress, kMaxHardwareAddrSize) !=
                     CHIP_NO_ERROR)
@@ -603,46 +642,16 @@ CHIP_ERROR DiagnosticDataProviderImpl::GetEthOverrunCount(uint64_t & overrunCoun
 
 CHIP_ERROR DiagnosticDataProviderImpl::ResetEthNetworkDiagnosticsCounts()
 {
-    CHIP_ERROR err          = CHIP_ERROR_READ_FAILED;
-    struct ifaddrs * ifaddr = nullptr;
+    const struct rtnl_link_stats * stats = GetInterfaceStats(InterfaceTypeEnum::kEthernet, true /* forceRefresh */);
+    VerifyOrReturnError(stats != nullptr, CHIP_ERROR_READ_FAILED);
 
-    if (getifaddrs(&ifaddr) == -1)
-    {
-        ChipLogError(DeviceLayer, "Failed to get network interfaces");
-    }
-    else
-    {
-        struct ifaddrs * ifa = nullptr;
+    mEthPacketRxCount  = stats->rx_packets;
+    mEthPacketTxCount  = stats->tx_packets;
+    mEthTxErrCount     = stats->tx_errors;
+    mEthCollisionCount = stats->collisions;
+    mEthOverrunCount   = stats->rx_over_errors;
 
-        // Walk through linked list, maintaining head pointer so we can free list later.
-        for (ifa = ifaddr; ifa != nullptr; ifa = ifa->ifa_next)
-        {
-            if (ConnectivityUtils::GetInterfaceConnectionType(ifa->ifa_name) == InterfaceTypeEnum::kEthernet)
-            {
-                ChipLogProgress(DeviceLayer, "Found the primary Ethernet interface:%s", StringOrNullMarker(ifa->ifa_name));
-                break;
-            }
-        }
-
-        if (ifa != nullptr)
-        {
-            if (ifa->ifa_addr->sa_family == AF_PACKET && ifa->ifa_data != nullptr)
-            {
-                struct rtnl_link_stats * stats = (struct rtnl_link_stats *) ifa->ifa_data;
-
-                mEthPacketRxCount  = stats->rx_packets;
-                mEthPacketTxCount  = stats->tx_packets;
-                mEthTxErrCount     = stats->tx_errors;
-                mEthCollisionCount = stats->collisions;
-                mEthOverrunCount   = stats->rx_over_errors;
-                err                = CHIP_NO_ERROR;
-            }
-        }
-
-        freeifaddrs(ifaddr);
-    }
-
-    return err;
+    return CHIP_NO_ERROR;
 }
 
 #if CHIP_DEVICE_CONFIG_ENABLE_WIFI
@@ -766,49 +775,18 @@ CHIP_ERROR DiagnosticDataProviderImpl::GetWiFiOverrunCount(uint64_t & overrunCou
 
 CHIP_ERROR DiagnosticDataProviderImpl::ResetWiFiNetworkDiagnosticsCounts()
 {
-    CHIP_ERROR err          = CHIP_ERROR_READ_FAILED;
-    struct ifaddrs * ifaddr = nullptr;
-
     ReturnErrorOnFailure(GetWiFiBeaconLostCount(mBeaconLostCount));
 
-    if (getifaddrs(&ifaddr) == -1)
-    {
-        ChipLogError(DeviceLayer, "Failed to get network interfaces");
-    }
-    else
-    {
-        struct ifaddrs * ifa = nullptr;
+    const struct rtnl_link_stats * stats = GetInterfaceStats(InterfaceTypeEnum::kWiFi, true /* forceRefresh */);
+    VerifyOrReturnError(stats != nullptr, CHIP_ERROR_READ_FAILED);
 
-        // Walk through linked list, maintaining head pointer so we can free list later.
-        for (ifa = ifaddr; ifa != nullptr; ifa = ifa->ifa_next)
-        {
-            if (ConnectivityUtils::GetInterfaceConnectionType(ifa->ifa_name) == InterfaceTypeEnum::kWiFi)
-            {
-                ChipLogProgress(DeviceLayer, "Found the primary WiFi interface:%s", StringOrNullMarker(ifa->ifa_name));
-                break;
-            }
-        }
-
-        if (ifa != nullptr)
-        {
-            if (ifa->ifa_addr->sa_family == AF_PACKET && ifa->ifa_data != nullptr)
-            {
-                struct rtnl_link_stats * stats = (struct rtnl_link_stats *) ifa->ifa_data;
-
-                mPacketMulticastRxCount = stats->multicast;
-                mPacketMulticastTxCount = 0;
-                mPacketUnicastRxCount   = stats->rx_packets;
-                mPacketUnicastTxCount   = stats->tx_packets;
-                mOverrunCount           = stats->rx_over_errors;
+    mPacketMulticastRxCount = stats->multicast;
+    mPacketMulticastTxCount = 0;
+    mPacketUnicastRxCount   = stats->rx_packets;
+    mPacketUnicastTxCount   = stats->tx_packets;
+    mOverrunCount           = stats->rx_over_errors;
 
-                err = CHIP_NO_ERROR;
-            }
-        }
-
-        freeifaddrs(ifaddr);
-    }
-
-    return err;
+    return CHIP_NO_ERROR;
 }
 #endif // CHIP_DEVICE_CONFIG_ENABLE_WIFI
 
@@ -138,6 +138,21 @@ std::string GetFullType(const char * type, DnssdServiceProtocol protocol)
     return typeBuilder.str();
 }
 
+// Avahi reports one browse result per interface and protocol a service is seen on, all sharing this prefix.
+std::string GetBrowseKeyPrefix(const char * name, const char * type)
+{
+    std::ostringstream keyBuilder;
+    keyBuilder << name << "." << type << "%";
+    return keyBuilder.str();
+}
+
+std::string GetBrowseKey(const char * name, const char * type, AvahiIfIndex interface, AvahiProtocol protocol)
+{
+    std::ostringstream keyBuilder;
+    keyBuilder << GetBrowseKeyPrefix(name, type) << interface << "/" << protocol;
+    return keyBuilder.str();
+}
+
 } // namespace
 
 namespace chip {
@@ -160,6 +175,13 @@ Poller::Poller()
     mEarliestTimeout = std::chrono::steady_clock::time_point();
 }
 
+Poller::~Poller()
+{
+    // The poller lives as long as the process; anything Avahi did not free by now is simply dropped.
+    mWatches.ReleaseAll();
+    mTimers.ReleaseAll();
+}
+
 AvahiWatch * Poller::WatchNew(const struct AvahiPoll * poller, int fd, AvahiWatchEvent event, AvahiWatchCallback callback,
                               void * context)
 {
@@ -170,18 +192,19 @@ AvahiWatch * Poller::WatchNew(int fd, AvahiWatchEvent event, AvahiWatchCallback
 {
     VerifyOrDie(callback != nullptr && fd >= 0);
 
-    auto watch     = std::make_unique<AvahiWatch>();
+    AvahiWatch * watch = mWatches.CreateObject();
+    VerifyOrReturnValue(watch != nullptr, nullptr);
+
     watch->mSocket = fd;
     LogErrorOnFailure(DeviceLayer::SystemLayerSockets().StartWatchingSocket(fd, &watch->mSocketWatch));
     LogErrorOnFailure(DeviceLayer::SystemLayerSockets().SetCallback(watch->mSocketWatch, AvahiWatchCallbackTrampoline,
-                                                                    reinterpret_cast<intptr_t>(watch.get())));
-    WatchUpdate(watch.get(), event);
+                                                                    reinterpret_cast<intptr_t>(watch)));
+    WatchUpdate(watch, event);
     watch->mCallback = callback;
     watch->mContext  = context;
     watch->mPoller   = this;
-    mWatches.emplace_back(std::move(watch));
 
-    return mWatches.back().get();
+    return watch;
 }
 
 void Poller::WatchUpdate(AvahiWatch * watch, AvahiWatchEvent event)
@@ -217,9 +240,7 @@ void Poller::WatchFree(AvahiWatch * watch)
 void Poller::WatchFree(AvahiWatch & watch)
 {
     DeviceLayer::SystemLayerSockets().StopWatchingSocket(&watch.mSocketWatch);
-    mWatches.erase(std::remove_if(mWatches.begin(), mWatches.end(),
-                                  [&watch](const std::unique_ptr<AvahiWatch> & aValue) { return aValue.get() == &watch; }),
-                   mWatches.end());
+    mWatches.ReleaseObject(&watch);
 }
 
 AvahiTimeout * Poller::TimeoutNew(const AvahiPoll * poller, const struct timeval * timeout, AvahiTimeoutCallback callback,
@@ -246,9 +267,15 @@ steady_clock::time_point GetAbsTimeout(const struct timeval * timeout)
 
 AvahiTimeout * Poller::TimeoutNew(const struct timeval * timeout, AvahiTimeoutCallback callback, void * context)
 {
-    mTimers.emplace_back(new AvahiTimeout{ GetAbsTimeout(timeout), callback, timeout != nullptr, context, this });
-    AvahiTimeout * timer = mTimers.back().get();
-    SystemTimerUpdate(timer);
+    AvahiTimeout * timer = mTimers.CreateObject();
+    VerifyOrReturnValue(timer != nullptr, nullptr);
+
+    timer->mAbsTimeout = GetAbsTimeout(timeout);
+    timer->mCallback   = callback;
+    timer->mEnabled    = timeout != nullptr;
+    timer->mContext    = context;
+    timer->mPoller     = this;
+    SystemTimerUpdate(timer->mAbsTimeout);
     return timer;
 }
 
@@ -258,7 +285,7 @@ void Poller::TimeoutUpdate(AvahiTimeout * timer, const struct timeval * timeout)
     {
         timer->mAbsTimeout = GetAbsTimeout(timeout);
         timer->mEnabled    = true;
-        static_cast<Poller *>(timer->mPoller)->SystemTimerUpdate(timer);
+        static_cast<Poller *>(timer->mPoller)->SystemTimerUpdate(timer->mAbsTimeout);
     }
     else
     {
@@ -273,9 +300,7 @@ void Poller::TimeoutFree(AvahiTimeout * timer)
 
 void Poller::TimeoutFree(AvahiTimeout & timer)
 {
-    mTimers.erase(std::remove_if(mTimers.begin(), mTimers.end(),
-                                 [&timer](const std::unique_ptr<AvahiTimeout> & aValue) { return aValue.get() == &timer; }),
-                  mTimers.end());
+    mTimers.ReleaseObject(&timer);
 }
 
 void Poller::SystemTimerCallback(System::Layer * layer, void * data)
@@ -288,37 +313,39 @@ void Poller::HandleTimeout()
     mEarliestTimeout             = std::chrono::steady_clock::time_point();
     steady_clock::time_point now = steady_clock::now();
 
-    AvahiTimeout * earliest = nullptr;
-    for (auto && timer : mTimers)
-    {
+    // Callbacks may free their own or other timers, so only remember when the next one is due rather than which one it is.
+    steady_clock::time_point earliest;
+    mTimers.ForEachActiveObject([&](AvahiTimeout * timer) {
         if (!timer->mEnabled)
         {
-            continue;
+            return Loop::Continue;
         }
         if (timer->mAbsTimeout <= now)
         {
-            timer->mCallback(timer.get(), timer->mContext);
+            timer->mCallback(timer, timer->mContext);
         }
         else
         {
-            if ((earliest == nullptr) || (timer->mAbsTimeout < earliest->mAbsTimeout))
+            if ((earliest == steady_clock::time_point()) || (timer->mAbsTimeout < earliest))
             {
-                earliest = timer.get();
+                earliest = timer->mAbsTimeout;
             }
         }
-    }
-    if (earliest)
+        return Loop::Continue;
+    });
+    if (earliest != steady_clock::time_point())
     {
         SystemTimerUpdate(earliest);
     }
 }
 
-void Poller::SystemTimerUpdate(AvahiTimeout * timer)
+void Poller::SystemTimerUpdate(steady_clock::time_point absTimeout)
 {
-    if ((mEarliestTimeout == std::chrono::steady_clock::time_point()) || (timer->mAbsTimeout < mEarliestTimeout))
+    if ((mEarliestTimeout == std::chrono::steady_clock::time_point()) || (absTimeout < mEarliestTimeout))
     {
-        mEarliestTimeout = timer->mAbsTimeout;
-        auto delay       = std::chrono::duration_cast<chip::System::Clock::Milliseconds32>(steady_clock::now() - mEarliestTimeout);
+        mEarliestTimeout = absTimeout;
+        auto remaining   = mEarliestTimeout - steady_clock::now();
+        auto delay       = std::chrono::duration_cast<chip::System::Clock::Milliseconds32>(std::max(remaining, remaining.zero()));
         DeviceLayer::SystemLayer().StartTimer(delay, SystemTimerCallback, this);
     }
 }
@@ -720,8 +747,9 @@ void MdnsAvahi::HandleBrowse(AvahiServiceBrowser * browser, AvahiIfIndex interfa
         chip::Platform::Delete(context);
         break;
     case AVAHI_BROWSER_NEW:
-        ChipLogProgress(DeviceLayer, "Avahi browse: cache new");
-        if (strcmp("local", domain) == 0)
+        ChipLogDetail(DeviceLayer, "Avahi browse: cache new");
+        // Every retry re-browses from scratch, so only queue services that were not already reported.
+        if (strcmp("local", domain) == 0 && context->mKnownServices.insert(GetBrowseKey(name, type, interface, protocol)).second)
         {
             DnssdService service = {};
 
@@ -742,12 +770,14 @@ void MdnsAvahi::HandleBrowse(AvahiServiceBrowser * browser, AvahiIfIndex interfa
     case AVAHI_BROWSER_ALL_FOR_NOW: {
         ChipLogProgress(DeviceLayer, "Avahi browse: all for now");
         bool needRetries = context->mBrowseRetries++ < kMaxBrowseRetries && !context->mStopped.load();
-        // If we were already asked to stop, no need to send a callback - no one is listening.
-        if (!context->mStopped.load())
+        // If we were already asked to stop, no need to send a callback - no one is listening. Intermediate updates
+        // with nothing new to report are skipped.
+        if (!context->mStopped.load() && (!needRetries || !context->mServices.empty()))
         {
             context->mCallback(context->mContext, context->mServices.data(), context->mServices.size(), !needRetries,
                                CHIP_NO_ERROR);
         }
+        context->mServices.clear();
         avahi_service_browser_free(browser);
         if (needRetries)
         {
@@ -764,13 +794,23 @@ void MdnsAvahi::HandleBrowse(AvahiServiceBrowser * browser, AvahiIfIndex interfa
         break;
     }
     case AVAHI_BROWSER_REMOVE:
-        ChipLogProgress(DeviceLayer, "Avahi browse: remove");
+        ChipLogDetail(DeviceLayer, "Avahi browse: remove");
         if (strcmp("local", domain) == 0)
         {
-            context->mServices.erase(
-                std::remove_if(context->mServices.begin(), context->mServices.end(), [name, type](const DnssdService & service) {
-                    return strcmp(name, service.mName) == 0 && type == GetFullType(service.mType, service.mProtocol);
-                }));
+            // Forget the service on every interface; a later browse re-reports whichever ones are still around.
+            const std::string prefix = GetBrowseKeyPrefix(name, type);
+            for (auto it = context->mKnownServices.lower_bound(prefix);
+                 it != context->mKnownServices.end() && it->compare(0, prefix.size(), prefix) == 0;)
+            {
+                it = context->mKnownServices.erase(it);
+            }
+            context->mServices.erase(std::remove_if(context->mServices.begin(), context->mServices.end(),
+                                                    [name, type](const DnssdService & service) {
+                                                        return strcmp(name, service.mName) == 0 &&
+                                                            type == GetFullType(service.mType, service.mProtocol);
+                                                    }),
+                                     context->mServices.end());
+            context->mInstance->InvalidateCachedResolves(name, type);
         }
         break;
     case AVAHI_BROWSER_CACHE_EXHAUSTED:
@@ -839,9 +879,10 @@ CHIP_ERROR MdnsAvahi::Resolve(const char * name, const char * type, DnssdService
     AvahiIfIndex avahiInterface     = static_cast<AvahiIfIndex>(interface.GetPlatformInterface());
     ResolveContext * resolveContext = AllocateResolveContext();
     CHIP_ERROR error                = CHIP_NO_ERROR;
-    resolveContext->mInstance       = this;
-    resolveContext->mCallback       = callback;
-    resolveContext->mContext        = context;
+    VerifyOrReturnError(resolveContext != nullptr, CHIP_ERROR_NO_MEMORY);
+    resolveContext->mInstance = this;
+    resolveContext->mCallback = callback;
+    resolveContext->mContext  = context;
 
     if (!interface.IsPresent())
     {
@@ -854,6 +895,16 @@ CHIP_ERROR MdnsAvahi::Resolve(const char * name, const char * type, DnssdService
     resolveContext->mAddressType = ToAvahiProtocol(addressType);
     resolveContext->mFullType    = GetFullType(type, protocol);
 
+    // A recent answer for the same query is delivered from the cache, asynchronously like a real resolve would be.
+    if (FindCachedResolve(ResolveCacheKey(*resolveContext)) != nullptr)
+    {
+        error = DeviceLayer::SystemLayer().ScheduleWork(HandleCachedResolve, reinterpret_cast<void *>(resolveContext->mNumber));
+        if (error == CHIP_NO_ERROR)
+        {
+            return error;
+        }
+    }
+
     AvahiServiceResolver * resolver =
         avahi_service_resolver_new(mClient, avahiInterface, resolveContext->mTransport, name, resolveContext->mFullType.c_str(),
                                    nullptr, resolveContext->mAddressType, static_cast<AvahiLookupFlags>(0), HandleResolve,
@@ -861,12 +912,131 @@ CHIP_ERROR MdnsAvahi::Resolve(const char * name, const char * type, DnssdService
     // Otherwise the resolver will be freed in the callback
     if (resolver == nullptr)
     {
-        error = CHIP_ERROR_INTERNAL;
-        chip::Platform::Delete(resolveContext);
+        FreeResolveContext(resolveContext->mNumber);
+        return CHIP_ERROR_INTERNAL;
     }
     resolveContext->mResolver = resolver;
 
-    return error;
+    return CHIP_NO_ERROR;
+}
+
+std::string MdnsAvahi::ResolveCacheKey(const ResolveContext & context)
+{
+    // Shares its prefix with the browse keys so that a removed service can drop all of its cached answers.
+    std::ostringstream keyBuilder;
+    keyBuilder << GetBrowseKeyPrefix(context.mName, context.mFullType.c_str()) << context.mInterface << "/" << context.mTransport
+               << "/" << context.mAddressType;
+    return keyBuilder.str();
+}
+
+void MdnsAvahi::CacheResolveResult(const ResolveContext & context, const DnssdService & service, const Inet::IPAddress & address)
+{
+    const steady_clock::time_point now = steady_clock::now();
+    const auto ttl                     = std::chrono::milliseconds(CHIP_DEVICE_CONFIG_DNSSD_RESOLVE_CACHE_TTL_MS);
+    VerifyOrReturn(ttl.count() > 0);
+
+    if (mResolveCache.size() >= kMaxCachedResolves)
+    {
+        // Make room by dropping the entry closest to expiring.
+        auto oldest = std::min_element(mResolveCache.begin(), mResolveCache.end(), [](const auto & a, const auto & b) {
+            return a.second.mExpiry < b.second.mExpiry;
+        });
+        mResolveCache.erase(oldest);
+    }
+
+    CachedResolve & entry = mResolveCache[ResolveCacheKey(context)];
+    entry.mService        = service;
+    entry.mAddress        = address;
+    entry.mExpiry         = now + ttl;
+    entry.mTextRecords.clear();
+    for (size_t i = 0; i < service.mTextEntrySize; i++)
+    {
+        const TextEntry & text = service.mTextEntries[i];
+        std::vector<char> record(text.mKey, text.mKey + strlen(text.mKey) + 1);
+        record.insert(record.end(), text.mData, text.mData + text.mDataSize);
+        entry.mTextRecords.push_back(std::move(record));
+    }
+    entry.mService.mTextEntries   = nullptr;
+    entry.mService.mTextEntrySize = 0;
+}
+
+const MdnsAvahi::CachedResolve * MdnsAvahi::FindCachedResolve(const std::string & key)
+{
+    auto it = mResolveCache.find(key);
+    VerifyOrReturnValue(it != mResolveCache.end(), nullptr);
+
+    if (it->second.mExpiry <= steady_clock::now())
+    {
+        mResolveCache.erase(it);
+        return nullptr;
+    }
+
+    return &it->second;
+}
+
+void MdnsAvahi::InvalidateCachedResolves(const char * name, const char * fullType)
+{
+    const std::string prefix = GetBrowseKeyPrefix(name, fullType);
+    for (auto it = mResolveCache.lower_bound(prefix);
+         it != mResolveCache.end() && it->first.compare(0, prefix.size(), prefix) == 0;)
+    {
+        it = mResolveCache.erase(it);
+    }
+}
+
+void MdnsAvahi::InvalidateCachedResolves(const Inet::IPAddress & address)
+{
+    for (auto it = mResolveCache.begin(); it != mResolveCache.end();)
+    {
+        it = (it->second.mAddress == address) ? mResolveCache.erase(it) : std::next(it);
+    }
+}
+
+void MdnsAvahi::ReconfirmRecord(const Inet::IPAddress & address)
+{
+    InvalidateCachedResolves(address);
+}
+
+void MdnsAvahi::HandleCachedResolve(System::Layer * layer, void * appState)
+{
+    size_t handle            = reinterpret_cast<size_t>(appState);
+    ResolveContext * context = sInstance.ResolveContextForHandle(handle);
+
+    // The resolve may have been cancelled by StopResolve in the meantime.
+    VerifyOrReturn(context != nullptr);
+
+    const CachedResolve * cached = sInstance.FindCachedResolve(ResolveCacheKey(*context));
+    if (cached == nullptr)
+    {
+        // Expired or invalidated since the resolve was requested; ask avahi after all.
+        context->mResolver = avahi_service_resolver_new(
+            sInstance.mClient, context->mInterface, context->mTransport, context->mName, context->mFullType.c_str(), nullptr,
+            context->mAddressType, static_cast<AvahiLookupFlags>(0), HandleResolve, reinterpret_cast<void *>(handle));
+        if (context->mResolver == nullptr)
+        {
+            context->mCallback(context->mContext, nullptr, Span<Inet::IPAddress>(), CHIP_ERROR_INTERNAL);
+            sInstance.FreeResolveContext(handle);
+        }
+        return;
+    }
+
+    DnssdService result     = cached->mService;
+    Inet::IPAddress address = cached->mAddress;
+    std::vector<TextEntry> textEntries;
+    for (const auto & record : cached->mTextRecords)
+    {
+        size_t keyLength = strlen(record.data());
+        textEntries.push_back(TextEntry{ record.data(), reinterpret_cast<const uint8_t *>(record.data() + keyLength + 1),
+                                         record.size() - keyLength - 1 });
+    }
+    if (!textEntries.empty())
+    {
+        result.mTextEntries = textEntries.data();
+    }
+    result.mTextEntrySize = textEntries.size();
+
+    context->mCallback(context->mContext, &result, Span<Inet::IPAddress>(&address, 1), CHIP_NO_ERROR);
+    sInstance.FreeResolveContext(handle);
 }
 
 void MdnsAvahi::HandleResolve(AvahiServiceResolver * resolver, AvahiIfIndex interface, AvahiProtocol protocol,
@@ -893,7 +1063,7 @@ void MdnsAvahi::HandleResolve(AvahiServiceResolver * resolver, AvahiIfIndex inte
             avahi_service_resolver_free(resolver);
             context->mResolver = avahi_service_resolver_new(
                 context->mInstance->mClient, context->mInterface, context->mTransport, context->mName, context->mFullType.c_str(),
-                nullptr, context->mAddressType, static_cast<AvahiLookupFlags>(0), HandleResolve, context);
+                nullptr, context->mAddressType, static_cast<AvahiLookupFlags>(0), HandleResolve, reinterpret_cast<void *>(handle));
             if (context->mResolver == nullptr)
             {
                 ChipLogError(DeviceLayer, "Avahi resolve failed on retry");
@@ -903,6 +1073,7 @@ void MdnsAvahi::HandleResolve(AvahiServiceResolver * resolver, AvahiIfIndex inte
             return;
         }
         ChipLogError(DeviceLayer, "Avahi resolve failed");
+        sInstance.mResolveCache.erase(ResolveCacheKey(*context));
         context->mCallback(context->mContext, nullptr, Span<Inet::IPAddress>(), CHIP_ERROR_INTERNAL);
         break;
     case AVAHI_RESOLVER_FOUND:
@@ -981,6 +1152,7 @@ void MdnsAvahi::HandleResolve(AvahiServiceResolver * resolver, AvahiIfIndex inte
 
         if (result_err == CHIP_NO_ERROR)
         {
+            sInstance.CacheResolveResult(*context, result, ipAddress);
             context->mCallback(context->mContext, &result, Span<Inet::IPAddress>(&ipAddress, 1), CHIP_NO_ERROR);
         }
         else
@@ -1054,6 +1226,8 @@ void ChipDnssdResolveNoLongerNeeded(const char * instanceName)
 
 CHIP_ERROR ChipDnssdReconfirmRecord(const char * hostname, chip::Inet::IPAddress address, chip::Inet::InterfaceId interface)
 {
+    // Avahi has no way to reconfirm a record, but at least stop handing out our own cached answers for the address.
+    MdnsAvahi::GetInstance().ReconfirmRecord(address);
     return CHIP_ERROR_NOT_IMPLEMENTED;
 }
 
@@ -25,6 +25,7 @@
 #include <list>
 #include <map>
 #include <memory>
+#include <set>
 #include <string>
 #include <vector>
 
@@ -36,6 +37,7 @@
 #include <avahi-common/watch.h>
 
 #include "lib/dnssd/platform/Dnssd.h"
+#include <lib/support/Pool.h>
 
 struct AvahiWatch
 {
@@ -63,6 +65,7 @@ class Poller
 {
 public:
     Poller(void);
+    ~Poller();
 
     void HandleTimeout();
 
@@ -89,11 +92,13 @@ private:
     static void TimeoutFree(AvahiTimeout * timer);
     void TimeoutFree(AvahiTimeout & timer);
 
-    void SystemTimerUpdate(AvahiTimeout * timer);
+    void SystemTimerUpdate(std::chrono::steady_clock::time_point absTimeout);
     static void SystemTimerCallback(System::Layer * layer, void * data);
 
-    std::vector<std::unique_ptr<AvahiWatch>> mWatches;
-    std::vector<std::unique_ptr<AvahiTimeout>> mTimers;
+    // Avahi creates and frees watches and timeouts for every browse and resolve, so recycle them through pools rather than
+    // going back to the allocator each time. Pools also tolerate frees from within the timeout callbacks.
+    HeapObjectPool<AvahiWatch> mWatches;
+    HeapObjectPool<AvahiTimeout> mTimers;
     std::chrono::steady_clock::time_point mEarliestTimeout;
 
     AvahiPoll mAvahiPoller;
@@ -117,6 +122,7 @@ public:
                        chip::Inet::IPAddressType transportType, chip::Inet::InterfaceId interface, DnssdResolveCallback callback,
                        void * context);
     void StopResolve(const char * name);
+    void ReconfirmRecord(const Inet::IPAddress & address);
 
     Poller & GetPoller() { return mPoller; }
 
@@ -129,7 +135,10 @@ private:
         DnssdBrowseCallback mCallback;
         void * mContext;
         Inet::IPAddressType mAddressType;
+        // Services found since the last update delivered to mCallback.
         std::vector<DnssdService> mServices;
+        // Keys of every service reported so far, so that re-browses only report what is new.
+        std::set<std::string> mKnownServices;
         size_t mBrowseRetries;
         AvahiIfIndex mInterface;
         std::string mProtocol;
@@ -161,6 +170,15 @@ private:
         }
     };
 
+    struct CachedResolve
+    {
+        DnssdService mService;
+        // Backing storage for the TXT entries of mService, each stored as key, NUL, value.
+        std::vector<std::vector<char>> mTextRecords;
+        Inet::IPAddress mAddress;
+        std::chrono::steady_clock::time_point mExpiry;
+    };
+
     MdnsAvahi() : mClient(nullptr) {}
     static MdnsAvahi sInstance;
 
@@ -171,6 +189,13 @@ private:
     void FreeResolveContext(size_t handle);
     void FreeResolveContext(const char * name);
 
+    static std::string ResolveCacheKey(const ResolveContext & context);
+    void CacheResolveResult(const ResolveContext & context, const DnssdService & service, const Inet::IPAddress & address);
+    const CachedResolve * FindCachedResolve(const std::string & key);
+    void InvalidateCachedResolves(const char * name, const char * fullType);
+    void InvalidateCachedResolves(const Inet::IPAddress & address);
+    static void HandleCachedResolve(System::Layer * layer, void * appState);
+
     static void HandleClientState(AvahiClient * client, AvahiClientState state, void * context);
     void HandleClientState(AvahiClient * client, AvahiClientState state);
 
@@ -198,6 +223,10 @@ private:
     // Handling of allocated resolves
     size_t mResolveCount = 0;
     std::list<ResolveContext *> mAllocatedResolves;
+
+    // Recently resolved services, keyed by ResolveCacheKey()
+    static constexpr size_t kMaxCachedResolves = 32;
+    std::map<std::string, CachedResolve> mResolveCache;
 };
 
 } // namespace Dnssd
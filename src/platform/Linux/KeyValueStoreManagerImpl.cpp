@@ -83,6 +83,12 @@ CHIP_ERROR KeyValueStoreManagerImpl::_Put(const char * key, const void * value,
     err = mStorage.WriteValueBin(key, reinterpret_cast<const uint8_t *>(value), value_size);
     SuccessOrExit(err);
 
+    if (mInTransaction)
+    {
+        mTransactionChanged = true;
+        ExitNow();
+    }
+
     // Commit the value to the persistent store.
     err = mStorage.Commit();
     SuccessOrExit(err);
@@ -102,6 +108,12 @@ CHIP_ERROR KeyValueStoreManagerImpl::_Delete(const char * key)
     }
     SuccessOrExit(err);
 
+    if (mInTransaction)
+    {
+        mTransactionChanged = true;
+        ExitNow();
+    }
+
     // Commit the value to the persistent store.
     err = mStorage.Commit();
     SuccessOrExit(err);
@@ -110,6 +122,50 @@ exit:
     return err;
 }
 
+CHIP_ERROR KeyValueStoreManagerImpl::_BeginTransaction()
+{
+    VerifyOrReturnError(!mInTransaction, CHIP_ERROR_INCORRECT_STATE);
+
+    mInTransaction      = true;
+    mTransactionChanged = false;
+    return CHIP_NO_ERROR;
+}
+
+CHIP_ERROR KeyValueStoreManagerImpl::_CommitTransaction()
+{
+    VerifyOrReturnError(mInTransaction, CHIP_ERROR_INCORRECT_STATE);
+
+    mInTransaction = false;
+    VerifyOrReturnError(mTransactionChanged, CHIP_NO_ERROR);
+
+    // The whole file is replaced atomically, so either all of the transaction's changes are persisted or none are.
+    CHIP_ERROR err = mStorage.Commit();
+    if (err != CHIP_NO_ERROR)
+    {
+        ChipLogError(DeviceLayer, "KVS transaction commit failed: %" CHIP_ERROR_FORMAT, err.Format());
+        // Keep the in-memory state in line with the file.
+        (void) mStorage.Reload();
+        err = CHIP_ERROR_PERSISTED_STORAGE_FAILED;
+    }
+    return err;
+}
+
+void KeyValueStoreManagerImpl::_AbortTransaction()
+{
+    VerifyOrReturn(mInTransaction);
+
+    mInTransaction = false;
+    if (mTransactionChanged)
+    {
+        // Nothing is written to the file during a transaction, so it still holds the state from before it.
+        CHIP_ERROR err = mStorage.Reload();
+        if (err != CHIP_NO_ERROR)
+        {
+            ChipLogError(DeviceLayer, "KVS transaction abort failed to reload: %" CHIP_ERROR_FORMAT, err.Format());
+        }
+    }
+}
+
 } // namespace PersistedStorage
 } // namespace DeviceLayer
 } // namespace chip
@@ -42,9 +42,17 @@ public:
     CHIP_ERROR _Delete(const char * key);
     CHIP_ERROR _Put(const char * key, const void * value, size_t value_size);
 
+    // Changes made during a transaction are only written to the file, in one go, when it is committed.
+    CHIP_ERROR _BeginTransaction();
+    CHIP_ERROR _CommitTransaction();
+    void _AbortTransaction();
+
 private:
     DeviceLayer::Internal::ChipLinuxStorage mStorage;
 
+    bool mInTransaction      = false;
+    bool mTransactionChanged = false;
+
     // ===== Members for internal use by the following friends.
     friend KeyValueStoreManager & KeyValueStoreMgr();
     friend KeyValueStoreManagerImpl & KeyValueStoreMgrImpl();
@@ -3,6 +3,7 @@
 #include <lib/core/CHIPConfig.h>
 #include <lib/support/EnforceFormat.h>
 #include <lib/support/logging/Constants.h>
+#include <platform/CHIPDeviceConfig.h>
 #include <platform/logging/LogV.h>
 
 #include <cinttypes>
@@ -16,6 +17,21 @@
 #include <pw_log/log.h>
 #endif // CHIP_USE_PW_LOGGING
 
+#if CHIP_DEVICE_CONFIG_ASYNC_LOGGING && !CHIP_USE_PW_LOGGING && !defined(__NuttX__)
+#define CHIP_LINUX_ASYNC_LOGGING 1
+#else
+#define CHIP_LINUX_ASYNC_LOGGING 0
+#endif
+
+#if CHIP_LINUX_ASYNC_LOGGING
+#include <lib/support/CodeUtils.h>
+#include <platform/Linux/AsyncLogWriter.h>
+
+#include <csignal>
+#include <cstdlib>
+#include <pthread.h>
+#endif // CHIP_LINUX_ASYNC_LOGGING
+
 namespace chip {
 namespace DeviceLayer {
 
@@ -32,11 +48,62 @@ void __attribute__((weak)) OnLogOutput() {}
 namespace Logging {
 namespace Platform {
 
+#if CHIP_LINUX_ASYNC_LOGGING
+namespace {
+
+using DeviceLayer::Internal::AsyncLogWriter;
+
+pthread_once_t sAsyncLogWriterStartOnce = PTHREAD_ONCE_INIT;
+struct sigaction sPreviousAbortAction;
+
+AsyncLogWriter & GetAsyncLogWriter()
+{
+    // Constructed on first use and never destroyed, so that logging from static initializers and destructors
+    // elsewhere is safe.
+    static AsyncLogWriter & sWriter = *new AsyncLogWriter(STDOUT_FILENO);
+    return sWriter;
+}
+
+void OnAbort(int signal)
+{
+    // chipDie, VerifyOrDie and failed assertions end up here: write out the lines logged right before them.
+    GetAsyncLogWriter().DrainForAbort();
+    sigaction(SIGABRT, &sPreviousAbortAction, nullptr);
+    raise(signal);
+}
+
+void StartAsyncLogWriter()
+{
+    VerifyOrReturn(GetAsyncLogWriter().Start() == CHIP_NO_ERROR);
+
+    // Write out whatever is still queued when the process exits normally.
+    atexit([] { GetAsyncLogWriter().Stop(); });
+
+    // And when it aborts.
+    struct sigaction action = {};
+    action.sa_handler       = OnAbort;
+    sigemptyset(&action.sa_mask);
+    sigaction(SIGABRT, &action, &sPreviousAbortAction);
+}
+
+} // namespace
+#endif // CHIP_LINUX_ASYNC_LOGGING
+
 /**
  * CHIP log output functions.
  */
 void ENFORCE_FORMAT(3, 0) LogV(const char * module, uint8_t category, const char * msg, va_list v)
 {
+#if CHIP_LINUX_ASYNC_LOGGING
+    pthread_once(&sAsyncLogWriterStartOnce, StartAsyncLogWriter);
+    if (GetAsyncLogWriter().Log(module, category, msg, v))
+    {
+        // Let the application know that a log message has been emitted.
+        DeviceLayer::OnLogOutput();
+        return;
+    }
+#endif // CHIP_LINUX_ASYNC_LOGGING
+
     struct timeval tv;
 
     // Should not fail per man page of gettimeofday(), but failed to get time is not a fatal error in log. The bad time value will
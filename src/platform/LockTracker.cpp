@@ -27,8 +27,22 @@ namespace chip {
 namespace Platform {
 namespace Internal {
 
+#if CHIP_IM_REPORT_BUILDER_THREADS > 0
+namespace {
+thread_local bool tChipStackLockShared = false;
+} // namespace
+
+void SetChipStackLockSharedWithCurrentThread(bool shared)
+{
+    tChipStackLockShared = shared;
+}
+#endif
+
 void AssertChipStackLockedByCurrentThread(const char * file, int line)
 {
+#if CHIP_IM_REPORT_BUILDER_THREADS > 0
+    VerifyOrReturn(!tChipStackLockShared);
+#endif
     if (!chip::DeviceLayer::PlatformMgr().IsChipStackLockedByCurrentThread())
     {
         ChipLogError(DeviceLayer, "Chip stack locking error at '%s:%d'. Code is unsafe/racy", StringOrNullMarker(file), line);
@@ -0,0 +1,263 @@
+/*
+ *
+ *    Copyright (c) 2023 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *      This file implements a unit test suite for the Linux asynchronous log writer.
+ *
+ */
+
+#include <lib/support/CodeUtils.h>
+#include <lib/support/UnitTestRegistration.h>
+#include <lib/support/UnitTestUtils.h>
+#include <lib/support/logging/Constants.h>
+#include <nlunit-test.h>
+#include <platform/Linux/AsyncLogWriter.h>
+
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <string>
+#include <thread>
+#include <unistd.h>
+#include <vector>
+
+using namespace chip;
+using namespace chip::DeviceLayer::Internal;
+using namespace chip::Logging;
+
+namespace {
+
+constexpr uint32_t kWaitForLineMs = 2000;
+
+/**
+ * An AsyncLogWriter writing to a temporary file, which the test reads back.
+ */
+class LogFile
+{
+public:
+    LogFile() : mFile(tmpfile()), mWriter(std::make_unique<AsyncLogWriter>(fileno(mFile))) {}
+    ~LogFile()
+    {
+        mWriter.reset();
+        fclose(mFile);
+    }
+
+    AsyncLogWriter & Writer() { return *mWriter; }
+
+    bool Log(uint8_t category, const char * msg, ...) ENFORCE_FORMAT(3, 4)
+    {
+        va_list v;
+        va_start(v, msg);
+        bool queued = mWriter->Log("TST", category, msg, v);
+        va_end(v);
+        return queued;
+    }
+
+    std::string Contents() const
+    {
+        std::string contents;
+        char buffer[1024];
+        ssize_t count;
+        for (off_t offset = 0; (count = pread(fileno(mFile), buffer, sizeof(buffer), offset)) > 0; offset += count)
+        {
+            contents.append(buffer, static_cast<size_t>(count));
+        }
+        return contents;
+    }
+
+    bool WaitForContents(const char * text) const
+    {
+        for (uint32_t waited = 0; waited < kWaitForLineMs; waited++)
+        {
+            if (Contents().find(text) != std::string::npos)
+            {
+                return true;
+            }
+            chip::test_utils::SleepMillis(1);
+        }
+        return false;
+    }
+
+private:
+    FILE * mFile;
+    std::unique_ptr<AsyncLogWriter> mWriter;
+};
+
+// Position of "CHIP:TST: <message>\n" in contents, or npos.
+size_t FindLine(const std::string & contents, const char * message)
+{
+    return contents.find(std::string("CHIP:TST: ") + message + "\n");
+}
+
+size_t CountLines(const std::string & contents)
+{
+    size_t count = 0;
+    for (char c : contents)
+    {
+        count += (c == '\n') ? 1 : 0;
+    }
+    return count;
+}
+
+// Sum of the counts reported by "N log lines dropped" notices, and the number of those notices.
+size_t CountDroppedLines(const std::string & contents, size_t & notices)
+{
+    size_t dropped = 0;
+    notices        = 0;
+    for (size_t pos = contents.find(" log lines dropped"); pos != std::string::npos;
+         pos        = contents.find(" log lines dropped", pos + 1))
+    {
+        size_t start = contents.rfind(' ', pos - 1) + 1;
+        dropped += strtoul(contents.c_str() + start, nullptr, 10);
+        notices++;
+    }
+    return dropped;
+}
+
+void TestNotStarted(nlTestSuite * inSuite, void * inContext)
+{
+    LogFile file;
+
+    // The caller has to write lines itself until the writer is started, and once it is stopped.
+    NL_TEST_ASSERT(inSuite, !file.Log(kLogCategory_Progress, "before start"));
+    file.Writer().Stop();
+
+    NL_TEST_ASSERT(inSuite, file.Writer().Start() == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, file.Writer().Start() == CHIP_ERROR_INCORRECT_STATE);
+    file.Writer().Stop();
+    NL_TEST_ASSERT(inSuite, !file.Log(kLogCategory_Progress, "after stop"));
+    NL_TEST_ASSERT(inSuite, file.Writer().Start() == CHIP_ERROR_INCORRECT_STATE);
+
+    NL_TEST_ASSERT(inSuite, file.Contents().empty());
+}
+
+void TestQueuedLinesAreWritten(nlTestSuite * inSuite, void * inContext)
+{
+    LogFile file;
+    NL_TEST_ASSERT(inSuite, file.Writer().Start() == CHIP_NO_ERROR);
+
+    NL_TEST_ASSERT(inSuite, file.Log(kLogCategory_Progress, "progress %d", 1));
+    NL_TEST_ASSERT(inSuite, file.Log(kLogCategory_Detail, "detail %d", 2));
+
+    // Written by the writer thread within a write interval, in order.
+    NL_TEST_ASSERT(inSuite, file.WaitForContents("detail 2"));
+    std::string contents = file.Contents();
+    NL_TEST_ASSERT(inSuite, FindLine(contents, "progress 1") != std::string::npos);
+    NL_TEST_ASSERT(inSuite, FindLine(contents, "progress 1") < FindLine(contents, "detail 2"));
+}
+
+void TestErrorLinesAreWrittenRightAway(nlTestSuite * inSuite, void * inContext)
+{
+    LogFile file;
+    NL_TEST_ASSERT(inSuite, file.Writer().Start() == CHIP_NO_ERROR);
+
+    NL_TEST_ASSERT(inSuite, file.Log(kLogCategory_Progress, "before error"));
+    NL_TEST_ASSERT(inSuite, file.Log(kLogCategory_Error, "error"));
+
+    // No waiting: the error line, and the lines queued before it, are out before Log returns.
+    std::string contents = file.Contents();
+    NL_TEST_ASSERT(inSuite, FindLine(contents, "error") != std::string::npos);
+    NL_TEST_ASSERT(inSuite, FindLine(contents, "before error") < FindLine(contents, "error"));
+}
+
+void TestDrainForAbort(nlTestSuite * inSuite, void * inContext)
+{
+    LogFile file;
+    NL_TEST_ASSERT(inSuite, file.Writer().Start() == CHIP_NO_ERROR);
+
+    for (int i = 0; i < 10; i++)
+    {
+        NL_TEST_ASSERT(inSuite, file.Log(kLogCategory_Progress, "line %d", i));
+    }
+    file.Writer().DrainForAbort();
+
+    // Whether or not the writer thread got to them first, every line is out once DrainForAbort returns.
+    std::string contents = file.Contents();
+    NL_TEST_ASSERT(inSuite, CountLines(contents) == 10);
+    NL_TEST_ASSERT(inSuite, FindLine(contents, "line 0") < FindLine(contents, "line 9"));
+}
+
+void TestStopWithConcurrentProducers(nlTestSuite * inSuite, void * inContext)
+{
+    constexpr size_t kThreadCount    = 4;
+    constexpr size_t kLinesPerThread = 2000;
+
+    LogFile file;
+    NL_TEST_ASSERT(inSuite, file.Writer().Start() == CHIP_NO_ERROR);
+
+    std::atomic<size_t> refused{ 0 };
+    std::atomic<bool> go{ false };
+    std::vector<std::thread> threads;
+    for (size_t t = 0; t < kThreadCount; t++)
+    {
+        threads.emplace_back([&file, &refused, &go, t] {
+            while (!go.load())
+            {
+            }
+            for (size_t i = 0; i < kLinesPerThread; i++)
+            {
+                if (!file.Log(kLogCategory_Progress, "thread %zu line %zu", t, i))
+                {
+                    refused++;
+                }
+            }
+        });
+    }
+
+    go.store(true);
+    chip::test_utils::SleepMillis(1);
+    file.Writer().Stop();
+    for (auto & thread : threads)
+    {
+        thread.join();
+    }
+
+    // Every line was written, reported as dropped, or refused so that the caller writes it: none is left queued.
+    std::string contents = file.Contents();
+    size_t notices;
+    size_t dropped = CountDroppedLines(contents, notices);
+    NL_TEST_ASSERT(inSuite, CountLines(contents) - notices + dropped + refused.load() == kThreadCount * kLinesPerThread);
+}
+
+} // namespace
+
+/**
+ *   Test Suite. It lists all the test functions.
+ */
+static const nlTest sTests[] = {
+
+    NL_TEST_DEF("Test AsyncLogWriter not started", TestNotStarted),
+    NL_TEST_DEF("Test AsyncLogWriter queued lines", TestQueuedLinesAreWritten),
+    NL_TEST_DEF("Test AsyncLogWriter error lines", TestErrorLinesAreWrittenRightAway),
+    NL_TEST_DEF("Test AsyncLogWriter drain for abort", TestDrainForAbort),
+    NL_TEST_DEF("Test AsyncLogWriter stop with concurrent producers", TestStopWithConcurrentProducers),
+
+    NL_TEST_SENTINEL()
+};
+
+int TestAsyncLogWriter()
+{
+    nlTestSuite theSuite = { "AsyncLogWriter tests", &sTests[0], nullptr, nullptr };
+
+    // Run test suite against one context.
+    nlTestRunner(&theSuite, nullptr);
+    return nlTestRunnerStats(&theSuite);
+}
+
+CHIP_REGISTER_TEST_SUITE(TestAsyncLogWriter)
@@ -28,6 +28,7 @@
 #include <stdlib.h>
 #include <string.h>
 
+#include <algorithm>
 #include <atomic>
 
 #include <lib/support/CHIPMem.h>
@@ -38,6 +39,10 @@
 
 #include <platform/CHIPDeviceLayer.h>
 
+#if CHIP_SYSTEM_CONFIG_POSIX_LOCKING
+#include <pthread.h>
+#endif // CHIP_SYSTEM_CONFIG_POSIX_LOCKING
+
 using namespace chip;
 using namespace chip::Logging;
 using namespace chip::Inet;
@@ -252,6 +257,101 @@ static void TestPlatformMgr_MockSystemLayer(nlTestSuite * inSuite, void * inCont
     DeviceLayer::SetSystemLayerForTesting(nullptr);
 }
 
+#if CHIP_SYSTEM_CONFIG_POSIX_LOCKING
+
+static constexpr size_t kEventProducerCount  = 8;
+static constexpr uint32_t kEventsPerProducer = 2000;
+
+struct EventProducer
+{
+    pthread_t mThread;
+    std::atomic<uint32_t> mPostFailures{ 0 };
+    // Only touched from the chip task.
+    uint32_t mDispatched = 0;
+    bool mInOrder        = true;
+};
+
+static std::atomic<uint32_t> sEventsDispatched;
+static uint64_t sEventLatencyTotalUs;
+static uint64_t sEventLatencyMaxUs;
+
+static void * ProduceEvents(void * context)
+{
+    EventProducer * producer = static_cast<EventProducer *>(context);
+
+    for (uint32_t i = 0; i < kEventsPerProducer; i++)
+    {
+        const uint64_t postedAt = System::SystemClock().GetMonotonicMicroseconds64().count();
+        CHIP_ERROR err          = DeviceLayer::SystemLayer().ScheduleLambda([producer, i, postedAt]() {
+            const uint64_t latency = System::SystemClock().GetMonotonicMicroseconds64().count() - postedAt;
+            sEventLatencyTotalUs += latency;
+            sEventLatencyMaxUs = std::max(sEventLatencyMaxUs, latency);
+            producer->mInOrder = producer->mInOrder && (producer->mDispatched == i);
+            producer->mDispatched++;
+            sEventsDispatched++;
+        });
+        if (err != CHIP_NO_ERROR)
+        {
+            producer->mPostFailures++;
+        }
+    }
+
+    return nullptr;
+}
+
+static void TestPlatformMgr_ContendedPostEvent(nlTestSuite * inSuite, void * inContext)
+{
+    constexpr uint32_t kTotalEvents = kEventProducerCount * kEventsPerProducer;
+    EventProducer producers[kEventProducerCount];
+
+    sEventsDispatched    = 0;
+    sEventLatencyTotalUs = 0;
+    sEventLatencyMaxUs   = 0;
+
+    CHIP_ERROR err = PlatformMgr().InitChipStack();
+    NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR);
+
+    err = PlatformMgr().StartEventLoopTask();
+    NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR);
+
+    // Many threads posting at once overrun the event ring, which exercises the overflow path as well.
+    const System::Clock::Microseconds64 start = System::SystemClock().GetMonotonicMicroseconds64();
+    for (auto & producer : producers)
+    {
+        NL_TEST_ASSERT(inSuite, pthread_create(&producer.mThread, nullptr, ProduceEvents, &producer) == 0);
+    }
+    for (auto & producer : producers)
+    {
+        NL_TEST_ASSERT(inSuite, pthread_join(producer.mThread, nullptr) == 0);
+    }
+
+    for (size_t t = 0; sEventsDispatched != kTotalEvents && t < 10000; t++)
+        chip::test_utils::SleepMillis(1);
+    const System::Clock::Microseconds64 elapsed = System::SystemClock().GetMonotonicMicroseconds64() - start;
+
+    err = PlatformMgr().StopEventLoopTask();
+    NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR);
+
+    NL_TEST_ASSERT(inSuite, sEventsDispatched == kTotalEvents);
+    for (auto & producer : producers)
+    {
+        NL_TEST_ASSERT(inSuite, producer.mPostFailures == 0);
+        NL_TEST_ASSERT(inSuite, producer.mDispatched == kEventsPerProducer);
+        NL_TEST_ASSERT(inSuite, producer.mInOrder);
+    }
+
+    ChipLogProgress(DeviceLayer,
+                    "%u events from %u threads in %" PRIu64 "us: post-to-dispatch latency mean %" PRIu64 "us, max %" PRIu64 "us",
+                    static_cast<unsigned>(kTotalEvents), static_cast<unsigned>(kEventProducerCount), elapsed.count(),
+                    sEventLatencyTotalUs / kTotalEvents, sEventLatencyMaxUs);
+
+    PlatformMgr().Shutdown();
+}
+
+#else // CHIP_SYSTEM_CONFIG_POSIX_LOCKING
+static void TestPlatformMgr_ContendedPostEvent(nlTestSuite * inSuite, void * inContext) {}
+#endif // CHIP_SYSTEM_CONFIG_POSIX_LOCKING
+
 /**
  *   Test Suite. It lists all the test functions.
  */
@@ -265,6 +365,7 @@ static const nlTest sTests[] = {
     NL_TEST_DEF("Test PlatformMgr::TryLockChipStack", TestPlatformMgr_TryLockChipStack),
     NL_TEST_DEF("Test PlatformMgr::AddEventHandler", TestPlatformMgr_AddEventHandler),
     NL_TEST_DEF("Test mock System::Layer", TestPlatformMgr_MockSystemLayer),
+    NL_TEST_DEF("Test PlatformMgr::PostEvent from many threads", TestPlatformMgr_ContendedPostEvent),
 
     NL_TEST_SENTINEL()
 };
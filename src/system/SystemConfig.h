@@ -430,6 +430,24 @@
 
 #endif /* !CHIP_SYSTEM_CONFIG_USE_LWIP */
 
+/**
+ *  @def CHIP_SYSTEM_CONFIG_MAX_LARGE_BUFFER_SIZE_BYTES
+ *
+ *  @brief
+ *      The maximum size an application can use with a large \c PacketBuffer, as allocated by
+ *      \c PacketBufferHandle::NewLarge(). Large buffers hold messages that do not fit in a regular packet buffer, such as
+ *      large messages received over TCP.
+ *
+ *  @note
+ *      Large buffers are only available when packet buffers are allocated from the heap; on other platforms, and when this
+ *      value is no greater than \c CHIP_SYSTEM_CONFIG_PACKETBUFFER_CAPACITY_MAX, large buffers are limited to the size of a
+ *      regular packet buffer. Since packet buffer lengths are 16-bit, the value plus the size of the \c PacketBuffer
+ *      structure must fit in a uint16_t.
+ */
+#ifndef CHIP_SYSTEM_CONFIG_MAX_LARGE_BUFFER_SIZE_BYTES
+#define CHIP_SYSTEM_CONFIG_MAX_LARGE_BUFFER_SIZE_BYTES 64000
+#endif /* CHIP_SYSTEM_CONFIG_MAX_LARGE_BUFFER_SIZE_BYTES */
+
 /**
  *  @def CHIP_SYSTEM_CONFIG_EVENT_TYPE
  *
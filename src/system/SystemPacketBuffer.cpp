@@ -475,6 +475,16 @@ void PacketBuffer::AddRef()
 }
 
 PacketBufferHandle PacketBufferHandle::New(size_t aAvailableSize, uint16_t aReservedSize)
+{
+    return Allocate(aAvailableSize, aReservedSize, PacketBuffer::kMaxSizeWithoutReserve);
+}
+
+PacketBufferHandle PacketBufferHandle::NewLarge(size_t aAvailableSize)
+{
+    return Allocate(aAvailableSize, 0, PacketBuffer::kLargeBufMaxSizeWithoutReserve);
+}
+
+PacketBufferHandle PacketBufferHandle::Allocate(size_t aAvailableSize, uint16_t aReservedSize, size_t aMaxAllocSize)
 {
     // Adding three 16-bit-int sized numbers together will never overflow
     // assuming int is at least 32 bits.
@@ -483,6 +493,8 @@ PacketBufferHandle PacketBufferHandle::New(size_t aAvailableSize, uint16_t aRese
     static_assert(PacketBuffer::kStructureSize < UINT16_MAX, "Check for overflow more carefully");
     static_assert(SIZE_MAX >= INT_MAX, "Our additions might not fit in size_t");
     static_assert(PacketBuffer::kMaxSizeWithoutReserve <= UINT16_MAX, "PacketBuffer may have size not fitting uint16_t");
+    static_assert(PacketBuffer::kStructureSize + PacketBuffer::kLargeBufMaxSizeWithoutReserve <= UINT16_MAX,
+                  "Large PacketBuffer may have block size not fitting uint16_t");
 
     // When `aAvailableSize` fits in uint16_t (as tested below) and size_t is at least 32 bits (as asserted above),
     // these additions will not overflow.
@@ -492,7 +504,7 @@ PacketBufferHandle PacketBufferHandle::New(size_t aAvailableSize, uint16_t aRese
 
     CHIP_SYSTEM_FAULT_INJECT(FaultInjection::kFault_PacketBufferNew, return PacketBufferHandle());
 
-    if (aAvailableSize > UINT16_MAX || lAllocSize > PacketBuffer::kMaxSizeWithoutReserve || lBlockSize > UINT16_MAX)
+    if (aAvailableSize > UINT16_MAX || lAllocSize > aMaxAllocSize || lBlockSize > UINT16_MAX)
     {
         ChipLogError(chipSystemLayer, "PacketBuffer: allocation too large.");
         return PacketBufferHandle();
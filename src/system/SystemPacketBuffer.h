@@ -140,6 +140,18 @@ public:
      */
     static constexpr uint16_t kMaxSize = kMaxSizeWithoutReserve - kDefaultHeaderReserve;
 
+    /**
+     * The maximum size large buffer an application can allocate with no protocol header reserve, using
+     * \c PacketBufferHandle::NewLarge().
+     */
+#if CHIP_SYSTEM_PACKETBUFFER_FROM_CHIP_HEAP
+    static constexpr uint16_t kLargeBufMaxSizeWithoutReserve =
+        (CHIP_SYSTEM_CONFIG_MAX_LARGE_BUFFER_SIZE_BYTES > kMaxSizeWithoutReserve) ? CHIP_SYSTEM_CONFIG_MAX_LARGE_BUFFER_SIZE_BYTES
+                                                                                  : kMaxSizeWithoutReserve;
+#else
+    static constexpr uint16_t kLargeBufMaxSizeWithoutReserve = kMaxSizeWithoutReserve;
+#endif
+
     /**
      * Return the size of the allocation including the reserved and payload data spaces but not including space
      * allocated for the PacketBuffer structure.
@@ -620,6 +632,18 @@ public:
      */
     static PacketBufferHandle New(size_t aAvailableSize, uint16_t aReservedSize = PacketBuffer::kDefaultHeaderReserve);
 
+    /**
+     * Allocates a packet buffer that may be larger than a regular packet buffer, with no protocol header reserve.
+     *
+     *  Behaves like \c New(), except that the size requested is guaranteed not to be too large when it is no greater than
+     *  \c PacketBuffer::kLargeBufMaxSizeWithoutReserve.
+     *
+     *  @param[in]  aAvailableSize  Minimum number of octets to for application data (at `Start()`).
+     *
+     *  @return     On success, a PacketBufferHandle to the allocated buffer. On fail, \c nullptr.
+     */
+    static PacketBufferHandle NewLarge(size_t aAvailableSize);
+
     /**
      * Allocates a packet buffer with initial contents.
      *
@@ -676,6 +700,8 @@ private:
     // The caller's ownership is transferred to this.
     explicit PacketBufferHandle(PacketBuffer * buffer) : mBuffer(buffer) {}
 
+    static PacketBufferHandle Allocate(size_t aAvailableSize, uint16_t aReservedSize, size_t aMaxAllocSize);
+
     static PacketBufferHandle Hold(PacketBuffer * buffer)
     {
         if (buffer != nullptr)
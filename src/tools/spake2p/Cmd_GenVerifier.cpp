@@ -34,12 +34,21 @@
 
 #include <CHIPVersion.h>
 #include <crypto/CHIPCryptoPAL.h>
+#include <crypto/CryptoBuildConfig.h>
 #include <lib/support/Base64.h>
 #include <lib/support/CHIPArgParser.hpp>
 #include <lib/support/CHIPMem.h>
 #include <protocols/secure_channel/PASESession.h>
+#include <setup_payload/ManualSetupPayloadGenerator.h>
+#include <setup_payload/QRCodeSetupPayloadGenerator.h>
 #include <setup_payload/SetupPayload.h>
 
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
+
 namespace {
 
 using namespace chip::ArgParser;
@@ -58,6 +67,11 @@ OptionDef gCmdOptionDefs[] =
     { "salt-len",        kArgumentRequired, 'l' },
     { "salt",            kArgumentRequired, 's' },
     { "out",             kArgumentRequired, 'o' },
+    { "threads",         kArgumentRequired, 't' },
+    { "vendor-id",       kArgumentRequired, 'V' },
+    { "product-id",      kArgumentRequired, 'P' },
+    { "discriminator",   kArgumentRequired, 'd' },
+    { "rendezvous",      kArgumentRequired, 'r' },
     { }
 };
 
@@ -127,6 +141,30 @@ const char * const gCmdOptionHelp =
     "           index of the parameter set in the list,'pin-code','iteration-count','salt'(Base-64 encoded),'verifier'(Base-64 encoded)\n"
     "           ....\n"
     "\n"
+    "   -t, --threads <int>\n"
+    "\n"
+    "       The number of threads computing verifiers in parallel, up to 1024. Specify 0 to use one thread\n"
+    "       per CPU core. If not specified, one thread will be used. The output is the same whatever the\n"
+    "       thread count. A generation rate summary is printed to stderr when done.\n"
+    "\n"
+    "   -V, --vendor-id <int>\n"
+    "   -P, --product-id <int>\n"
+    "\n"
+    "       The Vendor ID and Product ID of the devices, in decimal or 0x-prefixed hexadecimal. When both are\n"
+    "       specified, the onboarding payload of each parameter set is generated as well, and the output file\n"
+    "       gets three more columns:\n"
+    "           Discriminator,QR Code,Manual Code\n"
+    "\n"
+    "   -d, --discriminator <int>\n"
+    "\n"
+    "       The 12-bit discriminator used in the onboarding payloads, in range [0..4095]. If not specified,\n"
+    "       each parameter set gets a random discriminator.\n"
+    "\n"
+    "   -r, --rendezvous <int>\n"
+    "\n"
+    "       The discovery capabilities bitmask used in the QR codes: 1 for SoftAP, 2 for BLE, 4 for on-network.\n"
+    "       If not specified, 2 (BLE) will be used.\n"
+    "\n"
     ;
 
 OptionSet gCmdOptions =
@@ -160,6 +198,29 @@ uint8_t gSaltDecodedLen   = 0;
 uint8_t gSaltLen          = 0;
 const char * gOutFileName = nullptr;
 FILE * gPinCodeFile       = nullptr;
+uint32_t gThreadCount     = 1;
+uint16_t gVendorId        = 0;
+uint16_t gProductId       = 0;
+bool gHasVendorId         = false;
+bool gHasProductId        = false;
+bool gGeneratePayloads    = false;
+uint16_t gDiscriminator   = 0;
+bool gHasDiscriminator    = false;
+uint8_t gRendezvous       = static_cast<uint8_t>(chip::RendezvousInformationFlag::kBLE);
+
+constexpr uint32_t kMaxThreadCount = 1024;
+
+// Verifiers are computed in batches of this many per thread, then written out in order.
+constexpr uint32_t kVerifiersPerThreadBatch = 64;
+
+struct VerifierJob
+{
+    uint32_t mPinCode;
+    uint8_t mSalt[chip::kSpake2p_Max_PBKDF_Salt_Length];
+    uint16_t mDiscriminator;
+    chip::Spake2pVerifierSerialized mVerifier;
+    CHIP_ERROR mError;
+};
 
 static uint32_t GetNextPinCode()
 {
@@ -264,6 +325,49 @@ bool HandleOption(const char * progName, OptionSet * optSet, int id, const char
         gOutFileName = arg;
         break;
 
+    case 't':
+        if (!ParseInt(arg, gThreadCount) || gThreadCount > kMaxThreadCount)
+        {
+            PrintArgError("%s: Invalid value specified for thread count: %s\n", progName, arg);
+            return false;
+        }
+        break;
+
+    case 'V':
+        if (!ParseInt(arg, gVendorId, 0))
+        {
+            PrintArgError("%s: Invalid value specified for Vendor ID: %s\n", progName, arg);
+            return false;
+        }
+        gHasVendorId = true;
+        break;
+
+    case 'P':
+        if (!ParseInt(arg, gProductId, 0))
+        {
+            PrintArgError("%s: Invalid value specified for Product ID: %s\n", progName, arg);
+            return false;
+        }
+        gHasProductId = true;
+        break;
+
+    case 'd':
+        if (!ParseInt(arg, gDiscriminator) || gDiscriminator >= (1 << chip::kPayloadDiscriminatorFieldLengthInBits))
+        {
+            PrintArgError("%s: Invalid value specified for discriminator: %s\n", progName, arg);
+            return false;
+        }
+        gHasDiscriminator = true;
+        break;
+
+    case 'r':
+        if (!ParseInt(arg, gRendezvous) || gRendezvous == 0 || gRendezvous > 7)
+        {
+            PrintArgError("%s: Invalid value specified for rendezvous: %s\n", progName, arg);
+            return false;
+        }
+        break;
+
     default:
         PrintArgError("%s: Unhandled option: %s\n", progName, name);
         return false;
@@ -272,6 +376,170 @@ bool HandleOption(const char * progName, OptionSet * optSet, int id, const char
     return true;
 }
 
+// Picks the PIN code and salt of the next parameter set. The PIN code file and the DRBG are only used from here, on
+// the main thread, so that the set generated for a given index does not depend on the thread count.
+bool PrepareJob(VerifierJob & job)
+{
+    while (gPinCode == chip::kSetupPINCodeUndefinedValue)
+    {
+        CHIP_ERROR err = chip::Crypto::DRBG_get_bytes(reinterpret_cast<uint8_t *>(&gPinCode), sizeof(gPinCode));
+        if (err != CHIP_NO_ERROR)
+        {
+            fprintf(stderr, "DRBG_get_bytes() failed.\n");
+            return false;
+        }
+
+        // Passcodes shall be restricted to the values 00000001 to 99999998 in decimal, see 5.1.1.6
+        gPinCode = (gPinCode % chip::kSetupPINCodeMaximumValue) + 1;
+        if (!chip::SetupPayload::IsValidSetupPIN(gPinCode))
+        {
+            gPinCode = chip::kSetupPINCodeUndefinedValue;
+        }
+    }
+    job.mPinCode = gPinCode;
+
+    if (gSaltDecodedLen == 0)
+    {
+        CHIP_ERROR err = chip::Crypto::DRBG_get_bytes(job.mSalt, gSaltLen);
+        if (err != CHIP_NO_ERROR)
+        {
+            fprintf(stderr, "DRBG_get_bytes() failed.\n");
+            return false;
+        }
+    }
+    else
+    {
+        memcpy(job.mSalt, gSalt, gSaltLen);
+    }
+
+    job.mDiscriminator = gDiscriminator;
+    if (gGeneratePayloads && !gHasDiscriminator)
+    {
+        CHIP_ERROR err = chip::Crypto::DRBG_get_bytes(reinterpret_cast<uint8_t *>(&job.mDiscriminator), sizeof(job.mDiscriminator));
+        if (err != CHIP_NO_ERROR)
+        {
+            fprintf(stderr, "DRBG_get_bytes() failed.\n");
+            return false;
+        }
+        job.mDiscriminator = static_cast<uint16_t>(job.mDiscriminator & ((1 << chip::kPayloadDiscriminatorFieldLengthInBits) - 1));
+    }
+
+    // If the file with PIN codes is not provided, the PIN code on next iteration will be randomly generated.
+    gPinCode = GetNextPinCode();
+    // On the next iteration the Salt will be randomly generated.
+    gSaltDecodedLen = 0;
+
+    return true;
+}
+
+void ComputeVerifier(VerifierJob & job)
+{
+    chip::Spake2pVerifier verifier;
+    job.mError = chip::PASESession::GeneratePASEVerifier(verifier, gIterationCount, chip::ByteSpan(job.mSalt, gSaltLen),
+                                                         false, job.mPinCode);
+    if (job.mError == CHIP_NO_ERROR)
+    {
+        chip::MutableByteSpan serializedVerifierSpan(job.mVerifier);
+        job.mError = verifier.Serialize(serializedVerifierSpan);
+    }
+}
+
+// PBKDF2 dominates the cost of each set, and sets are independent, so they are simply spread over the threads.
+void ComputeVerifiers(std::vector<VerifierJob> & jobs, uint32_t threadCount)
+{
+    std::atomic<size_t> nextJob{ 0 };
+    auto worker = [&jobs, &nextJob]() {
+        for (size_t i = nextJob++; i < jobs.size(); i = nextJob++)
+        {
+            ComputeVerifier(jobs[i]);
+        }
+    };
+
+    std::vector<std::thread> threads;
+    for (uint32_t i = 1; i < threadCount; i++)
+    {
+        threads.emplace_back(worker);
+    }
+    worker();
+    for (auto & thread : threads)
+    {
+        thread.join();
+    }
+}
+
+// The onboarding payloads are cheap to encode next to the verifier, so they are generated as the set is written out.
+bool WritePayloads(FILE * outFile, const VerifierJob & job)
+{
+    chip::PayloadContents payload;
+    payload.vendorID     = gVendorId;
+    payload.productID    = gProductId;
+    payload.setUpPINCode = job.mPinCode;
+    payload.discriminator.SetLongValue(job.mDiscriminator);
+    payload.rendezvousInformation.SetValue(chip::RendezvousInformationFlags(gRendezvous));
+
+    char qrCode[chip::QRCodeBasicSetupPayloadGenerator::kMaxQRCodeBase38RepresentationLength + 1];
+    chip::MutableCharSpan qrCodeSpan(qrCode);
+    CHIP_ERROR err = chip::QRCodeBasicSetupPayloadGenerator(payload).payloadBase38Representation(qrCodeSpan);
+    if (err != CHIP_NO_ERROR)
+    {
+        fprintf(stderr, "Generating the QR code failed: %" CHIP_ERROR_FORMAT "\n", err.Format());
+        return false;
+    }
+
+    char manualCode[chip::kManualSetupLongCodeCharLength + 1];
+    chip::MutableCharSpan manualCodeSpan(manualCode);
+    err = chip::ManualSetupPayloadGenerator(payload).payloadDecimalStringRepresentation(manualCodeSpan);
+    if (err != CHIP_NO_ERROR)
+    {
+        fprintf(stderr, "Generating the manual pairing code failed: %" CHIP_ERROR_FORMAT "\n", err.Format());
+        return false;
+    }
+
+    if (fprintf(outFile, ",%u,%s,%s", job.mDiscriminator, qrCode, manualCode) < 0 || ferror(outFile))
+    {
+        fprintf(stderr, "Error writing to output file: %s\n", strerror(errno));
+        return false;
+    }
+
+    return true;
+}
+
+bool WriteJob(FILE * outFile, uint32_t index, const VerifierJob & job)
+{
+    if (job.mError != CHIP_NO_ERROR)
+    {
+        fprintf(stderr, "GeneratePASEVerifier() failed: %" CHIP_ERROR_FORMAT "\n", job.mError.Format());
+        return false;
+    }
+
+    char saltB64[BASE64_ENCODED_LEN(chip::kSpake2p_Max_PBKDF_Salt_Length) + 1];
+    uint32_t saltB64Len = chip::Base64Encode32(job.mSalt, gSaltLen, saltB64);
+    saltB64[saltB64Len] = '\0';
+
+    char verifierB64[BASE64_ENCODED_LEN(chip::kSpake2p_VerifierSerialized_Length) + 1];
+    uint32_t verifierB64Len     = chip::Base64Encode32(job.mVerifier, chip::kSpake2p_VerifierSerialized_Length, verifierB64);
+    verifierB64[verifierB64Len] = '\0';
+
+    if (fprintf(outFile, "%d,%08d,%d,%s,%s", index, job.mPinCode, gIterationCount, saltB64, verifierB64) < 0 || ferror(outFile))
+    {
+        fprintf(stderr, "Error writing to output file: %s\n", strerror(errno));
+        return false;
+    }
+
+    if (gGeneratePayloads)
+    {
+        VerifyOrReturnError(WritePayloads(outFile, job), false);
+    }
+
+    if (fprintf(outFile, "\n") < 0 || ferror(outFile))
+    {
+        fprintf(stderr, "Error writing to output file: %s\n", strerror(errno));
+        return false;
+    }
+
+    return true;
+}
+
 } // namespace
 
 bool Cmd_GenVerifier(int argc, char * argv[])
@@ -314,6 +582,30 @@ bool Cmd_GenVerifier(int argc, char * argv[])
         return false;
     }
 
+    if (gHasVendorId != gHasProductId)
+    {
+        fprintf(stderr, "Please specify both the 'vendor-id' and 'product-id' parameters to generate onboarding payloads.\n");
+        return false;
+    }
+    gGeneratePayloads = gHasVendorId;
+    if (gHasDiscriminator && !gGeneratePayloads)
+    {
+        fprintf(stderr, "The 'discriminator' parameter is only used with the 'vendor-id' and 'product-id' parameters.\n");
+        return false;
+    }
+
+    if (gThreadCount == 0)
+    {
+        gThreadCount = std::max(1u, std::thread::hardware_concurrency());
+    }
+#if !(CHIP_CRYPTO_OPENSSL || CHIP_CRYPTO_BORINGSSL)
+    if (gThreadCount > 1)
+    {
+        fprintf(stderr, "Parallel verifier generation requires a thread-safe crypto backend (OpenSSL or BoringSSL).\n");
+        return false;
+    }
+#endif
+
     if (strcmp(gOutFileName, "-") != 0)
     {
         outFile = fopen(gOutFileName, "w+b");
@@ -328,67 +620,38 @@ bool Cmd_GenVerifier(int argc, char * argv[])
         outFile = stdout;
     }
 
-    if (fprintf(outFile, "Index,PIN Code,Iteration Count,Salt,Verifier\n") < 0 || ferror(outFile))
+    const char * payloadColumns = gGeneratePayloads ? ",Discriminator,QR Code,Manual Code" : "";
+    if (fprintf(outFile, "Index,PIN Code,Iteration Count,Salt,Verifier%s\n", payloadColumns) < 0 || ferror(outFile))
     {
         fprintf(stderr, "Error writing to output file: %s\n", strerror(errno));
         return false;
     }
 
-    for (uint32_t i = 0; i < gCount; i++)
-    {
-        uint8_t salt[chip::kSpake2p_Max_PBKDF_Salt_Length];
-        if (gSaltDecodedLen == 0)
-        {
-            CHIP_ERROR err = chip::Crypto::DRBG_get_bytes(salt, gSaltLen);
-            if (err != CHIP_NO_ERROR)
-            {
-                fprintf(stderr, "DRBG_get_bytes() failed.\n");
-                return false;
-            }
-        }
-        else
-        {
-            memcpy(salt, gSalt, gSaltLen);
-        }
+    const uint32_t batchSize = gThreadCount * kVerifiersPerThreadBatch;
+    const auto start         = std::chrono::steady_clock::now();
+    std::vector<VerifierJob> jobs;
 
-        chip::Spake2pVerifier verifier;
-        CHIP_ERROR err = chip::PASESession::GeneratePASEVerifier(verifier, gIterationCount, chip::ByteSpan(salt, gSaltLen),
-                                                                 (gPinCode == chip::kSetupPINCodeUndefinedValue), gPinCode);
-        if (err != CHIP_NO_ERROR)
-        {
-            fprintf(stderr, "GeneratePASEVerifier() failed.\n");
-            return false;
-        }
+    for (uint32_t first = 0; first < gCount; first += batchSize)
+    {
+        jobs.resize(std::min(batchSize, gCount - first));
 
-        chip::Spake2pVerifierSerialized serializedVerifier;
-        chip::MutableByteSpan serializedVerifierSpan(serializedVerifier);
-        err = verifier.Serialize(serializedVerifierSpan);
-        if (err != CHIP_NO_ERROR)
+        for (auto & job : jobs)
         {
-            fprintf(stderr, "Spake2pVerifier::Serialize() failed.\n");
-            return false;
+            VerifyOrReturnError(PrepareJob(job), false);
         }
 
-        char saltB64[BASE64_ENCODED_LEN(chip::kSpake2p_Max_PBKDF_Salt_Length) + 1];
-        uint32_t saltB64Len = chip::Base64Encode32(salt, gSaltLen, saltB64);
-        saltB64[saltB64Len] = '\0';
-
-        char verifierB64[BASE64_ENCODED_LEN(chip::kSpake2p_VerifierSerialized_Length) + 1];
-        uint32_t verifierB64Len = chip::Base64Encode32(serializedVerifier, chip::kSpake2p_VerifierSerialized_Length, verifierB64);
-        verifierB64[verifierB64Len] = '\0';
+        ComputeVerifiers(jobs, gThreadCount);
 
-        if (fprintf(outFile, "%d,%08d,%d,%s,%s\n", i, gPinCode, gIterationCount, saltB64, verifierB64) < 0 || ferror(outFile))
+        for (uint32_t i = 0; i < jobs.size(); i++)
         {
-            fprintf(stderr, "Error writing to output file: %s\n", strerror(errno));
-            return false;
+            VerifyOrReturnError(WriteJob(outFile, first + i, jobs[i]), false);
         }
-
-        // If the file with PIN codes is not provided, the PIN code on next iteration will be randomly generated.
-        gPinCode = GetNextPinCode();
-        // On the next iteration the Salt will be randomly generated.
-        gSaltDecodedLen = 0;
     }
 
+    const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    fprintf(stderr, "Generated %u parameter set(s) in %.2f s (%.1f per second) using %u thread(s).\n", gCount, elapsed.count(),
+            gCount / std::max(elapsed.count(), 1e-6), gThreadCount);
+
     if (gPinCodeFile)
     {
         fclose(gPinCodeFile);
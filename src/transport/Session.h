@@ -25,6 +25,7 @@
 #include <lib/support/IntrusiveList.h>
 #include <lib/support/ReferenceCountedHandle.h>
 #include <messaging/ReliableMessageProtocolConfig.h>
+#include <messaging/ReliableMessageRttEstimator.h>
 #include <platform/LockTracker.h>
 #include <transport/SessionDelegate.h>
 
@@ -205,6 +206,12 @@ public:
     // the target For group sessions, this function will always return 0.
     System::Clock::Timeout ComputeRoundTripTimeout(System::Clock::Timeout upperlayerProcessingTimeout);
 
+#if CHIP_CONFIG_MRP_ADAPTIVE_RETRANS_TIMEOUT
+    // Round-trip times measured by MRP on this session, used to adapt the retransmission timeout to the peer.
+    ReliableMessageRttEstimator & GetRttEstimator() { return mRttEstimator; }
+    const ReliableMessageRttEstimator & GetRttEstimator() const { return mRttEstimator; }
+#endif // CHIP_CONFIG_MRP_ADAPTIVE_RETRANS_TIMEOUT
+
     FabricIndex GetFabricIndex() const { return mFabricIndex; }
 
     SecureSession * AsSecureSession();
@@ -260,6 +267,9 @@ protected:
 
 private:
     FabricIndex mFabricIndex = kUndefinedFabricIndex;
+#if CHIP_CONFIG_MRP_ADAPTIVE_RETRANS_TIMEOUT
+    ReliableMessageRttEstimator mRttEstimator;
+#endif // CHIP_CONFIG_MRP_ADAPTIVE_RETRANS_TIMEOUT
 };
 
 //
@@ -32,6 +32,7 @@
 
 #include <inttypes.h>
 #include <limits>
+#include <string.h>
 
 namespace chip {
 namespace Transport {
@@ -42,8 +43,9 @@ using namespace chip::Encoding;
 // Packets start with a 16-bit size
 constexpr size_t kPacketSizeBytes = 2;
 
+// Largest message that can be received: it must fit in a single (possibly large) packet buffer to be passed upstream.
 // TODO: Actual limit may be lower (spec issue #2119)
-constexpr uint16_t kMaxMessageSize = static_cast<uint16_t>(System::PacketBuffer::kMaxSizeWithoutReserve - kPacketSizeBytes);
+constexpr uint16_t kMaxMessageSize = System::PacketBuffer::kLargeBufMaxSizeWithoutReserve;
 
 constexpr int kListenBacklogSize = 2;
 
@@ -140,11 +142,9 @@ TCPBase::ActiveConnectionState * TCPBase::FindActiveConnection(const PeerAddress
         {
             continue;
         }
-        Inet::IPAddress addr;
-        uint16_t port;
-        mActiveConnections[i].mEndPoint->GetPeerInfo(&addr, &port);
+        const PeerAddress & peerAddress = mActiveConnections[i].mPeerAddress;
 
-        if ((addr == address.GetIPAddress()) && (port == address.GetPort()))
+        if ((peerAddress.GetIPAddress() == address.GetIPAddress()) && (peerAddress.GetPort() == address.GetPort()))
         {
             return &mActiveConnections[i];
         }
@@ -261,31 +261,65 @@ CHIP_ERROR TCPBase::ProcessReceivedBuffer(Inet::TCPEndPoint * endPoint, const Pe
 
     while (!state->mReceived.IsNull())
     {
-        uint8_t messageSizeBuf[kPacketSizeBytes];
-        CHIP_ERROR err = state->mReceived->Read(messageSizeBuf);
-        if (err == CHIP_ERROR_BUFFER_TOO_SMALL)
+        if (state->mPendingMessage.IsNull())
         {
-            // We don't have enough data to read the message size. Wait until there's more.
-            return CHIP_NO_ERROR;
+            uint8_t messageSizeBuf[kPacketSizeBytes];
+            CHIP_ERROR err = state->mReceived->Read(messageSizeBuf);
+            if (err == CHIP_ERROR_BUFFER_TOO_SMALL)
+            {
+                // We don't have enough data to read the message size. Wait until there's more.
+                return CHIP_NO_ERROR;
+            }
+            if (err != CHIP_NO_ERROR)
+            {
+                return err;
+            }
+            uint16_t messageSize = LittleEndian::Get16(messageSizeBuf);
+            if (messageSize > kMaxMessageSize)
+            {
+                // This message is too long for upper layers.
+                return CHIP_ERROR_MESSAGE_TOO_LONG;
+            }
+            // The subtraction will not underflow because we successfully read kPacketSizeBytes.
+            if (messageSize <= (state->mReceived->TotalLength() - kPacketSizeBytes))
+            {
+                // We have already received the complete message.
+                state->mReceived.Consume(kPacketSizeBytes);
+                ReturnErrorOnFailure(ProcessSingleMessage(peerAddress, state, messageSize));
+                continue;
+            }
+
+            // We have not yet received the complete message. Rather than keeping every received buffer until we have, and
+            // copying them all at the end, allocate the message now and fill it in as data arrives.
+            state->mPendingMessage = System::PacketBufferHandle::NewLarge(messageSize);
+            VerifyOrReturnError(!state->mPendingMessage.IsNull(), CHIP_ERROR_NO_MEMORY);
+            state->mPendingMessageSize = messageSize;
+            state->mReceived.Consume(kPacketSizeBytes);
+            continue;
         }
-        if (err != CHIP_NO_ERROR)
+
+        if (state->mReceived->DataLength() == 0)
         {
-            return err;
+            state->mReceived.FreeHead();
+            continue;
         }
-        uint16_t messageSize = LittleEndian::Get16(messageSizeBuf);
-        if (messageSize >= kMaxMessageSize)
+
+        // Move the data belonging to the pending message out of the head buffer, releasing it once drained.
+        uint16_t received = state->mPendingMessage->DataLength();
+        uint16_t length   = static_cast<uint16_t>(state->mPendingMessageSize - received);
+        if (length > state->mReceived->DataLength())
         {
-            // This message is too long for upper layers.
-            return CHIP_ERROR_MESSAGE_TOO_LONG;
+            length = state->mReceived->DataLength();
         }
-        // The subtraction will not underflow because we successfully read kPacketSizeBytes.
-        if (messageSize > (state->mReceived->TotalLength() - kPacketSizeBytes))
+        memcpy(state->mPendingMessage->Start() + received, state->mReceived->Start(), length);
+        state->mPendingMessage->SetDataLength(static_cast<uint16_t>(received + length));
+        state->mReceived.Consume(length);
+
+        if (state->mPendingMessage->DataLength() == state->mPendingMessageSize)
         {
-            // We have not yet received the complete message.
-            return CHIP_NO_ERROR;
+            System::PacketBufferHandle message = std::move(state->mPendingMessage);
+            HandleMessageReceived(peerAddress, std::move(message));
         }
-        state->mReceived.Consume(kPacketSizeBytes);
-        ReturnErrorOnFailure(ProcessSingleMessage(peerAddress, state, messageSize));
     }
 
     return CHIP_NO_ERROR;
@@ -310,7 +344,7 @@ CHIP_ERROR TCPBase::ProcessSingleMessage(const PeerAddress & peerAddress, Active
         // In either case, copy the message to a fresh linear buffer to pass upstream. We always copy, rather than provide
         // a shared reference to the current buffer, in case upper layers manipulate the buffer in ways that would affect
         // our use, e.g. chaining it elsewhere or reusing space beyond the current message.
-        message = System::PacketBufferHandle::New(messageSize, 0);
+        message = System::PacketBufferHandle::NewLarge(messageSize);
         if (message.IsNull())
         {
             return CHIP_ERROR_NO_MEMORY;
@@ -339,16 +373,14 @@ void TCPBase::ReleaseActiveConnection(Inet::TCPEndPoint * endPoint)
 
 CHIP_ERROR TCPBase::OnTcpReceive(Inet::TCPEndPoint * endPoint, System::PacketBufferHandle && buffer)
 {
-    Inet::IPAddress ipAddress;
-    uint16_t port;
-    Inet::InterfaceId interfaceId;
-
-    endPoint->GetPeerInfo(&ipAddress, &port);
-    endPoint->GetInterfaceId(&interfaceId);
-    PeerAddress peerAddress = PeerAddress::TCP(ipAddress, port, interfaceId);
+    TCPBase * tcp                 = reinterpret_cast<TCPBase *>(endPoint->mAppState);
+    ActiveConnectionState * state = tcp->FindActiveConnection(endPoint);
+    CHIP_ERROR err                = CHIP_ERROR_INTERNAL;
 
-    TCPBase * tcp  = reinterpret_cast<TCPBase *>(endPoint->mAppState);
-    CHIP_ERROR err = tcp->ProcessReceivedBuffer(endPoint, peerAddress, std::move(buffer));
+    if (state != nullptr)
+    {
+        err = tcp->ProcessReceivedBuffer(endPoint, state->mPeerAddress, std::move(buffer));
+    }
 
     if (err != CHIP_NO_ERROR)
     {
@@ -415,7 +447,7 @@ void TCPBase::OnConnectionComplete(Inet::TCPEndPoint * endPoint, CHIP_ERROR inet
         {
             if (!tcp->mActiveConnections[i].InUse())
             {
-                tcp->mActiveConnections[i].Init(endPoint);
+                tcp->mActiveConnections[i].Init(endPoint, addr);
                 connectionStored = true;
                 break;
             }
@@ -448,12 +480,15 @@ void TCPBase::OnConnectionReceived(Inet::TCPEndPoint * listenEndPoint, Inet::TCP
 
     if (tcp->mUsedEndPointCount < tcp->mActiveConnectionsSize)
     {
+        Inet::InterfaceId interfaceId;
+        endPoint->GetInterfaceId(&interfaceId);
+
         // have space to use one more (even if considering pending connections)
         for (size_t i = 0; i < tcp->mActiveConnectionsSize; i++)
         {
             if (!tcp->mActiveConnections[i].InUse())
             {
-                tcp->mActiveConnections[i].Init(endPoint);
+                tcp->mActiveConnections[i].Init(endPoint, PeerAddress::TCP(peerAddress, peerPort, interfaceId));
                 tcp->mUsedEndPointCount++;
                 break;
             }
@@ -486,13 +521,7 @@ void TCPBase::Disconnect(const PeerAddress & address)
     {
         if (mActiveConnections[i].InUse())
         {
-            Inet::IPAddress ipAddress;
-            uint16_t port;
-            Inet::InterfaceId interfaceId;
-
-            mActiveConnections[i].mEndPoint->GetPeerInfo(&ipAddress, &port);
-            mActiveConnections[i].mEndPoint->GetInterfaceId(&interfaceId);
-            if (address == PeerAddress::TCP(ipAddress, port, interfaceId))
+            if (address == mActiveConnections[i].mPeerAddress)
             {
                 // NOTE: this leaves the socket in TIME_WAIT.
                 // Calling Abort() would clean it since SO_LINGER would be set to 0,
@@ -111,25 +111,36 @@ protected:
      */
     struct ActiveConnectionState
     {
-        void Init(Inet::TCPEndPoint * endPoint)
+        void Init(Inet::TCPEndPoint * endPoint, const PeerAddress & peerAddress)
         {
-            mEndPoint = endPoint;
-            mReceived = nullptr;
+            mEndPoint           = endPoint;
+            mPeerAddress        = peerAddress;
+            mReceived           = nullptr;
+            mPendingMessage     = nullptr;
+            mPendingMessageSize = 0;
         }
 
         void Free()
         {
             mEndPoint->Free();
-            mEndPoint = nullptr;
-            mReceived = nullptr;
+            mEndPoint       = nullptr;
+            mReceived       = nullptr;
+            mPendingMessage = nullptr;
         }
         bool InUse() const { return mEndPoint != nullptr; }
 
         // Associated endpoint.
         Inet::TCPEndPoint * mEndPoint;
 
+        // Address of the peer, kept so that connection lookups do not need to query the endpoint.
+        PeerAddress mPeerAddress;
+
         // Buffers received but not yet consumed.
         System::PacketBufferHandle mReceived;
+
+        // Message being reassembled, allocated at its full size once its length is known, and its expected size.
+        System::PacketBufferHandle mPendingMessage;
+        uint16_t mPendingMessageSize;
     };
 
 public:
@@ -210,6 +221,10 @@ private:
      *
      * Ownership of buffer is taken over and will be freed (or re-enqueued to the endPoint receive queue)
      * as needed during processing.
+     *
+     * Messages that have not been completely received are copied into a buffer of their full size as data arrives, so that
+     * messages larger than a single packet buffer (up to PacketBuffer::kLargeBufMaxSizeWithoutReserve) can be received
+     * without holding on to every buffer they span.
      */
     CHIP_ERROR ProcessReceivedBuffer(Inet::TCPEndPoint * endPoint, const PeerAddress & peerAddress,
                                      System::PacketBufferHandle && buffer);
@@ -277,7 +292,7 @@ public:
     {
         for (size_t i = 0; i < kActiveConnectionsSize; ++i)
         {
-            mConnectionsBuffer[i].Init(nullptr);
+            mConnectionsBuffer[i].Init(nullptr, PeerAddress());
         }
     }
     ~TCP() override { mPendingPackets.ReleaseAll(); }
@@ -30,6 +30,7 @@
 #include <lib/support/UnitTestContext.h>
 #include <lib/support/UnitTestRegistration.h>
 #include <lib/support/UnitTestUtils.h>
+#include <system/SystemClock.h>
 #include <system/SystemLayer.h>
 #include <transport/TransportMgr.h>
 #include <transport/raw/TCP.h>
@@ -38,6 +39,7 @@
 #include <nlunit-test.h>
 
 #include <errno.h>
+#include <inttypes.h>
 #include <stdlib.h>
 #include <string.h>
 #include <utility>
@@ -74,6 +76,9 @@ using TestContext = chip::Test::IOContext;
 
 const char PAYLOAD[] = "Hello!";
 
+// Size of the payload of large messages, which do not fit in a regular packet buffer.
+constexpr uint16_t kLargePayloadSize = 20000;
+
 class MockTransportMgrDelegate : public chip::TransportMgrDelegate
 {
 public:
@@ -161,6 +166,56 @@ public:
         SetCallback(nullptr);
     }
 
+    void LargeMessageTest(TCPImpl & tcp, const IPAddress & addr, int messageCount)
+    {
+        PacketHeader header;
+        header.SetSourceNodeId(kSourceNodeId).SetDestinationNodeId(kDestinationNodeId).SetMessageCounter(kMessageCounter);
+
+        SetCallback([](const uint8_t * message, size_t length, int count, void * data) {
+            if (length != kLargePayloadSize)
+            {
+                return -1;
+            }
+            for (size_t i = 0; i < length; ++i)
+            {
+                if (message[i] != static_cast<uint8_t>(i))
+                {
+                    return -2;
+                }
+            }
+            return 0;
+        });
+
+        System::Clock::Timestamp start = System::SystemClock().GetMonotonicTimestamp();
+        for (int i = 0; i < messageCount; ++i)
+        {
+            System::PacketBufferHandle buffer =
+                System::PacketBufferHandle::NewLarge(kPacketSizeBytes + header.EncodeSizeBytes() + kLargePayloadSize);
+            NL_TEST_ASSERT(mSuite, !buffer.IsNull());
+            for (uint16_t j = 0; j < kLargePayloadSize; ++j)
+            {
+                buffer->Start()[j] = static_cast<uint8_t>(j);
+            }
+            buffer->SetDataLength(kLargePayloadSize);
+
+            CHIP_ERROR err = header.EncodeBeforeData(buffer);
+            NL_TEST_ASSERT(mSuite, err == CHIP_NO_ERROR);
+
+            err = tcp.SendMessage(Transport::PeerAddress::TCP(addr), std::move(buffer));
+            NL_TEST_ASSERT(mSuite, err == CHIP_NO_ERROR);
+        }
+
+        mContext.DriveIOUntil(chip::System::Clock::Seconds16(5),
+                              [this, messageCount]() { return mReceiveHandlerCallCount == messageCount; });
+        NL_TEST_ASSERT(mSuite, mReceiveHandlerCallCount == messageCount);
+
+        System::Clock::Milliseconds64 elapsed = System::SystemClock().GetMonotonicTimestamp() - start;
+        ChipLogProgress(NotSpecified, "Received %d messages of %u bytes in %" PRIu64 " ms", mReceiveHandlerCallCount,
+                        static_cast<unsigned>(kLargePayloadSize), elapsed.count());
+
+        SetCallback(nullptr);
+    }
+
     void FinalizeMessageTest(TCPImpl & tcp, const IPAddress & addr)
     {
         // Disconnect and wait for seeing peer close
@@ -232,6 +287,26 @@ void CheckMessageTest6(nlTestSuite * inSuite, void * inContext)
     CheckMessageTest(inSuite, inContext, addr);
 }
 
+void CheckLargeMessageTest(nlTestSuite * inSuite, void * inContext)
+{
+    // Large messages need large packet buffers, which are not available on all platforms.
+    if (System::PacketBuffer::kLargeBufMaxSizeWithoutReserve < kLargePayloadSize + System::PacketBuffer::kDefaultHeaderReserve)
+    {
+        return;
+    }
+
+    TestContext & ctx = *reinterpret_cast<TestContext *>(inContext);
+    TCPImpl tcp;
+
+    IPAddress addr;
+    IPAddress::FromString("::1", addr);
+
+    MockTransportMgrDelegate gMockTransportMgrDelegate(inSuite, ctx);
+    gMockTransportMgrDelegate.InitializeMessageTest(tcp, addr);
+    gMockTransportMgrDelegate.LargeMessageTest(tcp, addr, 8);
+    gMockTransportMgrDelegate.FinalizeMessageTest(tcp, addr);
+}
+
 // Generates a packet buffer or a chain of packet buffers for a single message.
 struct TestData
 {
@@ -440,13 +515,41 @@ void chip::Transport::TCPTest::CheckProcessReceivedBuffer(nlTestSuite * inSuite,
     NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR);
     NL_TEST_ASSERT(inSuite, gMockTransportMgrDelegate.mReceiveHandlerCallCount == 2);
 
-    // Test a message that is too large to coalesce into a single packet buffer.
+    // Test a message delivered one buffer at a time, which is reassembled as the buffers arrive.
+    gMockTransportMgrDelegate.mReceiveHandlerCallCount = 0;
+    NL_TEST_ASSERT(inSuite, testData[0].Init((const uint16_t[]){ 151, 152, 153, 154, 0 }));
+    while (!testData[0].mHandle.IsNull())
+    {
+        NL_TEST_ASSERT(inSuite, gMockTransportMgrDelegate.mReceiveHandlerCallCount == 0);
+        err = tcp.ProcessReceivedBuffer(lEndPoint, lPeerAddress, testData[0].mHandle.PopHead());
+        NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR);
+    }
+    NL_TEST_ASSERT(inSuite, gMockTransportMgrDelegate.mReceiveHandlerCallCount == 1);
+
+    // Test a message that is too large for a regular packet buffer, delivered one buffer at a time.
+    if (System::PacketBuffer::kLargeBufMaxSizeWithoutReserve > 3 * System::PacketBuffer::kMaxSizeWithoutReserve)
+    {
+        constexpr uint16_t kSize = System::PacketBuffer::kMaxSizeWithoutReserve;
+        gMockTransportMgrDelegate.mReceiveHandlerCallCount = 0;
+        NL_TEST_ASSERT(inSuite, testData[0].Init((const uint16_t[]){ kSize, kSize, kSize, 0 }));
+        while (!testData[0].mHandle.IsNull())
+        {
+            NL_TEST_ASSERT(inSuite, gMockTransportMgrDelegate.mReceiveHandlerCallCount == 0);
+            err = tcp.ProcessReceivedBuffer(lEndPoint, lPeerAddress, testData[0].mHandle.PopHead());
+            NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR);
+        }
+        NL_TEST_ASSERT(inSuite, gMockTransportMgrDelegate.mReceiveHandlerCallCount == 1);
+    }
+
+    // Test a message that is too large to be received. Its length alone should be enough to trigger the error.
     gMockTransportMgrDelegate.mReceiveHandlerCallCount = 0;
     gMockTransportMgrDelegate.SetCallback(TestDataCallbackCheck, &testData[1]);
-    NL_TEST_ASSERT(inSuite, testData[0].Init((const uint16_t[]){ 51, System::PacketBuffer::kMaxSizeWithoutReserve, 0 }));
-    // Sending only the first buffer of the long chain. This should be enough to trigger the error.
-    System::PacketBufferHandle head = testData[0].mHandle.PopHead();
-    err                             = tcp.ProcessReceivedBuffer(lEndPoint, lPeerAddress, std::move(head));
+    System::PacketBufferHandle head = System::PacketBufferHandle::New(kPacketSizeBytes, 0 /* reserve */);
+    NL_TEST_ASSERT(inSuite, !head.IsNull());
+    chip::Encoding::LittleEndian::Put16(head->Start(),
+                                        static_cast<uint16_t>(System::PacketBuffer::kLargeBufMaxSizeWithoutReserve + 1));
+    head->SetDataLength(kPacketSizeBytes);
+    err = tcp.ProcessReceivedBuffer(lEndPoint, lPeerAddress, std::move(head));
     NL_TEST_ASSERT(inSuite, err == CHIP_ERROR_MESSAGE_TOO_LONG);
     NL_TEST_ASSERT(inSuite, gMockTransportMgrDelegate.mReceiveHandlerCallCount == 0);
 
@@ -467,6 +570,7 @@ static const nlTest sTests[] =
 
     NL_TEST_DEF("Simple Init Test IPV6",        CheckSimpleInitTest6),
     NL_TEST_DEF("Message Self Test IPV6",       CheckMessageTest6),
+    NL_TEST_DEF("Large Message Self Test",      CheckLargeMessageTest),
     NL_TEST_DEF("ProcessReceivedBuffer Test",   chip::Transport::TCPTest::CheckProcessReceivedBuffer),
 
     NL_TEST_SENTINEL()